@@ -129,8 +129,53 @@ static void API_renderStill_multiple_sources(::benchmark::State& state) {
     }
 }
 
+// Places icons from several sources. Without cross-source collisions, each source is placed in
+// parallel; the argument selects whether cross-source collisions are enabled.
+static void API_renderStill_multiple_label_sources(::benchmark::State& state) {
+    using namespace mbgl::style;
+    RenderBenchmark bench;
+    HeadlessFrontend frontend{size, pixelRatio};
+    Map map{frontend,
+            MapObserver::nullObserver(),
+            MapOptions()
+                .withMapMode(MapMode::Static)
+                .withSize(size)
+                .withPixelRatio(pixelRatio)
+                .withCrossSourceCollisions(state.range(0) != 0),
+            ResourceOptions().withCachePath(cachePath).withAccessToken("foobar")};
+    prepare(map);
+    auto& style = map.getStyle();
+    const int kSourcesCount = 8;
+    const int kPointsCount = 2000;
+    for (int i = 0; i < kSourcesCount; ++i) {
+        mapbox::geojson::feature_collection features;
+        for (int j = 0; j < kPointsCount; ++j) {
+            // Scatter the points deterministically over the visible part of Manhattan.
+            const double x = double((j * 7919 + i * 104729) % 1000) / 1000.0;
+            const double y = double((j * 6271 + i * 7907) % 1000) / 1000.0;
+            features.emplace_back(mapbox::geojson::point{-74.005 + x * 0.025, 40.717 + y * 0.02});
+        }
+
+        std::ostringstream sourceOss;
+        sourceOss << "LabelSource" << i;
+        std::string sourceId{sourceOss.str()};
+        auto source = std::make_unique<GeoJSONSource>(sourceId);
+        source->setGeoJSON(mapbox::geojson::geojson{features});
+        style.addSource(std::move(source));
+
+        auto layer = std::make_unique<SymbolLayer>(sourceId + "#icons", sourceId);
+        layer->setIconImage(expression::Image("test-icon"));
+        style.addLayer(std::move(layer));
+    }
+
+    while (state.KeepRunning()) {
+        frontend.render(map);
+    }
+}
+
 BENCHMARK(API_renderStill_reuse_map);
 BENCHMARK(API_renderStill_reuse_map_formatted_labels);
 BENCHMARK(API_renderStill_reuse_map_switch_styles);
 BENCHMARK(API_renderStill_recreate_map);
 BENCHMARK(API_renderStill_multiple_sources);
+BENCHMARK(API_renderStill_multiple_label_sources)->Arg(0)->Arg(1);
@@ -6,6 +6,8 @@
 #include <mbgl/style/conversion/property_value.hpp>
 #include <mbgl/style/conversion_impl.hpp>
 
+#include <array>
+
 using namespace mbgl;
 using namespace mbgl::style;
 
@@ -52,6 +54,50 @@ static void Evaluate_SourceFunction(benchmark::State& state) {
     state.SetLabel(std::to_string(stopCount).c_str());
 }
 
+// Arg 0 evaluates the expression tree, 1 the compiled form and 2 all features at once.
+static void Evaluate_SourceExpression(benchmark::State& state) {
+    const int64_t mode = state.range(0);
+    const std::string doc = R"(["match", ["get", "class"],
+        ["park", "cemetery"], ["interpolate", ["linear"], ["get", "rank"], 0, 1, 10, 4],
+        "water", ["step", ["get", "rank"], 2, 5, 3],
+        0])";
+    conversion::Error error;
+    optional<PropertyValue<float>> expression = conversion::convertJSON<PropertyValue<float>>(doc, error, true, false);
+    if (!expression) {
+        state.SkipWithError(error.message.c_str());
+        return;
+    }
+
+    const std::array<std::string, 4> classes = {{"park", "cemetery", "water", "road"}};
+    std::vector<StubGeometryTileFeature> features;
+    for (std::size_t i = 0; i < 1000; i++) {
+        features.emplace_back(PropertyMap{{"class", classes[i % classes.size()]}, {"rank", static_cast<int64_t>(i % 10)}});
+    }
+
+    std::vector<const GeometryTileFeature*> featurePointers;
+    for (const auto& feature : features) {
+        featurePointers.push_back(&feature);
+    }
+
+    const auto& propertyExpression = expression->asExpression();
+    while (state.KeepRunning()) {
+        if (mode == 2) {
+            benchmark::DoNotOptimize(propertyExpression.evaluate(expression::EvaluationContext(), featurePointers, -1.0f));
+            continue;
+        }
+        for (const auto& feature : features) {
+            if (mode == 1) {
+                benchmark::DoNotOptimize(propertyExpression.evaluate(feature, -1.0f));
+            } else {
+                benchmark::DoNotOptimize(propertyExpression.getExpression().evaluate(expression::EvaluationContext(&feature)));
+            }
+        }
+    }
+
+    state.SetLabel(mode == 2 ? "column" : mode == 1 ? "compiled" : "tree");
+    state.SetItemsProcessed(state.iterations() * features.size());
+}
+
 BENCHMARK(Parse_SourceFunction)
     ->Arg(1)->Arg(2)->Arg(4)->Arg(6)->Arg(8)->Arg(10)->Arg(12);
 
@@ -59,3 +105,5 @@ BENCHMARK(Evaluate_SourceFunction)
     ->Arg(1)->Arg(2)->Arg(4)->Arg(6)->Arg(8)->Arg(10)->Arg(12);
 
 
+
+BENCHMARK(Evaluate_SourceExpression)->Arg(0)->Arg(1)->Arg(2);
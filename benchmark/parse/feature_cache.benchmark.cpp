@@ -0,0 +1,65 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/tile/geometry_tile_feature_cache.hpp>
+#include <mbgl/tile/vector_tile_data.hpp>
+#include <mbgl/util/io.hpp>
+
+using namespace mbgl;
+
+namespace {
+
+// Number of layout groups reading each source layer, similar to how Streets styles
+// draw e.g. the "road" source layer with a dozen line layers.
+constexpr std::size_t groupsPerSourceLayer = 12;
+
+// Mimics the per-feature work of GeometryTileWorker::parse() for every layout group:
+// evaluate a filter on a property and then read the feature geometry.
+template <class GetLayer>
+std::size_t parseGroups(const std::vector<std::string>& sourceLayers, GetLayer&& getLayer) {
+    std::size_t length = 0;
+    for (std::size_t group = 0; group < groupsPerSourceLayer; ++group) {
+        for (const auto& name : sourceLayers) {
+            auto layer = getLayer(name);
+            if (!layer) continue;
+            const std::size_t count = layer->featureCount();
+            for (std::size_t i = 0; i < count; ++i) {
+                auto feature = layer->getFeature(i);
+                if (feature->getValue("class")) {
+                    ++length;
+                }
+                length += feature->getGeometries().size();
+            }
+        }
+    }
+    return length;
+}
+
+} // namespace
+
+static void Parse_VectorTileGroups(benchmark::State& state) {
+    auto data = std::make_shared<std::string>(util::read_file("test/fixtures/api/assets/streets/10-163-395.vector.pbf"));
+    const auto sourceLayers = VectorTileData(data).layerNames();
+
+    while (state.KeepRunning()) {
+        VectorTileData tile(data);
+        benchmark::DoNotOptimize(parseGroups(sourceLayers, [&](const std::string& name) {
+            return tile.getLayer(name);
+        }));
+    }
+}
+
+static void Parse_VectorTileGroupsFeatureCache(benchmark::State& state) {
+    auto data = std::make_shared<std::string>(util::read_file("test/fixtures/api/assets/streets/10-163-395.vector.pbf"));
+    const auto sourceLayers = VectorTileData(data).layerNames();
+
+    while (state.KeepRunning()) {
+        VectorTileData tile(data);
+        GeometryTileFeatureCache cache(tile);
+        benchmark::DoNotOptimize(parseGroups(sourceLayers, [&](const std::string& name) {
+            return cache.getLayer(name);
+        }));
+    }
+}
+
+BENCHMARK(Parse_VectorTileGroups);
+BENCHMARK(Parse_VectorTileGroupsFeatureCache);
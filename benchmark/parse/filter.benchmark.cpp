@@ -5,6 +5,8 @@
 #include <mbgl/style/conversion/filter.hpp>
 #include <mbgl/style/conversion_impl.hpp>
 #include <mbgl/tile/geometry_tile_data.hpp>
+#include <mbgl/tile/vector_tile_data.hpp>
+#include <mbgl/util/io.hpp>
 #include <mbgl/benchmark/stub_geometry_tile_feature.hpp>
 
 using namespace mbgl;
@@ -30,5 +32,34 @@ static void Parse_EvaluateFilter(benchmark::State& state) {
     }
 }
 
+// Evaluates filters similar to the ones of the Streets style on all features of the "road" layer.
+static void Parse_EvaluateFilterVectorTile(benchmark::State& state) {
+    const std::vector<style::Filter> filters = {
+        parse(R"FILTER(["all", ["==", "$type", "LineString"], ["in", "class", "motorway", "trunk"]])FILTER"),
+        parse(R"FILTER(["all", ["==", "class", "street"], ["!=", "type", "service"]])FILTER"),
+        parse(R"FILTER(["all", [">=", "len", 100], ["has", "name"]])FILTER"),
+        parse(R"FILTER(["==", ["get", "structure"], "bridge"])FILTER"),
+    };
+    VectorTileData data(std::make_shared<std::string>(util::read_file("test/fixtures/api/assets/streets/10-163-395.vector.pbf")));
+    auto layer = data.getLayer("road");
+    std::vector<std::unique_ptr<GeometryTileFeature>> features;
+    for (std::size_t i = 0; i < layer->featureCount(); ++i) {
+        features.push_back(layer->getFeature(i));
+    }
+
+    while (state.KeepRunning()) {
+        std::size_t count = 0;
+        for (const auto& feature : features) {
+            const style::expression::EvaluationContext context(16.0f, feature.get());
+            for (const auto& filter : filters) {
+                count += filter(context);
+            }
+        }
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetItemsProcessed(state.iterations() * features.size() * filters.size());
+}
+
 BENCHMARK(Parse_Filter);
 BENCHMARK(Parse_EvaluateFilter);
+BENCHMARK(Parse_EvaluateFilterVectorTile);
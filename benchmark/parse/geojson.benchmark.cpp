@@ -0,0 +1,156 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/style/conversion/geojson.hpp>
+#include <mbgl/style/conversion/json.hpp>
+#include <mbgl/util/constants.hpp>
+#include <mbgl/util/io.hpp>
+
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+#if defined(__linux__)
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+using namespace mbgl;
+using namespace mbgl::style::conversion;
+
+namespace {
+
+const std::string fixturePath = "benchmark/fixtures/geojson.benchmark.json";
+
+// Writes a FeatureCollection of the given number of polygons with a few properties each, which is
+// about 1.5 kB of text per feature.
+std::string makeFixture(std::size_t count) {
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+
+    writer.StartObject();
+    writer.Key("type");
+    writer.String("FeatureCollection");
+    writer.Key("features");
+    writer.StartArray();
+    for (std::size_t i = 0; i < count; ++i) {
+        const double x = -180.0 + double(i * 7919 % 36000) / 100.0;
+        const double y = -80.0 + double(i * 6271 % 16000) / 100.0;
+        writer.StartObject();
+        writer.Key("type");
+        writer.String("Feature");
+        writer.Key("id");
+        writer.Uint64(i);
+        writer.Key("properties");
+        writer.StartObject();
+        writer.Key("name");
+        writer.String(("Feature " + std::to_string(i)).c_str());
+        writer.Key("population");
+        writer.Uint64(i * 31 % 100000);
+        writer.Key("tags");
+        writer.StartArray();
+        writer.String("residential");
+        writer.Bool(i % 2 == 0);
+        writer.EndArray();
+        writer.EndObject();
+        writer.Key("geometry");
+        writer.StartObject();
+        writer.Key("type");
+        writer.String("Polygon");
+        writer.Key("coordinates");
+        writer.StartArray();
+        writer.StartArray();
+        for (int vertex = 0; vertex <= 32; ++vertex) {
+            const double angle = util::M2PI * (vertex % 32) / 32;
+            writer.StartArray();
+            writer.Double(x + 0.01 * std::cos(angle));
+            writer.Double(y + 0.01 * std::sin(angle));
+            writer.EndArray();
+        }
+        writer.EndArray();
+        writer.EndArray();
+        writer.EndObject();
+        writer.EndObject();
+    }
+    writer.EndArray();
+    writer.EndObject();
+
+    return { buffer.GetString(), buffer.GetSize() };
+}
+
+// Returns how much the peak resident set size grows while running the function. It runs in a
+// forked process, so that neither the peaks of earlier runs nor memory kept by the allocator hide
+// the growth. Returns 0 where this is not supported.
+template <class Fn>
+double peakMemoryGrowth(Fn&& fn) {
+#if defined(__linux__)
+    long pages = 0;
+    if (FILE* statm = std::fopen("/proc/self/statm", "r")) {
+        if (std::fscanf(statm, "%*s%ld", &pages) != 1) {
+            pages = 0;
+        }
+        std::fclose(statm);
+    }
+    const double before = double(pages) * sysconf(_SC_PAGESIZE);
+
+    const pid_t pid = fork();
+    if (pid == 0) {
+        fn();
+        _exit(0);
+    }
+    int status = 0;
+    struct rusage usage;
+    if (pid == -1 || wait4(pid, &status, 0, &usage) == -1) {
+        return 0;
+    }
+    // The forked process starts out with the resident pages of this one.
+    return std::max(0.0, double(usage.ru_maxrss) * 1024 - before);
+#else
+    (void)fn;
+    return 0;
+#endif
+}
+
+template <class Parse>
+void parseFixture(benchmark::State& state, std::size_t size, Parse&& parse) {
+    while (state.KeepRunning()) {
+        Error error;
+        benchmark::DoNotOptimize(parse(error));
+    }
+    state.SetBytesProcessed(state.iterations() * size);
+    state.counters["peak_memory_mb"] = peakMemoryGrowth([&] {
+        Error error;
+        benchmark::DoNotOptimize(parse(error));
+    }) / (1024 * 1024);
+}
+
+} // namespace
+
+// Parses a JSON document first, like GeoJSON sources used to.
+static void Parse_GeoJSON_Document(benchmark::State& state) {
+    const std::string json = makeFixture(state.range(0));
+    parseFixture(state, json.size(), [&](Error& error) { return convertJSON<GeoJSON>(json, error); });
+}
+
+static void Parse_GeoJSON_Stream(benchmark::State& state) {
+    const std::string json = makeFixture(state.range(0));
+    parseFixture(state, json.size(), [&](Error& error) { return parseGeoJSON(json, error); });
+}
+
+static void Parse_GeoJSON_MappedFile(benchmark::State& state) {
+    std::size_t size = 0;
+    {
+        const std::string json = makeFixture(state.range(0));
+        size = json.size();
+        util::write_file(fixturePath, json);
+    }
+    parseFixture(state, size, [&](Error& error) { return parseGeoJSONFile(fixturePath, error); });
+    util::deleteFile(fixturePath);
+}
+
+BENCHMARK(Parse_GeoJSON_Document)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
+BENCHMARK(Parse_GeoJSON_Stream)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
+BENCHMARK(Parse_GeoJSON_MappedFile)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
@@ -35,6 +35,11 @@ public:
         return properties.count(key) ? properties.at(key) : optional<Value>();
     }
 
+    const Value* findValue(const std::string& key) const override {
+        auto it = properties.find(key);
+        return it != properties.end() ? &it->second : nullptr;
+    }
+
     const GeometryCollection& getGeometries() const override {
         return geometry;
     }
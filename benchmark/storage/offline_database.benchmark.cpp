@@ -4,6 +4,7 @@
 #include <mbgl/storage/resource.hpp>
 #include <mbgl/storage/response.hpp>
 #include <mbgl/storage/sqlite3.hpp>
+#include <mbgl/util/compression.hpp>
 #include <mbgl/util/string.hpp>
 #include <mbgl/util/logging.hpp>
 
@@ -131,6 +132,22 @@ BENCHMARK_F(OfflineDatabase, GetTile)(benchmark::State& state) {
     }
 }
 
+BENCHMARK_F(OfflineDatabase, GetTileWarmCache)(benchmark::State& state) {
+    using namespace mbgl;
+
+    std::vector<Resource> tiles;
+    for (unsigned i = 0; i < tileCount; ++i) {
+        tiles.push_back(Resource::tile("mapbox://tile_ambient" + util::toString(i), 1, 0, 0, 0, Tileset::Scheme::XYZ));
+        db.get(tiles.back());
+    }
+
+    std::size_t i = 0;
+    while (state.KeepRunning()) {
+        auto res = db.get(tiles[i++ % tiles.size()]);
+        assert(res != nullopt);
+    }
+}
+
 BENCHMARK_F(OfflineDatabase, AddTilesToFullDatabase)(benchmark::State& state) {
     using namespace mbgl;
 
@@ -194,3 +211,47 @@ BENCHMARK_F(OfflineDatabase, ResizeDatabase)(benchmark::State& state) {
         }
     }
 }
+
+// Stores the vector tiles of a real region, compressed with a dictionary trained on the first of
+// them, and reads them back. `stored` is the size of the stored tiles, and `original` their size
+// compressed without a dictionary.
+static void OfflineDatabase_GetRegionTiles(benchmark::State& state) {
+    using namespace mbgl;
+
+    std::vector<std::pair<Resource, Response>> tiles;
+    uint64_t original = 0;
+    {
+        mapbox::sqlite::Database cache =
+            mapbox::sqlite::Database::open("benchmark/fixtures/api/cache.db", mapbox::sqlite::ReadOnly);
+        mapbox::sqlite::Statement statement(cache, "SELECT url_template, x, y, z, data, compressed FROM tiles");
+        mapbox::sqlite::Query query{ statement };
+        while (query.run()) {
+            Response response;
+            const auto data = query.get<std::string>(4);
+            response.data = std::make_shared<std::string>(query.get<bool>(5) ? util::decompress(data) : data);
+            original += std::min(response.data->size(), util::compress(*response.data).size());
+            tiles.emplace_back(Resource::tile(query.get<std::string>(0), 1, query.get<int>(1),
+                                              query.get<int>(2), static_cast<int8_t>(query.get<int>(3)), Tileset::Scheme::XYZ),
+                               std::move(response));
+        }
+    }
+
+    mbgl::OfflineDatabase db(":memory:");
+    OfflineTilePyramidRegionDefinition definition{ "mapbox://style", LatLngBounds::world(), 0, 22, 1.0, false };
+    auto region = db.createRegion(definition, {});
+    uint64_t stored = 0;
+    for (const auto& tile : tiles) {
+        stored += db.putRegionResource(region->getID(), tile.first, tile.second);
+    }
+
+    std::size_t i = 0;
+    while (state.KeepRunning()) {
+        auto res = db.getRegionResource(tiles[i++ % tiles.size()].first);
+        assert(res != nullopt);
+    }
+
+    state.counters["original"] = original;
+    state.counters["stored"] = stored;
+}
+
+BENCHMARK(OfflineDatabase_GetRegionTiles);
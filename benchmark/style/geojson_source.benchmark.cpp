@@ -0,0 +1,131 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/style/sources/geojson_source.hpp>
+#include <mbgl/util/geo.hpp>
+#include <mbgl/util/run_loop.hpp>
+#include <mbgl/util/tile_cover.hpp>
+
+#include <vector>
+
+using namespace mbgl;
+using namespace mbgl::style;
+
+namespace {
+
+constexpr uint64_t kPointsCount = 200000;
+constexpr uint64_t kChangesCount = 300;
+
+// Scatters the points deterministically over Manhattan, moving them a little on every update.
+GeoJSONFeature makePoint(uint64_t id, uint64_t update) {
+    const double x = double((id * 7919 + update * 104729) % 100000) / 100000.0;
+    const double y = double((id * 6271 + update * 7907) % 100000) / 100000.0;
+    GeoJSONFeature feature{mapbox::geometry::point<double>{-74.02 + x * 0.06, 40.70 + y * 0.06}};
+    feature.id = id;
+    return feature;
+}
+
+std::vector<CanonicalTileID> viewportTiles() {
+    std::vector<CanonicalTileID> tiles;
+    for (const auto& tile : util::tileCover(LatLngBounds::hull({40.72, -74.00}, {40.74, -73.98}), 14)) {
+        tiles.push_back(tile.canonical);
+    }
+    return tiles;
+}
+
+// Loads the given tiles of the data, like a renderer does after the data changed.
+void loadTiles(util::RunLoop& loop, GeoJSONData& data, const std::vector<CanonicalTileID>& tiles) {
+    std::size_t pending = tiles.size();
+    for (const auto& tile : tiles) {
+        data.getTile(tile, [&](GeoJSONData::TileFeatures) { --pending; });
+    }
+    while (pending) {
+        loop.runOnce();
+    }
+}
+
+Immutable<GeoJSONOptions> makeOptions(bool incrementalUpdates) {
+    auto options = makeMutable<GeoJSONOptions>();
+    options->incrementalUpdates = incrementalUpdates;
+    return std::move(options);
+}
+
+} // namespace
+
+// Changes a few hundred of 200k points and replaces the whole data.
+static void GeoJSON_setGeoJSON(benchmark::State& state) {
+    util::RunLoop loop;
+    const auto tiles = viewportTiles();
+    const auto options = makeOptions(false);
+
+    FeatureCollection features;
+    for (uint64_t id = 0; id < kPointsCount; ++id) {
+        features.push_back(makePoint(id, 0));
+    }
+
+    uint64_t update = 0;
+    while (state.KeepRunning()) {
+        ++update;
+        for (uint64_t i = 0; i < kChangesCount; ++i) {
+            const uint64_t id = (update * kChangesCount + i) % kPointsCount;
+            features[id] = makePoint(id, update);
+        }
+        auto data = GeoJSONData::create(features, options);
+        loadTiles(loop, *data, tiles);
+    }
+}
+
+// Changes a few hundred of 200k points with an incremental update, and reloads only the
+// tiles containing changed points.
+static void GeoJSON_updateGeoJSON(benchmark::State& state) {
+    util::RunLoop loop;
+    const auto tiles = viewportTiles();
+
+    FeatureCollection features;
+    for (uint64_t id = 0; id < kPointsCount; ++id) {
+        features.push_back(makePoint(id, 0));
+    }
+    auto data = GeoJSONData::create(features, makeOptions(true));
+    loadTiles(loop, *data, tiles);
+
+    uint64_t update = 0;
+    while (state.KeepRunning()) {
+        ++update;
+        GeoJSONFeatureChanges changes;
+        for (uint64_t i = 0; i < kChangesCount; ++i) {
+            const uint64_t id = (update * kChangesCount + i) % kPointsCount;
+            changes.changed.push_back(makePoint(id, update));
+        }
+        auto updated = data->update(changes);
+
+        std::vector<CanonicalTileID> changedTiles;
+        for (const auto& tile : tiles) {
+            if (updated->tileChanged(*data, tile)) {
+                changedTiles.push_back(tile);
+            }
+        }
+        loadTiles(loop, *updated, changedTiles);
+        data = std::move(updated);
+    }
+}
+
+// Indexes a large source and loads the tiles of a viewport, which is how long it takes until the
+// first tiles of a new source can be shown.
+static void GeoJSON_firstTiles(benchmark::State& state) {
+    util::RunLoop loop;
+    const auto tiles = viewportTiles();
+    const auto options = makeOptions(false);
+
+    FeatureCollection features;
+    for (uint64_t id = 0; id < uint64_t(state.range(0)); ++id) {
+        features.push_back(makePoint(id, id / kPointsCount));
+    }
+
+    while (state.KeepRunning()) {
+        auto data = GeoJSONData::create(features, options);
+        loadTiles(loop, *data, tiles);
+    }
+}
+
+BENCHMARK(GeoJSON_setGeoJSON)->Unit(benchmark::kMillisecond);
+BENCHMARK(GeoJSON_firstTiles)->Arg(200000)->Arg(2000000)->Unit(benchmark::kMillisecond);
+BENCHMARK(GeoJSON_updateGeoJSON)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,86 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/renderer/tile_render_data.hpp>
+#include <mbgl/tile/tile_cache.hpp>
+
+#include <algorithm>
+#include <deque>
+#include <limits>
+
+using namespace mbgl;
+
+namespace {
+
+class StubTile final : public Tile {
+public:
+    StubTile(const OverscaledTileID& id_, std::size_t bytes_) : Tile(Kind::Geometry, id_), bytes(bytes_) {
+        renderable = true;
+    }
+
+    std::unique_ptr<TileRenderData> createRenderData() override { return nullptr; }
+    bool layerPropertiesUpdated(const Immutable<style::LayerProperties>&) override { return false; }
+    std::size_t getMemoryUsage() const override { return bytes; }
+
+private:
+    const std::size_t bytes;
+};
+
+// Pans a 4x4 tile viewport back and forth along a row of tiles, moving every tile that
+// leaves the viewport into the cache and looking up every tile that enters it.
+void runPanning(benchmark::State& state, std::size_t maxBytes) {
+    const uint8_t z = 14;
+    const uint32_t viewport = 4;
+    const uint32_t distance = 512;
+    const std::size_t tileBytes = 256 * 1024;
+
+    TileCache cache(state.range(0), maxBytes);
+    std::deque<std::unique_ptr<Tile>> tiles;
+    uint32_t x = 0;
+    int32_t step = 1;
+
+    auto column = [&](uint32_t col, auto fn) {
+        for (uint32_t y = 0; y < viewport; ++y) {
+            fn(OverscaledTileID(z, col, y));
+        }
+    };
+
+    column(0, [&](const OverscaledTileID& id) { tiles.push_back(std::make_unique<StubTile>(id, tileBytes)); });
+
+    while (state.KeepRunning()) {
+        if ((step > 0 && x + viewport == distance) || (step < 0 && x == 0)) {
+            step = -step;
+        }
+
+        const uint32_t leaving = step > 0 ? x : x + viewport - 1;
+        const uint32_t entering = step > 0 ? x + viewport : x - 1;
+        x += step;
+
+        column(leaving, [&](const OverscaledTileID& id) {
+            auto it = std::find_if(tiles.begin(), tiles.end(), [&](const auto& tile) { return tile->id == id; });
+            if (it != tiles.end()) {
+                cache.add(id, std::move(*it));
+                tiles.erase(it);
+            }
+        });
+        column(entering, [&](const OverscaledTileID& id) {
+            auto tile = cache.pop(id);
+            tiles.push_back(tile ? std::move(tile) : std::make_unique<StubTile>(id, tileBytes));
+        });
+    }
+
+    state.SetItemsProcessed(state.iterations() * viewport * 2);
+}
+
+} // namespace
+
+static void TileCache_Panning(benchmark::State& state) {
+    runPanning(state, std::numeric_limits<std::size_t>::max());
+}
+
+static void TileCache_PanningMemoryBudget(benchmark::State& state) {
+    // Only a quarter of the cached tiles fit into the budget.
+    runPanning(state, state.range(0) * 64 * 1024);
+}
+
+BENCHMARK(TileCache_Panning)->RangeMultiplier(4)->Range(16, 4096);
+BENCHMARK(TileCache_PanningMemoryBudget)->RangeMultiplier(4)->Range(16, 4096);
@@ -0,0 +1,150 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/geometry/feature_index.hpp>
+#include <mbgl/tile/vector_tile_data.hpp>
+#include <mbgl/util/constants.hpp>
+#include <mbgl/util/grid_index.hpp>
+#include <mbgl/util/io.hpp>
+
+#include <cmath>
+
+using namespace mbgl;
+
+namespace {
+
+using Grid = GridIndex<IndexedSubfeature>;
+
+// Same dimensions as the collision grid of a 1024x768 map, including the viewport padding.
+constexpr float gridWidth = 1024 + 2 * 100;
+constexpr float gridHeight = 768 + 2 * 100;
+constexpr uint32_t cellSize = 25;
+
+// The collision geometries of one label: a box for point labels, a chain of circles for line labels.
+struct Label {
+    std::vector<Grid::BBox> boxes;
+    std::vector<Grid::BCircle> circles;
+    uint16_t collisionGroupId;
+};
+
+// Records the collision workload of the labels of a Streets tile displayed at 1024px. Label
+// positions come from the point and line features of the tile; label sizes are made up.
+std::vector<Label> recordLabels() {
+    VectorTileData tile(std::make_shared<std::string>(util::read_file("test/fixtures/api/assets/streets/10-163-395.vector.pbf")));
+    const float scale = 1024.0f / util::EXTENT;
+
+    std::vector<Label> labels;
+    uint16_t group = 0;
+    for (const auto& name : tile.layerNames()) {
+        auto layer = tile.getLayer(name);
+        group = (group + 1) % 3;
+        for (std::size_t i = 0; i < layer->featureCount(); ++i) {
+            auto feature = layer->getFeature(i);
+            const float width = 30 + (i * 37) % 120;
+            for (const auto& geometry : feature->getGeometries()) {
+                if (geometry.empty()) continue;
+                Label label{{}, {}, group};
+                if (feature->getType() == FeatureType::Point) {
+                    const float x = geometry[0].x * scale + 100;
+                    const float y = geometry[0].y * scale + 100;
+                    label.boxes.push_back({{x - width / 2, y - 8}, {x + width / 2, y + 8}});
+                } else if (feature->getType() == FeatureType::LineString) {
+                    // Circles of 8px radius, spaced by their radius as in CollisionIndex::placeLineFeature().
+                    float distance = 0;
+                    for (std::size_t j = 1; j < geometry.size() && distance < width; ++j) {
+                        const float x0 = geometry[j - 1].x * scale + 100, y0 = geometry[j - 1].y * scale + 100;
+                        const float x1 = geometry[j].x * scale + 100, y1 = geometry[j].y * scale + 100;
+                        const float length = std::hypot(x1 - x0, y1 - y0);
+                        for (float t = 0; t < length && distance < width; t += 8, distance += 8) {
+                            label.circles.push_back({{x0 + (x1 - x0) * t / length, y0 + (y1 - y0) * t / length}, 8});
+                        }
+                    }
+                } else {
+                    continue;
+                }
+                if (!label.boxes.empty() || !label.circles.empty()) {
+                    labels.push_back(std::move(label));
+                }
+            }
+        }
+    }
+    return labels;
+}
+
+// Places the labels in order: a label is inserted into the grid unless one of its
+// geometries hits a previously placed label.
+template <class HitTest>
+std::size_t replay(const std::vector<Label>& labels, HitTest&& hitTest) {
+    Grid grid(gridWidth, gridHeight, cellSize);
+    std::size_t placed = 0;
+    for (const auto& label : labels) {
+        bool collides = false;
+        for (const auto& box : label.boxes) {
+            collides = collides || hitTest(grid, box, label.collisionGroupId);
+        }
+        for (const auto& circle : label.circles) {
+            collides = collides || hitTest(grid, circle, label.collisionGroupId);
+        }
+        if (collides) continue;
+
+        ++placed;
+        IndexedSubfeature feature(placed, "source-layer", "bucket", placed);
+        for (const auto& box : label.boxes) {
+            grid.insert(IndexedSubfeature(feature, 0, label.collisionGroupId), box);
+        }
+        for (const auto& circle : label.circles) {
+            grid.insert(IndexedSubfeature(feature, 0, label.collisionGroupId), circle);
+        }
+    }
+    return placed;
+}
+
+} // namespace
+
+static void GridIndex_CollisionReplay(benchmark::State& state) {
+    const auto labels = recordLabels();
+    while (state.KeepRunning()) {
+        benchmark::DoNotOptimize(replay(labels, [](const Grid& grid, const auto& geometry, uint16_t) {
+            return grid.hitTest(geometry);
+        }));
+    }
+    state.SetItemsProcessed(state.iterations() * labels.size());
+}
+
+static void GridIndex_CollisionReplayGroups(benchmark::State& state) {
+    const auto labels = recordLabels();
+    while (state.KeepRunning()) {
+        benchmark::DoNotOptimize(replay(labels, [](const Grid& grid, const auto& geometry, uint16_t group) {
+            return grid.hitTest(geometry, [group](const IndexedSubfeature& feature) {
+                return feature.collisionGroupId == group;
+            });
+        }));
+    }
+    state.SetItemsProcessed(state.iterations() * labels.size());
+}
+
+static void GridIndex_Query(benchmark::State& state) {
+    const auto labels = recordLabels();
+    Grid grid(gridWidth, gridHeight, cellSize);
+    for (const auto& label : labels) {
+        for (const auto& box : label.boxes) {
+            grid.insert(IndexedSubfeature(0, "source-layer", "bucket", 0), box);
+        }
+    }
+
+    while (state.KeepRunning()) {
+        std::size_t count = 0;
+        for (float y = 0; y < gridHeight; y += 64) {
+            for (float x = 0; x < gridWidth; x += 64) {
+                grid.query(Grid::BBox{{x, y}, {x + 96, y + 96}}, [&](const IndexedSubfeature&, const Grid::BBox&) {
+                    ++count;
+                    return false;
+                });
+            }
+        }
+        benchmark::DoNotOptimize(count);
+    }
+}
+
+BENCHMARK(GridIndex_CollisionReplay);
+BENCHMARK(GridIndex_CollisionReplayGroups);
+BENCHMARK(GridIndex_Query);
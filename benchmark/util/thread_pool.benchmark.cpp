@@ -0,0 +1,100 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/util/thread_pool.hpp>
+
+#include <atomic>
+#include <future>
+#include <queue>
+
+using namespace mbgl;
+
+namespace {
+
+// Reference scheduler that funnels all tasks through one mutex-protected queue,
+// which is how the shared worker pool used to be implemented.
+class SingleQueueScheduler {
+public:
+    explicit SingleQueueScheduler(std::size_t threadCount) {
+        for (std::size_t i = 0; i < threadCount; ++i) {
+            threads.emplace_back([this] {
+                while (true) {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    cv.wait(lock, [this] { return !queue.empty() || terminated; });
+                    if (terminated) return;
+                    auto function = std::move(queue.front());
+                    queue.pop();
+                    lock.unlock();
+                    function();
+                }
+            });
+        }
+    }
+
+    ~SingleQueueScheduler() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            terminated = true;
+        }
+        cv.notify_all();
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    void schedule(std::function<void()> fn) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            queue.push(std::move(fn));
+        }
+        cv.notify_one();
+    }
+
+private:
+    std::vector<std::thread> threads;
+    std::queue<std::function<void()>> queue;
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool terminated = false;
+};
+
+// Each root task fans out into many small tasks, similar to how tile workers
+// reply to themselves and to other actors while parsing.
+template <class SchedulerType>
+void runFanOut(SchedulerType& scheduler, benchmark::State& state) {
+    const std::size_t roots = 64;
+    const std::size_t leaves = 256;
+
+    while (state.KeepRunning()) {
+        std::atomic<std::size_t> remaining{roots * leaves};
+        std::promise<void> done;
+        for (std::size_t i = 0; i < roots; ++i) {
+            scheduler.schedule([&] {
+                for (std::size_t j = 0; j < leaves; ++j) {
+                    scheduler.schedule([&remaining, &done, j] {
+                        std::size_t work = j;
+                        benchmark::DoNotOptimize(work *= 31);
+                        if (--remaining == 0) done.set_value();
+                    });
+                }
+            });
+        }
+        done.get_future().wait();
+    }
+
+    state.SetItemsProcessed(state.iterations() * roots * (leaves + 1));
+}
+
+} // namespace
+
+static void ThreadPool_FanOut(benchmark::State& state) {
+    ThreadPool pool(state.range(0));
+    runFanOut(pool, state);
+}
+
+static void ThreadPool_FanOutSingleQueue(benchmark::State& state) {
+    SingleQueueScheduler scheduler(state.range(0));
+    runFanOut(scheduler, state);
+}
+
+BENCHMARK(ThreadPool_FanOut)->RangeMultiplier(2)->Range(1, 32)->UseRealTime();
+BENCHMARK(ThreadPool_FanOutSingleQueue)->RangeMultiplier(2)->Range(1, 32)->UseRealTime();
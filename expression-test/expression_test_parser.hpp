@@ -49,6 +49,8 @@ struct TestResult {
     Compiled compiled;
     optional<Value> expression;
     optional<Value> outputs;
+    // Outputs of the expression evaluated through its `CompiledExpression`.
+    optional<Value> compiledOutputs;
     optional<Value> serialized;
 };
 
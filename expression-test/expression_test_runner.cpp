@@ -4,6 +4,7 @@
 #include "filesystem.hpp"
 #include "test_runner_common.hpp"
 
+#include <mbgl/style/expression/compiled_expression.hpp>
 #include <mbgl/util/io.hpp>
 
 #include <rapidjson/writer.h>
@@ -98,25 +99,36 @@ void writeTestData(const JSDocument& document, const std::string& rootPath, cons
 
 TestRunOutput runExpressionTest(TestData& data, const std::string& rootPath, const std::string& id) {
     TestRunOutput output(id);
-    const auto evaluateExpression = [&data](std::unique_ptr<style::expression::Expression>& expression,
+    const auto evaluateExpression = [&data](std::unique_ptr<style::expression::Expression> parsed,
                                             TestResult& result) {
-        assert(expression);
+        assert(parsed);
+        const std::shared_ptr<const style::expression::Expression> expression = std::move(parsed);
+        // Every expression is also evaluated in its compiled form, which must produce the same outputs.
+        const auto compiled = style::expression::CompiledExpression::compile(expression);
+        const auto toOutput = [](const style::expression::EvaluationResult& evaluationResult) {
+            if (!evaluationResult) {
+                std::unordered_map<std::string, Value> error{{"error", Value{evaluationResult.error().message}}};
+                return Value{std::move(error)};
+            }
+            auto value = toValue(*evaluationResult);
+            assert(value);
+            return Value{*value};
+        };
+
         std::vector<Value> outputs;
+        std::vector<Value> compiledOutputs;
         if (!data.inputs.empty()) {
             for (const auto& input : data.inputs) {
-                auto evaluationResult =
-                    expression->evaluate(input.zoom, input.feature, input.heatmapDensity, input.availableImages);
-                if (!evaluationResult) {
-                    std::unordered_map<std::string, Value> error{{"error", Value{evaluationResult.error().message}}};
-                    outputs.emplace_back(Value{std::move(error)});
-                } else {
-                    auto value = toValue(*evaluationResult);
-                    assert(value);
-                    outputs.emplace_back(Value{*value});
-                }
+                outputs.emplace_back(toOutput(
+                    expression->evaluate(input.zoom, input.feature, input.heatmapDensity, input.availableImages)));
+                compiledOutputs.emplace_back(toOutput(
+                    compiled
+                        ? compiled->evaluate(input.zoom, input.feature, input.heatmapDensity, input.availableImages)
+                        : expression->evaluate(input.zoom, input.feature, input.heatmapDensity, input.availableImages)));
             }
         }
         result.outputs = {Value{std::move(outputs)}};
+        result.compiledOutputs = {Value{std::move(compiledOutputs)}};
     };
 
     // Parse expression
@@ -125,13 +137,13 @@ TestRunOutput runExpressionTest(TestData& data, const std::string& rootPath, con
 
     // Evaluate expression
     if (parsedExpression) {
-        evaluateExpression(parsedExpression, data.result);
+        evaluateExpression(std::move(parsedExpression), data.result);
         output.serialized = toJSON(data.result.serialized.value_or(Value{}), 2, true);
 
         // round trip
         auto recompiledExpression = parseExpression(data.result.serialized, data.spec, data.recompiled);
         if (recompiledExpression) {
-            evaluateExpression(recompiledExpression, data.recompiled);
+            evaluateExpression(std::move(recompiledExpression), data.recompiled);
             rewriteRoundtrippedType(data.expected.compiled.serializedType,
                                     data.recompiled.compiled.serializedType);
         }
@@ -146,6 +158,7 @@ TestRunOutput runExpressionTest(TestData& data, const std::string& rootPath, con
 
     bool compileOk = data.result.compiled == data.expected.compiled;
     bool evalOk = compileOk && deepEqual(data.result.outputs, data.expected.outputs);
+    bool compiledEvalOk = compileOk && deepEqual(data.result.compiledOutputs, data.expected.outputs);
 
     bool recompileOk = true;
     bool roundTripOk = true;
@@ -157,7 +170,7 @@ TestRunOutput runExpressionTest(TestData& data, const std::string& rootPath, con
         roundTripOk = recompileOk && deepEqual(data.recompiled.outputs, data.expected.outputs);
     }
 
-    output.passed = compileOk && evalOk && recompileOk && roundTripOk && serializationOk;
+    output.passed = compileOk && evalOk && compiledEvalOk && recompileOk && roundTripOk && serializationOk;
 
     if (!compileOk) {
         auto resultValue = toValue(data.result.compiled);
@@ -187,6 +200,12 @@ TestRunOutput runExpressionTest(TestData& data, const std::string& rootPath, con
         output.text += "Expression outputs difference:\n"s + diff + "\n"s;
     }
 
+    if (compileOk && !compiledEvalOk) {
+        auto diff = simpleDiff(data.expected.outputs.value_or(Value{}),
+                               data.result.compiledOutputs.value_or(Value{}));
+        output.text += "Compiled form outputs difference:\n"s + diff + "\n"s;
+    }
+
     if (recompileOk && !roundTripOk) {
         auto diff = simpleDiff(data.expected.outputs.value_or(Value{}),
                                data.recompiled.outputs.value_or(Value{}));
@@ -2,6 +2,8 @@
 
 #include <mbgl/util/optional.hpp>
 
+#include <atomic>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -11,6 +13,7 @@ namespace mbgl {
 
 class Scheduler;
 class Message;
+enum class TaskPriority : uint8_t;
 
 class Mailbox : public std::enable_shared_from_this<Mailbox> {
 public:
@@ -31,6 +34,10 @@ public:
 
     bool isOpen() const;
 
+    // Sets the priority with which the scheduler processes the messages sent
+    // to this mailbox. Takes effect for messages scheduled after the call.
+    void setPriority(TaskPriority);
+
     void push(std::unique_ptr<Message>);
     void receive();
 
@@ -38,7 +45,10 @@ public:
     static std::function<void()> makeClosure(std::weak_ptr<Mailbox>);
 
 private:
+    void schedule();
+
     optional<Scheduler*> scheduler;
+    std::atomic<TaskPriority> priority;
 
     std::recursive_mutex receivingMutex;
     std::mutex pushingMutex;
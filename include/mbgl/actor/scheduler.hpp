@@ -2,6 +2,7 @@
 
 #include <mapbox/weak.hpp>
 
+#include <cstdint>
 #include <functional>
 #include <memory>
 
@@ -26,6 +27,14 @@ private:
 template <typename T>
 using PassRefPtr = Pass<std::shared_ptr<T>>;
 
+// Relative urgency of a scheduled task. Schedulers that support priorities run
+// pending higher priority tasks first; all other schedulers ignore it.
+enum class TaskPriority : uint8_t {
+    High,   // e.g. parsing tiles that are currently visible
+    Normal,
+    Low     // e.g. parsing prefetched tiles
+};
+
 /*
     A `Scheduler` is responsible for coordinating the processing of messages by
     one or more actors via their mailboxes. It's an abstract interface. Currently,
@@ -39,7 +48,10 @@ using PassRefPtr = Pass<std::shared_ptr<T>>;
         concurrency within a mailbox
 
       Subject to these constraints, processing can happen on whatever thread in the
-      pool is available.
+      pool is available. Each pool thread owns a set of work queues (one per
+      `TaskPriority`) and idle threads steal work from busy ones. Because a mailbox
+      never has more than one pending closure scheduled at any time, the order in
+      which the pool picks up tasks cannot break the guarantees above.
 
     * `Scheduler::GetCurrent()` is typically used to create a mailbox and `ActorRef`
       for an object that lives on the main thread and is not itself wrapped an
@@ -54,6 +66,9 @@ public:
 
     // Enqueues a function for execution.
     virtual void schedule(std::function<void()>) = 0;
+    // Enqueues a function for execution with the given priority. By default,
+    // the priority is ignored.
+    virtual void scheduleWithPriority(TaskPriority, std::function<void()> fn) { schedule(std::move(fn)); }
     // Makes a weak pointer to this Scheduler.
     virtual mapbox::base::WeakPtr<Scheduler> makeWeakPtr() = 0;
 
@@ -17,6 +17,9 @@ struct RenderingStats {
     int memIndexBuffers;
     int memVertexBuffers;
 
+    // Total number of bytes uploaded to textures.
+    int memTextureUploads;
+
     RenderingStats& operator+=(const RenderingStats& right);
 };
 
@@ -30,6 +33,8 @@ inline RenderingStats& RenderingStats::operator+=(const RenderingStats& r) {
     memTextures += r.memTextures;
     memIndexBuffers += r.memIndexBuffers;
     memVertexBuffers += r.memVertexBuffers;
+
+    memTextureUploads += r.memTextureUploads;
     return *this;
 }
 
@@ -4,6 +4,7 @@
 #include <mbgl/util/geo.hpp>
 #include <mbgl/util/size.hpp>
 
+#include <cstddef>
 #include <memory>
 
 namespace mbgl {
@@ -88,6 +89,64 @@ public:
      */
     bool crossSourceCollisions() const;
 
+    /**
+     * @brief Specify whether the independent layer groups of a tile are laid
+     * out in parallel on the worker pool. The result is identical to the
+     * sequential layout, but heavy tiles are ready sooner when worker threads
+     * are idle. By default, it is set to false.
+     *
+     * @param enableParallelLayout true to enable, false to disable
+     * @return MapOptions for chaining options together.
+     */
+    MapOptions& withParallelTileLayout(bool enableParallelLayout);
+
+    /**
+     * @brief Gets the previously set (or default) parallelTileLayout value.
+     *
+     * @return true if tile layer groups are laid out in parallel, false
+     * otherwise.
+     */
+    bool parallelTileLayout() const;
+
+    /**
+     * @brief Specify a directory in which the laid out buckets of vector tiles
+     * are stored, so that tiles that were loaded before with the same style
+     * are restored without decoding and tessellating their features again,
+     * also after the application restarts. The directory must exist; a good
+     * place for it is next to the ambient cache database. Map instances may
+     * share the directory. By default, it is empty, which disables the cache.
+     *
+     * @param path Path of the bucket cache directory.
+     * @return reference to MapOptions for chaining options together.
+     */
+    MapOptions& withBucketCachePath(std::string path);
+
+    /**
+     * @brief Gets the previously set (or default) bucket cache directory.
+     *
+     * @return Path of the bucket cache directory, or an empty string if the
+     * bucket cache is disabled.
+     */
+    std::string bucketCachePath() const;
+
+    /**
+     * @brief Specify how much memory the tiles that each source keeps cached
+     * after they leave the viewport may use, in bytes. The number of cached
+     * tiles is limited separately, based on the viewport size. By default, it
+     * is set to 64 MB.
+     *
+     * @param bytes Memory budget of each source's tile cache.
+     * @return reference to MapOptions for chaining options together.
+     */
+    MapOptions& withTileCacheSize(std::size_t bytes);
+
+    /**
+     * @brief Gets the previously set (or default) tile cache memory budget.
+     *
+     * @return Memory budget of each source's tile cache, in bytes.
+     */
+    std::size_t tileCacheSize() const;
+
     /**
      * @brief Sets the orientation of the Map. By default, it is set to
      * Upwards.
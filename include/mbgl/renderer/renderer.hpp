@@ -23,8 +23,11 @@ class RendererBackend;
 
 class Renderer {
 public:
+    // When a program cache directory is given, compiled shader programs are cached there where the
+    // driver supports it, so that later runs don't need to compile them again.
     Renderer(gfx::RendererBackend&, float pixelRatio_,
-             const optional<std::string> localFontFamily = {});
+             const optional<std::string> localFontFamily = {},
+             const optional<std::string> programCacheDir = {});
     ~Renderer();
 
     void markContextLost();
@@ -33,6 +36,10 @@ public:
 
     void render(const UpdateParameters&);
 
+    // Prepares the shader programs that earlier runs recorded in the program cache, so that the
+    // first frames don't stall on compiling them.
+    void warmUpPrograms();
+
     // Feature queries
     std::vector<Feature> queryRenderedFeatures(const ScreenLineString&, const RenderedQueryOptions& options = {}) const;
     std::vector<Feature> queryRenderedFeatures(const ScreenCoordinate& point, const RenderedQueryOptions& options = {}) const;
@@ -4,6 +4,9 @@
 #include <mbgl/style/conversion.hpp>
 #include <mbgl/util/optional.hpp>
 
+#include <cstddef>
+#include <string>
+
 namespace mbgl {
 namespace style {
 namespace conversion {
@@ -11,6 +14,12 @@ namespace conversion {
 // Workaround until https://github.com/mapbox/mapbox-gl-native/issues/5623 is done.
 optional<GeoJSON> parseGeoJSON(const std::string&, Error&);
 
+// Parses GeoJSON text as it is read, building the features without an intermediate JSON document.
+optional<GeoJSON> parseGeoJSON(const char* data, std::size_t size, Error&);
+
+// Parses the GeoJSON file at the given path, which is memory-mapped where supported.
+optional<GeoJSON> parseGeoJSONFile(const std::string& path, Error&);
+
 template <>
 struct Converter<GeoJSON> {
 public:
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <mbgl/style/expression/expression.hpp>
+
+#include <memory>
+#include <vector>
+
+namespace mbgl {
+namespace style {
+namespace expression {
+
+/**
+ * @brief CompiledExpression is a form of an expression tree that is specialised for
+ * repeated evaluation against many features.
+ *
+ * Compilation folds constant subtrees and lowers the most common operators (`get`,
+ * type assertions, `match`, `step`, `interpolate`, comparisons, boolean and arithmetic
+ * operators) into nodes that pass numbers, booleans, colors and borrowed strings between
+ * each other instead of boxed `Value`s. Anything else is delegated to the expression
+ * tree it was compiled from.
+ *
+ * The compiled form produces the same results as the tree. Evaluation errors are
+ * reported by re-evaluating the tree, so the error messages are identical as well.
+ *
+ * Number and color expressions can also be evaluated for many features at once. Column
+ * evaluation evaluates each node for all of the features before moving on to its parent,
+ * so shapes like `interpolate` over a `get` run as tight loops over the feature values.
+ */
+class CompiledExpression {
+public:
+    class Node;
+
+    // Returns null if the expression cannot be evaluated faster than the tree.
+    static std::unique_ptr<const CompiledExpression> compile(std::shared_ptr<const Expression>);
+
+    ~CompiledExpression();
+
+    EvaluationResult evaluate(const EvaluationContext&) const;
+    EvaluationResult evaluate(optional<float> zoom,
+                              const Feature& feature,
+                              optional<double> colorRampParameter,
+                              const std::set<std::string>& availableImages) const;
+
+    // Evaluates the expression for each of the features, with `params` providing everything
+    // but the feature. Returns false if the expression isn't of the type of the results.
+    // Otherwise, `valid[i]` tells whether the evaluation for the i-th feature succeeded; the
+    // error of a failed evaluation is obtained by evaluating the feature on its own.
+    bool evaluate(const EvaluationContext& params,
+                  const std::vector<const GeometryTileFeature*>& features,
+                  std::vector<double>& results,
+                  std::vector<bool>& valid) const;
+    bool evaluate(const EvaluationContext& params,
+                  const std::vector<const GeometryTileFeature*>& features,
+                  std::vector<Color>& results,
+                  std::vector<bool>& valid) const;
+
+    const Expression& getExpression() const { return *expression; }
+
+private:
+    CompiledExpression(std::shared_ptr<const Expression>, std::unique_ptr<const Node>);
+
+    const std::shared_ptr<const Expression> expression;
+    const std::unique_ptr<const Node> root;
+};
+
+} // namespace expression
+} // namespace style
+} // namespace mbgl
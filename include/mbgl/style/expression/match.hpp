@@ -35,12 +35,20 @@ public:
     
     mbgl::Value serialize() const override;
     std::string getOperator() const override { return "match"; }
+
+    const std::unique_ptr<Expression>& getInput() const { return input; }
+    const Branches& getBranches() const { return branches; }
+    const std::unique_ptr<Expression>& getOtherwise() const { return otherwise; }
+
 private:
     std::unique_ptr<Expression> input;
     Branches branches;
     std::unique_ptr<Expression> otherwise;
 };
 
+// Returns the type of the labels of a `match` expression: either number or string.
+type::Type getMatchLabelType(const Expression&);
+
 ParseResult parseMatch(const mbgl::style::conversion::Convertible& value, ParsingContext& ctx);
 
 } // namespace expression
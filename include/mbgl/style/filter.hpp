@@ -4,6 +4,7 @@
 #include <mbgl/util/feature.hpp>
 #include <mbgl/util/geometry.hpp>
 #include <mbgl/style/expression/expression.hpp>
+#include <mbgl/style/expression/compiled_expression.hpp>
 
 #include <string>
 #include <vector>
@@ -17,6 +18,7 @@ public:
     optional<std::shared_ptr<const expression::Expression>> expression;
 private:
     optional<mbgl::Value> legacyFilter;
+    std::shared_ptr<const expression::CompiledExpression> compiled;
 public:
     Filter() : expression() {}
     
@@ -24,6 +26,9 @@ public:
     : expression(std::move(*_expression)),
      legacyFilter(std::move(_filter)){
         assert(!expression || *expression != nullptr);
+        if (expression) {
+            compiled = expression::CompiledExpression::compile(*expression);
+        }
     }
     
     bool operator()(const expression::EvaluationContext& context) const;
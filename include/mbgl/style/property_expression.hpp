@@ -1,6 +1,7 @@
 #pragma once
 
 #include <mbgl/style/expression/expression.hpp>
+#include <mbgl/style/expression/compiled_expression.hpp>
 #include <mbgl/style/expression/is_constant.hpp>
 #include <mbgl/style/expression/interpolate.hpp>
 #include <mbgl/style/expression/step.hpp>
@@ -25,14 +26,37 @@ public:
 
 protected:
     std::shared_ptr<const expression::Expression> expression;
+    // Feature-dependent expressions are evaluated through their compiled form, if any.
+    std::shared_ptr<const expression::CompiledExpression> compiled;
     variant<std::nullptr_t, const expression::Interpolate*, const expression::Step*> zoomCurve;
     bool isZoomConstant_;
     bool isFeatureConstant_;
     bool isRuntimeConstant_;
 };
 
+namespace detail {
+
+template <class T>
+struct ExpressionColumn {
+    using Type = void;
+};
+
+template <>
+struct ExpressionColumn<float> {
+    using Type = double;
+};
+
+template <>
+struct ExpressionColumn<Color> {
+    using Type = Color;
+};
+
+} // namespace detail
+
 template <class T>
 class PropertyExpression final : public PropertyExpressionBase {
+    using Column = typename detail::ExpressionColumn<T>::Type;
+
 public:
     // Second parameter to be used only for conversions from legacy functions.
     PropertyExpression(std::unique_ptr<expression::Expression> expression_, optional<T> defaultValue_ = nullopt)
@@ -41,7 +65,8 @@ public:
     }
 
     T evaluate(const expression::EvaluationContext& context, T finalDefaultValue = T()) const {
-        const expression::EvaluationResult result = expression->evaluate(context);
+        const expression::EvaluationResult result =
+            compiled ? compiled->evaluate(context) : expression->evaluate(context);
         if (result) {
             const optional<T> typed = expression::fromExpressionValue<T>(*result);
             return typed ? *typed : defaultValue ? *defaultValue : finalDefaultValue;
@@ -85,6 +110,25 @@ public:
         return evaluate(expression::EvaluationContext(zoom, &feature, &state), finalDefaultValue);
     }
 
+    // Evaluates the expression for each of the features, with `context` providing everything
+    // but the feature. Number and color expressions with a compiled form are evaluated a
+    // column at a time, which avoids most of the per-feature overhead.
+    std::vector<T> evaluate(const expression::EvaluationContext& context,
+                            const std::vector<const GeometryTileFeature*>& features,
+                            T finalDefaultValue = T()) const {
+        std::vector<T> results;
+        results.reserve(features.size());
+        if (!compiled ||
+            !evaluateColumn(context, features, results, finalDefaultValue, static_cast<Column*>(nullptr))) {
+            expression::EvaluationContext params = context;
+            for (const GeometryTileFeature* feature : features) {
+                params.feature = feature;
+                results.push_back(evaluate(params, finalDefaultValue));
+            }
+        }
+        return results;
+    }
+
     std::vector<optional<T>> possibleOutputs() const {
         return expression::fromExpressionValues<T>(expression->possibleOutputs());
     }
@@ -95,6 +139,39 @@ public:
     }
 
 private:
+    // Compiled number and color expressions evaluate to a column of doubles and colors.
+    template <class Column>
+    bool evaluateColumn(const expression::EvaluationContext& context,
+                        const std::vector<const GeometryTileFeature*>& features,
+                        std::vector<T>& results,
+                        T finalDefaultValue,
+                        Column*) const {
+        std::vector<Column> values;
+        std::vector<bool> valid;
+        if (!compiled->evaluate(context, features, values, valid)) {
+            return false;
+        }
+        expression::EvaluationContext params = context;
+        for (std::size_t i = 0; i < features.size(); ++i) {
+            if (valid[i]) {
+                results.push_back(static_cast<T>(values[i]));
+            } else {
+                // Failed evaluations fall back to the default value like in the single feature case.
+                params.feature = features[i];
+                results.push_back(evaluate(params, finalDefaultValue));
+            }
+        }
+        return true;
+    }
+
+    bool evaluateColumn(const expression::EvaluationContext&,
+                        const std::vector<const GeometryTileFeature*>&,
+                        std::vector<T>&,
+                        T,
+                        void*) const {
+        return false;
+    }
+
     optional<T> defaultValue;
 };
 
@@ -10,6 +10,7 @@
 #include <memory>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 namespace mbgl {
 
@@ -35,8 +36,15 @@ struct GeoJSONOptions {
     using ClusterProperties = std::unordered_map<std::string, ClusterExpression>;
     ClusterProperties clusterProperties;
 
+    // Keep the features indexed by their identifiers, so that GeoJSONSource::updateGeoJSON()
+    // can change them without rebuilding the whole index.
+    bool incrementalUpdates = false;
+
     static Immutable<GeoJSONOptions> defaultOptions();
 };
+
+class GeoJSONFeatureChanges;
+
 class GeoJSONData {
 public:
     using TileFeatures = mapbox::feature::feature_collection<int16_t>;
@@ -53,6 +61,22 @@ public:
                                const std::uint32_t limit = 10u,
                                const std::uint32_t offset = 0u) = 0;
     virtual std::uint8_t getClusterExpansionZoom(std::uint32_t) = 0;
+
+    // Returns new data with the given changes applied, sharing the parts of the index that the
+    // changes don't affect. Returns nullptr if this data doesn't support incremental updates.
+    virtual std::shared_ptr<GeoJSONData> update(const GeoJSONFeatureChanges&) { return nullptr; }
+
+    // Returns whether the features of the given tile may differ from the ones in `previous`.
+    virtual bool tileChanged(const GeoJSONData& /* previous */, const CanonicalTileID&) const { return true; }
+};
+
+// Features to add, remove and replace in a GeoJSON source. Features are matched by their
+// identifiers; changed features with an unknown identifier are added.
+class GeoJSONFeatureChanges {
+public:
+    GeoJSONData::Features added;
+    std::vector<FeatureIdentifier> removed;
+    GeoJSONData::Features changed;
 };
 
 class GeoJSONSource final : public Source {
@@ -63,6 +87,9 @@ public:
     void setURL(const std::string& url);
     void setGeoJSON(const GeoJSON&);
     void setGeoJSONData(std::shared_ptr<GeoJSONData>);
+    // Applies the given changes to the current features. Only the tiles containing changed
+    // features are reloaded. Requires GeoJSONOptions::incrementalUpdates.
+    void updateGeoJSON(const GeoJSONFeatureChanges&);
 
     optional<std::string> getURL() const;
     const GeoJSONOptions& getOptions() const;
@@ -1,12 +1,30 @@
 #pragma once
 
+#include <mbgl/util/optional.hpp>
+
+#include <cstdint>
 #include <string>
+#include <vector>
 
 namespace mbgl {
 namespace util {
 
 std::string compress(const std::string& raw);
+// Decompresses zlib or gzip compressed data.
 std::string decompress(const std::string& raw);
 
+// Compresses and decompresses data using a preset dictionary, which makes small inputs sharing
+// a lot of content with the dictionary compress much better.
+std::string compress(const std::string& raw, const std::string& dictionary);
+std::string decompress(const std::string& raw, const std::string& dictionary);
+
+// Returns the ID of the preset dictionary that the data was compressed with, if any, which is
+// the ID `getDictionaryID()` returns for the dictionary.
+optional<uint32_t> getPresetDictionaryID(const std::string& compressed);
+uint32_t getDictionaryID(const std::string& dictionary);
+
+// Builds a dictionary of at most `maxSize` bytes out of the content shared between samples.
+std::string trainDictionary(const std::vector<std::string>& samples, std::size_t maxSize);
+
 } // namespace util
 } // namespace mbgl
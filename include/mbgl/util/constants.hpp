@@ -52,6 +52,10 @@ constexpr uint64_t DEFAULT_MAX_CACHE_SIZE = 50 * 1024 * 1024;
 // Average sprite size with 1.0 pixel ratio is ~2kB, 8kB for pixel ratio of 2.0.
 constexpr std::size_t DEFAULT_ON_DEMAND_IMAGES_CACHE_SIZE = 100 * 8192;
 
+// Default memory budget of a source's tile cache, in addition to the tile count limit
+// that is derived from the viewport size.
+constexpr std::size_t DEFAULT_TILE_CACHE_SIZE = 64 * 1024 * 1024;
+
 constexpr Duration DEFAULT_TRANSITION_DURATION = Milliseconds(300);
 constexpr Seconds CLOCK_SKEW_RETRY_TIMEOUT { 30 };
 
@@ -224,6 +224,7 @@ target_sources(
         ${MBGL_ROOT}/platform/default/src/mbgl/storage/offline_download.cpp
         ${MBGL_ROOT}/platform/default/src/mbgl/storage/online_file_source.cpp
         ${MBGL_ROOT}/platform/default/src/mbgl/storage/sqlite3.cpp
+        ${MBGL_ROOT}/platform/default/src/mbgl/storage/tile_archive_file_source.cpp
         ${MBGL_ROOT}/platform/default/src/mbgl/text/bidi.cpp
         ${MBGL_ROOT}/platform/default/src/mbgl/util/compression.cpp
         ${MBGL_ROOT}/platform/default/src/mbgl/util/monotonic_timer.cpp
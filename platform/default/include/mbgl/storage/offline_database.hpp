@@ -8,11 +8,15 @@
 #include <mbgl/util/constants.hpp>
 #include <mbgl/util/mapbox.hpp>
 #include <mbgl/util/expected.hpp>
+#include <mbgl/util/chrono.hpp>
 
 #include <unordered_map>
+#include <map>
 #include <memory>
 #include <string>
 #include <list>
+#include <tuple>
+#include <vector>
 
 namespace mapbox {
 namespace sqlite {
@@ -40,7 +44,12 @@ class OfflineDatabase : private util::noncopyable {
 public:
     // Limits affect ambient caching (put) only; resources required by offline
     // regions are exempt.
-    OfflineDatabase(std::string path);
+    //
+    // A read-only database only serves get() and getRegionResource(), e.g. to look up
+    // resources on other threads than the one writing to the database. It never creates,
+    // migrates or writes to the database, and doesn't record accessed timestamps; see
+    // markAccessed().
+    OfflineDatabase(std::string path, bool readOnly = false);
     ~OfflineDatabase();
 
     void changePath(const std::string&);
@@ -51,6 +60,9 @@ public:
     // Return value is (inserted, stored size)
     std::pair<bool, uint64_t> put(const Resource&, const Response&);
 
+    // Records that a resource was read from the cache by a read-only database, for LRU eviction.
+    void markAccessed(const Resource&);
+
     // Force Mapbox GL Native to revalidate tiles stored in the ambient
     // cache with the tile server before using them, making sure they
     // are the latest version. This is more efficient than cleaning the
@@ -97,6 +109,13 @@ public:
     void runPackDatabaseAutomatically(bool autopack_) { autopack = autopack_; }
 
 private:
+    // Values of the `compressed` column, identifying how data is encoded.
+    enum class Codec : int64_t {
+        None = 0,
+        // A zlib stream, which may refer to a preset dictionary of the `dictionaries` table.
+        Deflate = 1,
+    };
+
     void initialize();
     void handleError(const mapbox::sqlite::Exception&, const char* action);
     void handleError(const util::IOException&, const char* action);
@@ -109,6 +128,7 @@ private:
     void migrateToVersion5();
     void migrateToVersion3();
     void migrateToVersion6();
+    void migrateToVersion7();
     void cleanup();
     bool disabled();
     void vacuum();
@@ -118,19 +138,27 @@ private:
     optional<std::pair<Response, uint64_t>> getTile(const Resource::TileData&);
     optional<int64_t> hasTile(const Resource::TileData&);
     bool putTile(const Resource::TileData&, const Response&,
-                 const std::string&, bool compressed);
+                 const std::string&, Codec);
 
     optional<std::pair<Response, uint64_t>> getResource(const Resource&);
     optional<int64_t> hasResource(const Resource&);
     bool putResource(const Resource&, const Response&,
-                     const std::string&, bool compressed);
+                     const std::string&, Codec);
 
     uint64_t putRegionResourceInternal(int64_t regionID, const Resource&, const Response&);
 
     optional<std::pair<Response, uint64_t>> getInternal(const Resource&);
+    void flushAccessedIfNeeded();
+    void flushAccessed();
+    void writeAccessed();
     optional<int64_t> hasInternal(const Resource&);
     std::pair<bool, uint64_t> putInternal(const Resource&, const Response&, bool evict);
 
+    std::string compressTile(const std::string& urlTemplate, const std::string& data);
+    void recompressMergedTiles();
+    std::string decode(Codec, const std::string& data);
+    std::shared_ptr<const std::string> getDictionary(uint32_t id);
+
     // Return value is true iff the resource was previously unused by any other regions.
     bool markUsed(int64_t regionID, const Resource&);
 
@@ -138,6 +166,7 @@ private:
     std::pair<int64_t, int64_t> getCompletedTileCountAndSize(int64_t regionID);
 
     std::string path;
+    const bool readOnly;
     std::unique_ptr<mapbox::sqlite::Database> db;
     std::unordered_map<const char *, const std::unique_ptr<mapbox::sqlite::Statement>> statements;
 
@@ -149,6 +178,27 @@ private:
 
     optional<uint64_t> offlineMapboxTileCount;
 
+    // Accessed timestamps of the resources and tiles read since the last flush, keyed by URL and
+    // by (URL template, pixel ratio, x, y, z). They are written when there are too many of them,
+    // when the interval elapses, and before eviction.
+    std::unordered_map<std::string, Timestamp> accessedResources;
+    std::map<std::tuple<std::string, uint8_t, int32_t, int32_t, int8_t>, Timestamp> accessedTiles;
+    TimePoint lastAccessedFlush = Clock::now();
+    const std::size_t maximumPendingAccessedCount = 256;
+    const Duration accessedFlushInterval = std::chrono::seconds(30);
+
+    // The preset dictionary tiles of every URL template are compressed with, which is trained
+    // on the first tiles stored for the template. Dictionaries are never replaced, as the tiles
+    // compressed with them refer to them, and are loaded along with dictionaries by ID when needed.
+    struct TileDictionary {
+        std::shared_ptr<const std::string> dictionary;
+        std::vector<std::string> samples;
+    };
+    std::unordered_map<std::string, TileDictionary> tileDictionaries;
+    std::unordered_map<uint32_t, std::shared_ptr<const std::string>> dictionaries;
+    const std::size_t dictionarySampleCount = 16;
+    const std::size_t maximumDictionarySize = 32 * 1024;
+
     bool evict(uint64_t neededFreeSize);
     bool autopack = true;
 };
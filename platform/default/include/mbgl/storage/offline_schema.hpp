@@ -35,6 +35,11 @@ static constexpr const char* offlineDatabaseSchema =
 "  must_revalidate INTEGER NOT NULL DEFAULT 0,\n"
 "  UNIQUE (url_template, pixel_ratio, z, x, y)\n"
 ");\n"
+"CREATE TABLE dictionaries (\n"
+"  id INTEGER NOT NULL PRIMARY KEY,\n"
+"  url_template TEXT NOT NULL,\n"
+"  data BLOB NOT NULL\n"
+");\n"
 "CREATE TABLE regions (\n"
 "  id INTEGER NOT NULL PRIMARY KEY AUTOINCREMENT,\n"
 "  definition TEXT NOT NULL,\n"
@@ -58,6 +63,8 @@ static constexpr const char* offlineDatabaseSchema =
 "ON region_resources (resource_id);\n"
 "CREATE INDEX region_tiles_tile_id\n"
 "ON region_tiles (tile_id);\n"
+"CREATE INDEX dictionaries_url_template\n"
+"ON dictionaries (url_template);\n"
 ;
 
 } // namespace mbgl
@@ -80,7 +80,8 @@ CREATE TABLE tiles (
   compressed INTEGER NOT NULL DEFAULT 0,           -- If the tile is compressed with Deflate or not. Compression is
                                                    -- optional and should be used when the compression ratio is
                                                    -- significant. Using compression will make decoding time slower
-                                                   -- because it will add an extra decompression step.
+                                                   -- because it will add an extra decompression step. Compressed
+                                                   -- tiles may refer to a preset dictionary, see below.
 
   accessed INTEGER NOT NULL,                       -- Last time the tile was used by GL Native. Useful for when
                                                    -- evicting the least used tiles from the cache.
@@ -90,6 +91,20 @@ CREATE TABLE tiles (
   UNIQUE (url_template, pixel_ratio, z, x, y)
 );
 
+--
+-- Table containing the preset dictionaries that tiles are compressed with.
+-- Tiles of the same tileset share a lot of content, which compresses much
+-- better against a dictionary trained on a few of them.
+--
+CREATE TABLE dictionaries (
+  id INTEGER NOT NULL PRIMARY KEY,                 -- Adler-32 checksum of the dictionary, which Deflate records in the
+                                                   -- header of the data compressed with it.
+
+  url_template TEXT NOT NULL,                      -- The URL template of the tiles the dictionary was trained on.
+
+  data BLOB NOT NULL                               -- Contents of the dictionary.
+);
+
 --
 -- Regions define the offline regions, which could be a GeoJSON geometry,
 -- or a bounding box like this example:
@@ -166,3 +181,6 @@ ON region_resources (resource_id);
 
 CREATE INDEX region_tiles_tile_id
 ON region_tiles (tile_id);
+
+CREATE INDEX dictionaries_url_template
+ON dictionaries (url_template);
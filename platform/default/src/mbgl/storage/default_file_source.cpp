@@ -6,6 +6,7 @@
 #include <mbgl/storage/offline_database.hpp>
 #include <mbgl/storage/offline_download.hpp>
 #include <mbgl/storage/resource_transform.hpp>
+#include <mbgl/storage/tile_archive_file_source.hpp>
 
 #include <mbgl/util/platform.hpp>
 #include <mbgl/util/url.hpp>
@@ -13,17 +14,49 @@
 #include <mbgl/util/work_request.hpp>
 #include <mbgl/util/stopwatch.hpp>
 
+#include <algorithm>
 #include <cassert>
+#include <thread>
 #include <utility>
 
 namespace mbgl {
 
+namespace {
+
+// Looks up resources in the offline database on a read-only connection of its own, so that cache
+// lookups neither wait for each other nor for the writes done on the file source thread.
+class CacheReader {
+public:
+    CacheReader(const std::string& cachePath, uint64_t maximumAmbientCacheSize) : offlineDatabase(cachePath, true) {
+        offlineDatabase.setMaximumAmbientCacheSize(maximumAmbientCacheSize);
+    }
+
+    void get(const Resource& resource, std::function<void (optional<Response>)> callback) {
+        callback(offlineDatabase.get(resource));
+    }
+
+    void setCachePath(const std::string& path) {
+        offlineDatabase.changePath(path);
+    }
+
+    void setMaximumAmbientCacheSize(uint64_t size) {
+        offlineDatabase.setMaximumAmbientCacheSize(size);
+    }
+
+private:
+    OfflineDatabase offlineDatabase;
+};
+
+} // namespace
+
 class DefaultFileSource::Impl {
 public:
-    Impl(std::shared_ptr<FileSource> assetFileSource_, std::string cachePath)
-            : assetFileSource(std::move(assetFileSource_))
+    Impl(ActorRef<Impl> self_, std::shared_ptr<FileSource> assetFileSource_, std::string cachePath_)
+            : self(std::move(self_))
+            , assetFileSource(std::move(assetFileSource_))
             , localFileSource(std::make_unique<LocalFileSource>())
-            , offlineDatabase(std::make_unique<OfflineDatabase>(std::move(cachePath))) {
+            , cachePath(std::move(cachePath_))
+            , offlineDatabase(std::make_unique<OfflineDatabase>(cachePath)) {
     }
 
     void setAPIBaseURL(const std::string& url) {
@@ -47,7 +80,11 @@ public:
     }
 
     void setResourceCachePath(const std::string& path, optional<ActorRef<PathChangeCallback>>&& callback) {
+        cachePath = path;
         offlineDatabase->changePath(path);
+        for (auto& reader : cacheReaders) {
+            reader->actor().invoke(&CacheReader::setCachePath, path);
+        }
         if (callback) {
             callback->invoke(&PathChangeCallback::operator());
         }
@@ -114,64 +151,61 @@ public:
         } else if (LocalFileSource::acceptsURL(resource.url)) {
             //Local file request
             tasks[req] = localFileSource->request(resource, callback);
+        } else if (TileArchiveFileSource::acceptsURL(resource.url)) {
+            //MBTiles or PMTiles archive request. The archive threads are only started once needed.
+            if (!tileArchiveFileSource) {
+                tileArchiveFileSource = std::make_unique<TileArchiveFileSource>();
+            }
+            tasks[req] = tileArchiveFileSource->request(resource, callback);
         } else {
-            // Try the offline database
-            if (resource.hasLoadingMethod(Resource::LoadingMethod::Cache)) {
-                auto offlineResponse = offlineDatabase->get(resource);
-
-                if (resource.loadingMethod == Resource::LoadingMethod::CacheOnly) {
-                    if (!offlineResponse) {
-                        // Ensure there's always a response that we can send, so the caller knows that
-                        // there's no optional data available in the cache, when it's the only place
-                        // we're supposed to load from.
-                        offlineResponse.emplace();
-                        offlineResponse->noContent = true;
-                        offlineResponse->error = std::make_unique<Response::Error>(
-                                Response::Error::Reason::NotFound, "Not found in offline database");
-                    } else if (!offlineResponse->isUsable()) {
-                        // Don't return resources the server requested not to show when they're stale.
-                        // Even if we can't directly use the response, we may still use it to send a
-                        // conditional HTTP request, which is why we're saving it above.
-                        offlineResponse->error = std::make_unique<Response::Error>(
-                            Response::Error::Reason::NotFound, "Cached resource is unusable");
-                    }
-                    callback(*offlineResponse);
-                } else if (offlineResponse) {
-                    // Copy over the fields so that we can use them when making a refresh request.
-                    resource.priorModified = offlineResponse->modified;
-                    resource.priorExpires = offlineResponse->expires;
-                    resource.priorEtag = offlineResponse->etag;
-                    resource.priorData = offlineResponse->data;
-
-                    if (offlineResponse->isUsable()) {
-                        callback(*offlineResponse);
-                        // Set the priority of existing resource to low if it's expired but usable.
-                        resource.setPriority(Resource::Priority::Low);
+            // An in-memory database can't be shared between connections.
+            if (resource.hasLoadingMethod(Resource::LoadingMethod::Cache) && !cachePath.empty() &&
+                cachePath != ":memory:") {
+                if (cacheReaders.empty()) {
+                    const unsigned readerCount = std::max(1u, std::min(4u, std::thread::hardware_concurrency()));
+                    for (unsigned i = 0; i < readerCount; ++i) {
+                        cacheReaders.push_back(std::make_unique<util::Thread<CacheReader>>(
+                            "CacheReader", cachePath, maximumAmbientCacheSize));
                     }
                 }
+
+                // Continue once one of the readers looked up the resource. The ID tells whether
+                // the request was cancelled, or another one was made at the same address, since.
+                const uint64_t id = nextCacheRequestID++;
+                cacheRequests[req] = id;
+                auto& reader = *cacheReaders[id % cacheReaders.size()];
+                reader.actor().invoke(&CacheReader::get, resource,
+                    [impl = self, req, id, resource, ref] (optional<Response> offlineResponse) {
+                        impl.invoke(&Impl::cacheResponse, req, id, resource, std::move(offlineResponse), ref);
+                    });
+                return;
             }
 
-            // Get from the online file source
-            if (resource.hasLoadingMethod(Resource::LoadingMethod::Network)) {
-                MBGL_TIMING_START(watch);
-                tasks[req] = onlineFileSource.request(resource, [=] (Response onlineResponse) {
-                    this->offlineDatabase->put(resource, onlineResponse);
-                    if (resource.kind == Resource::Kind::Tile) {
-                        // onlineResponse.data will be null if data not modified
-                        MBGL_TIMING_FINISH(watch,
-                                           " Action: " << "Requesting," <<
-                                           " URL: " << resource.url.c_str() <<
-                                           " Size: " << (onlineResponse.data != nullptr ? onlineResponse.data->size() : 0) << "B," <<
-                                           " Time")
-                    }
-                    callback(onlineResponse);
-                });
+            optional<Response> offlineResponse;
+            if (resource.hasLoadingMethod(Resource::LoadingMethod::Cache)) {
+                offlineResponse = offlineDatabase->get(resource);
             }
+            respond(req, std::move(resource), std::move(offlineResponse), std::move(ref));
+        }
+    }
+
+    void cacheResponse(AsyncRequest* req, uint64_t id, Resource resource, optional<Response> offlineResponse,
+                       ActorRef<FileSourceRequest> ref) {
+        auto it = cacheRequests.find(req);
+        if (it == cacheRequests.end() || it->second != id) {
+            return;
+        }
+        cacheRequests.erase(it);
+
+        if (offlineResponse) {
+            offlineDatabase->markAccessed(resource);
         }
+        respond(req, std::move(resource), std::move(offlineResponse), std::move(ref));
     }
 
     void cancel(AsyncRequest* req) {
         tasks.erase(req);
+        cacheRequests.erase(req);
     }
 
     void setOfflineMapboxTileCountLimit(uint64_t limit) {
@@ -191,7 +225,12 @@ public:
     }
 
     void resetDatabase(std::function<void (std::exception_ptr)> callback) {
-        callback(offlineDatabase->resetDatabase());
+        auto result = offlineDatabase->resetDatabase();
+        // Reopen the read-only connections, which may still refer to the removed database.
+        for (auto& reader : cacheReaders) {
+            reader->actor().invoke(&CacheReader::setCachePath, cachePath);
+        }
+        callback(result);
     }
 
     void invalidateAmbientCache(std::function<void (std::exception_ptr)> callback) {
@@ -203,7 +242,14 @@ public:
     }
 
     void setMaximumAmbientCacheSize(uint64_t size, std::function<void (std::exception_ptr)> callback) {
-        callback(offlineDatabase->setMaximumAmbientCacheSize(size));
+        auto result = offlineDatabase->setMaximumAmbientCacheSize(size);
+        if (!result) {
+            maximumAmbientCacheSize = size;
+            for (auto& reader : cacheReaders) {
+                reader->actor().invoke(&CacheReader::setMaximumAmbientCacheSize, size);
+            }
+        }
+        callback(result);
     }
 
     void packDatabase(std::function<void(std::exception_ptr)> callback) { callback(offlineDatabase->pack()); }
@@ -211,6 +257,63 @@ public:
     void runPackDatabaseAutomatically(bool autopack) { offlineDatabase->runPackDatabaseAutomatically(autopack); }
 
 private:
+    // Completes a request once the offline database was searched for the resource.
+    void respond(AsyncRequest* req, Resource resource, optional<Response> offlineResponse, ActorRef<FileSourceRequest> ref) {
+        auto callback = [ref] (const Response& res) {
+            ref.invoke(&FileSourceRequest::setResponse, res);
+        };
+
+        if (resource.hasLoadingMethod(Resource::LoadingMethod::Cache)) {
+            if (resource.loadingMethod == Resource::LoadingMethod::CacheOnly) {
+                if (!offlineResponse) {
+                    // Ensure there's always a response that we can send, so the caller knows that
+                    // there's no optional data available in the cache, when it's the only place
+                    // we're supposed to load from.
+                    offlineResponse.emplace();
+                    offlineResponse->noContent = true;
+                    offlineResponse->error = std::make_unique<Response::Error>(
+                            Response::Error::Reason::NotFound, "Not found in offline database");
+                } else if (!offlineResponse->isUsable()) {
+                    // Don't return resources the server requested not to show when they're stale.
+                    // Even if we can't directly use the response, we may still use it to send a
+                    // conditional HTTP request, which is why we're saving it above.
+                    offlineResponse->error = std::make_unique<Response::Error>(
+                        Response::Error::Reason::NotFound, "Cached resource is unusable");
+                }
+                callback(*offlineResponse);
+            } else if (offlineResponse) {
+                // Copy over the fields so that we can use them when making a refresh request.
+                resource.priorModified = offlineResponse->modified;
+                resource.priorExpires = offlineResponse->expires;
+                resource.priorEtag = offlineResponse->etag;
+                resource.priorData = offlineResponse->data;
+
+                if (offlineResponse->isUsable()) {
+                    callback(*offlineResponse);
+                    // Set the priority of existing resource to low if it's expired but usable.
+                    resource.setPriority(Resource::Priority::Low);
+                }
+            }
+        }
+
+        // Get from the online file source
+        if (resource.hasLoadingMethod(Resource::LoadingMethod::Network)) {
+            MBGL_TIMING_START(watch);
+            tasks[req] = onlineFileSource.request(resource, [=] (Response onlineResponse) {
+                this->offlineDatabase->put(resource, onlineResponse);
+                if (resource.kind == Resource::Kind::Tile) {
+                    // onlineResponse.data will be null if data not modified
+                    MBGL_TIMING_FINISH(watch,
+                                       " Action: " << "Requesting," <<
+                                       " URL: " << resource.url.c_str() <<
+                                       " Size: " << (onlineResponse.data != nullptr ? onlineResponse.data->size() : 0) << "B," <<
+                                       " Time")
+                }
+                callback(onlineResponse);
+            });
+        }
+    }
+
     expected<OfflineDownload*, std::exception_ptr> getDownload(int64_t regionID) {
         auto it = downloads.find(regionID);
         if (it != downloads.end()) {
@@ -225,13 +328,23 @@ private:
         return downloads.emplace(regionID, std::move(download)).first->second.get();
     }
 
+    const ActorRef<Impl> self;
+
     // shared so that destruction is done on the creating thread
     const std::shared_ptr<FileSource> assetFileSource;
     const std::unique_ptr<FileSource> localFileSource;
+    std::unique_ptr<FileSource> tileArchiveFileSource;
+    std::string cachePath;
     std::unique_ptr<OfflineDatabase> offlineDatabase;
     OnlineFileSource onlineFileSource;
     std::unordered_map<AsyncRequest*, std::unique_ptr<AsyncRequest>> tasks;
     std::unordered_map<int64_t, std::unique_ptr<OfflineDownload>> downloads;
+
+    // Serve cache lookups when the database is stored in a file, created on first use.
+    std::vector<std::unique_ptr<util::Thread<CacheReader>>> cacheReaders;
+    uint64_t maximumAmbientCacheSize = util::DEFAULT_MAX_CACHE_SIZE;
+    std::unordered_map<AsyncRequest*, uint64_t> cacheRequests;
+    uint64_t nextCacheRequestID = 0;
 };
 
 DefaultFileSource::DefaultFileSource(const std::string& cachePath, const std::string& assetPath, bool supportCacheOnlyRequests_)
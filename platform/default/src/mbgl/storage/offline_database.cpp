@@ -13,8 +13,13 @@
 
 namespace mbgl {
 
-OfflineDatabase::OfflineDatabase(std::string path_)
-    : path(std::move(path_)) {
+OfflineDatabase::OfflineDatabase(std::string path_, bool readOnly_)
+    : path(std::move(path_)), readOnly(readOnly_) {
+    if (readOnly) {
+        // Read-only connections are opened on first use.
+        return;
+    }
+
     try {
         initialize();
     } catch (...) {
@@ -31,6 +36,19 @@ void OfflineDatabase::initialize() {
     assert(!db);
     assert(statements.empty());
 
+    if (readOnly) {
+        // Creating and migrating the database is left to the writable connection.
+        db = std::make_unique<mapbox::sqlite::Database>(
+            mapbox::sqlite::Database::open(path, mapbox::sqlite::ReadOnly));
+        db->setBusyTimeout(Milliseconds::max());
+        if (getPragma<int64_t>("PRAGMA user_version") != 7) {
+            statements.clear();
+            db.reset();
+            throw std::runtime_error("Database schema is out of date");
+        }
+        return;
+    }
+
     db = std::make_unique<mapbox::sqlite::Database>(
         mapbox::sqlite::Database::open(path, mapbox::sqlite::ReadWriteCreate));
     db->setBusyTimeout(Milliseconds::max());
@@ -57,6 +75,9 @@ void OfflineDatabase::initialize() {
         migrateToVersion6();
         // fall through
     case 6:
+        migrateToVersion7();
+        // fall through
+    case 7:
         // Happy path; we're done
         return;
     default:
@@ -70,14 +91,21 @@ void OfflineDatabase::changePath(const std::string& path_) {
     Log::Info(Event::Database, "Changing the database path.");
     cleanup();
     path = path_;
-    initialize();
+    if (!readOnly) {
+        initialize();
+    }
 }
 
 void OfflineDatabase::cleanup() {
     // Deleting these SQLite objects may result in exceptions
     try {
+        if (db && !readOnly) {
+            flushAccessed();
+        }
         statements.clear();
         db.reset();
+        tileDictionaries.clear();
+        dictionaries.clear();
     } catch (...) {
         handleError("close database");
     }
@@ -104,6 +132,12 @@ void OfflineDatabase::handleError(const mapbox::sqlite::Exception& ex, const cha
         // The database was corruped, moved away, or deleted. We're going to start fresh with a
         // clean slate for the next operation.
         Log::Error(Event::Database, static_cast<int>(ex.code), "Can't %s: %s", action, ex.what());
+        if (readOnly) {
+            // Leave removing the database to the writable connection, and reopen it next time.
+            statements.clear();
+            db.reset();
+            return;
+        }
         try {
             removeExisting();
         } catch (const util::IOException& ioEx) {
@@ -125,6 +159,10 @@ void OfflineDatabase::handleError(const std::runtime_error& ex, const char* acti
 }
 
 void OfflineDatabase::handleError(const char* action) {
+    // Dictionaries may have been stored by a transaction that was rolled back.
+    tileDictionaries.clear();
+    dictionaries.clear();
+
     // Note: mbgl-defined exceptions must be handled first.
     try {
         throw;
@@ -145,6 +183,10 @@ void OfflineDatabase::handleError(const char* action) {
 void OfflineDatabase::removeExisting() {
     Log::Warning(Event::Database, "Removing existing incompatible offline database");
 
+    accessedResources.clear();
+    accessedTiles.clear();
+    tileDictionaries.clear();
+    dictionaries.clear();
     statements.clear();
     db.reset();
 
@@ -164,7 +206,7 @@ void OfflineDatabase::createSchema() {
     db->exec("PRAGMA synchronous = FULL");
     mapbox::sqlite::Transaction transaction(*db);
     db->exec(offlineDatabaseSchema);
-    db->exec("PRAGMA user_version = 6");
+    db->exec("PRAGMA user_version = 7");
     transaction.commit();
 }
 
@@ -196,6 +238,19 @@ void OfflineDatabase::migrateToVersion6() {
     transaction.commit();
 }
 
+void OfflineDatabase::migrateToVersion7() {
+    assert(db);
+    mapbox::sqlite::Transaction transaction(*db);
+    // Existing data stays valid, as data compressed without a preset dictionary doesn't refer to one.
+    db->exec("CREATE TABLE dictionaries ("
+             "id INTEGER NOT NULL PRIMARY KEY, "
+             "url_template TEXT NOT NULL, "
+             "data BLOB NOT NULL)");
+    db->exec("CREATE INDEX dictionaries_url_template ON dictionaries (url_template)");
+    db->exec("PRAGMA user_version = 7");
+    transaction.commit();
+}
+
 void OfflineDatabase::vacuum() {
     assert(db);
     if (getPragma<int64_t>("PRAGMA auto_vacuum") != 2 /*INCREMENTAL*/) {
@@ -230,11 +285,112 @@ optional<Response> OfflineDatabase::get(const Resource& resource) try {
 }
 
 optional<std::pair<Response, uint64_t>> OfflineDatabase::getInternal(const Resource& resource) {
+    auto result = [&] {
+        if (resource.kind == Resource::Kind::Tile) {
+            assert(resource.tileData);
+            return getTile(*resource.tileData);
+        } else {
+            return getResource(resource);
+        }
+    }();
+
+    flushAccessedIfNeeded();
+    return result;
+}
+
+void OfflineDatabase::markAccessed(const Resource& resource) try {
+    assert(!readOnly);
     if (resource.kind == Resource::Kind::Tile) {
         assert(resource.tileData);
-        return getTile(*resource.tileData);
+        const Resource::TileData& tile = *resource.tileData;
+        accessedTiles[std::make_tuple(tile.urlTemplate, tile.pixelRatio, tile.x, tile.y, tile.z)] = util::now();
     } else {
-        return getResource(resource);
+        accessedResources[resource.url] = util::now();
+    }
+    flushAccessedIfNeeded();
+} catch (...) {
+    handleError("update timestamp");
+}
+
+void OfflineDatabase::flushAccessedIfNeeded() {
+    if (accessedResources.size() + accessedTiles.size() >= maximumPendingAccessedCount ||
+        Clock::now() - lastAccessedFlush >= accessedFlushInterval) {
+        flushAccessed();
+    }
+}
+
+// Writes the buffered accessed timestamps of resources and tiles that were read since the last
+// flush in a single transaction. Reads don't update the timestamps themselves, which would turn
+// every cache hit into a write.
+void OfflineDatabase::flushAccessed() {
+    if (accessedResources.empty() && accessedTiles.empty()) {
+        lastAccessedFlush = Clock::now();
+        return;
+    }
+
+    try {
+        mapbox::sqlite::Transaction transaction(*db);
+        writeAccessed();
+        transaction.commit();
+    } catch (const mapbox::sqlite::Exception& ex) {
+        if (ex.code == mapbox::sqlite::ResultCode::NotADB ||
+            ex.code == mapbox::sqlite::ResultCode::Corrupt) {
+            throw;
+        }
+
+        // If we don't have any indication that the database is corrupt, continue as usual.
+        Log::Warning(Event::Database, static_cast<int>(ex.code), "Can't update timestamp: %s", ex.what());
+    }
+}
+
+// Timestamps are only ever moved forward, since the entry may have been written since it was read.
+void OfflineDatabase::writeAccessed() {
+    lastAccessedFlush = Clock::now();
+    if (accessedResources.empty() && accessedTiles.empty()) {
+        return;
+    }
+
+    // Drop the timestamps even if they can't be written, so that a failure isn't repeated for
+    // every read. LRU eviction is best-effort.
+    auto resources = std::move(accessedResources);
+    auto tiles = std::move(accessedTiles);
+    accessedResources.clear();
+    accessedTiles.clear();
+
+    // clang-format off
+    mapbox::sqlite::Query resourceQuery{ getStatement(
+        "UPDATE resources "
+        "SET accessed = max(accessed, ?1) "
+        "WHERE url    = ?2 ") };
+    // clang-format on
+
+    for (const auto& resource : resources) {
+        resourceQuery.bind(1, resource.second);
+        resourceQuery.bind(2, resource.first);
+        resourceQuery.run();
+        resourceQuery.reset();
+    }
+
+    // clang-format off
+    mapbox::sqlite::Query tileQuery{ getStatement(
+        "UPDATE tiles "
+        "SET accessed       = max(accessed, ?1) "
+        "WHERE url_template = ?2 "
+        "  AND pixel_ratio  = ?3 "
+        "  AND x            = ?4 "
+        "  AND y            = ?5 "
+        "  AND z            = ?6 ") };
+    // clang-format on
+
+    for (const auto& tile : tiles) {
+        tileQuery.bind(1, tile.second);
+        tileQuery.bind(2, std::get<0>(tile.first));
+        tileQuery.bind(3, std::get<1>(tile.first));
+        tileQuery.bind(4, std::get<2>(tile.first));
+        tileQuery.bind(5, std::get<3>(tile.first));
+        tileQuery.bind(6, std::get<4>(tile.first));
+        tileQuery.run();
+        tileQuery.reset();
     }
 }
 
@@ -275,7 +431,9 @@ std::pair<bool, uint64_t> OfflineDatabase::putInternal(const Resource& resource,
     uint64_t size = 0;
 
     if (response.data) {
-        compressedData = util::compress(*response.data);
+        compressedData = resource.kind == Resource::Kind::Tile
+            ? compressTile(resource.tileData->urlTemplate, *response.data)
+            : util::compress(*response.data);
         compressed = compressedData.size() < response.data->size();
         size = compressed ? compressedData.size() : response.data->size();
     }
@@ -291,33 +449,171 @@ std::pair<bool, uint64_t> OfflineDatabase::putInternal(const Resource& resource,
         assert(resource.tileData);
         inserted = putTile(*resource.tileData, response,
                 compressed ? compressedData : response.data ? *response.data : "",
-                compressed);
+                compressed ? Codec::Deflate : Codec::None);
     } else {
         inserted = putResource(resource, response,
                 compressed ? compressedData : response.data ? *response.data : "",
-                compressed);
+                compressed ? Codec::Deflate : Codec::None);
     }
 
     return { inserted, size };
 }
 
-optional<std::pair<Response, uint64_t>> OfflineDatabase::getResource(const Resource& resource) {
-    // Update accessed timestamp used for LRU eviction.
-    try {
-        mapbox::sqlite::Query accessedQuery{ getStatement("UPDATE resources SET accessed = ?1 WHERE url = ?2") };
-        accessedQuery.bind(1, util::now());
-        accessedQuery.bind(2, resource.url);
-        accessedQuery.run();
-    } catch (const mapbox::sqlite::Exception& ex) {
-        if (ex.code == mapbox::sqlite::ResultCode::NotADB ||
-            ex.code == mapbox::sqlite::ResultCode::Corrupt) {
-            throw;
+std::string OfflineDatabase::compressTile(const std::string& urlTemplate, const std::string& data) {
+    auto it = tileDictionaries.find(urlTemplate);
+    if (it == tileDictionaries.end()) {
+        // clang-format off
+        mapbox::sqlite::Query query{ getStatement(
+            "SELECT id, data FROM dictionaries WHERE url_template = ?1 LIMIT 1") };
+        // clang-format on
+        query.bind(1, urlTemplate);
+        it = tileDictionaries.emplace(urlTemplate, TileDictionary()).first;
+        if (query.run()) {
+            auto dictionary = std::make_shared<const std::string>(query.get<std::string>(1));
+            dictionaries.emplace(static_cast<uint32_t>(query.get<int64_t>(0)), dictionary);
+            it->second.dictionary = std::move(dictionary);
         }
+    }
 
-        // If we don't have any indication that the database is corrupt, continue as usual.
-        Log::Warning(Event::Database, static_cast<int>(ex.code), "Can't update timestamp: %s", ex.what());
+    TileDictionary& tileDictionary = it->second;
+    if (tileDictionary.dictionary) {
+        return tileDictionary.dictionary->empty() ? util::compress(data)
+                                                  : util::compress(data, *tileDictionary.dictionary);
     }
 
+    tileDictionary.samples.push_back(data);
+    if (tileDictionary.samples.size() < dictionarySampleCount) {
+        return util::compress(data);
+    }
+
+    auto dictionary = std::make_shared<const std::string>(
+        util::trainDictionary(tileDictionary.samples, maximumDictionarySize));
+    tileDictionary.samples.clear();
+    tileDictionary.dictionary = dictionary;
+    if (dictionary->empty()) {
+        return util::compress(data);
+    }
+
+    // Dictionaries are identified by their checksum. In the unlikely case that it is taken by
+    // another dictionary, the tiles of the template are compressed without one.
+    const uint32_t id = util::getDictionaryID(*dictionary);
+    // clang-format off
+    mapbox::sqlite::Query insertQuery{ getStatement(
+        "INSERT OR IGNORE INTO dictionaries (id, url_template, data) VALUES (?1, ?2, ?3)") };
+    // clang-format on
+    insertQuery.bind(1, int64_t(id));
+    insertQuery.bind(2, urlTemplate);
+    insertQuery.bindBlob(3, dictionary->data(), dictionary->size(), false);
+    insertQuery.run();
+    if (insertQuery.changes() == 0) {
+        tileDictionary.dictionary = std::make_shared<const std::string>();
+        return util::compress(data);
+    }
+
+    dictionaries.emplace(id, dictionary);
+    return util::compress(data, *dictionary);
+}
+
+// Dictionaries are identified by their checksum, so a dictionary of a merged database may have the
+// ID of a different dictionary of this one, and isn't copied then. The merged tiles compressed with
+// it are recompressed without a dictionary.
+void OfflineDatabase::recompressMergedTiles() {
+    // clang-format off
+    mapbox::sqlite::Query dictionaryQuery{ getStatement(
+        "SELECT sd.id, sd.data "
+        "FROM side.dictionaries sd "
+        "JOIN dictionaries d ON sd.id = d.id "
+        "WHERE sd.data != d.data") };
+    // clang-format on
+
+    std::unordered_map<uint32_t, std::string> collidingDictionaries;
+    while (dictionaryQuery.run()) {
+        collidingDictionaries.emplace(static_cast<uint32_t>(dictionaryQuery.get<int64_t>(0)),
+                                      dictionaryQuery.get<std::string>(1));
+    }
+    if (collidingDictionaries.empty()) {
+        return;
+    }
+
+    // clang-format off
+    mapbox::sqlite::Query tileQuery{ getStatement(
+        "SELECT t.id, t.data "
+        "FROM tiles t "
+        "JOIN side.tiles st ON st.url_template = t.url_template AND st.pixel_ratio = t.pixel_ratio AND "
+            "st.z = t.z AND st.x = t.x AND st.y = t.y "
+        "WHERE t.compressed = ?1 AND st.compressed = ?1 AND t.data = st.data") };
+    // clang-format on
+    tileQuery.bind(1, int64_t(Codec::Deflate));
+
+    std::vector<std::pair<int64_t, std::string>> tiles;
+    while (tileQuery.run()) {
+        const std::string data = tileQuery.get<std::string>(1);
+        const optional<uint32_t> dictionaryID = util::getPresetDictionaryID(data);
+        if (!dictionaryID) {
+            continue;
+        }
+        auto it = collidingDictionaries.find(*dictionaryID);
+        if (it != collidingDictionaries.end()) {
+            tiles.emplace_back(tileQuery.get<int64_t>(0), util::decompress(data, it->second));
+        }
+    }
+
+    // clang-format off
+    mapbox::sqlite::Query updateQuery{ getStatement(
+        "UPDATE tiles "
+        "SET data       = ?1, "
+        "    compressed = ?2 "
+        "WHERE id       = ?3") };
+    // clang-format on
+
+    for (const auto& tile : tiles) {
+        const std::string compressedData = util::compress(tile.second);
+        const bool compressed = compressedData.size() < tile.second.size();
+        const std::string& data = compressed ? compressedData : tile.second;
+        updateQuery.bindBlob(1, data.data(), data.size(), false);
+        updateQuery.bind(2, int64_t(compressed ? Codec::Deflate : Codec::None));
+        updateQuery.bind(3, tile.first);
+        updateQuery.run();
+        updateQuery.reset();
+    }
+}
+
+std::string OfflineDatabase::decode(Codec codec, const std::string& data) {
+    switch (codec) {
+    case Codec::None:
+        return data;
+    case Codec::Deflate: {
+        const optional<uint32_t> dictionaryID = util::getPresetDictionaryID(data);
+        if (!dictionaryID) {
+            return util::decompress(data);
+        }
+        const auto dictionary = getDictionary(*dictionaryID);
+        if (!dictionary) {
+            throw std::runtime_error("Missing compression dictionary");
+        }
+        return util::decompress(data, *dictionary);
+    }
+    }
+    throw std::runtime_error("Unknown compression codec");
+}
+
+std::shared_ptr<const std::string> OfflineDatabase::getDictionary(uint32_t id) {
+    auto it = dictionaries.find(id);
+    if (it != dictionaries.end()) {
+        return it->second;
+    }
+
+    mapbox::sqlite::Query query{ getStatement("SELECT data FROM dictionaries WHERE id = ?1") };
+    query.bind(1, int64_t(id));
+    if (!query.run()) {
+        return nullptr;
+    }
+    auto dictionary = std::make_shared<const std::string>(query.get<std::string>(0));
+    dictionaries.emplace(id, dictionary);
+    return dictionary;
+}
+
+optional<std::pair<Response, uint64_t>> OfflineDatabase::getResource(const Resource& resource) {
     // clang-format off
     mapbox::sqlite::Query query{ getStatement(
         //        0      1            2            3       4      5
@@ -332,6 +628,12 @@ optional<std::pair<Response, uint64_t>> OfflineDatabase::getResource(const Resou
         return nullopt;
     }
 
+    // Update accessed timestamp used for LRU eviction. Read-only connections leave it to the
+    // writable connection, see markAccessed().
+    if (!readOnly) {
+        accessedResources[resource.url] = util::now();
+    }
+
     Response response;
     uint64_t size = 0;
 
@@ -343,11 +645,8 @@ optional<std::pair<Response, uint64_t>> OfflineDatabase::getResource(const Resou
     auto data = query.get<optional<std::string>>(4);
     if (!data) {
         response.noContent = true;
-    } else if (query.get<bool>(5)) {
-        response.data = std::make_shared<std::string>(util::decompress(*data));
-        size = data->length();
     } else {
-        response.data = std::make_shared<std::string>(*data);
+        response.data = std::make_shared<std::string>(decode(Codec(query.get<int64_t>(5)), *data));
         size = data->length();
     }
 
@@ -367,7 +666,7 @@ optional<int64_t> OfflineDatabase::hasResource(const Resource& resource) {
 bool OfflineDatabase::putResource(const Resource& resource,
                                   const Response& response,
                                   const std::string& data,
-                                  bool compressed) {
+                                  Codec codec) {
     if (response.notModified) {
         // clang-format off
         mapbox::sqlite::Query notModifiedQuery{ getStatement(
@@ -414,7 +713,7 @@ bool OfflineDatabase::putResource(const Resource& resource,
         updateQuery.bind(8, false);
     } else {
         updateQuery.bindBlob(7, data.data(), data.size(), false);
-        updateQuery.bind(8, compressed);
+        updateQuery.bind(8, static_cast<int64_t>(codec));
     }
 
     updateQuery.run();
@@ -441,7 +740,7 @@ bool OfflineDatabase::putResource(const Resource& resource,
         insertQuery.bind(9, false);
     } else {
         insertQuery.bindBlob(8, data.data(), data.size(), false);
-        insertQuery.bind(9, compressed);
+        insertQuery.bind(9, static_cast<int64_t>(codec));
     }
 
     insertQuery.run();
@@ -450,35 +749,6 @@ bool OfflineDatabase::putResource(const Resource& resource,
 }
 
 optional<std::pair<Response, uint64_t>> OfflineDatabase::getTile(const Resource::TileData& tile) {
-    // Update accessed timestamp used for LRU eviction.
-    try {
-        // clang-format off
-        mapbox::sqlite::Query accessedQuery{ getStatement(
-            "UPDATE tiles "
-            "SET accessed       = ?1 "
-            "WHERE url_template = ?2 "
-            "  AND pixel_ratio  = ?3 "
-            "  AND x            = ?4 "
-            "  AND y            = ?5 "
-            "  AND z            = ?6 ") };
-        // clang-format on
-
-        accessedQuery.bind(1, util::now());
-        accessedQuery.bind(2, tile.urlTemplate);
-        accessedQuery.bind(3, tile.pixelRatio);
-        accessedQuery.bind(4, tile.x);
-        accessedQuery.bind(5, tile.y);
-        accessedQuery.bind(6, tile.z);
-        accessedQuery.run();
-    } catch (const mapbox::sqlite::Exception& ex) {
-        if (ex.code == mapbox::sqlite::ResultCode::NotADB || ex.code == mapbox::sqlite::ResultCode::Corrupt) {
-            throw;
-        }
-
-        // If we don't have any indication that the database is corrupt, continue as usual.
-        Log::Warning(Event::Database, static_cast<int>(ex.code), "Can't update timestamp: %s", ex.what());
-    }
-
     // clang-format off
     mapbox::sqlite::Query query{ getStatement(
         //        0      1           2,            3,      4,      5
@@ -501,6 +771,12 @@ optional<std::pair<Response, uint64_t>> OfflineDatabase::getTile(const Resource:
         return nullopt;
     }
 
+    // Update accessed timestamp used for LRU eviction. Read-only connections leave it to the
+    // writable connection, see markAccessed().
+    if (!readOnly) {
+        accessedTiles[std::make_tuple(tile.urlTemplate, tile.pixelRatio, tile.x, tile.y, tile.z)] = util::now();
+    }
+
     Response response;
     uint64_t size = 0;
 
@@ -512,11 +788,8 @@ optional<std::pair<Response, uint64_t>> OfflineDatabase::getTile(const Resource:
     optional<std::string> data = query.get<optional<std::string>>(4);
     if (!data) {
         response.noContent = true;
-    } else if (query.get<bool>(5)) {
-        response.data = std::make_shared<std::string>(util::decompress(*data));
-        size = data->length();
     } else {
-        response.data = std::make_shared<std::string>(*data);
+        response.data = std::make_shared<std::string>(decode(Codec(query.get<int64_t>(5)), *data));
         size = data->length();
     }
 
@@ -551,7 +824,7 @@ optional<int64_t> OfflineDatabase::hasTile(const Resource::TileData& tile) {
 bool OfflineDatabase::putTile(const Resource::TileData& tile,
                               const Response& response,
                               const std::string& data,
-                              bool compressed) {
+                              Codec codec) {
     if (response.notModified) {
         // clang-format off
         mapbox::sqlite::Query notModifiedQuery{ getStatement(
@@ -613,7 +886,7 @@ bool OfflineDatabase::putTile(const Resource::TileData& tile,
         updateQuery.bind(7, false);
     } else {
         updateQuery.bindBlob(6, data.data(), data.size(), false);
-        updateQuery.bind(7, compressed);
+        updateQuery.bind(7, static_cast<int64_t>(codec));
     }
 
     updateQuery.run();
@@ -643,7 +916,7 @@ bool OfflineDatabase::putTile(const Resource::TileData& tile,
         insertQuery.bind(12, false);
     } else {
         insertQuery.bindBlob(11, data.data(), data.size(), false);
-        insertQuery.bind(12, compressed);
+        insertQuery.bind(12, static_cast<int64_t>(codec));
     }
 
     insertQuery.run();
@@ -805,12 +1078,11 @@ OfflineDatabase::mergeDatabase(const std::string& sideDatabasePath) {
         return unexpected<std::exception_ptr>(std::current_exception());
     }
     try {
-        // Support sideloaded databases at user_version = 6. Future schema version
-        // changes will need to implement migration paths for sideloaded databases at
-        // version 6.
+        // Support sideloaded databases at user_version = 6 and 7. Version 7 only added
+        // the dictionaries table, which version 6 databases have no use for.
         auto sideUserVersion = static_cast<int>(getPragma<int64_t>("PRAGMA side.user_version"));
         const auto mainUserVersion = getPragma<int64_t>("PRAGMA user_version");
-        if (sideUserVersion < 6 || sideUserVersion != mainUserVersion) {
+        if (sideUserVersion < 6 || sideUserVersion > mainUserVersion) {
             throw std::runtime_error("Merge database has incorrect user_version");
         }
 
@@ -837,7 +1109,14 @@ OfflineDatabase::mergeDatabase(const std::string& sideDatabasePath) {
         queryTiles.reset();
 
         mapbox::sqlite::Transaction transaction(*db);
+        if (sideUserVersion >= 7) {
+            // Tiles refer to the dictionaries they are compressed with by ID.
+            db->exec("INSERT OR IGNORE INTO dictionaries SELECT id, url_template, data FROM side.dictionaries");
+        }
         db->exec(mergeSideloadedDatabaseSQL);
+        if (sideUserVersion >= 7) {
+            recompressMergedTiles();
+        }
         transaction.commit();
 
         // clang-format off
@@ -1148,6 +1427,9 @@ T OfflineDatabase::getPragma(const char* sql) {
 // delete an arbitrary number of old cache entries. The free pages approach saves
 // us from calling VACUUM or keeping a running total, which can be costly.
 bool OfflineDatabase::evict(uint64_t neededFreeSize) {
+    // Eviction must see the accessed timestamps of recent reads.
+    writeAccessed();
+
     uint64_t pageSize = getPragma<int64_t>("PRAGMA page_size");
     uint64_t pageCount = getPragma<int64_t>("PRAGMA page_count");
 
@@ -1225,6 +1507,13 @@ bool OfflineDatabase::evict(uint64_t neededFreeSize) {
 }
 
 std::exception_ptr OfflineDatabase::setMaximumAmbientCacheSize(uint64_t size) {
+    if (readOnly) {
+        // Only used to tell whether the ambient cache is disabled; eviction is left to the
+        // writable connection.
+        maximumAmbientCacheSize = size;
+        return nullptr;
+    }
+
     uint64_t previousMaximumAmbientCacheSize = maximumAmbientCacheSize;
 
     try {
@@ -0,0 +1,480 @@
+#include <mbgl/storage/tile_archive_file_source.hpp>
+#include <mbgl/storage/file_source_request.hpp>
+#include <mbgl/storage/response.hpp>
+#include <mbgl/storage/sqlite3.hpp>
+#include <mbgl/util/compression.hpp>
+#include <mbgl/util/mapped_file.hpp>
+#include <mbgl/util/optional.hpp>
+#include <mbgl/util/rapidjson.hpp>
+#include <mbgl/util/string.hpp>
+#include <mbgl/util/thread.hpp>
+#include <mbgl/util/url.hpp>
+
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+
+namespace {
+
+const std::string mbtilesProtocol = "mbtiles://";
+const std::string pmtilesProtocol = "pmtiles://";
+
+// Appended to the URL of an archive to form the tile URL template of its TileJSON.
+const std::string tileSuffix = "/{z}/{x}/{y}";
+
+} // namespace
+
+namespace mbgl {
+
+namespace {
+
+struct ArchiveMetadata {
+    uint8_t minZoom = 0;
+    uint8_t maxZoom = 22;
+    optional<std::array<double, 4>> bounds;
+    optional<std::string> attribution;
+};
+
+std::string makeTileJSON(const std::string& url, const ArchiveMetadata& metadata) {
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+
+    writer.StartObject();
+    writer.Key("tilejson");
+    writer.String("2.2.0");
+    writer.Key("tiles");
+    writer.StartArray();
+    writer.String(url + tileSuffix);
+    writer.EndArray();
+    writer.Key("minzoom");
+    writer.Uint(metadata.minZoom);
+    writer.Key("maxzoom");
+    writer.Uint(metadata.maxZoom);
+    if (metadata.bounds) {
+        writer.Key("bounds");
+        writer.StartArray();
+        for (double value : *metadata.bounds) {
+            writer.Double(value);
+        }
+        writer.EndArray();
+    }
+    if (metadata.attribution) {
+        writer.Key("attribution");
+        writer.String(*metadata.attribution);
+    }
+    writer.EndObject();
+
+    return buffer.GetString();
+}
+
+// Reads the tiles of an MBTiles archive through a read-only connection. See
+// https://github.com/mapbox/mbtiles-spec/blob/master/1.3/spec.md
+class MBTilesArchive {
+public:
+    MBTilesArchive(const std::string& path)
+        : db(mapbox::sqlite::Database::open(path, mapbox::sqlite::ReadOnly)),
+          tileStatement(db, "SELECT tile_data FROM tiles WHERE zoom_level = ?1 AND tile_column = ?2 AND tile_row = ?3") {
+    }
+
+    ArchiveMetadata getMetadata() {
+        ArchiveMetadata metadata;
+        bool hasZoomRange = false;
+
+        mapbox::sqlite::Statement statement(db, "SELECT name, value FROM metadata");
+        mapbox::sqlite::Query query{ statement };
+        while (query.run()) {
+            const auto name = query.get<std::string>(0);
+            const auto value = query.get<std::string>(1);
+            if (name == "minzoom") {
+                metadata.minZoom = static_cast<uint8_t>(std::atoi(value.c_str()));
+                hasZoomRange = true;
+            } else if (name == "maxzoom") {
+                metadata.maxZoom = static_cast<uint8_t>(std::atoi(value.c_str()));
+                hasZoomRange = true;
+            } else if (name == "attribution") {
+                metadata.attribution = value;
+            } else if (name == "bounds") {
+                std::array<double, 4> bounds;
+                if (std::sscanf(value.c_str(), "%lf,%lf,%lf,%lf", &bounds[0], &bounds[1], &bounds[2], &bounds[3]) == 4) {
+                    metadata.bounds = bounds;
+                }
+            }
+        }
+
+        // The zoom range is optional metadata.
+        if (!hasZoomRange) {
+            mapbox::sqlite::Statement zoomStatement(db, "SELECT min(zoom_level), max(zoom_level) FROM tiles");
+            mapbox::sqlite::Query zoomQuery{ zoomStatement };
+            if (zoomQuery.run()) {
+                metadata.minZoom = static_cast<uint8_t>(zoomQuery.get<int64_t>(0));
+                metadata.maxZoom = static_cast<uint8_t>(zoomQuery.get<int64_t>(1));
+            }
+        }
+
+        return metadata;
+    }
+
+    optional<std::string> getTile(uint8_t z, uint32_t x, uint32_t y) {
+        mapbox::sqlite::Query query{ tileStatement };
+        query.bind(1, int64_t(z));
+        query.bind(2, int64_t(x));
+        // Rows are numbered from the south.
+        query.bind(3, int64_t((1u << z) - 1 - y));
+        if (!query.run()) {
+            return nullopt;
+        }
+        auto data = query.get<std::string>(0);
+        // Vector tiles are usually stored gzip or zlib compressed, while images are stored as is.
+        if (isCompressed(data)) {
+            return util::decompress(data);
+        }
+        return data;
+    }
+
+private:
+    static bool isCompressed(const std::string& data) {
+        if (data.size() < 2) {
+            return false;
+        }
+        const auto first = static_cast<uint8_t>(data[0]);
+        const auto second = static_cast<uint8_t>(data[1]);
+        if (first == 0x1f && second == 0x8b) {
+            return true; // gzip
+        }
+        // zlib: deflate with a window of at most 32 KiB, no preset dictionary and a valid header checksum.
+        return (first & 0x0f) == 8 && (first >> 4) <= 7 && (second & 0x20) == 0 && ((first << 8) | second) % 31 == 0;
+    }
+
+    mapbox::sqlite::Database db;
+    mapbox::sqlite::Statement tileStatement;
+};
+
+// Reads the tiles of a PMTiles version 3 archive, which is memory-mapped. The root directory is
+// parsed when the archive is opened, and recently used leaf directories are kept in memory. See
+// https://github.com/protomaps/PMTiles/blob/main/spec/v3/spec.md
+class PMTilesArchive {
+public:
+    PMTilesArchive(const std::string& path) : file(path) {
+        const char* header = file.range(0, 127);
+        if (std::memcmp(header, "PMTiles", 7) != 0 || header[7] != 3) {
+            throw std::runtime_error("Unsupported archive");
+        }
+
+        const uint64_t rootDirectoryOffset = readLE<uint64_t>(header + 8);
+        const uint64_t rootDirectoryLength = readLE<uint64_t>(header + 16);
+        const uint64_t metadataOffset = readLE<uint64_t>(header + 24);
+        const uint64_t metadataLength = readLE<uint64_t>(header + 32);
+        leafDirectoriesOffset = readLE<uint64_t>(header + 40);
+        tileDataOffset = readLE<uint64_t>(header + 56);
+        internalCompression = static_cast<uint8_t>(header[97]);
+        tileCompression = static_cast<uint8_t>(header[98]);
+
+        metadata.minZoom = static_cast<uint8_t>(header[100]);
+        metadata.maxZoom = static_cast<uint8_t>(header[101]);
+        metadata.bounds = std::array<double, 4>{{ static_cast<int32_t>(readLE<uint32_t>(header + 102)) / 1e7,
+                                                  static_cast<int32_t>(readLE<uint32_t>(header + 106)) / 1e7,
+                                                  static_cast<int32_t>(readLE<uint32_t>(header + 110)) / 1e7,
+                                                  static_cast<int32_t>(readLE<uint32_t>(header + 114)) / 1e7 }};
+
+        root = parseDirectory(rootDirectoryOffset, rootDirectoryLength);
+
+        if (metadataLength > 0) {
+            const std::string json = decompress(file.range(metadataOffset, metadataLength), metadataLength, internalCompression);
+            JSDocument document;
+            document.Parse<0>(json.c_str());
+            if (!document.HasParseError() && document.IsObject() && document.HasMember("attribution") &&
+                document["attribution"].IsString()) {
+                metadata.attribution = std::string(document["attribution"].GetString(), document["attribution"].GetStringLength());
+            }
+        }
+    }
+
+    const ArchiveMetadata& getMetadata() const {
+        return metadata;
+    }
+
+    optional<std::string> getTile(uint8_t z, uint32_t x, uint32_t y) {
+        const uint64_t tileID = getTileID(z, x, y);
+
+        // Directories are nested at most three levels deep below the root.
+        std::shared_ptr<const Directory> leaf;
+        const Directory* directory = &root;
+        for (int depth = 0; depth < 4; ++depth) {
+            const Entry* entry = findEntry(*directory, tileID);
+            if (!entry) {
+                return nullopt;
+            }
+            if (entry->runLength > 0) {
+                return decompress(file.range(tileDataOffset + entry->offset, entry->length), entry->length, tileCompression);
+            }
+            leaf = getLeafDirectory(leafDirectoriesOffset + entry->offset, entry->length);
+            directory = leaf.get();
+        }
+        return nullopt;
+    }
+
+private:
+    struct Entry {
+        uint64_t tileID;
+        uint64_t offset;
+        uint32_t length;
+        uint32_t runLength;
+    };
+
+    using Directory = std::vector<Entry>;
+
+    template <class T>
+    static T readLE(const char* data) {
+        T value = 0;
+        for (std::size_t i = 0; i < sizeof(T); ++i) {
+            value |= static_cast<T>(static_cast<uint8_t>(data[i])) << (8 * i);
+        }
+        return value;
+    }
+
+    // Tiles are numbered along a Hilbert curve within each zoom level, following all tiles of
+    // the lower zoom levels.
+    static uint64_t getTileID(uint8_t z, uint32_t x, uint32_t y) {
+        uint64_t id = ((uint64_t(1) << (2 * z)) - 1) / 3;
+        for (uint64_t s = (uint64_t(1) << z) / 2; s > 0; s /= 2) {
+            const uint64_t rx = (x & s) > 0;
+            const uint64_t ry = (y & s) > 0;
+            id += s * s * ((3 * rx) ^ ry);
+            if (ry == 0) {
+                if (rx == 1) {
+                    x = static_cast<uint32_t>(s - 1 - x);
+                    y = static_cast<uint32_t>(s - 1 - y);
+                }
+                std::swap(x, y);
+            }
+        }
+        return id;
+    }
+
+    static std::string decompress(const char* data, uint64_t length, uint8_t compression) {
+        switch (compression) {
+        case 0: // Unknown
+        case 1: // None
+            return std::string(data, length);
+        case 2: // gzip
+            return util::decompress(std::string(data, length));
+        default:
+            throw std::runtime_error("Unsupported compression");
+        }
+    }
+
+    Directory parseDirectory(uint64_t offset, uint64_t length) const {
+        std::string decompressed;
+        const char* begin = file.range(offset, length);
+        const char* end = begin + length;
+        if (internalCompression > 1) {
+            decompressed = decompress(begin, length, internalCompression);
+            begin = decompressed.data();
+            end = begin + decompressed.size();
+        }
+
+        auto readVarint = [&] {
+            uint64_t value = 0;
+            for (int shift = 0; shift < 64; shift += 7) {
+                if (begin == end) {
+                    break;
+                }
+                const auto byte = static_cast<uint8_t>(*begin++);
+                value |= uint64_t(byte & 0x7f) << shift;
+                if (!(byte & 0x80)) {
+                    return value;
+                }
+            }
+            throw std::runtime_error("Malformed archive directory");
+        };
+
+        const uint64_t count = readVarint();
+        if (count > static_cast<uint64_t>(end - begin)) {
+            throw std::runtime_error("Malformed archive directory");
+        }
+
+        Directory directory(count);
+        uint64_t tileID = 0;
+        for (auto& entry : directory) {
+            tileID += readVarint();
+            entry.tileID = tileID;
+        }
+        for (auto& entry : directory) {
+            entry.runLength = static_cast<uint32_t>(readVarint());
+        }
+        for (auto& entry : directory) {
+            entry.length = static_cast<uint32_t>(readVarint());
+        }
+        for (std::size_t i = 0; i < directory.size(); ++i) {
+            const uint64_t value = readVarint();
+            // Zero means that the data directly follows the data of the previous entry.
+            if (value == 0 && i > 0) {
+                directory[i].offset = directory[i - 1].offset + directory[i - 1].length;
+            } else {
+                directory[i].offset = value - 1;
+            }
+        }
+        return directory;
+    }
+
+    // Returns the entry containing the tile, or the leaf directory that may contain it.
+    static const Entry* findEntry(const Directory& directory, uint64_t tileID) {
+        auto it = std::upper_bound(directory.begin(), directory.end(), tileID,
+                                   [](uint64_t id, const Entry& entry) { return id < entry.tileID; });
+        if (it == directory.begin()) {
+            return nullptr;
+        }
+        --it;
+        if (it->runLength == 0 || tileID - it->tileID < it->runLength) {
+            return &*it;
+        }
+        return nullptr;
+    }
+
+    std::shared_ptr<const Directory> getLeafDirectory(uint64_t offset, uint64_t length) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = leafDirectories.find(offset);
+        if (it != leafDirectories.end()) {
+            return it->second;
+        }
+        if (leafDirectories.size() >= 64) {
+            leafDirectories.clear();
+        }
+        auto directory = std::make_shared<const Directory>(parseDirectory(offset, length));
+        leafDirectories.emplace(offset, directory);
+        return directory;
+    }
+
+    const util::MappedFile file;
+    uint64_t leafDirectoriesOffset;
+    uint64_t tileDataOffset;
+    uint8_t internalCompression;
+    uint8_t tileCompression;
+    ArchiveMetadata metadata;
+    Directory root;
+
+    std::mutex mutex;
+    std::unordered_map<uint64_t, std::shared_ptr<const Directory>> leafDirectories;
+};
+
+// PMTiles archives are shared by all threads, as they only map their file once.
+class PMTilesArchives {
+public:
+    std::shared_ptr<PMTilesArchive> get(const std::string& path) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = archives.find(path);
+        if (it == archives.end()) {
+            it = archives.emplace(path, std::make_shared<PMTilesArchive>(path)).first;
+        }
+        return it->second;
+    }
+
+private:
+    std::mutex mutex;
+    std::unordered_map<std::string, std::shared_ptr<PMTilesArchive>> archives;
+};
+
+} // namespace
+
+class TileArchiveFileSource::Impl {
+public:
+    Impl(ActorRef<Impl>, std::shared_ptr<PMTilesArchives> pmtilesArchives_)
+        : pmtilesArchives(std::move(pmtilesArchives_)) {
+    }
+
+    void request(const Resource& resource, ActorRef<FileSourceRequest> req) {
+        Response response;
+        try {
+            response = getResponse(resource);
+        } catch (const std::exception& ex) {
+            response.error = std::make_unique<Response::Error>(Response::Error::Reason::Other, ex.what());
+        }
+        req.invoke(&FileSourceRequest::setResponse, response);
+    }
+
+private:
+    Response getResponse(const Resource& resource) {
+        // Tiles are requested through the URL template of the TileJSON of their archive.
+        const bool isTile = resource.kind == Resource::Kind::Tile && resource.tileData &&
+                            resource.tileData->urlTemplate.size() > tileSuffix.size() &&
+                            0 == resource.tileData->urlTemplate.compare(
+                                     resource.tileData->urlTemplate.size() - tileSuffix.size(), tileSuffix.size(), tileSuffix);
+        const std::string url = isTile ? resource.tileData->urlTemplate.substr(
+                                             0, resource.tileData->urlTemplate.size() - tileSuffix.size())
+                                       : resource.url;
+        const bool isMBTiles = 0 == url.rfind(mbtilesProtocol, 0);
+        const std::string path =
+            util::percentDecode(url.substr(isMBTiles ? mbtilesProtocol.size() : pmtilesProtocol.size()));
+
+        Response response;
+        if (!isTile) {
+            const ArchiveMetadata metadata = isMBTiles ? getMBTiles(path).getMetadata()
+                                                       : pmtilesArchives->get(path)->getMetadata();
+            response.data = std::make_shared<std::string>(makeTileJSON(url, metadata));
+            return response;
+        }
+
+        const auto& tile = *resource.tileData;
+        if (tile.z < 0 || tile.z > 26 || tile.x < 0 || tile.y < 0 || tile.x >= (1 << tile.z) || tile.y >= (1 << tile.z)) {
+            response.noContent = true;
+            return response;
+        }
+
+        const auto z = static_cast<uint8_t>(tile.z);
+        const auto x = static_cast<uint32_t>(tile.x);
+        const auto y = static_cast<uint32_t>(tile.y);
+        optional<std::string> data = isMBTiles ? getMBTiles(path).getTile(z, x, y)
+                                               : pmtilesArchives->get(path)->getTile(z, x, y);
+        if (!data) {
+            response.noContent = true;
+        } else {
+            response.data = std::make_shared<std::string>(std::move(*data));
+        }
+        return response;
+    }
+
+    // Every thread opens MBTiles archives on a read-only connection of its own.
+    MBTilesArchive& getMBTiles(const std::string& path) {
+        auto it = mbtilesArchives.find(path);
+        if (it == mbtilesArchives.end()) {
+            it = mbtilesArchives.emplace(path, std::make_unique<MBTilesArchive>(path)).first;
+        }
+        return *it->second;
+    }
+
+    const std::shared_ptr<PMTilesArchives> pmtilesArchives;
+    std::unordered_map<std::string, std::unique_ptr<MBTilesArchive>> mbtilesArchives;
+};
+
+TileArchiveFileSource::TileArchiveFileSource() {
+    auto pmtilesArchives = std::make_shared<PMTilesArchives>();
+    const unsigned threadCount = std::max(1u, std::min(4u, std::thread::hardware_concurrency()));
+    for (unsigned i = 0; i < threadCount; ++i) {
+        impls.push_back(std::make_unique<util::Thread<Impl>>("TileArchiveFileSource", pmtilesArchives));
+    }
+}
+
+TileArchiveFileSource::~TileArchiveFileSource() = default;
+
+std::unique_ptr<AsyncRequest> TileArchiveFileSource::request(const Resource& resource, Callback callback) {
+    auto req = std::make_unique<FileSourceRequest>(std::move(callback));
+
+    impls[nextImpl++ % impls.size()]->actor().invoke(&Impl::request, resource, req->actor());
+
+    return std::move(req);
+}
+
+bool TileArchiveFileSource::acceptsURL(const std::string& url) {
+    return 0 == url.rfind(mbtilesProtocol, 0) || 0 == url.rfind(pmtilesProtocol, 0);
+}
+
+} // namespace mbgl
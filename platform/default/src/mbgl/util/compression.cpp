@@ -6,9 +6,13 @@
 #include <zlib.h>
 #endif
 
+#include <algorithm>
 #include <cstdio>
 #include <cstring>
+#include <queue>
 #include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
 
 // Check zlib library version.
 const static bool zlibVersionCheck __attribute__((unused)) = []() {
@@ -31,7 +35,7 @@ namespace util {
 // cause a link error.
 #undef compress
 
-std::string compress(const std::string &raw) {
+std::string compress(const std::string &raw, const std::string &dictionary) {
     z_stream deflate_stream;
     memset(&deflate_stream, 0, sizeof(deflate_stream));
 
@@ -40,6 +44,13 @@ std::string compress(const std::string &raw) {
         throw std::runtime_error("failed to initialize deflate");
     }
 
+    if (!dictionary.empty() &&
+        deflateSetDictionary(&deflate_stream, reinterpret_cast<const Bytef *>(dictionary.data()),
+                             uInt(dictionary.size())) != Z_OK) {
+        deflateEnd(&deflate_stream);
+        throw std::runtime_error("failed to set deflate dictionary");
+    }
+
     deflate_stream.next_in = (Bytef *)raw.data();
     deflate_stream.avail_in = uInt(raw.size());
 
@@ -66,12 +77,17 @@ std::string compress(const std::string &raw) {
     return result;
 }
 
-std::string decompress(const std::string &raw) {
+std::string compress(const std::string &raw) {
+    return compress(raw, {});
+}
+
+std::string decompress(const std::string &raw, const std::string &dictionary) {
     z_stream inflate_stream;
     memset(&inflate_stream, 0, sizeof(inflate_stream));
 
     // TODO: reuse z_streams
-    if (inflateInit(&inflate_stream) != Z_OK) {
+    // Detect zlib and gzip headers automatically.
+    if (inflateInit2(&inflate_stream, MAX_WBITS + 32) != Z_OK) {
         throw std::runtime_error("failed to initialize inflate");
     }
 
@@ -90,6 +106,10 @@ std::string decompress(const std::string &raw) {
         if (result.size() < inflate_stream.total_out) {
             result.append(out, inflate_stream.total_out - result.size());
         }
+        if (code == Z_NEED_DICT && !dictionary.empty()) {
+            code = inflateSetDictionary(&inflate_stream, reinterpret_cast<const Bytef *>(dictionary.data()),
+                                        uInt(dictionary.size()));
+        }
     } while (code == Z_OK);
 
     inflateEnd(&inflate_stream);
@@ -100,5 +120,115 @@ std::string decompress(const std::string &raw) {
 
     return result;
 }
+
+std::string decompress(const std::string &raw) {
+    return decompress(raw, {});
+}
+
+optional<uint32_t> getPresetDictionaryID(const std::string &compressed) {
+    // A zlib stream references its preset dictionary in the header, see RFC 1950.
+    if (compressed.size() < 6 || (static_cast<uint8_t>(compressed[0]) & 0x0f) != Z_DEFLATED ||
+        !(static_cast<uint8_t>(compressed[1]) & 0x20)) {
+        return nullopt;
+    }
+    uint32_t id = 0;
+    for (std::size_t i = 2; i < 6; ++i) {
+        id = (id << 8) | static_cast<uint8_t>(compressed[i]);
+    }
+    return id;
+}
+
+uint32_t getDictionaryID(const std::string &dictionary) {
+    return static_cast<uint32_t>(
+        adler32(adler32(0, Z_NULL, 0), reinterpret_cast<const Bytef *>(dictionary.data()), uInt(dictionary.size())));
+}
+
+std::string trainDictionary(const std::vector<std::string> &samples, std::size_t maxSize) {
+    // Picks the segments of the samples covering the most substrings shared between samples,
+    // greedily, like the COVER algorithm of zstd does. Substrings are counted once per sample.
+    constexpr std::size_t substringLength = 8;
+    constexpr std::size_t segmentLength = 64;
+
+    auto substringAt = [](const char *data) {
+        uint64_t substring;
+        std::memcpy(&substring, data, substringLength);
+        return substring;
+    };
+
+    std::unordered_map<uint64_t, uint32_t> frequencies;
+    std::unordered_set<uint64_t> seen;
+    for (const auto &sample : samples) {
+        seen.clear();
+        for (std::size_t i = 0; i + substringLength <= sample.size(); ++i) {
+            const uint64_t substring = substringAt(sample.data() + i);
+            if (seen.insert(substring).second) {
+                ++frequencies[substring];
+            }
+        }
+    }
+
+    struct Segment {
+        const char *data;
+        uint64_t score;
+        bool operator<(const Segment &other) const {
+            return score < other.score;
+        }
+    };
+
+    std::vector<uint64_t> substrings;
+    auto score = [&](const char *data) {
+        substrings.clear();
+        for (std::size_t i = 0; i + substringLength <= segmentLength; ++i) {
+            substrings.push_back(substringAt(data + i));
+        }
+        std::sort(substrings.begin(), substrings.end());
+        substrings.erase(std::unique(substrings.begin(), substrings.end()), substrings.end());
+
+        uint64_t result = 0;
+        for (uint64_t substring : substrings) {
+            const uint32_t frequency = frequencies[substring];
+            // Substrings found in a single sample are unlikely to recur.
+            if (frequency > 1) {
+                result += frequency;
+            }
+        }
+        return result;
+    };
+
+    std::priority_queue<Segment> segments;
+    for (const auto &sample : samples) {
+        for (std::size_t i = 0; i + segmentLength <= sample.size(); i += segmentLength / 2) {
+            segments.push({ sample.data() + i, score(sample.data() + i) });
+        }
+    }
+
+    // Scores only decrease as segments are picked, so a segment whose score is still the
+    // highest once it is updated is the best one.
+    std::vector<const char *> picked;
+    while (!segments.empty() && (picked.size() + 1) * segmentLength <= maxSize) {
+        Segment segment = segments.top();
+        segments.pop();
+        segment.score = score(segment.data);
+        if (segment.score == 0) {
+            continue;
+        }
+        if (!segments.empty() && segment.score < segments.top().score) {
+            segments.push(segment);
+            continue;
+        }
+        picked.push_back(segment.data);
+        for (std::size_t i = 0; i + substringLength <= segmentLength; ++i) {
+            frequencies[substringAt(segment.data + i)] = 0;
+        }
+    }
+
+    // Put the best segments last, as matches closer to the data are encoded in fewer bits.
+    std::string dictionary;
+    dictionary.reserve(picked.size() * segmentLength);
+    for (auto it = picked.rbegin(); it != picked.rend(); ++it) {
+        dictionary.append(*it, segmentLength);
+    }
+    return dictionary;
+}
 } // namespace util
 } // namespace mbgl
@@ -118,6 +118,9 @@ struct GfxProbe {
     Memory memIndexBuffers;
     Memory memVertexBuffers;
     Memory memTextures;
+
+    // Bytes uploaded to textures since the probe started, or -1 if the expectation doesn't record them.
+    int memTextureUploads;
 };
 
 class TestMetrics {
@@ -146,6 +149,7 @@ struct TestMetadata {
     mbgl::MapMode mapMode = mbgl::MapMode::Static;
     mbgl::MapDebugOptions debug = mbgl::MapDebugOptions::NoDebug;
     bool crossSourceCollisions = true;
+    bool parallelTileLayout = false;
     bool axonometric = false;
     double xSkew = 0.0;
     double ySkew = 1.0;
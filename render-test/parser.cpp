@@ -277,6 +277,7 @@ std::string serializeMetrics(const TestMetrics& metrics) {
             writer.Int(gfxProbe.second.memVertexBuffers.allocated);
             writer.Int(gfxProbe.second.memVertexBuffers.peak);
             writer.EndArray();
+            writer.Int(gfxProbe.second.memTextureUploads);
             writer.EndArray();
         }
         writer.EndArray();
@@ -433,6 +434,7 @@ TestMetrics readExpectedMetrics(const mbgl::filesystem::path& path) {
             probe.memIndexBuffers.peak = probeValue[6].GetArray()[1].GetInt();
             probe.memVertexBuffers.allocated = probeValue[7].GetArray()[0].GetInt();
             probe.memVertexBuffers.peak = probeValue[7].GetArray()[1].GetInt();
+            probe.memTextureUploads = probeValue.Size() > 8u ? probeValue[8].GetInt() : -1;
 
             result.gfx.insert({mark, std::move(probe)});
         }
@@ -531,6 +533,11 @@ TestMetadata parseTestMetadata(const TestPaths& paths, const Manifest& manifest)
         metadata.crossSourceCollisions = testValue["crossSourceCollisions"].GetBool();
     }
 
+    if (testValue.HasMember("parallelTileLayout")) {
+        assert(testValue["parallelTileLayout"].IsBool());
+        metadata.parallelTileLayout = testValue["parallelTileLayout"].GetBool();
+    }
+
     if (testValue.HasMember("axonometric")) {
         assert(testValue["axonometric"].IsBool());
         metadata.axonometric = testValue["axonometric"].GetBool();
@@ -1266,6 +1273,7 @@ TestOperations parseTestOperations(TestMetadata& metadata, const Manifest& manif
                 metricProbe.memIndexBuffers.peak -= ctx.baselineGfxProbe.memIndexBuffers.peak;
                 metricProbe.memVertexBuffers.peak -= ctx.baselineGfxProbe.memVertexBuffers.peak;
                 metricProbe.memTextures.peak -= ctx.baselineGfxProbe.memTextures.peak;
+                metricProbe.memTextureUploads -= ctx.baselineGfxProbe.memTextureUploads;
                 ctx.getMetadata().metrics.gfx.insert({mark, metricProbe});
                 return true;
             });
@@ -39,7 +39,8 @@ GfxProbe::GfxProbe(const mbgl::gfx::RenderingStats& stats, const GfxProbe& prev)
       numTextures(stats.numActiveTextures),
       memIndexBuffers(stats.memIndexBuffers, std::max(stats.memIndexBuffers, prev.memIndexBuffers.peak)),
       memVertexBuffers(stats.memVertexBuffers, std::max(stats.memVertexBuffers, prev.memVertexBuffers.peak)),
-      memTextures(stats.memTextures, std::max(stats.memTextures, prev.memTextures.peak)) {}
+      memTextures(stats.memTextures, std::max(stats.memTextures, prev.memTextures.peak)),
+      memTextureUploads(stats.memTextureUploads) {}
 
 // static
 gfx::HeadlessBackend::SwapBehaviour swapBehavior(MapMode mode) {
@@ -497,6 +498,15 @@ void TestRunner::checkProbingResults(TestMetadata& resultMetadata) {
                 metadata.metricsFailed++;
             }
 
+            if (expectedValue.memTextureUploads >= 0 &&
+                expectedValue.memTextureUploads != actualValue.memTextureUploads) {
+                if (!metadata.errorMessage.empty()) ss << std::endl;
+                ss << "Uploaded texture memory size at probe \"" << probeName << "\" is "
+                   << actualValue.memTextureUploads << " bytes, expected is " << expectedValue.memTextureUploads
+                   << " bytes";
+                metadata.metricsFailed++;
+            }
+
             metadata.errorMessage += metadata.errorMessage.empty() ? ss.str() : "\n" + ss.str();
         }
     };
@@ -596,6 +606,7 @@ TestOperations getAfterOperations(const Manifest& manifest) {
                 metricProbe.memIndexBuffers.peak -= ctx.baselineGfxProbe.memIndexBuffers.peak;
                 metricProbe.memVertexBuffers.peak -= ctx.baselineGfxProbe.memVertexBuffers.peak;
                 metricProbe.memTextures.peak -= ctx.baselineGfxProbe.memTextures.peak;
+                metricProbe.memTextureUploads -= ctx.baselineGfxProbe.memTextureUploads;
                 ctx.getMetadata().metrics.gfx.insert({gfxProbeOp + mark, metricProbe});
 
                 ctx.gfxProbeActive = false;
@@ -660,7 +671,8 @@ TestRunner::Impl::Impl(const TestMetadata& metadata)
               .withMapMode(metadata.mapMode)
               .withSize(metadata.size)
               .withPixelRatio(metadata.pixelRatio)
-              .withCrossSourceCollisions(metadata.crossSourceCollisions),
+              .withCrossSourceCollisions(metadata.crossSourceCollisions)
+              .withParallelTileLayout(metadata.parallelTileLayout),
           mbgl::ResourceOptions().withCacheOnlyRequestsSupport(false)) {}
 
 TestRunner::Impl::~Impl() {}
@@ -700,7 +712,8 @@ void TestRunner::run(TestMetadata& metadata) {
 
     std::string key = mbgl::util::toString(uint32_t(metadata.mapMode)) + "/" +
                       mbgl::util::toString(metadata.pixelRatio) + "/" +
-                      mbgl::util::toString(uint32_t(metadata.crossSourceCollisions));
+                      mbgl::util::toString(uint32_t(metadata.crossSourceCollisions)) + "/" +
+                      mbgl::util::toString(uint32_t(metadata.parallelTileLayout));
 
     if (maps.find(key) == maps.end()) {
         maps[key] = std::make_unique<TestRunner::Impl>(metadata);
@@ -6,10 +6,11 @@
 
 namespace mbgl {
 
-Mailbox::Mailbox() = default;
+Mailbox::Mailbox() : priority(TaskPriority::Normal) {
+}
 
 Mailbox::Mailbox(Scheduler& scheduler_)
-    : scheduler(&scheduler_) {
+    : scheduler(&scheduler_), priority(TaskPriority::Normal) {
 }
 
 void Mailbox::open(Scheduler& scheduler_) {
@@ -27,7 +28,7 @@ void Mailbox::open(Scheduler& scheduler_) {
     }
     
     if (!queue.empty()) {
-        (*scheduler)->schedule(makeClosure(shared_from_this()));
+        schedule();
     }
 }
 
@@ -45,6 +46,14 @@ void Mailbox::close() {
 
 bool Mailbox::isOpen() const { return bool(scheduler); }
 
+void Mailbox::setPriority(TaskPriority priority_) {
+    priority = priority_;
+}
+
+void Mailbox::schedule() {
+    (*scheduler)->scheduleWithPriority(priority, makeClosure(shared_from_this()));
+}
+
 
 void Mailbox::push(std::unique_ptr<Message> message) {
     std::lock_guard<std::mutex> pushingLock(pushingMutex);
@@ -57,7 +66,7 @@ void Mailbox::push(std::unique_ptr<Message> message) {
     bool wasEmpty = queue.empty();
     queue.push(std::move(message));
     if (wasEmpty && scheduler) {
-        (*scheduler)->schedule(makeClosure(shared_from_this()));
+        schedule();
     }
 }
 
@@ -84,7 +93,7 @@ void Mailbox::receive() {
     (*message)();
 
     if (!wasEmpty) {
-        (*scheduler)->schedule(makeClosure(shared_from_this()));
+        schedule();
     }
 }
 
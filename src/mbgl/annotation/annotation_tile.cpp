@@ -27,13 +27,13 @@ public:
         : id(id_),
           type(type_),
           geometries(std::move(geometries_)),
-          properties(std::move(properties_)) {
+          properties(properties_.begin(), properties_.end()) {
     }
 
     AnnotationID id;
     FeatureType type;
     GeometryCollection geometries;
-    std::unordered_map<std::string, std::string> properties;
+    PropertyMap properties;
 };
 
 AnnotationTileFeature::AnnotationTileFeature(std::shared_ptr<const AnnotationTileFeatureData> data_)
@@ -47,11 +47,13 @@ FeatureType AnnotationTileFeature::getType() const {
 }
 
 optional<Value> AnnotationTileFeature::getValue(const std::string& key) const {
+    const Value* value = findValue(key);
+    return value ? optional<Value>(*value) : optional<Value>();
+}
+
+const Value* AnnotationTileFeature::findValue(const std::string& key) const {
     auto it = data->properties.find(key);
-    if (it != data->properties.end()) {
-        return optional<Value>(it->second);
-    }
-    return optional<Value>();
+    return it != data->properties.end() ? &it->second : nullptr;
 }
 
 FeatureIdentifier AnnotationTileFeature::getID() const {
@@ -27,6 +27,7 @@ public:
 
     FeatureType getType() const override;
     optional<Value> getValue(const std::string&) const override;
+    const Value* findValue(const std::string&) const override;
     FeatureIdentifier getID() const override;
     const GeometryCollection& getGeometries() const override;
 
@@ -7,6 +7,7 @@
 #include <mbgl/style/filter.hpp>
 #include <mbgl/text/collision_index.hpp>
 #include <mbgl/tile/tile_id.hpp>
+#include <mbgl/util/binary_stream.hpp>
 #include <mbgl/util/constants.hpp>
 #include <mbgl/util/math.hpp>
 
@@ -39,6 +40,65 @@ void FeatureIndex::insert(const GeometryCollection& geometries,
     }
 }
 
+void FeatureIndex::append(const FeatureIndex& other) {
+    const auto sortIndexOffset = sortIndex;
+    other.grid.forEachBox([&](const IndexedSubfeature& feature, const GridIndex<IndexedSubfeature>::BBox& bbox) {
+        IndexedSubfeature appended(feature);
+        appended.sortIndex += sortIndexOffset;
+        grid.insert(std::move(appended), bbox);
+    });
+    sortIndex += other.sortIndex;
+
+    for (const auto& entry : other.bucketLayerIDs) {
+        bucketLayerIDs[entry.first] = entry.second;
+    }
+}
+
+namespace {
+
+struct SerializedSubfeature {
+    uint64_t index;
+    uint64_t sortIndex;
+    float minX, minY, maxX, maxY;
+};
+
+} // namespace
+
+void FeatureIndex::serialize(util::BinaryWriter& writer, const std::string& bucketLeaderID) const {
+    std::vector<SerializedSubfeature> features;
+    uint64_t firstSortIndex = std::numeric_limits<uint64_t>::max();
+    grid.forEachBox([&](const IndexedSubfeature& feature, const GridIndex<IndexedSubfeature>::BBox& bbox) {
+        if (feature.bucketLeaderID == bucketLeaderID) {
+            features.push_back({feature.index, feature.sortIndex, bbox.min.x, bbox.min.y, bbox.max.x, bbox.max.y});
+            firstSortIndex = std::min<uint64_t>(firstSortIndex, feature.sortIndex);
+        }
+    });
+
+    // Sort indices are stored relative to the first feature of the bucket.
+    for (auto& feature : features) {
+        feature.sortIndex -= firstSortIndex;
+    }
+    writer.write(features);
+}
+
+bool FeatureIndex::deserialize(util::BinaryReader& reader,
+                               const std::string& sourceLayerName,
+                               const std::string& bucketLeaderID) {
+    std::vector<SerializedSubfeature> features;
+    if (!reader.read(features)) {
+        return false;
+    }
+
+    uint64_t sortIndexCount = 0;
+    for (const auto& feature : features) {
+        grid.insert(IndexedSubfeature(feature.index, sourceLayerName, bucketLeaderID, sortIndex + feature.sortIndex),
+                    {{feature.minX, feature.minY}, {feature.maxX, feature.maxY}});
+        sortIndexCount = std::max(sortIndexCount, feature.sortIndex + 1);
+    }
+    sortIndex += static_cast<unsigned int>(sortIndexCount);
+    return true;
+}
+
 void FeatureIndex::query(std::unordered_map<std::string, std::vector<Feature>>& result,
                          const GeometryCoordinates& queryGeometry, const TransformState& transformState,
                          const mat4& posMatrix, const double tileSize, const double scale,
@@ -55,21 +115,26 @@ void FeatureIndex::query(std::unordered_map<std::string, std::vector<Feature>>&
 
     // Query the grid index
     mapbox::geometry::box<int16_t> box = mapbox::geometry::envelope(queryGeometry);
-    std::vector<IndexedSubfeature> features = grid.query({ convertPoint<float>(box.min - additionalPadding),
-                                                           convertPoint<float>(box.max + additionalPadding) });
-
+    // Collect pointers to the indexed features so that their strings aren't copied.
+    std::vector<const IndexedSubfeature*> features;
+    grid.query(GridIndex<IndexedSubfeature>::BBox{ convertPoint<float>(box.min - additionalPadding),
+                                                   convertPoint<float>(box.max + additionalPadding) },
+               [&](const IndexedSubfeature& feature, const GridIndex<IndexedSubfeature>::BBox&) {
+                   features.push_back(&feature);
+                   return false;
+               });
 
-    std::sort(features.begin(), features.end(), [](const IndexedSubfeature& a, const IndexedSubfeature& b) {
-        return a.sortIndex > b.sortIndex;
+    std::sort(features.begin(), features.end(), [](const IndexedSubfeature* a, const IndexedSubfeature* b) {
+        return a->sortIndex > b->sortIndex;
     });
     size_t previousSortIndex = std::numeric_limits<size_t>::max();
-    for (const auto& indexedFeature : features) {
+    for (const auto* indexedFeature : features) {
 
         // If this feature is the same as the previous feature, skip it.
-        if (indexedFeature.sortIndex == previousSortIndex) continue;
-        previousSortIndex = indexedFeature.sortIndex;
+        if (indexedFeature->sortIndex == previousSortIndex) continue;
+        previousSortIndex = indexedFeature->sortIndex;
 
-        addFeature(result, indexedFeature, queryOptions, tileID.canonical, layers, queryGeometry, transformState,
+        addFeature(result, *indexedFeature, queryOptions, tileID.canonical, layers, queryGeometry, transformState,
                    pixelsToTileUnits, posMatrix, &sourceFeatureState);
     }
 }
@@ -190,6 +255,10 @@ optional<GeometryCoordinates> FeatureIndex::translateQueryGeometry(
     return translated;
 }
 
+std::size_t FeatureIndex::getMemoryUsage() const {
+    return grid.getMemoryUsage() + (tileData ? tileData->getMemoryUsage() : 0);
+}
+
 void FeatureIndex::setBucketLayerIDs(const std::string& bucketLeaderID, const std::vector<std::string>& layerIDs) {
     bucketLayerIDs[bucketLeaderID] = layerIDs;
 }
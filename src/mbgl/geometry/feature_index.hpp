@@ -20,6 +20,11 @@ class SourceFeatureState;
 
 class CollisionIndex;
 
+namespace util {
+class BinaryWriter;
+class BinaryReader;
+} // namespace util
+
 class IndexedSubfeature {
 public:
     IndexedSubfeature() = delete;
@@ -76,6 +81,19 @@ public:
 
     void setBucketLayerIDs(const std::string& bucketLeaderID, const std::vector<std::string>& layerIDs);
 
+    // Adds the features and bucket layer IDs of the given index, as if they had been
+    // inserted into this index after its existing features.
+    void append(const FeatureIndex&);
+
+    // Writes the features inserted for the given bucket to the bucket cache.
+    void serialize(util::BinaryWriter&, const std::string& bucketLeaderID) const;
+    // Inserts features written by `serialize()` for the given bucket, as if they had been inserted
+    // after the existing features. Returns false if the data is malformed.
+    bool deserialize(util::BinaryReader&, const std::string& sourceLayerName, const std::string& bucketLeaderID);
+
+    // Approximate number of bytes held by the index and the tile data it refers to.
+    std::size_t getMemoryUsage() const;
+
     std::unordered_map<std::string, std::vector<Feature>> lookupSymbolFeatures(
         const std::vector<IndexedSubfeature>& symbolFeatures,
         const RenderedQueryOptions& options,
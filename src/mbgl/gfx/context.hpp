@@ -6,8 +6,10 @@
 #include <mbgl/gfx/program.hpp>
 #include <mbgl/gfx/renderbuffer.hpp>
 #include <mbgl/gfx/rendering_stats.hpp>
+#include <mbgl/gfx/scissor_rect.hpp>
 #include <mbgl/gfx/texture.hpp>
 #include <mbgl/gfx/types.hpp>
+#include <mbgl/util/optional.hpp>
 
 namespace mbgl {
 
@@ -95,6 +97,9 @@ public:
 #endif
 
     virtual void clearStencilBuffer(int32_t) = 0;
+
+    // Limits all following draw calls to the rectangle, or lifts that limit again.
+    virtual void setScissorRect(const optional<ScissorRect>&) = 0;
 };
 
 } // namespace gfx
@@ -43,6 +43,11 @@ public:
         return v;
     }
 
+    // Replaces the elements, e.g. with ones restored from the bucket cache.
+    void assign(std::vector<uint16_t> elements) {
+        v = std::move(elements);
+    }
+
 private:
     std::vector<uint16_t> v;
 };
@@ -49,6 +49,9 @@ public:
                       const IndexBuffer&,
                       std::size_t indexOffset,
                       std::size_t indexLength) = 0;
+
+    // Prepares the permutations of the program that are expected to be drawn.
+    virtual void warmUp(Context&) = 0;
 };
 
 } // namespace gfx
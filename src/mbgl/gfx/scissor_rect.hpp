@@ -0,0 +1,27 @@
+#pragma once
+
+#include <mbgl/util/size.hpp>
+
+#include <cstdint>
+
+namespace mbgl {
+namespace gfx {
+
+// A rectangle in framebuffer pixels, with the origin in the lower left corner.
+class ScissorRect {
+public:
+    int32_t x;
+    int32_t y;
+    Size size;
+};
+
+constexpr bool operator!=(const ScissorRect& a, const ScissorRect& b) {
+    return a.x != b.x || a.y != b.y || a.size != b.size;
+}
+
+constexpr bool operator==(const ScissorRect& a, const ScissorRect& b) {
+    return !(a != b);
+}
+
+} // namespace gfx
+} // namespace mbgl
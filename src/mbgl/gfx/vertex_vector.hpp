@@ -49,6 +49,11 @@ public:
         return v;
     }
 
+    // Replaces the elements, e.g. with ones restored from the bucket cache.
+    void assign(std::vector<Vertex> elements) {
+        v = std::move(elements);
+    }
+
 private:
     std::vector<Vertex> v;
 };
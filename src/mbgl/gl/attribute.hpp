@@ -102,8 +102,14 @@ public:
     }
 
     static std::string defines(const gfx::AttributeBindings<TypeList<As...>>& bindings) {
+        return defines(compute(bindings));
+    }
+
+    // Returns the defines of the permutation with the given key, which has every attribute that
+    // isn't part of the key bound as a uniform.
+    static std::string defines(const uint32_t key) {
         std::string result;
-        util::ignore({ (!bindings.template get<As>()
+        util::ignore({ (!(key & (1 << TypeIndex<As, As...>::value))
                             ? (void)(result += concat_literals<&attributeDefinePrefix, &As::name, &string_literal<'\n'>::value>::value())
                             : (void)0,
                         0)... });
@@ -0,0 +1,118 @@
+#include <mbgl/gl/binary_program.hpp>
+#include <mbgl/util/binary_stream.hpp>
+#include <mbgl/util/io.hpp>
+#include <mbgl/util/logging.hpp>
+#include <mbgl/util/string.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <random>
+
+namespace mbgl {
+namespace gl {
+
+namespace {
+
+// Identifies the file format. Bump the version whenever the layout of the file changes.
+constexpr uint64_t kMagic = 0x4d42474c50524731; // "MBGLPRG1"
+constexpr uint32_t kVersion = 1;
+
+} // namespace
+
+BinaryProgramFile::BinaryProgramFile(std::string path_) : path(std::move(path_)), entries(read()) {
+}
+
+std::vector<BinaryProgramFile::Entry> BinaryProgramFile::read() const {
+    optional<std::string> data = util::readFile(path);
+    if (!data) {
+        return {};
+    }
+
+    util::BinaryReader reader(*data);
+    uint64_t magic, count;
+    uint32_t version;
+    if (!reader.read(magic) || magic != kMagic || !reader.read(version) || version != kVersion ||
+        !reader.read(count)) {
+        return {};
+    }
+
+    std::vector<Entry> entries;
+    for (uint64_t i = 0; i < count; ++i) {
+        Entry entry;
+        if (!reader.read(entry.key) || !reader.read(entry.identifier) || !reader.read(entry.program.format) ||
+            !reader.read(entry.program.code)) {
+            Log::Warning(Event::OpenGL, "Program cache file %s is truncated", path.c_str());
+            return {};
+        }
+        entries.push_back(std::move(entry));
+    }
+    return entries;
+}
+
+std::vector<uint32_t> BinaryProgramFile::keys() const {
+    std::vector<uint32_t> result;
+    for (const auto& entry : entries) {
+        result.push_back(entry.key);
+    }
+    return result;
+}
+
+const BinaryProgram* BinaryProgramFile::load(const uint32_t key, const std::string& identifier) const {
+    for (const auto& entry : entries) {
+        if (entry.key == key && entry.identifier == identifier) {
+            return &entry.program;
+        }
+    }
+    return nullptr;
+}
+
+void BinaryProgramFile::store(const uint32_t key, const std::string& identifier, BinaryProgram program) {
+    entries.erase(std::remove_if(entries.begin(), entries.end(), [&](const Entry& entry) { return entry.key == key; }),
+                  entries.end());
+    entries.push_back({ key, identifier, std::move(program) });
+    modified = true;
+}
+
+void BinaryProgramFile::save() {
+    if (!modified) {
+        return;
+    }
+    modified = false;
+
+    // Keep the permutations that other writers added since the file was read.
+    for (auto& entry : read()) {
+        if (std::none_of(entries.begin(), entries.end(), [&](const Entry& own) { return own.key == entry.key; })) {
+            entries.push_back(std::move(entry));
+        }
+    }
+
+    util::BinaryWriter writer;
+    writer.write(kMagic);
+    writer.write(kVersion);
+    writer.write<uint64_t>(entries.size());
+    for (const auto& entry : entries) {
+        writer.write(entry.key);
+        writer.write(entry.identifier);
+        writer.write(entry.program.format);
+        writer.write(entry.program.code);
+    }
+
+    // Write to a file of our own first, so that readers never see a partially written file. The
+    // name is unique within the process, and random across the processes sharing the directory.
+    static const uint32_t processID = std::random_device()();
+    static std::atomic<uint64_t> nextTemporaryFile{0};
+    const std::string temporaryPath =
+        path + "." + util::toString(processID) + "-" + util::toString(uint64_t(nextTemporaryFile++)) + ".tmp";
+    try {
+        util::write_file(temporaryPath, writer.getData());
+        if (std::rename(temporaryPath.c_str(), path.c_str()) != 0) {
+            util::deleteFile(temporaryPath);
+        }
+    } catch (const std::exception& e) {
+        Log::Warning(Event::OpenGL, "Failed to write program cache file %s: %s", path.c_str(), e.what());
+    }
+}
+
+} // namespace gl
+} // namespace mbgl
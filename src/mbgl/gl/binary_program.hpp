@@ -0,0 +1,63 @@
+#pragma once
+
+#include <mbgl/gl/types.hpp>
+#include <mbgl/util/optional.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace mbgl {
+namespace gl {
+
+// A linked program as returned by glGetProgramBinary. Only the driver that produced it can load it.
+class BinaryProgram {
+public:
+    BinaryProgramFormat format;
+    std::string code;
+};
+
+// A file that stores the binaries of the permutations of a program, keyed by the attribute key of
+// each permutation. Every binary is stored along with an identifier of the sources, the defines
+// and the driver it was built from, and is only loaded for the same identifier.
+//
+// The file is read once when this object is created. Stored binaries are kept in memory until
+// `save()` writes them all at once. The file is replaced atomically, so that readers never see a
+// partially written file. Before replacing it, `save()` reads the file again and keeps the
+// permutations that other writers added in the meantime. Two writers that save at the same time
+// may still lose each other's permutations; these are then compiled and stored again in a later
+// run.
+class BinaryProgramFile {
+public:
+    explicit BinaryProgramFile(std::string path);
+
+    // Returns the keys of all permutations, in the order they were stored.
+    std::vector<uint32_t> keys() const;
+
+    // Returns the binary of the permutation, or `nullptr` if there is none for the identifier. The
+    // binary stays valid until the next call to `store()`.
+    const BinaryProgram* load(uint32_t key, const std::string& identifier) const;
+
+    // Adds the permutation, replacing a previous binary with the same key. It is written to the
+    // file by the next call to `save()`.
+    void store(uint32_t key, const std::string& identifier, BinaryProgram);
+
+    // Writes the file if permutations were stored since it was read or last written.
+    void save();
+
+private:
+    struct Entry {
+        uint32_t key;
+        std::string identifier;
+        BinaryProgram program;
+    };
+
+    std::vector<Entry> read() const;
+
+    const std::string path;
+    std::vector<Entry> entries;
+    bool modified = false;
+};
+
+} // namespace gl
+} // namespace mbgl
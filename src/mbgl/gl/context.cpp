@@ -9,6 +9,7 @@
 #include <mbgl/gl/command_encoder.hpp>
 #include <mbgl/gl/debugging_extension.hpp>
 #include <mbgl/gl/vertex_array_extension.hpp>
+#include <mbgl/gl/program_binary_extension.hpp>
 #include <mbgl/util/traits.hpp>
 #include <mbgl/util/std.hpp>
 #include <mbgl/util/logging.hpp>
@@ -30,6 +31,7 @@ static_assert(std::is_same<TextureID, GLuint>::value, "OpenGL type mismatch");
 static_assert(std::is_same<VertexArrayID, GLuint>::value, "OpenGL type mismatch");
 static_assert(std::is_same<FramebufferID, GLuint>::value, "OpenGL type mismatch");
 static_assert(std::is_same<RenderbufferID, GLuint>::value, "OpenGL type mismatch");
+static_assert(std::is_same<BinaryProgramFormat, GLenum>::value, "OpenGL type mismatch");
 
 static_assert(underlying_type(UniformDataType::Float) == GL_FLOAT, "OpenGL type mismatch");
 static_assert(underlying_type(UniformDataType::FloatVec2) == GL_FLOAT_VEC2, "OpenGL type mismatch");
@@ -122,6 +124,22 @@ void Context::initializeExtensions(const std::function<gl::ProcAddress(const cha
         if (!supportsVertexArrays()) {
             Log::Warning(Event::OpenGL, "Not using Vertex Array Objects");
         }
+
+        // Some drivers expose the extension without supporting any binary format.
+        auto programBinaryExtension = std::make_unique<extension::ProgramBinary>(fn);
+        if (programBinaryExtension->getProgramBinary && programBinaryExtension->programBinary) {
+            GLint binaryFormats = 0;
+            MBGL_CHECK_ERROR(glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &binaryFormats));
+            if (binaryFormats > 0) {
+                programBinary = std::move(programBinaryExtension);
+            }
+        }
+
+        const auto driverString = [](GLenum name) -> std::string {
+            const auto* value = reinterpret_cast<const char*>(MBGL_CHECK_ERROR(glGetString(name)));
+            return value ? value : "";
+        };
+        driverIdentifier = driverString(GL_VENDOR) + "\n" + renderer + "\n" + driverString(GL_VERSION);
     }
 }
 
@@ -181,6 +199,40 @@ UniqueProgram Context::createProgram(ShaderID vertexShader, ShaderID fragmentSha
     return result;
 }
 
+UniqueProgram Context::createProgram(const BinaryProgram& binaryProgram) {
+    assert(supportsProgramBinaries());
+    UniqueProgram result { MBGL_CHECK_ERROR(glCreateProgram()), { this } };
+
+    MBGL_CHECK_ERROR(programBinary->programBinary(result, static_cast<GLenum>(binaryProgram.format),
+                                                  binaryProgram.code.data(),
+                                                  static_cast<GLint>(binaryProgram.code.size())));
+    verifyProgramLinkage(result);
+
+    return result;
+}
+
+bool Context::supportsProgramBinaries() const {
+    return programBinary != nullptr;
+}
+
+optional<BinaryProgram> Context::getBinaryProgram(ProgramID program_) const {
+    if (!supportsProgramBinaries()) {
+        return {};
+    }
+
+    GLint binaryLength = 0;
+    MBGL_CHECK_ERROR(glGetProgramiv(program_, GL_PROGRAM_BINARY_LENGTH, &binaryLength));
+    if (binaryLength <= 0) {
+        return {};
+    }
+
+    std::string binary(binaryLength, '\0');
+    GLenum binaryFormat = 0;
+    MBGL_CHECK_ERROR(programBinary->getProgramBinary(program_, binaryLength, &binaryLength, &binaryFormat, &binary[0]));
+    binary.resize(binaryLength);
+    return BinaryProgram{ binaryFormat, std::move(binary) };
+}
+
 void Context::linkProgram(ProgramID program_) {
     MBGL_CHECK_ERROR(glLinkProgram(program_));
     verifyProgramLinkage(program_);
@@ -461,6 +513,7 @@ void Context::reset() {
 void Context::setDirtyState() {
     // Note: does not set viewport/scissorTest/bindFramebuffer to dirty
     // since they are handled separately in the view object.
+    scissor.setDirty();
     stencilFunc.setDirty();
     stencilMask.setDirty();
     stencilTest.setDirty();
@@ -783,5 +836,14 @@ void Context::clearStencilBuffer(const int32_t bits) {
     MBGL_CHECK_ERROR(glClear(GL_STENCIL_BUFFER_BIT));
 }
 
+void Context::setScissorRect(const optional<gfx::ScissorRect>& rect) {
+    if (rect) {
+        scissor = *rect;
+        scissorTest = true;
+    } else {
+        scissorTest = false;
+    }
+}
+
 } // namespace gl
 } // namespace mbgl
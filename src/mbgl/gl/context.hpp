@@ -1,6 +1,7 @@
 #pragma once
 
 #include <mbgl/gfx/context.hpp>
+#include <mbgl/gl/binary_program.hpp>
 #include <mbgl/gl/object.hpp>
 #include <mbgl/gl/state.hpp>
 #include <mbgl/gl/value.hpp>
@@ -32,6 +33,7 @@ class RendererBackend;
 namespace extension {
 class VertexArray;
 class Debugging;
+class ProgramBinary;
 } // namespace extension
 
 class Context final : public gfx::Context {
@@ -52,6 +54,13 @@ public:
 
     UniqueShader createShader(ShaderType type, const std::initializer_list<const char*>& sources);
     UniqueProgram createProgram(ShaderID vertexShader, ShaderID fragmentShader, const char* location0AttribName);
+    UniqueProgram createProgram(const BinaryProgram&);
+    bool supportsProgramBinaries() const;
+    optional<BinaryProgram> getBinaryProgram(ProgramID) const;
+    // Identifies the driver, since only the driver that built a program binary can load it.
+    const std::string& getDriverIdentifier() const {
+        return driverIdentifier;
+    }
     void verifyProgramLinkage(ProgramID);
     void linkProgram(ProgramID);
     UniqueTexture createUniqueTexture();
@@ -138,12 +147,15 @@ private:
     gfx::RenderingStats stats;
     std::unique_ptr<extension::Debugging> debugging;
     std::unique_ptr<extension::VertexArray> vertexArray;
+    std::unique_ptr<extension::ProgramBinary> programBinary;
+    std::string driverIdentifier;
 
 public:
     State<value::ActiveTextureUnit> activeTextureUnit;
     State<value::BindFramebuffer> bindFramebuffer;
     State<value::Viewport> viewport;
     State<value::ScissorTest> scissorTest;
+    State<value::Scissor> scissor;
     std::array<State<value::BindTexture>, 2> texture;
     State<value::Program> program;
     State<value::BindVertexBuffer> vertexBuffer;
@@ -235,6 +247,7 @@ public:
 #endif
 
     void clearStencilBuffer(int32_t) override;
+    void setScissorRect(const optional<gfx::ScissorRect>&) override;
 };
 
 } // namespace gl
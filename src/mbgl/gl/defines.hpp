@@ -105,6 +105,7 @@
 #define GL_NEVER 0x0200
 #define GL_NO_ERROR 0
 #define GL_NOTEQUAL 0x0205
+#define GL_NUM_PROGRAM_BINARY_FORMATS 0x87FE
 #define GL_ONE 1
 #define GL_ONE_MINUS_CONSTANT_ALPHA 0x8004
 #define GL_ONE_MINUS_CONSTANT_COLOR 0x8002
@@ -115,6 +116,7 @@
 #define GL_OUT_OF_MEMORY 0x0505
 #define GL_PACK_ALIGNMENT 0x0D05
 #define GL_POINTS 0x0000
+#define GL_PROGRAM_BINARY_LENGTH 0x8741
 #define GL_RENDERBUFFER 0x8D41
 #define GL_RENDERBUFFER_BINDING 0x8CA7
 #define GL_RENDERER 0x1F01
@@ -124,6 +126,7 @@
 #define GL_RGBA8_OES 0x8058
 #define GL_SAMPLER_2D 0x8B5E
 #define GL_SAMPLER_CUBE 0x8B60
+#define GL_SCISSOR_BOX 0x0C10
 #define GL_SCISSOR_TEST 0x0C11
 #define GL_SHORT 0x1402
 #define GL_SRC_ALPHA 0x0302
@@ -158,6 +161,8 @@
 #define GL_UNSIGNED_BYTE 0x1401
 #define GL_UNSIGNED_INT 0x1405
 #define GL_UNSIGNED_SHORT 0x1403
+#define GL_VENDOR 0x1F00
+#define GL_VERSION 0x1F02
 #define GL_VERTEX_SHADER 0x8B31
 #define GL_VIEWPORT 0x0BA2
 #define GL_ZERO 0
@@ -12,13 +12,16 @@
 #include <mbgl/gl/attribute.hpp>
 #include <mbgl/gl/uniform.hpp>
 #include <mbgl/gl/texture.hpp>
+#include <mbgl/gl/binary_program.hpp>
 #include <mbgl/util/io.hpp>
 
 #include <mbgl/util/logging.hpp>
 #include <mbgl/programs/program_parameters.hpp>
 #include <mbgl/programs/gl/shader_source.hpp>
 #include <mbgl/programs/gl/shaders.hpp>
+#include <mbgl/programs/gl/preludes.hpp>
 
+#include <stdexcept>
 #include <string>
 
 namespace mbgl {
@@ -35,6 +38,12 @@ public:
         : programParameters(std::move(programParameters_)) {
     }
 
+    ~Program() override {
+        if (programFile) {
+            programFile->save();
+        }
+    }
+
     const ProgramParameters programParameters;
 
     static constexpr const auto vertexOffset = programs::gl::ShaderSource<Name>::vertexOffset;
@@ -55,10 +64,38 @@ public:
             textureStates.queryLocations(program);
         }
 
+        Instance(Context& context, const BinaryProgram& binaryProgram)
+            : program(context.createProgram(binaryProgram)) {
+            attributeLocations.queryLocations(program);
+            uniformStates.queryLocations(program);
+            textureStates.queryLocations(program);
+        }
+
         static std::unique_ptr<Instance>
         createInstance(gl::Context& context,
                        const ProgramParameters& programParameters,
-                       const std::string& additionalDefines) {
+                       BinaryProgramFile* programFile,
+                       const uint32_t key) {
+            const std::string additionalDefines = gl::AttributeKey<AttributeList>::defines(key);
+
+            // Load the program binary that an earlier run cached for the same driver, if any.
+            std::string identifier;
+            if (programFile) {
+                identifier = programs::gl::programIdentifier(programParameters.getDefines(),
+                                                             additionalDefines,
+                                                             programs::gl::preludeHash,
+                                                             programs::gl::ShaderSource<Name>::hash) +
+                             context.getDriverIdentifier();
+                if (const BinaryProgram* binaryProgram = programFile->load(key, identifier)) {
+                    try {
+                        return std::make_unique<Instance>(context, *binaryProgram);
+                    } catch (const std::runtime_error& error) {
+                        Log::Warning(Event::OpenGL, "Could not load cached program %s: %s",
+                                     programs::gl::ShaderSource<Name>::name, error.what());
+                    }
+                }
+            }
+
             // Compile the shader
             const std::initializer_list<const char*> vertexSource = {
                 programParameters.getDefines().c_str(),
@@ -74,6 +111,12 @@ public:
             };
             auto result = std::make_unique<Instance>(context, vertexSource, fragmentSource);
 
+            if (programFile) {
+                if (auto binaryProgram = context.getBinaryProgram(result->program)) {
+                    programFile->store(key, identifier, std::move(*binaryProgram));
+                }
+            }
+
             return std::move(result);
         }
 
@@ -107,13 +150,8 @@ public:
         const uint32_t key = gl::AttributeKey<AttributeList>::compute(attributeBindings);
         auto it = instances.find(key);
         if (it == instances.end()) {
-            it = instances
-                     .emplace(key,
-                              Instance::createInstance(
-                                  context,
-                                  programParameters,
-                                  gl::AttributeKey<AttributeList>::defines(attributeBindings)))
-                     .first;
+            auto instance = Instance::createInstance(context, programParameters, getProgramFile(context), key);
+            it = instances.emplace(key, std::move(instance)).first;
         }
 
         auto& instance = *it->second;
@@ -133,8 +171,41 @@ public:
                      indexLength);
     }
 
+    // Creates the permutations that the program cache recorded in earlier runs, so that they don't
+    // need to be compiled or loaded in the middle of rendering a frame.
+    void warmUp(gfx::Context& genericContext) override {
+        auto& context = static_cast<gl::Context&>(genericContext);
+        BinaryProgramFile* file = getProgramFile(context);
+        if (!file) {
+            return;
+        }
+        for (const uint32_t key : file->keys()) {
+            if (instances.find(key) == instances.end()) {
+                instances.emplace(key, Instance::createInstance(context, programParameters, file, key));
+            }
+        }
+        // Permutations whose binaries were outdated have been compiled again.
+        file->save();
+    }
+
 private:
+    // Returns the cache of the permutations of this program, or `nullptr` if program binaries
+    // aren't cached. The file is read on first use, and written by `warmUp()` and on destruction.
+    BinaryProgramFile* getProgramFile(Context& context) {
+        if (!programFileResolved) {
+            programFileResolved = true;
+            if (context.supportsProgramBinaries()) {
+                if (auto cachePath = programParameters.cachePath(programs::gl::ShaderSource<Name>::name)) {
+                    programFile.emplace(std::move(*cachePath));
+                }
+            }
+        }
+        return programFile ? &*programFile : nullptr;
+    }
+
     std::map<uint32_t, std::unique_ptr<Instance>> instances;
+    bool programFileResolved = false;
+    optional<BinaryProgramFile> programFile;
 };
 
 } // namespace gl
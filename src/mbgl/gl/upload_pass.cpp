@@ -96,6 +96,10 @@ void UploadPass::updateTextureResource(gfx::TextureResource& resource,
                                   size.width, size.height, 0,
                                   Enum<gfx::TexturePixelType>::to(format),
                                   Enum<gfx::TextureChannelDataType>::to(type), data));
+    if (data) {
+        commandEncoder.context.renderingStats().memTextureUploads +=
+            gl::TextureResource::getStorageSize(size, format, type);
+    }
 }
 
 void UploadPass::updateTextureResourceSub(gfx::TextureResource& resource,
@@ -111,6 +115,8 @@ void UploadPass::updateTextureResourceSub(gfx::TextureResource& resource,
     MBGL_CHECK_ERROR(glTexSubImage2D(GL_TEXTURE_2D, 0, xOffset, yOffset, size.width, size.height,
                                      Enum<gfx::TexturePixelType>::to(format),
                                      Enum<gfx::TextureChannelDataType>::to(type), data));
+    commandEncoder.context.renderingStats().memTextureUploads +=
+        gl::TextureResource::getStorageSize(size, format, type);
 }
 
 void UploadPass::pushDebugGroup(const char* name) {
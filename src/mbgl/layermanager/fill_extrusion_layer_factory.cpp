@@ -24,6 +24,11 @@ std::unique_ptr<style::Layer> FillExtrusionLayerFactory::createLayer(const std::
     return layer;
 }
 
+std::unique_ptr<Bucket> FillExtrusionLayerFactory::createBucket(const BucketParameters& parameters, const std::vector<Immutable<style::LayerProperties>>& layers) noexcept {
+    using namespace style;
+    return PatternLayout<FillExtrusionBucket, FillExtrusionLayerProperties, FillExtrusionPattern>::createEmptyBucket(parameters, layers);
+}
+
 std::unique_ptr<Layout> FillExtrusionLayerFactory::createLayout(const LayoutParameters& parameters,
                                                                 std::unique_ptr<GeometryTileLayer> layer,
                                                                 const std::vector<Immutable<style::LayerProperties>>& group) noexcept {
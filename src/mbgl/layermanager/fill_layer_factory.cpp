@@ -24,6 +24,11 @@ std::unique_ptr<style::Layer> FillLayerFactory::createLayer(const std::string& i
     return layer;
 }
 
+std::unique_ptr<Bucket> FillLayerFactory::createBucket(const BucketParameters& parameters, const std::vector<Immutable<style::LayerProperties>>& layers) noexcept {
+    using namespace style;
+    return PatternLayout<FillBucket, FillLayerProperties, FillPattern, FillLayoutProperties>::createEmptyBucket(parameters, layers);
+}
+
 std::unique_ptr<Layout>
 FillLayerFactory::createLayout(const LayoutParameters& parameters,
                                std::unique_ptr<GeometryTileLayer> layer,
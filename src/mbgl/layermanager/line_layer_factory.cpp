@@ -24,6 +24,11 @@ std::unique_ptr<style::Layer> LineLayerFactory::createLayer(const std::string& i
     return layer;
 }
 
+std::unique_ptr<Bucket> LineLayerFactory::createBucket(const BucketParameters& parameters, const std::vector<Immutable<style::LayerProperties>>& layers) noexcept {
+    using namespace style;
+    return PatternLayout<LineBucket, LineLayerProperties, LinePattern, LineLayoutProperties>::createEmptyBucket(parameters, layers);
+}
+
 std::unique_ptr<Layout> LineLayerFactory::createLayout(const LayoutParameters& parameters,
                                                        std::unique_ptr<GeometryTileLayer> layer,
                                                        const std::vector<Immutable<style::LayerProperties>>& group) noexcept {
@@ -12,6 +12,7 @@ class BucketParameters;
 class RenderLayer;
 class FeatureIndex;
 class LayerRenderData;
+class ShapingCache;
 
 class Layout {
 public:
@@ -38,6 +39,8 @@ public:
     GlyphDependencies& glyphDependencies;
     ImageDependencies& imageDependencies;
     std::set<std::string>& availableImages;
+    // Shared by all tiles of the renderer.
+    const std::shared_ptr<ShapingCache>& shapingCache;
 };
 
 } // namespace mbgl
@@ -152,8 +152,37 @@ public:
         return hasPattern;
     }
 
+    // Creates an empty bucket like the one created by the layout of the group, e.g. to restore
+    // its contents from the bucket cache.
+    static std::unique_ptr<Bucket> createEmptyBucket(const BucketParameters& parameters,
+                                                     const std::vector<Immutable<style::LayerProperties>>& group) {
+        assert(!group.empty());
+        const float bucketZoom = parameters.tileID.overscaledZ;
+        auto leaderLayerProperties = staticImmutableCast<LayerPropertiesType>(group.front());
+        std::map<std::string, Immutable<style::LayerProperties>> propertiesMap;
+        for (const auto& layerProperties : group) {
+            propertiesMap.emplace(layerProperties->baseImpl->id, layerProperties);
+        }
+        return std::make_unique<BucketType>(
+            leaderLayerProperties->layerImpl().layout.evaluate(PropertyEvaluationParameters(bucketZoom)),
+            propertiesMap,
+            bucketZoom,
+            parameters.tileID.overscaleFactor());
+    }
+
     void createBucket(const ImagePositions& patternPositions, std::unique_ptr<FeatureIndex>& featureIndex, std::unordered_map<std::string, LayerRenderData>& renderData, const bool, const bool) override {
         auto bucket = std::make_shared<BucketType>(layout, layerPropertiesMap, zoom, overscaling);
+
+        std::vector<const GeometryTileFeature*> featurePointers;
+        std::vector<std::size_t> featureIndices;
+        featurePointers.reserve(features.size());
+        featureIndices.reserve(features.size());
+        for (const auto& patternFeature : features) {
+            featurePointers.push_back(patternFeature.feature.get());
+            featureIndices.push_back(patternFeature.i);
+        }
+        bucket->evaluateFeatures(featurePointers, featureIndices);
+
         for (auto & patternFeature : features) {
             const auto i = patternFeature.i;
             std::unique_ptr<GeometryTileFeature> feature = std::move(patternFeature.feature);
@@ -20,6 +20,7 @@ public:
     FeatureType getType() const override { return feature->getType(); }
     optional<Value> getValue(const std::string& key) const override { return feature->getValue(key); };
     const PropertyMap& getProperties() const override { return feature->getProperties(); };
+    const Value* findValue(const std::string& key) const override { return feature->findValue(key); };
     FeatureIdentifier getID() const override { return feature->getID(); };
     const GeometryCollection& getGeometries() const override { return geometry; };
 
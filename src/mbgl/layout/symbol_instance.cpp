@@ -88,26 +88,27 @@ SymbolInstance::SymbolInstance(Anchor& anchor_,
                                const IndexedSubfeature& indexedFeature,
                                const std::size_t layoutFeatureIndex_,
                                const std::size_t dataFeatureIndex_,
-                               std::u16string key_,
+                               const std::u16string& key_,
                                const float overscaling,
                                const float iconRotation,
                                const float textRotation,
                                const std::array<float, 2>& variableTextOffset_,
                                bool allowVerticalPlacement,
-                               const SymbolContent iconType) :
+                               const SymbolContent iconType,
+                               util::MonotonicBuffer* buffer) :
     sharedData(std::move(sharedData_)),
     anchor(anchor_),
     symbolContent(iconType),
     // Create the collision features that will be used to check whether this symbol instance can be placed
     // As a collision approximation, we can use either the vertical or any of the horizontal versions of the feature
-    textCollisionFeature(sharedData->line, anchor, getAnyShaping(shapedTextOrientations), textBoxScale_, textPadding, textPlacement, indexedFeature, overscaling, textRotation),
-    iconCollisionFeature(sharedData->line, anchor, shapedIcon, iconBoxScale, iconPadding, indexedFeature, iconRotation),
+    textCollisionFeature(sharedData->line, anchor, getAnyShaping(shapedTextOrientations), textBoxScale_, textPadding, textPlacement, indexedFeature, overscaling, textRotation, buffer),
+    iconCollisionFeature(sharedData->line, anchor, shapedIcon, iconBoxScale, iconPadding, indexedFeature, iconRotation, buffer),
     writingModes(WritingModeType::None),
     layoutFeatureIndex(layoutFeatureIndex_),
     dataFeatureIndex(dataFeatureIndex_),
     textOffset(textOffset_),
     iconOffset(iconOffset_),
-    key(std::move(key_)),
+    key(key_.begin(), key_.end(), util::MonotonicAllocator<char16_t>(buffer)),
     textBoxScale(textBoxScale_),
     variableTextOffset(variableTextOffset_),
     singleLine(shapedTextOrientations.singleLine) {
@@ -115,14 +116,15 @@ SymbolInstance::SymbolInstance(Anchor& anchor_,
     if(!sharedData->empty()) symbolContent |= SymbolContent::Text;
     if (allowVerticalPlacement && shapedTextOrientations.vertical) {
         const float verticalPointLabelAngle = 90.0f;
-        verticalTextCollisionFeature = CollisionFeature(line(), anchor, shapedTextOrientations.vertical, textBoxScale_, textPadding, textPlacement, indexedFeature, overscaling, textRotation + verticalPointLabelAngle);
+        verticalTextCollisionFeature = CollisionFeature(line(), anchor, shapedTextOrientations.vertical, textBoxScale_, textPadding, textPlacement, indexedFeature, overscaling, textRotation + verticalPointLabelAngle, buffer);
         if (verticallyShapedIcon) {
             verticalIconCollisionFeature = CollisionFeature(sharedData->line,
                                                             anchor,
                                                             verticallyShapedIcon,
                                                             iconBoxScale, iconPadding,
                                                             indexedFeature,
-                                                            iconRotation + verticalPointLabelAngle);
+                                                            iconRotation + verticalPointLabelAngle,
+                                                            buffer);
         }
     }
 
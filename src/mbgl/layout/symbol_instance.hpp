@@ -5,6 +5,7 @@
 #include <mbgl/text/collision_feature.hpp>
 #include <mbgl/style/layers/symbol_layer_properties.hpp>
 #include <mbgl/util/bitmask_operations.hpp>
+#include <mbgl/util/monotonic_buffer.hpp>
 
 namespace mbgl {
 
@@ -62,13 +63,14 @@ public:
                    const IndexedSubfeature& indexedFeature,
                    const std::size_t layoutFeatureIndex,
                    const std::size_t dataFeatureIndex,
-                   std::u16string key,
+                   const std::u16string& key,
                    const float overscaling,
                    const float iconRotation,
                    const float textRotation,
                    const std::array<float, 2>& variableTextOffset,
                    bool allowVerticalPlacement,
-                   const SymbolContent iconType = SymbolContent::None);
+                   const SymbolContent iconType = SymbolContent::None,
+                   util::MonotonicBuffer* buffer = nullptr);
 
     optional<size_t> getDefaultHorizontalPlacedTextIndex() const;
     const GeometryCoordinates& line() const;
@@ -104,7 +106,8 @@ public:
     std::size_t dataFeatureIndex;   // Index into the underlying tile data feature set
     std::array<float, 2> textOffset;
     std::array<float, 2> iconOffset;
-    std::u16string key;
+    // Allocated from the same buffer as the collision boxes.
+    util::MonotonicU16String key;
     bool isDuplicate;
     optional<size_t> placedRightTextIndex;
     optional<size_t> placedCenterTextIndex;
@@ -83,6 +83,7 @@ SymbolLayout::SymbolLayout(const BucketParameters& parameters,
                            std::unique_ptr<GeometryTileLayer> sourceLayer_,
                            const LayoutParameters& layoutParameters)
     : bucketLeaderID(layers.front()->baseImpl->id),
+      symbolBuffer(std::make_shared<util::MonotonicBuffer>()),
       sourceLayer(std::move(sourceLayer_)),
       overscaling(parameters.tileID.overscaleFactor()),
       zoom(parameters.tileID.overscaledZ),
@@ -90,7 +91,9 @@ SymbolLayout::SymbolLayout(const BucketParameters& parameters,
       pixelRatio(parameters.pixelRatio),
       tileSize(util::tileSize * overscaling),
       tilePixelRatio(float(util::EXTENT) / tileSize),
-      layout(createLayout(toSymbolLayerProperties(layers.at(0)).layerImpl().layout, zoom)) {
+      layout(createLayout(toSymbolLayerProperties(layers.at(0)).layerImpl().layout, zoom)),
+      shapingCache(layoutParameters.shapingCache) {
+    assert(shapingCache);
     const SymbolLayer::Impl& leader = toSymbolLayerProperties(layers.at(0)).layerImpl();
 
     textSize = leader.layout.get<TextSize>();
@@ -367,7 +370,7 @@ void SymbolLayout::prepareSymbols(const GlyphMap& glyphMap,
                                     WritingModeType writingMode,
                                     SymbolAnchorType textAnchor,
                                     TextJustifyType textJustify) {
-                const Shaping result = getShaping(
+                const Shaping result = shapingCache->getShaping(
                     /* string */ formattedText,
                     /* maxWidth: ems */
                     isPointPlacement ? layout->evaluate<TextMaxWidth>(zoom, feature) * util::ONE_EM : 0.0f,
@@ -572,6 +575,7 @@ void SymbolLayout::addFeature(const std::size_t layoutFeatureIndex,
         }
     }
 
+    const std::u16string noKey;
     auto addSymbolInstance = [&] (Anchor& anchor, std::shared_ptr<SymbolInstanceSharedData> sharedData) {
         assert(sharedData);
         const bool anchorInsideTile = anchor.point.x >= 0 && anchor.point.x < util::EXTENT && anchor.point.y >= 0 && anchor.point.y < util::EXTENT;
@@ -587,8 +591,9 @@ void SymbolLayout::addFeature(const std::size_t layoutFeatureIndex,
                     textBoxScale, textPadding, textPlacement, textOffset,
                     iconBoxScale, iconPadding, iconOffset, indexedFeature,
                     layoutFeatureIndex, feature.index,
-                    feature.formattedText ? feature.formattedText->rawText() : std::u16string(),
-                    overscaling, iconRotation, textRotation, variableTextOffset, allowVerticalPlacement, iconType);
+                    feature.formattedText ? feature.formattedText->rawText() : noKey,
+                    overscaling, iconRotation, textRotation, variableTextOffset, allowVerticalPlacement, iconType,
+                    symbolBuffer.get());
         }
     };
 
@@ -693,8 +698,10 @@ bool SymbolLayout::anchorIsTooClose(const std::u16string& text, const float repe
 
 // Analog of `addToLineVertexArray` in JS. This version doesn't need to build up a line array like the
 // JS version does, but it uses the same logic to calculate tile distances.
-std::vector<float> SymbolLayout::calculateTileDistances(const GeometryCoordinates& line, const Anchor& anchor) {
-    std::vector<float> tileDistances(line.size());
+util::MonotonicVector<float> SymbolLayout::calculateTileDistances(const GeometryCoordinates& line,
+                                                                 const Anchor& anchor,
+                                                                 util::MonotonicAllocator<float> allocator) {
+    util::MonotonicVector<float> tileDistances(line.size(), 0.0f, allocator);
     if (anchor.segment) {
         std::size_t segment = *anchor.segment;
         assert(segment < line.size());
@@ -729,8 +736,10 @@ void SymbolLayout::createBucket(const ImagePositions&, std::unique_ptr<FeatureIn
                                                  tilePixelRatio,
                                                  allowVerticalPlacement,
                                                  std::move(placementModes),
-                                                 iconsInText);
+                                                 iconsInText,
+                                                 symbolBuffer);
 
+    const util::MonotonicAllocator<float> allocator(symbolBuffer.get());
     for (SymbolInstance &symbolInstance : bucket->symbolInstances) {
         const bool hasText = symbolInstance.hasText();
         const bool hasIcon = symbolInstance.hasIcon();
@@ -753,7 +762,7 @@ void SymbolLayout::createBucket(const ImagePositions&, std::unique_ptr<FeatureIn
                                                       symbolInstance.iconOffset,
                                                       writingMode,
                                                       symbolInstance.line(),
-                                                      std::vector<float>());
+                                                      util::MonotonicVector<float>(allocator));
                 index = iconBuffer.placedSymbols.size() - 1;
                 PlacedSymbol& iconSymbol = iconBuffer.placedSymbols.back();
                 iconSymbol.angle = (allowVerticalPlacement && writingMode == WritingModeType::Vertical) ? M_PI_2 : 0;
@@ -842,10 +851,13 @@ std::size_t SymbolLayout::addSymbolGlyphQuads(SymbolBucket& bucket,
                                            symbolInstance.textOffset,
                                            writingMode,
                                            symbolInstance.line(),
-                                           calculateTileDistances(symbolInstance.line(), symbolInstance.anchor),
+                                           calculateTileDistances(symbolInstance.line(),
+                                                                  symbolInstance.anchor,
+                                                                  util::MonotonicAllocator<float>(symbolBuffer.get())),
                                            placedIconIndex);
     placedIndex = bucket.text.placedSymbols.size() - 1;
     PlacedSymbol& placedSymbol = bucket.text.placedSymbols.back();
+    placedSymbol.glyphOffsets.reserve(glyphQuads.size());
     placedSymbol.angle = (allowVerticalPlacement && writingMode == WritingModeType::Vertical) ? M_PI_2 : 0;
 
     bool firstSymbol = true;
@@ -6,6 +6,7 @@
 #include <mbgl/layout/symbol_feature.hpp>
 #include <mbgl/layout/symbol_instance.hpp>
 #include <mbgl/text/bidi.hpp>
+#include <mbgl/text/shaping_cache.hpp>
 #include <mbgl/renderer/buckets/symbol_bucket.hpp>
 
 #include <memory>
@@ -44,6 +45,8 @@ public:
     std::map<std::string, Immutable<style::LayerProperties>> layerPaintProperties;
 
     const std::string bucketLeaderID;
+    // Handed on to the bucket, which keeps it alive for as long as the symbols.
+    const std::shared_ptr<util::MonotonicBuffer> symbolBuffer;
     std::vector<SymbolInstance> symbolInstances;
 
     static constexpr float INVALID_OFFSET_VALUE = std::numeric_limits<float>::max();
@@ -56,7 +59,9 @@ public:
      */
     static std::array<float, 2> evaluateVariableOffset(style::SymbolAnchorType anchor, std::array<float, 2> textOffset);
 
-    static std::vector<float> calculateTileDistances(const GeometryCoordinates& line, const Anchor& anchor);
+    static util::MonotonicVector<float> calculateTileDistances(const GeometryCoordinates& line,
+                                                               const Anchor& anchor,
+                                                               util::MonotonicAllocator<float> = {});
 
 private:
     void addFeature(const size_t,
@@ -119,6 +124,9 @@ private:
     Immutable<style::SymbolLayoutProperties::PossiblyEvaluated> layout;
     std::vector<SymbolFeature> features;
 
+    // Shared by all tiles of the renderer.
+    const std::shared_ptr<ShapingCache> shapingCache;
+
     BiDi bidi; // Consider moving this up to geometry tile worker to reduce reinstantiation costs; use of BiDi/ubiditransform object must be constrained to one thread
 };
 
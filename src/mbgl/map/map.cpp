@@ -323,6 +323,9 @@ MapOptions Map::getMapOptions() const {
         .withConstrainMode(impl->transform.getConstrainMode())
         .withViewportMode(impl->transform.getViewportMode())
         .withCrossSourceCollisions(impl->crossSourceCollisions)
+        .withParallelTileLayout(impl->parallelTileLayout)
+        .withBucketCachePath(impl->bucketCachePath)
+        .withTileCacheSize(impl->tileCacheSize)
         .withNorthOrientation(impl->transform.getNorthOrientation())
         .withSize(impl->transform.getState().getSize())
         .withPixelRatio(impl->pixelRatio));
@@ -17,6 +17,9 @@ Map::Impl::Impl(RendererFrontend& frontend_,
           mode(mapOptions.mapMode()),
           pixelRatio(mapOptions.pixelRatio()),
           crossSourceCollisions(mapOptions.crossSourceCollisions()),
+          parallelTileLayout(mapOptions.parallelTileLayout()),
+          bucketCachePath(mapOptions.bucketCachePath()),
+          tileCacheSize(mapOptions.tileCacheSize()),
           fileSource(std::move(fileSource_)),
           style(std::make_unique<style::Style>(*fileSource, pixelRatio)),
           annotationManager(*style) {
@@ -66,7 +69,10 @@ void Map::Impl::onUpdate() {
         fileSource,
         prefetchZoomDelta,
         bool(stillImageRequest),
-        crossSourceCollisions
+        crossSourceCollisions,
+        parallelTileLayout,
+        bucketCachePath,
+        tileCacheSize
     };
 
     rendererFrontend.update(std::make_shared<UpdateParameters>(std::move(params)));
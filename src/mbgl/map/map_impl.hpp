@@ -59,6 +59,9 @@ public:
     const MapMode mode;
     const float pixelRatio;
     const bool crossSourceCollisions;
+    const bool parallelTileLayout;
+    const std::string bucketCachePath;
+    const std::size_t tileCacheSize;
 
     MapDebugOptions debugOptions { MapDebugOptions::NoDebug };
 
@@ -1,4 +1,5 @@
 #include <mbgl/map/map_options.hpp>
+#include <mbgl/util/constants.hpp>
 
 namespace mbgl {
 
@@ -9,6 +10,9 @@ public:
     ViewportMode viewportMode = ViewportMode::Default;
     NorthOrientation orientation = NorthOrientation::Upwards;
     bool crossSourceCollisions = true;
+    bool parallelTileLayout = false;
+    std::string bucketCachePath;
+    std::size_t tileCacheSize = util::DEFAULT_TILE_CACHE_SIZE;
     Size size = { 64, 64 };
     float pixelRatio = 1.0;
 };
@@ -54,6 +58,33 @@ bool MapOptions::crossSourceCollisions() const {
     return impl_->crossSourceCollisions;
 }
 
+MapOptions& MapOptions::withParallelTileLayout(bool enableParallelLayout) {
+    impl_->parallelTileLayout = enableParallelLayout;
+    return *this;
+}
+
+bool MapOptions::parallelTileLayout() const {
+    return impl_->parallelTileLayout;
+}
+
+MapOptions& MapOptions::withBucketCachePath(std::string path) {
+    impl_->bucketCachePath = std::move(path);
+    return *this;
+}
+
+std::string MapOptions::bucketCachePath() const {
+    return impl_->bucketCachePath;
+}
+
+MapOptions& MapOptions::withTileCacheSize(std::size_t bytes) {
+    impl_->tileCacheSize = bytes;
+    return *this;
+}
+
+std::size_t MapOptions::tileCacheSize() const {
+    return impl_->tileCacheSize;
+}
+
 MapOptions& MapOptions::withNorthOrientation(NorthOrientation orientation) {
     impl_->orientation = orientation;
     return *this;
@@ -83,6 +83,11 @@ public:
           backgroundPattern(context, programParameters) {}
     BackgroundProgram background;
     BackgroundPatternProgram backgroundPattern;
+
+    void warmUp(gfx::Context& context) override {
+        background.warmUp(context);
+        backgroundPattern.warmUp(context);
+    }
 };
 
 } // namespace mbgl
@@ -54,6 +54,10 @@ public:
     CircleLayerPrograms(gfx::Context& context, const ProgramParameters& programParameters)
         : circle(context, programParameters) {}
     CircleProgram circle;
+
+    void warmUp(gfx::Context& context) override {
+        circle.warmUp(context);
+    }
 };
 
 } // namespace mbgl
@@ -125,6 +125,11 @@ public:
     }
     FillExtrusionProgram fillExtrusion;
     FillExtrusionPatternProgram fillExtrusionPattern;
+
+    void warmUp(gfx::Context& context) override {
+        fillExtrusion.warmUp(context);
+        fillExtrusionPattern.warmUp(context);
+    }
 };
 
 } // namespace mbgl
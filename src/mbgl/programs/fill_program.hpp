@@ -114,6 +114,13 @@ public:
     FillPatternProgram fillPattern;
     FillOutlineProgram fillOutline;
     FillOutlinePatternProgram fillOutlinePattern;
+
+    void warmUp(gfx::Context& context) override {
+        fill.warmUp(context);
+        fillPattern.warmUp(context);
+        fillOutline.warmUp(context);
+        fillOutlinePattern.warmUp(context);
+    }
 };
 
 } // namespace mbgl
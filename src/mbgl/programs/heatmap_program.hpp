@@ -54,6 +54,11 @@ public:
           heatmapTexture(context, programParameters) {}
     HeatmapProgram heatmap;
     HeatmapTextureProgram heatmapTexture;
+
+    void warmUp(gfx::Context& context) override {
+        heatmap.warmUp(context);
+        heatmapTexture.warmUp(context);
+    }
 };
 
 } // namespace mbgl
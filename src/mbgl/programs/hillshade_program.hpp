@@ -61,6 +61,11 @@ public:
           hillshadePrepare(context, programParameters) {}
     HillshadeProgram hillshade;
     HillshadePrepareProgram hillshadePrepare;
+
+    void warmUp(gfx::Context& context) override {
+        hillshade.warmUp(context);
+        hillshadePrepare.warmUp(context);
+    }
 };
 
 } // namespace mbgl
@@ -197,6 +197,13 @@ public:
     LineGradientProgram lineGradient;
     LineSDFProgram lineSDF;
     LinePatternProgram linePattern;
+
+    void warmUp(gfx::Context& context) override {
+        line.warmUp(context);
+        lineGradient.warmUp(context);
+        lineSDF.warmUp(context);
+        linePattern.warmUp(context);
+    }
 };
 
 } // namespace mbgl
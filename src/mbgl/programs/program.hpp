@@ -49,6 +49,12 @@ public:
         : program(context.createProgram<Name>(programParameters)) {
     }
 
+    void warmUp(gfx::Context& context) {
+        if (program) {
+            program->warmUp(context);
+        }
+    }
+
     static UniformValues computeAllUniformValues(
         const LayoutUniformValues& layoutUniformValues,
         const Binders& paintPropertyBinders,
@@ -119,6 +125,8 @@ public:
 class LayerTypePrograms {
 public:
     virtual ~LayerTypePrograms() = default;
+
+    virtual void warmUp(gfx::Context&) = 0;
 };
 
 } // namespace mbgl
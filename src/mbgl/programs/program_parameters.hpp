@@ -8,12 +8,17 @@ namespace mbgl {
 
 class ProgramParameters {
 public:
-    ProgramParameters(float pixelRatio, bool overdraw);
+    ProgramParameters(float pixelRatio, bool overdraw, optional<std::string> cacheDir = {});
 
     const std::string& getDefines() const;
 
+    // Returns the path of the file that caches the binaries of the named program, or nothing if
+    // program binaries aren't cached.
+    optional<std::string> cachePath(const char* name) const;
+
 private:
     std::string defines;
+    optional<std::string> cacheDir;
 };
 
 } // namespace mbgl
@@ -83,4 +83,18 @@ SymbolLayerPrograms& Programs::getSymbolLayerPrograms() noexcept {
     return static_cast<SymbolLayerPrograms&>(*symbolPrograms);   
 }
 
+void Programs::warmUp() {
+    getBackgroundLayerPrograms().warmUp(context);
+    getRasterLayerPrograms().warmUp(context);
+    getHeatmapLayerPrograms().warmUp(context);
+    getHillshadeLayerPrograms().warmUp(context);
+    getFillLayerPrograms().warmUp(context);
+    getFillExtrusionLayerPrograms().warmUp(context);
+    getCircleLayerPrograms().warmUp(context);
+    getLineLayerPrograms().warmUp(context);
+    getSymbolLayerPrograms().warmUp(context);
+    debug.warmUp(context);
+    clippingMask.warmUp(context);
+}
+
 } // namespace mbgl
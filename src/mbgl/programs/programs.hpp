@@ -33,6 +33,9 @@ public:
     LineLayerPrograms& getLineLayerPrograms() noexcept;
     SymbolLayerPrograms& getSymbolLayerPrograms() noexcept;
 
+    // Prepares the programs of all layer types ahead of rendering, see gfx::Program::warmUp.
+    void warmUp();
+
     DebugProgram debug;
     ClippingMaskProgram clippingMask;
 
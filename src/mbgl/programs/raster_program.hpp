@@ -69,6 +69,10 @@ public:
     RasterLayerPrograms(gfx::Context& context, const ProgramParameters& programParameters)
         : raster(context, programParameters) {}
     RasterProgram raster;
+
+    void warmUp(gfx::Context& context) override {
+        raster.warmUp(context);
+    }
 };
 
 } // namespace mbgl
@@ -269,6 +269,12 @@ public:
         : program(context.createProgram<Name>(programParameters)) {
     }
 
+    void warmUp(gfx::Context& context) {
+        if (program) {
+            program->warmUp(context);
+        }
+    }
+
     static UniformValues computeAllUniformValues(
         const LayoutUniformValues& layoutUniformValues,
         const SymbolSizeBinder& symbolSizeBinder,
@@ -528,6 +534,15 @@ public:
     SymbolTextAndIconProgram symbolTextAndIcon;
     CollisionBoxProgram collisionBox;
     CollisionCircleProgram collisionCircle;
+
+    void warmUp(gfx::Context& context) override {
+        symbolIcon.warmUp(context);
+        symbolIconSDF.warmUp(context);
+        symbolGlyph.warmUp(context);
+        symbolTextAndIcon.warmUp(context);
+        collisionBox.warmUp(context);
+        collisionCircle.warmUp(context);
+    }
 };
 
 } // namespace mbgl
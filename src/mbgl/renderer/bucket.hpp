@@ -12,6 +12,11 @@ namespace gfx {
 class UploadPass;
 } // namespace gfx
 
+namespace util {
+class BinaryWriter;
+class BinaryReader;
+} // namespace util
+
 class RenderLayer;
 class CrossTileSymbolLayerIndex;
 class OverscaledTileID;
@@ -35,6 +40,10 @@ public:
     virtual void addFeature(const GeometryTileFeature&, const GeometryCollection&, const ImagePositions&,
                             const PatternLayerMap&, std::size_t){};
 
+    // Called with all of the features and their indices before they are added one by one,
+    // so that data-driven paint properties can be evaluated for all of them at once.
+    virtual void evaluateFeatures(const std::vector<const GeometryTileFeature*>&, const std::vector<std::size_t>&) {}
+
     virtual void update(const FeatureStates&, const GeometryTileLayer&, const std::string&, const ImagePositions&) {}
 
     // As long as this bucket has a Prepare render pass, this function is getting called. Typically,
@@ -47,6 +56,23 @@ public:
         return 0;
     };
 
+    // Approximate number of bytes held by the vertex, index and image data of this bucket.
+    virtual std::size_t getMemoryUsage() const {
+        return 0;
+    }
+
+    // Writes the data added by `addFeature()` to the bucket cache. Returns false if the bucket
+    // cannot be cached, e.g. because its contents depend on glyphs or images.
+    virtual bool serialize(util::BinaryWriter&) const {
+        return false;
+    }
+
+    // Restores data written by `serialize()` into a bucket that was created for the same
+    // layers and has no features yet. Returns false if the data doesn't match the bucket.
+    virtual bool deserialize(util::BinaryReader&) {
+        return false;
+    }
+
     bool needsUpload() const {
         return hasData() && !uploaded;
     }
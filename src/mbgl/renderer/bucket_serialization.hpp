@@ -0,0 +1,124 @@
+#pragma once
+
+#include <mbgl/gfx/vertex_vector.hpp>
+#include <mbgl/gfx/index_vector.hpp>
+#include <mbgl/programs/segment.hpp>
+#include <mbgl/util/binary_stream.hpp>
+
+#include <string>
+
+namespace mbgl {
+
+// Helpers for writing bucket data to the bucket cache, and reading it back into a bucket that
+// was created for the same layers. All of the `read*()` functions return false if the data is
+// malformed, in which case the bucket is discarded.
+
+template <class V>
+void writeBucketData(util::BinaryWriter& writer, const gfx::VertexVector<V>& vertices) {
+    writer.write(vertices.vector());
+}
+
+template <class V>
+bool readBucketData(util::BinaryReader& reader, gfx::VertexVector<V>& vertices) {
+    std::vector<V> elements;
+    if (!reader.read(elements)) {
+        return false;
+    }
+    vertices.assign(std::move(elements));
+    return true;
+}
+
+template <class DrawMode>
+void writeBucketData(util::BinaryWriter& writer, const gfx::IndexVector<DrawMode>& indices) {
+    writer.write(indices.vector());
+}
+
+template <class DrawMode>
+bool readBucketData(util::BinaryReader& reader, gfx::IndexVector<DrawMode>& indices) {
+    std::vector<uint16_t> elements;
+    if (!reader.read(elements) || elements.size() % gfx::IndexVector<DrawMode>::groupSize != 0) {
+        return false;
+    }
+    indices.assign(std::move(elements));
+    return true;
+}
+
+template <class AttributeList>
+void writeBucketData(util::BinaryWriter& writer, const SegmentVector<AttributeList>& segments) {
+    writer.write<uint64_t>(segments.size());
+    for (const auto& segment : segments) {
+        writer.write<uint64_t>(segment.vertexOffset);
+        writer.write<uint64_t>(segment.indexOffset);
+        writer.write<uint64_t>(segment.vertexLength);
+        writer.write<uint64_t>(segment.indexLength);
+        writer.write(segment.sortKey);
+    }
+}
+
+// Reads the segments of a bucket whose vertices and indices were read already. Rejects segments
+// that reach past these, or that contain indices past the vertices of the segment.
+template <class AttributeList, class V, class DrawMode>
+bool readBucketData(util::BinaryReader& reader,
+                    SegmentVector<AttributeList>& segments,
+                    const gfx::VertexVector<V>& vertices,
+                    const gfx::IndexVector<DrawMode>& indices) {
+    uint64_t count;
+    if (!reader.read(count)) {
+        return false;
+    }
+    const uint64_t vertexCount = vertices.elements();
+    const uint64_t indexCount = indices.elements();
+    segments.clear();
+    for (uint64_t i = 0; i < count; ++i) {
+        uint64_t vertexOffset, indexOffset, vertexLength, indexLength;
+        float sortKey;
+        if (!reader.read(vertexOffset) || !reader.read(indexOffset) || !reader.read(vertexLength) ||
+            !reader.read(indexLength) || !reader.read(sortKey)) {
+            return false;
+        }
+        if (vertexOffset > vertexCount || vertexLength > vertexCount - vertexOffset || indexOffset > indexCount ||
+            indexLength > indexCount - indexOffset) {
+            return false;
+        }
+        const uint16_t* segmentIndices = indices.data() + indexOffset;
+        for (uint64_t j = 0; j < indexLength; ++j) {
+            if (segmentIndices[j] >= vertexLength) {
+                return false;
+            }
+        }
+        segments.emplace_back(vertexOffset, indexOffset, vertexLength, indexLength, sortKey);
+    }
+    return true;
+}
+
+// Writes the paint property binders of a bucket, keyed by layer ID.
+template <class BinderMap>
+void writeBucketBinders(util::BinaryWriter& writer, const BinderMap& binders) {
+    writer.write<uint64_t>(binders.size());
+    for (const auto& pair : binders) {
+        writer.write(pair.first);
+        pair.second.serialize(writer);
+    }
+}
+
+// Reads the paint property binders of a bucket, which must have binders for the same layer IDs.
+template <class BinderMap>
+bool readBucketBinders(util::BinaryReader& reader, BinderMap& binders) {
+    uint64_t count;
+    if (!reader.read(count) || count != binders.size()) {
+        return false;
+    }
+    for (uint64_t i = 0; i < count; ++i) {
+        std::string layerID;
+        if (!reader.read(layerID)) {
+            return false;
+        }
+        auto it = binders.find(layerID);
+        if (it == binders.end() || !it->second.deserialize(reader)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace mbgl
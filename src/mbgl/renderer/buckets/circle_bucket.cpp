@@ -1,5 +1,6 @@
 #include <mbgl/renderer/buckets/circle_bucket.hpp>
 #include <mbgl/renderer/bucket_parameters.hpp>
+#include <mbgl/renderer/bucket_serialization.hpp>
 #include <mbgl/programs/circle_program.hpp>
 #include <mbgl/style/layers/circle_layer_impl.hpp>
 #include <mbgl/renderer/layers/render_circle_layer.hpp>
@@ -41,6 +42,36 @@ bool CircleBucket::hasData() const {
     return !segments.empty();
 }
 
+std::size_t CircleBucket::getMemoryUsage() const {
+    std::size_t bytes = vertices.bytes() + triangles.bytes();
+    for (const auto& pair : paintPropertyBinders) {
+        bytes += pair.second.getMemoryUsage();
+    }
+    return bytes;
+}
+
+bool CircleBucket::serialize(util::BinaryWriter& writer) const {
+    writeBucketData(writer, vertices);
+    writeBucketData(writer, triangles);
+    writeBucketData(writer, segments);
+    writeBucketBinders(writer, paintPropertyBinders);
+    return true;
+}
+
+bool CircleBucket::deserialize(util::BinaryReader& reader) {
+    return readBucketData(reader, vertices) &&
+           readBucketData(reader, triangles) &&
+           readBucketData(reader, segments, vertices, triangles) &&
+           readBucketBinders(reader, paintPropertyBinders);
+}
+
+void CircleBucket::evaluateFeatures(const std::vector<const GeometryTileFeature*>& features,
+                                    const std::vector<std::size_t>& indices) {
+    for (auto& pair : paintPropertyBinders) {
+        pair.second.evaluateFeatures(features, indices);
+    }
+}
+
 void CircleBucket::addFeature(const GeometryTileFeature& feature, const GeometryCollection& geometry,
                               const ImagePositions&, const PatternLayerMap&, std::size_t featureIndex) {
     constexpr const uint16_t vertexLength = 4;
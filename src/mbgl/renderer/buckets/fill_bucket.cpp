@@ -1,6 +1,7 @@
 #include <mbgl/renderer/buckets/fill_bucket.hpp>
 #include <mbgl/programs/fill_program.hpp>
 #include <mbgl/renderer/bucket_parameters.hpp>
+#include <mbgl/renderer/bucket_serialization.hpp>
 #include <mbgl/style/layers/fill_layer_impl.hpp>
 #include <mbgl/renderer/layers/render_fill_layer.hpp>
 #include <mbgl/util/math.hpp>
@@ -44,6 +45,13 @@ FillBucket::FillBucket(const FillBucket::PossiblyEvaluatedLayoutProperties,
 
 FillBucket::~FillBucket() = default;
 
+void FillBucket::evaluateFeatures(const std::vector<const GeometryTileFeature*>& features,
+                                  const std::vector<std::size_t>& indices) {
+    for (auto& pair : paintPropertyBinders) {
+        pair.second.evaluateFeatures(features, indices);
+    }
+}
+
 void FillBucket::addFeature(const GeometryTileFeature& feature, const GeometryCollection& geometry,
                             const ImagePositions& patternPositions, const PatternLayerMap& patternDependencies,
                             std::size_t index) {
@@ -139,6 +147,33 @@ bool FillBucket::hasData() const {
     return !triangleSegments.empty() || !lineSegments.empty();
 }
 
+std::size_t FillBucket::getMemoryUsage() const {
+    std::size_t bytes = vertices.bytes() + lines.bytes() + triangles.bytes();
+    for (const auto& pair : paintPropertyBinders) {
+        bytes += pair.second.getMemoryUsage();
+    }
+    return bytes;
+}
+
+bool FillBucket::serialize(util::BinaryWriter& writer) const {
+    writeBucketData(writer, vertices);
+    writeBucketData(writer, lines);
+    writeBucketData(writer, triangles);
+    writeBucketData(writer, lineSegments);
+    writeBucketData(writer, triangleSegments);
+    writeBucketBinders(writer, paintPropertyBinders);
+    return true;
+}
+
+bool FillBucket::deserialize(util::BinaryReader& reader) {
+    return readBucketData(reader, vertices) &&
+           readBucketData(reader, lines) &&
+           readBucketData(reader, triangles) &&
+           readBucketData(reader, lineSegments, vertices, lines) &&
+           readBucketData(reader, triangleSegments, vertices, triangles) &&
+           readBucketBinders(reader, paintPropertyBinders);
+}
+
 float FillBucket::getQueryRadius(const RenderLayer& layer) const {
     const auto& evaluated = getEvaluated<FillLayerProperties>(layer.evaluatedProperties);
     const std::array<float, 2>& translate = evaluated.get<FillTranslate>();
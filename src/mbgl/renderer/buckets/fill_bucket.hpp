@@ -27,8 +27,12 @@ public:
 
     void addFeature(const GeometryTileFeature&, const GeometryCollection&, const mbgl::ImagePositions&,
                     const PatternLayerMap&, std::size_t) override;
+    void evaluateFeatures(const std::vector<const GeometryTileFeature*>&, const std::vector<std::size_t>&) override;
 
     bool hasData() const override;
+    std::size_t getMemoryUsage() const override;
+    bool serialize(util::BinaryWriter&) const override;
+    bool deserialize(util::BinaryReader&) override;
 
     void upload(gfx::UploadPass&) override;
 
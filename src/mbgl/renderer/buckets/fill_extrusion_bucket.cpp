@@ -1,6 +1,7 @@
 #include <mbgl/renderer/buckets/fill_extrusion_bucket.hpp>
 #include <mbgl/programs/fill_extrusion_program.hpp>
 #include <mbgl/renderer/bucket_parameters.hpp>
+#include <mbgl/renderer/bucket_serialization.hpp>
 #include <mbgl/style/layers/fill_extrusion_layer_impl.hpp>
 #include <mbgl/renderer/layers/render_fill_extrusion_layer.hpp>
 #include <mbgl/util/math.hpp>
@@ -50,6 +51,13 @@ FillExtrusionBucket::FillExtrusionBucket(const FillExtrusionBucket::PossiblyEval
 
 FillExtrusionBucket::~FillExtrusionBucket() = default;
 
+void FillExtrusionBucket::evaluateFeatures(const std::vector<const GeometryTileFeature*>& features,
+                                           const std::vector<std::size_t>& indices) {
+    for (auto& pair : paintPropertyBinders) {
+        pair.second.evaluateFeatures(features, indices);
+    }
+}
+
 void FillExtrusionBucket::addFeature(const GeometryTileFeature& feature, const GeometryCollection& geometry,
                                      const ImagePositions& patternPositions, const PatternLayerMap& patternDependencies,
                                      std::size_t index) {
@@ -181,6 +189,29 @@ bool FillExtrusionBucket::hasData() const {
     return !triangleSegments.empty();
 }
 
+std::size_t FillExtrusionBucket::getMemoryUsage() const {
+    std::size_t bytes = vertices.bytes() + triangles.bytes();
+    for (const auto& pair : paintPropertyBinders) {
+        bytes += pair.second.getMemoryUsage();
+    }
+    return bytes;
+}
+
+bool FillExtrusionBucket::serialize(util::BinaryWriter& writer) const {
+    writeBucketData(writer, vertices);
+    writeBucketData(writer, triangles);
+    writeBucketData(writer, triangleSegments);
+    writeBucketBinders(writer, paintPropertyBinders);
+    return true;
+}
+
+bool FillExtrusionBucket::deserialize(util::BinaryReader& reader) {
+    return readBucketData(reader, vertices) &&
+           readBucketData(reader, triangles) &&
+           readBucketData(reader, triangleSegments, vertices, triangles) &&
+           readBucketBinders(reader, paintPropertyBinders);
+}
+
 float FillExtrusionBucket::getQueryRadius(const RenderLayer& layer) const {
     const auto& evaluated = getEvaluated<FillExtrusionLayerProperties>(layer.evaluatedProperties);
     const std::array<float, 2>& translate = evaluated.get<FillExtrusionTranslate>();
@@ -1,5 +1,6 @@
 #include <mbgl/renderer/buckets/heatmap_bucket.hpp>
 #include <mbgl/renderer/bucket_parameters.hpp>
+#include <mbgl/renderer/bucket_serialization.hpp>
 #include <mbgl/programs/heatmap_program.hpp>
 #include <mbgl/style/layers/heatmap_layer_impl.hpp>
 #include <mbgl/renderer/layers/render_heatmap_layer.hpp>
@@ -39,6 +40,36 @@ bool HeatmapBucket::hasData() const {
     return !segments.empty();
 }
 
+std::size_t HeatmapBucket::getMemoryUsage() const {
+    std::size_t bytes = vertices.bytes() + triangles.bytes();
+    for (const auto& pair : paintPropertyBinders) {
+        bytes += pair.second.getMemoryUsage();
+    }
+    return bytes;
+}
+
+bool HeatmapBucket::serialize(util::BinaryWriter& writer) const {
+    writeBucketData(writer, vertices);
+    writeBucketData(writer, triangles);
+    writeBucketData(writer, segments);
+    writeBucketBinders(writer, paintPropertyBinders);
+    return true;
+}
+
+bool HeatmapBucket::deserialize(util::BinaryReader& reader) {
+    return readBucketData(reader, vertices) &&
+           readBucketData(reader, triangles) &&
+           readBucketData(reader, segments, vertices, triangles) &&
+           readBucketBinders(reader, paintPropertyBinders);
+}
+
+void HeatmapBucket::evaluateFeatures(const std::vector<const GeometryTileFeature*>& features,
+                                     const std::vector<std::size_t>& indices) {
+    for (auto& pair : paintPropertyBinders) {
+        pair.second.evaluateFeatures(features, indices);
+    }
+}
+
 void HeatmapBucket::addFeature(const GeometryTileFeature& feature, const GeometryCollection& geometry,
                                const ImagePositions&, const PatternLayerMap&, std::size_t featureIndex) {
     constexpr const uint16_t vertexLength = 4;
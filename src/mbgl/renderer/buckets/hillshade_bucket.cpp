@@ -114,5 +114,9 @@ bool HillshadeBucket::hasData() const {
     return demdata.getImage()->valid();
 }
 
+std::size_t HillshadeBucket::getMemoryUsage() const {
+    return demdata.getImage()->bytes() + vertices.bytes() + indices.bytes();
+}
+
 
 } // namespace mbgl
@@ -1,5 +1,6 @@
 #include <mbgl/renderer/buckets/line_bucket.hpp>
 #include <mbgl/renderer/bucket_parameters.hpp>
+#include <mbgl/renderer/bucket_serialization.hpp>
 #include <mbgl/style/layers/line_layer_impl.hpp>
 #include <mbgl/util/math.hpp>
 #include <mbgl/util/constants.hpp>
@@ -27,6 +28,13 @@ LineBucket::LineBucket(const LineBucket::PossiblyEvaluatedLayoutProperties layou
 
 LineBucket::~LineBucket() = default;
 
+void LineBucket::evaluateFeatures(const std::vector<const GeometryTileFeature*>& features,
+                                  const std::vector<std::size_t>& indices) {
+    for (auto& pair : paintPropertyBinders) {
+        pair.second.evaluateFeatures(features, indices);
+    }
+}
+
 void LineBucket::addFeature(const GeometryTileFeature& feature, const GeometryCollection& geometryCollection,
                             const ImagePositions& patternPositions, const PatternLayerMap& patternDependencies,
                             std::size_t index) {
@@ -529,6 +537,29 @@ bool LineBucket::hasData() const {
     return !segments.empty();
 }
 
+std::size_t LineBucket::getMemoryUsage() const {
+    std::size_t bytes = vertices.bytes() + triangles.bytes();
+    for (const auto& pair : paintPropertyBinders) {
+        bytes += pair.second.getMemoryUsage();
+    }
+    return bytes;
+}
+
+bool LineBucket::serialize(util::BinaryWriter& writer) const {
+    writeBucketData(writer, vertices);
+    writeBucketData(writer, triangles);
+    writeBucketData(writer, segments);
+    writeBucketBinders(writer, paintPropertyBinders);
+    return true;
+}
+
+bool LineBucket::deserialize(util::BinaryReader& reader) {
+    return readBucketData(reader, vertices) &&
+           readBucketData(reader, triangles) &&
+           readBucketData(reader, segments, vertices, triangles) &&
+           readBucketBinders(reader, paintPropertyBinders);
+}
+
 template <class Property>
 static float get(const LinePaintProperties::PossiblyEvaluated& evaluated, const std::string& id, const std::map<std::string, LineProgram::Binders>& paintPropertyBinders) {
     auto it = paintPropertyBinders.find(id);
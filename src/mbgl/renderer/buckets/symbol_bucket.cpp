@@ -21,11 +21,12 @@ SymbolBucket::SymbolBucket(Immutable<style::SymbolLayoutProperties::PossiblyEval
                            bool iconsNeedLinear_,
                            bool sortFeaturesByY_,
                            const std::string bucketName_,
-                           const std::vector<SymbolInstance>&& symbolInstances_,
+                           std::vector<SymbolInstance>&& symbolInstances_,
                            float tilePixelRatio_,
                            bool allowVerticalPlacement_,
                            std::vector<style::TextWritingModeType> placementModes_,
-                           bool iconsInText_)
+                           bool iconsInText_,
+                           std::shared_ptr<util::MonotonicBuffer> symbolBuffer_)
     : layout(std::move(layout_)),
       bucketLeaderID(bucketName_),
       iconsNeedLinear(iconsNeedLinear_ || iconSize.isDataDriven() || !iconSize.isZoomConstant()),
@@ -37,7 +38,8 @@ SymbolBucket::SymbolBucket(Immutable<style::SymbolLayoutProperties::PossiblyEval
       iconsInText(iconsInText_),
       justReloaded(false),
       hasVariablePlacement(false),
-      symbolInstances(symbolInstances_),
+      symbolBuffer(std::move(symbolBuffer_)),
+      symbolInstances(std::move(symbolInstances_)),
       textSizeBinder(SymbolSizeBinder::create(zoom, textSize, TextSize::defaultValue())),
       iconSizeBinder(SymbolSizeBinder::create(zoom, iconSize, IconSize::defaultValue())),
       tilePixelRatio(tilePixelRatio_),
@@ -172,6 +174,31 @@ bool SymbolBucket::hasData() const {
            hasTextCollisionBoxData() || hasIconCollisionCircleData() || hasTextCollisionCircleData();
 }
 
+std::size_t SymbolBucket::getMemoryUsage() const {
+    std::size_t bytes = symbolInstances.size() * sizeof(SymbolInstance);
+    if (symbolBuffer) {
+        bytes += symbolBuffer->getMemoryUsage();
+    }
+    for (const Buffer* buffer : {&text, &icon, &sdfIcon}) {
+        bytes += buffer->vertices.bytes() + buffer->dynamicVertices.bytes() + buffer->opacityVertices.bytes() +
+                 buffer->triangles.bytes() + buffer->placedSymbols.size() * sizeof(PlacedSymbol);
+    }
+    for (const CollisionBoxBuffer* buffer : {iconCollisionBox.get(), textCollisionBox.get()}) {
+        if (buffer) {
+            bytes += buffer->vertices.bytes() + buffer->dynamicVertices.bytes() + buffer->lines.bytes();
+        }
+    }
+    for (const CollisionCircleBuffer* buffer : {iconCollisionCircle.get(), textCollisionCircle.get()}) {
+        if (buffer) {
+            bytes += buffer->vertices.bytes() + buffer->dynamicVertices.bytes() + buffer->triangles.bytes();
+        }
+    }
+    for (const auto& pair : paintProperties) {
+        bytes += pair.second.iconBinders.getMemoryUsage() + pair.second.textBinders.getMemoryUsage();
+    }
+    return bytes;
+}
+
 bool SymbolBucket::hasTextData() const {
     return !text.segments.empty();
 }
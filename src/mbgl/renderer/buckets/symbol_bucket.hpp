@@ -11,7 +11,9 @@
 #include <mbgl/style/layers/symbol_layer_properties.hpp>
 #include <mbgl/layout/symbol_feature.hpp>
 #include <mbgl/layout/symbol_instance.hpp>
+#include <mbgl/util/monotonic_buffer.hpp>
 
+#include <memory>
 #include <vector>
 
 namespace mbgl {
@@ -26,8 +28,8 @@ public:
                  float upperSize_,
                  std::array<float, 2> lineOffset_,
                  WritingModeType writingModes_,
-                 GeometryCoordinates line_,
-                 std::vector<float> tileDistances_,
+                 const GeometryCoordinates& line_,
+                 util::MonotonicVector<float> tileDistances_,
                  optional<size_t> placedIconIndex_ = nullopt)
         : anchorPoint(anchorPoint_),
           segment(segment_),
@@ -35,8 +37,9 @@ public:
           upperSize(upperSize_),
           lineOffset(lineOffset_),
           writingModes(writingModes_),
-          line(std::move(line_)),
+          line(line_.begin(), line_.end(), tileDistances_.get_allocator()),
           tileDistances(std::move(tileDistances_)),
+          glyphOffsets(tileDistances.get_allocator()),
           hidden(false),
           vertexStartIndex(0),
           placedIconIndex(std::move(placedIconIndex_)) {}
@@ -46,9 +49,10 @@ public:
     float upperSize;
     std::array<float, 2> lineOffset;
     WritingModeType writingModes;
-    GeometryCoordinates line;
-    std::vector<float> tileDistances;
-    std::vector<float> glyphOffsets;
+    // These share the allocator of `tileDistances`, usually the buffer of the bucket.
+    util::MonotonicVector<GeometryCoordinate> line;
+    util::MonotonicVector<float> tileDistances;
+    util::MonotonicVector<float> glyphOffsets;
     bool hidden;
     size_t vertexStartIndex;
     // The crossTileID is only filled/used on the foreground for variable text anchors
@@ -72,15 +76,17 @@ public:
                  bool iconsNeedLinear,
                  bool sortFeaturesByY,
                  const std::string bucketLeaderID,
-                 const std::vector<SymbolInstance>&&,
+                 std::vector<SymbolInstance>&&,
                  const float tilePixelRatio,
                  bool allowVerticalPlacement,
                  std::vector<style::TextWritingModeType> placementModes,
-                 bool iconsInText);
+                 bool iconsInText,
+                 std::shared_ptr<util::MonotonicBuffer> symbolBuffer = nullptr);
     ~SymbolBucket() override;
 
     void upload(gfx::UploadPass&) override;
     bool hasData() const override;
+    std::size_t getMemoryUsage() const override;
     std::pair<uint32_t, bool> registerAtCrossTileIndex(CrossTileSymbolLayerIndex&, const OverscaledTileID&, uint32_t& maxCrossTileID) override;
     void place(Placement&, const BucketPlacementParameters&, std::set<uint32_t>&) override;
     void updateVertices(
@@ -115,6 +121,11 @@ public:
     mutable bool justReloaded : 1;
     bool hasVariablePlacement : 1;
 
+    // Backs the strings and vectors of the symbol instances and placed symbols, so that they take
+    // a few large allocations rather than many small ones. Declared before them, so that it is
+    // released last.
+    const std::shared_ptr<util::MonotonicBuffer> symbolBuffer;
+
     std::vector<SymbolInstance> symbolInstances;
 
     struct PaintProperties {
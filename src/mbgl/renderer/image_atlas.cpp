@@ -1,118 +1,278 @@
 #include <mbgl/renderer/image_atlas.hpp>
-#include <mbgl/renderer/image_manager.hpp>
+#include <mbgl/gfx/upload_pass.hpp>
 
-#include <mapbox/shelf-pack.hpp>
+#include <algorithm>
+#include <limits>
 
 namespace mbgl {
 
 static constexpr uint32_t padding = 1;
+static constexpr int32_t initialSize = 128;
 
-ImagePosition::ImagePosition(const mapbox::Bin& bin, const style::Image::Impl& image, uint32_t version_)
+// Whether an image can be redrawn in place of another one, without changing its position.
+static bool fits(const style::Image::Impl& a, const style::Image::Impl& b) {
+    return a.image.size == b.image.size && a.pixelRatio == b.pixelRatio;
+}
+
+ImagePosition::ImagePosition(const mapbox::Bin& bin, const style::Image::Impl& image)
     : pixelRatio(image.pixelRatio),
       textureRect(
         bin.x + padding,
         bin.y + padding,
         bin.w - padding * 2,
         bin.h - padding * 2
-      ),
-      version(version_) {
-}
-
-const mapbox::Bin& _packImage(mapbox::ShelfPack& pack, const style::Image::Impl& image, ImageAtlas& resultImage, ImageType imageType) {
-    const mapbox::Bin& bin = *pack.packOne(-1,
-        image.image.size.width + 2 * padding,
-        image.image.size.height + 2 * padding);
-
-    resultImage.image.resize({
-        static_cast<uint32_t>(pack.width()),
-        static_cast<uint32_t>(pack.height())
-    });
-
-    PremultipliedImage::copy(image.image,
-                             resultImage.image,
-                             { 0, 0 },
-                             {
-                                bin.x + padding,
-                                bin.y + padding
-                             },
-                             image.image.size);
-    uint32_t x = bin.x + padding,
-            y = bin.y + padding,
-            w = image.image.size.width,
-            h = image.image.size.height;
-
-    if (imageType == ImageType::Pattern) {
-            // Add 1 pixel wrapped padding on each side of the image.
-        PremultipliedImage::copy(image.image, resultImage.image, { 0, h - 1 }, { x, y - 1 }, { w, 1 }); // T
-        PremultipliedImage::copy(image.image, resultImage.image, { 0,     0 }, { x, y + h }, { w, 1 }); // B
-        PremultipliedImage::copy(image.image, resultImage.image, { w - 1, 0 }, { x - 1, y }, { 1, h }); // L
-        PremultipliedImage::copy(image.image, resultImage.image, { 0,     0 }, { x + w, y }, { 1, h }); // R
-    }
-    return bin;
-}
-
-namespace {
-
-void populateImagePatches(
-    ImagePositions& imagePositions, 
-    const ImageManager& imageManager,
-    std::vector<ImagePatch>& /*out*/ patches) {
-    for (auto& updatedImageVersion : imageManager.updatedImageVersions) {
-        const std::string& name = updatedImageVersion.first;
-        const uint32_t version = updatedImageVersion.second;
-        auto it = imagePositions.find(updatedImageVersion.first);
-        if (it != imagePositions.end()) {
-            auto& position = it->second;
-            if (position.version == version) continue;
-
-            auto updatedImage = imageManager.getSharedImage(name);
-            if (updatedImage == nullptr) continue;
-
-            patches.emplace_back(*updatedImage, position.textureRect);
-            position.version = version;
+      ) {
+}
+
+ImageAtlasReference::ImageAtlasReference(std::shared_ptr<ImageAtlas> atlas_,
+                                         ImagePositions iconPositions_,
+                                         ImagePositions patternPositions_,
+                                         std::vector<mapbox::Bin*> bins_)
+    : iconPositions(std::move(iconPositions_)),
+      patternPositions(std::move(patternPositions_)),
+      atlas(std::move(atlas_)),
+      bins(std::move(bins_)) {
+}
+
+ImageAtlasReference::~ImageAtlasReference() {
+    atlas->release(bins);
+}
+
+ImageAtlas::ImageAtlas(uint16_t maximumSize_)
+    : maximumSize(maximumSize_),
+      dirtyTop(std::numeric_limits<uint32_t>::max()) {
+}
+
+ImageAtlas::~ImageAtlas() = default;
+
+std::unique_ptr<ImageAtlasReference> ImageAtlas::addImages(const ImageMap& icons, const ImageMap& patterns) {
+    ImagePositions iconPositions;
+    ImagePositions patternPositions;
+    std::vector<mapbox::Bin*> referenced;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        auto addAll = [&](const ImageMap& map, ImageType type, ImagePositions& positions) {
+            for (const auto& entry : map) {
+                // Workers may still hold an image that has been updated since.
+                auto current = images.find(entry.first);
+                const Immutable<style::Image::Impl>& image = current != images.end() ? current->second : entry.second;
+
+                mapbox::Bin* bin = add({ entry.first, type }, image);
+                if (!bin) {
+                    continue;
+                }
+                referenced.push_back(bin);
+                positions.emplace(entry.first, ImagePosition{ *bin, *image });
+            }
+        };
+
+        addAll(icons, ImageType::Icon, iconPositions);
+        addAll(patterns, ImageType::Pattern, patternPositions);
+    }
+
+    return std::make_unique<ImageAtlasReference>(
+        shared_from_this(), std::move(iconPositions), std::move(patternPositions), std::move(referenced));
+}
+
+mapbox::Bin* ImageAtlas::add(const ImageKey& key, const Immutable<style::Image::Impl>& image_) {
+    auto it = bins.find(key);
+    if (it != bins.end() && !fits(*entries.at(it->second).image, *image_)) {
+        replace(it->second);
+        it = bins.end();
+    }
+
+    if (it == bins.end()) {
+        mapbox::Bin* bin = allocate(image_->image.size.width + 2 * padding, image_->image.size.height + 2 * padding);
+        if (!bin) {
+            return nullptr;
         }
+        Entry& entry = entries.emplace(bin, Entry{ key, image_ }).first->second;
+        entry.references = 1;
+        bins.emplace(key, bin);
+        draw(*bin, entry);
+        return bin;
+    }
+
+    // Images without references that haven't been replaced are in the list of unused images.
+    Entry& entry = entries.at(it->second);
+    if (entry.references++ == 0) {
+        unused.erase(entry.unused);
     }
+    return it->second;
 }
 
-} // namespace
+void ImageAtlas::draw(const mapbox::Bin& bin, const Entry& entry) {
+    const PremultipliedImage& src = entry.image->image;
+
+    // The bin may have held a larger image before, which mustn't bleed into the padding of this one.
+    PremultipliedImage::clear(image,
+                              { static_cast<uint32_t>(bin.x), static_cast<uint32_t>(bin.y) },
+                              { static_cast<uint32_t>(bin.maxw), static_cast<uint32_t>(bin.maxh) });
+
+    const uint32_t x = bin.x + padding;
+    const uint32_t y = bin.y + padding;
+    const uint32_t w = src.size.width;
+    const uint32_t h = src.size.height;
+    PremultipliedImage::copy(src, image, { 0, 0 }, { x, y }, src.size);
+
+    if (entry.key.second == ImageType::Pattern) {
+        // Add 1 pixel wrapped padding on each side of the image.
+        PremultipliedImage::copy(src, image, { 0, h - 1 }, { x, y - 1 }, { w, 1 }); // T
+        PremultipliedImage::copy(src, image, { 0,     0 }, { x, y + h }, { w, 1 }); // B
+        PremultipliedImage::copy(src, image, { w - 1, 0 }, { x - 1, y }, { 1, h }); // L
+        PremultipliedImage::copy(src, image, { 0,     0 }, { x + w, y }, { 1, h }); // R
+    }
 
-std::vector<ImagePatch> ImageAtlas::getImagePatchesAndUpdateVersions(const ImageManager& imageManager) {
-    std::vector<ImagePatch> imagePatches;
-    populateImagePatches(iconPositions, imageManager, imagePatches);
-    populateImagePatches(patternPositions, imageManager, imagePatches);
-    return imagePatches;
+    dirtyTop = std::min(dirtyTop, static_cast<uint32_t>(bin.y));
+    dirtyBottom = std::max(dirtyBottom, static_cast<uint32_t>(bin.y + bin.maxh));
 }
 
-ImageAtlas makeImageAtlas(const ImageMap& icons, const ImageMap& patterns, const std::unordered_map<std::string, uint32_t>& versionMap) {
-    ImageAtlas result;
+void ImageAtlas::updateImage(Immutable<style::Image::Impl> image_) {
+    std::lock_guard<std::mutex> lock(mutex);
 
-    mapbox::ShelfPack::ShelfPackOptions options;
-    options.autoResize = true;
-    mapbox::ShelfPack pack(0, 0, options);
+    for (ImageType type : { ImageType::Icon, ImageType::Pattern }) {
+        auto it = bins.find({ image_->id, type });
+        if (it == bins.end()) {
+            continue;
+        }
+
+        Entry& entry = entries.at(it->second);
+        if (fits(*entry.image, *image_)) {
+            entry.image = image_;
+            draw(*it->second, entry);
+        } else {
+            replace(it->second);
+        }
+    }
 
-    for (const auto& entry : icons) {
-        const style::Image::Impl& image = *entry.second;
-        const mapbox::Bin& bin = _packImage(pack, image, result, ImageType::Icon);
-        auto it = versionMap.find(entry.first);
-        auto version = it != versionMap.end() ? it->second : 0;
-        result.iconPositions.emplace(image.id, ImagePosition { bin, image, version });
+    auto current = images.find(image_->id);
+    if (current != images.end()) {
+        current->second = std::move(image_);
+    } else {
+        images.emplace(image_->id, std::move(image_));
     }
+}
+
+void ImageAtlas::removeImage(const std::string& id) {
+    std::lock_guard<std::mutex> lock(mutex);
 
-    for (const auto& entry : patterns) {
-        const style::Image::Impl& image = *entry.second;
-        const mapbox::Bin& bin = _packImage(pack, image, result, ImageType::Pattern);
-        auto it = versionMap.find(entry.first);
-        auto version = it != versionMap.end() ? it->second : 0;
-        result.patternPositions.emplace(image.id, ImagePosition { bin, image, version });
+    for (ImageType type : { ImageType::Icon, ImageType::Pattern }) {
+        auto it = bins.find({ id, type });
+        if (it != bins.end()) {
+            replace(it->second);
+        }
     }
 
-    pack.shrink();
-    result.image.resize({
-        static_cast<uint32_t>(pack.width()),
-        static_cast<uint32_t>(pack.height())
-    });
+    images.erase(id);
+}
+
+void ImageAtlas::release(const std::vector<mapbox::Bin*>& released) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    for (mapbox::Bin* bin : released) {
+        Entry& entry = entries.at(bin);
+        assert(entry.references > 0);
+        if (--entry.references == 0) {
+            if (entry.replaced) {
+                discard(bin);
+            } else {
+                entry.unused = unused.insert(unused.end(), bin);
+            }
+        }
+    }
+}
+
+void ImageAtlas::replace(mapbox::Bin* bin) {
+    Entry& entry = entries.at(bin);
+    bins.erase(entry.key);
+    if (entry.references == 0) {
+        unused.erase(entry.unused);
+        discard(bin);
+    } else {
+        entry.replaced = true;
+    }
+}
+
+void ImageAtlas::discard(mapbox::Bin* bin) {
+    entries.erase(bin);
+    pack.unref(*bin);
+}
+
+mapbox::Bin* ImageAtlas::allocate(int32_t width, int32_t height) {
+    if (mapbox::Bin* bin = pack.packOne(-1, width, height)) {
+        return bin;
+    }
+
+    // Make room by evicting unused images before growing the atlas.
+    while (!unused.empty()) {
+        mapbox::Bin* evicted = unused.front();
+        unused.pop_front();
+        bins.erase(entries.at(evicted).key);
+        discard(evicted);
+
+        if (mapbox::Bin* bin = pack.packOne(-1, width, height)) {
+            return bin;
+        }
+    }
+
+    while (grow()) {
+        if (mapbox::Bin* bin = pack.packOne(-1, width, height)) {
+            return bin;
+        }
+    }
+
+    return nullptr;
+}
+
+bool ImageAtlas::grow() {
+    int32_t width = pack.width();
+    int32_t height = pack.height();
+    if (width == 0 || height == 0) {
+        width = height = std::min<int32_t>(initialSize, maximumSize);
+    } else if (width <= height && width < maximumSize) {
+        width = std::min<int32_t>(width * 2, maximumSize);
+    } else if (height < maximumSize) {
+        height = std::min<int32_t>(height * 2, maximumSize);
+    } else if (width < maximumSize) {
+        width = std::min<int32_t>(width * 2, maximumSize);
+    } else {
+        return false;
+    }
+
+    pack.resize(width, height);
+    image.resize({ static_cast<uint32_t>(width), static_cast<uint32_t>(height) });
+    return true;
+}
+
+Size ImageAtlas::getSize() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return image.size;
+}
+
+void ImageAtlas::upload(gfx::UploadPass& uploadPass) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (!image.valid()) {
+        return;
+    }
+
+    if (!texture || texture->size != image.size) {
+        texture = uploadPass.createTexture(image);
+    } else if (dirtyTop < dirtyBottom) {
+        PremultipliedImage rows({ image.size.width, dirtyBottom - dirtyTop });
+        PremultipliedImage::copy(image, rows, { 0, dirtyTop }, { 0, 0 }, rows.size);
+        uploadPass.updateTextureSub(*texture, rows, 0, static_cast<uint16_t>(dirtyTop));
+    }
+
+    dirtyTop = std::numeric_limits<uint32_t>::max();
+    dirtyBottom = 0;
+}
 
-    return result;
+const gfx::Texture& ImageAtlas::getTexture() const {
+    assert(texture);
+    return *texture;
 }
 
 } // namespace mbgl
@@ -1,29 +1,33 @@
 #pragma once
 
+#include <mbgl/gfx/texture.hpp>
 #include <mbgl/style/image_impl.hpp>
+#include <mbgl/util/noncopyable.hpp>
+#include <mbgl/util/optional.hpp>
 #include <mbgl/util/rect.hpp>
 
 #include <mapbox/shelf-pack.hpp>
 
 #include <array>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 namespace mbgl {
 
 namespace gfx {
 class UploadPass;
-class Texture;
 } // namespace gfx
 
-class ImageManager;
-
 class ImagePosition {
 public:
-    ImagePosition(const mapbox::Bin&, const style::Image::Impl&, uint32_t version = 0);
+    ImagePosition(const mapbox::Bin&, const style::Image::Impl&);
 
     static constexpr const uint16_t padding = 1u;
     float pixelRatio;
     Rect<uint16_t> textureRect;
-    uint32_t version;
 
     std::array<uint16_t, 2> tl() const {
         return {{
@@ -62,25 +66,99 @@ public:
 
 using ImagePositions = std::map<std::string, ImagePosition>;
 
-class ImagePatch {
+class ImageAtlas;
+
+// Positions of a set of icons and patterns in an ImageAtlas. The images keep their positions for
+// as long as the reference is alive.
+class ImageAtlasReference : private util::noncopyable {
 public:
-    ImagePatch(Immutable<style::Image::Impl> image_,
-               const Rect<uint16_t>& textureRect_)
-        : image(std::move(image_))
-        , textureRect(textureRect_) {}
-    Immutable<style::Image::Impl> image;
-    Rect<uint16_t> textureRect;
+    ImageAtlasReference(std::shared_ptr<ImageAtlas>,
+                        ImagePositions iconPositions,
+                        ImagePositions patternPositions,
+                        std::vector<mapbox::Bin*> bins);
+    ~ImageAtlasReference();
+
+    const ImagePositions iconPositions;
+    const ImagePositions patternPositions;
+
+private:
+    std::shared_ptr<ImageAtlas> atlas;
+    std::vector<mapbox::Bin*> bins;
 };
 
-class ImageAtlas {
+// An icon and pattern atlas shared by all tiles of a renderer. Like the glyph atlas, it grows as
+// images are added, keeps unreferenced images until it runs out of space, and uploads only what
+// changed since the last frame.
+//
+// The ImageManager keeps the atlas up to date with the style images: an image that is replaced
+// by one of the same size is redrawn in place, so that all tiles pick it up without a new layout.
+// An image that changes size or is removed keeps its old position until the tiles using it are
+// laid out again.
+class ImageAtlas : public std::enable_shared_from_this<ImageAtlas> {
 public:
-    PremultipliedImage image;
-    ImagePositions iconPositions;
-    ImagePositions patternPositions;
+    explicit ImageAtlas(uint16_t maximumSize = 4096);
+    ~ImageAtlas();
 
-    std::vector<ImagePatch> getImagePatchesAndUpdateVersions(const ImageManager&);
-};
+    // Adds the icons and patterns that aren't in the atlas yet, and returns a reference to the
+    // positions of all of them. Images that don't fit into an atlas of the maximum size are left out.
+    std::unique_ptr<ImageAtlasReference> addImages(const ImageMap& icons, const ImageMap& patterns);
+
+    // Called by the ImageManager whenever a style image is added, updated or removed.
+    void updateImage(Immutable<style::Image::Impl>);
+    void removeImage(const std::string&);
+
+    Size getSize() const;
+
+    // Uploads the rows of the atlas that changed since the last upload, or all of it if the
+    // atlas grew.
+    void upload(gfx::UploadPass&);
+
+    // The texture of the atlas, as of the last upload.
+    const gfx::Texture& getTexture() const;
 
-ImageAtlas makeImageAtlas(const ImageMap&, const ImageMap&, const std::unordered_map<std::string, uint32_t>& versionMap);
+private:
+    friend class ImageAtlasReference;
+    void release(const std::vector<mapbox::Bin*>&);
+
+    using ImageKey = std::pair<std::string, ImageType>;
+
+    struct Entry {
+        Entry(ImageKey key_, Immutable<style::Image::Impl> image_)
+            : key(std::move(key_)), image(std::move(image_)) {}
+
+        ImageKey key;
+        Immutable<style::Image::Impl> image;
+        uint32_t references = 0;
+        // Whether another image took over the key; the bin is freed once it isn't referenced.
+        bool replaced = false;
+        // Position in the list of unused images, if there are no references.
+        std::list<mapbox::Bin*>::iterator unused;
+    };
+
+    mapbox::Bin* add(const ImageKey&, const Immutable<style::Image::Impl>&);
+    void draw(const mapbox::Bin&, const Entry&);
+    void replace(mapbox::Bin*);
+    void discard(mapbox::Bin*);
+    mapbox::Bin* allocate(int32_t width, int32_t height);
+    bool grow();
+
+    const uint16_t maximumSize;
+
+    mutable std::mutex mutex;
+    mapbox::ShelfPack pack;
+    PremultipliedImage image;
+    std::map<mapbox::Bin*, Entry> entries;
+    std::map<ImageKey, mapbox::Bin*> bins;
+    // Images without references, least recently used first.
+    std::list<mapbox::Bin*> unused;
+    // The current version of every style image.
+    ImageMap images;
+
+    // Rows of the image that changed since the last upload.
+    uint32_t dirtyTop;
+    uint32_t dirtyBottom = 0;
+
+    optional<gfx::Texture> texture;
+};
 
 } // namespace mbgl
@@ -1,4 +1,5 @@
 #include <mbgl/renderer/image_manager.hpp>
+#include <mbgl/renderer/image_atlas.hpp>
 
 #include <mbgl/actor/actor.hpp>
 #include <mbgl/actor/scheduler.hpp>
@@ -10,7 +11,9 @@ namespace mbgl {
 
 static ImageManagerObserver nullObserver;
 
-ImageManager::ImageManager() = default;
+ImageManager::ImageManager()
+    : atlas(std::make_shared<ImageAtlas>()) {
+}
 
 ImageManager::~ImageManager() = default;
 
@@ -44,6 +47,7 @@ void ImageManager::addImage(Immutable<style::Image::Impl> image_) {
         requestedImagesCacheSize += image_->image.bytes();
     }
     availableImages.emplace(image_->id);
+    atlas->updateImage(image_);
     images.emplace(image_->id, std::move(image_));
 }
 
@@ -61,11 +65,10 @@ bool ImageManager::updateImage(Immutable<style::Image::Impl> image_) {
             assert(static_cast<int64_t>(requestedImagesCacheSize + diff) >= 0ll);
             requestedImagesCacheSize += diff;
         }
-        updatedImageVersions.erase(image_->id);
-    } else {
-        updatedImageVersions[image_->id]++;
     }
 
+    // Images of the same size are redrawn in place, for all tiles that use them.
+    atlas->updateImage(image_);
     oldImage->second = std::move(image_);
 
     return sizeChanged;
@@ -83,7 +86,7 @@ void ImageManager::removeImage(const std::string& id) {
     }
     images.erase(it);
     availableImages.erase(id);
-    updatedImageVersions.erase(id);
+    atlas->removeImage(id);
 }
 
 const style::Image::Impl* ImageManager::getImage(const std::string& id) const {
@@ -241,21 +244,15 @@ void ImageManager::checkMissingAndNotify(ImageRequestor& requestor, const ImageR
 void ImageManager::notify(ImageRequestor& requestor, const ImageRequestPair& pair) const {
     ImageMap iconMap;
     ImageMap patternMap;
-    ImageVersionMap versionMap;
 
     for (const auto& dependency : pair.first) {
         auto it = images.find(dependency.first);
         if (it != images.end()) {
             dependency.second == ImageType::Pattern ? patternMap.emplace(*it) : iconMap.emplace(*it);
-
-            auto versionIt = updatedImageVersions.find(dependency.first);
-            if (versionIt != updatedImageVersions.end()) {
-                versionMap.emplace(versionIt->first, versionIt->second);
-            }
         }
     }
 
-    requestor.onImagesAvailable(std::move(iconMap), std::move(patternMap), std::move(versionMap), pair.second);
+    requestor.onImagesAvailable(std::move(iconMap), std::move(patternMap), pair.second);
 }
 
 void ImageManager::dumpDebugLogs() const {
@@ -4,6 +4,7 @@
 #include <mbgl/util/immutable.hpp>
 
 #include <map>
+#include <memory>
 #include <string>
 
 namespace mbgl {
@@ -15,6 +16,7 @@ namespace gfx {
 class UploadPass;
 } // namespace gfx
 
+class ImageAtlas;
 class ImageManagerObserver;
 class ImageRequestor;
 
@@ -49,7 +51,8 @@ public:
     void reduceMemoryUseIfCacheSizeExceedsLimit();
     const std::set<std::string>& getAvailableImages() const;
 
-    ImageVersionMap updatedImageVersions;
+    // The atlas that the icons and patterns of all tiles are packed into.
+    const std::shared_ptr<ImageAtlas>& getAtlas() const { return atlas; }
 
 private:
     void checkMissingAndNotify(ImageRequestor&, const ImageRequestPair&);
@@ -67,13 +70,15 @@ private:
     std::set<std::string> availableImages;
 
     ImageManagerObserver* observer = nullptr;
+
+    std::shared_ptr<ImageAtlas> atlas;
 };
 
 class ImageRequestor {
 public:
     explicit ImageRequestor(ImageManager&);
     virtual ~ImageRequestor();
-    virtual void onImagesAvailable(ImageMap icons, ImageMap patterns, ImageVersionMap versionMap, uint64_t imageCorrelationID) = 0;
+    virtual void onImagesAvailable(ImageMap icons, ImageMap patterns, uint64_t imageCorrelationID) = 0;
 
     void addPendingRequest(const std::string& imageId) { pendingRequests.insert(imageId); }
     bool hasPendingRequest(const std::string& imageId) const { return pendingRequests.count(imageId); }
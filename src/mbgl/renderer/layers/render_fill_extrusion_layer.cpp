@@ -5,6 +5,7 @@
 #include <mbgl/programs/fill_extrusion_program.hpp>
 #include <mbgl/programs/programs.hpp>
 #include <mbgl/renderer/buckets/fill_extrusion_bucket.hpp>
+#include <mbgl/renderer/image_atlas.hpp>
 #include <mbgl/renderer/image_manager.hpp>
 #include <mbgl/renderer/layers/render_fill_extrusion_layer.hpp>
 #include <mbgl/renderer/paint_parameters.hpp>
@@ -195,7 +196,7 @@ void RenderFillExtrusionLayer::render(PaintParameters& parameters) {
                         tile.translatedClipMatrix(evaluated.get<FillExtrusionTranslate>(),
                                                   evaluated.get<FillExtrusionTranslateAnchor>(),
                                                   parameters.state),
-                        tile.getIconAtlasTexture().size,
+                        parameters.imageAtlas.getTexture().size,
                         crossfade,
                         tile.id,
                         parameters.state,
@@ -208,7 +209,7 @@ void RenderFillExtrusionLayer::render(PaintParameters& parameters) {
                     patternPosA,
                     patternPosB,
                     FillExtrusionPatternProgram::TextureBindings{
-                        textures::image::Value{ tile.getIconAtlasTexture().getResource(), gfx::TextureFilterType::Linear },
+                        textures::image::Value{ parameters.imageAtlas.getTexture().getResource(), gfx::TextureFilterType::Linear },
                     },
                     name
                 );
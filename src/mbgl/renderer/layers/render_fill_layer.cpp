@@ -6,6 +6,7 @@
 #include <mbgl/programs/fill_program.hpp>
 #include <mbgl/programs/programs.hpp>
 #include <mbgl/renderer/buckets/fill_bucket.hpp>
+#include <mbgl/renderer/image_atlas.hpp>
 #include <mbgl/renderer/image_manager.hpp>
 #include <mbgl/renderer/layers/render_fill_layer.hpp>
 #include <mbgl/renderer/paint_parameters.hpp>
@@ -156,6 +157,7 @@ void RenderFillLayer::render(PaintParameters& parameters) {
                      FillOutlineProgram::TextureBindings{});
             }
         }
+        parameters.endTileClipping();
     } else {
         if (parameters.pass != RenderPass::Translucent) {
             return;
@@ -191,7 +193,7 @@ void RenderFillLayer::render(PaintParameters& parameters) {
                                               evaluated.get<FillTranslateAnchor>(),
                                               parameters.state),
                         parameters.backend.getDefaultRenderable().getSize(),
-                        tile.getIconAtlasTexture().size,
+                        parameters.imageAtlas.getTexture().size,
                         crossfade,
                         tile.id,
                         parameters.state,
@@ -233,7 +235,7 @@ void RenderFillLayer::render(PaintParameters& parameters) {
                      *bucket.triangleIndexBuffer,
                      bucket.triangleSegments,
                      FillPatternProgram::TextureBindings{
-                         textures::image::Value{ tile.getIconAtlasTexture().getResource(), gfx::TextureFilterType::Linear },
+                         textures::image::Value{ parameters.imageAtlas.getTexture().getResource(), gfx::TextureFilterType::Linear },
                      });
             }
             if (evaluated.get<FillAntialias>() && unevaluated.get<FillOutlineColor>().isUndefined()) {
@@ -243,10 +245,11 @@ void RenderFillLayer::render(PaintParameters& parameters) {
                      *bucket.lineIndexBuffer,
                      bucket.lineSegments,
                      FillOutlinePatternProgram::TextureBindings{
-                         textures::image::Value{ tile.getIconAtlasTexture().getResource(), gfx::TextureFilterType::Linear },
+                         textures::image::Value{ parameters.imageAtlas.getTexture().getResource(), gfx::TextureFilterType::Linear },
                      });
             }
         }
+        parameters.endTileClipping();
     }
 }
 
@@ -4,6 +4,7 @@
 #include <mbgl/programs/line_program.hpp>
 #include <mbgl/programs/programs.hpp>
 #include <mbgl/renderer/buckets/line_bucket.hpp>
+#include <mbgl/renderer/image_atlas.hpp>
 #include <mbgl/renderer/image_manager.hpp>
 #include <mbgl/renderer/layers/render_line_layer.hpp>
 #include <mbgl/renderer/paint_parameters.hpp>
@@ -170,7 +171,7 @@ void RenderLineLayer::render(PaintParameters& parameters) {
 
         } else if (!unevaluated.get<LinePattern>().isUndefined()) {
             const auto& linePatternValue = evaluated.get<LinePattern>().constantOr(Faded<expression::Image>{"", ""});
-            const Size& texsize = tile.getIconAtlasTexture().size;
+            const Size& texsize = parameters.imageAtlas.getTexture().size;
 
             optional<ImagePosition> posA = tile.getPattern(linePatternValue.from.id());
             optional<ImagePosition> posB = tile.getPattern(linePatternValue.to.id());
@@ -187,7 +188,7 @@ void RenderLineLayer::render(PaintParameters& parameters) {
                      posA,
                      posB,
                      LinePatternProgram::TextureBindings{
-                         textures::image::Value{ tile.getIconAtlasTexture().getResource(), gfx::TextureFilterType::Linear },
+                         textures::image::Value{ parameters.imageAtlas.getTexture().getResource(), gfx::TextureFilterType::Linear },
                      });
         } else if (!unevaluated.get<LineGradient>().getValue().isUndefined()) {
             assert(colorRampTexture);
@@ -217,6 +218,7 @@ void RenderLineLayer::render(PaintParameters& parameters) {
                  LineProgram::TextureBindings{});
         }
     }
+    parameters.endTileClipping();
 }
 
 namespace {
@@ -6,6 +6,7 @@
 #include <mbgl/renderer/render_tile.hpp>
 #include <mbgl/renderer/upload_parameters.hpp>
 #include <mbgl/renderer/paint_parameters.hpp>
+#include <mbgl/renderer/image_atlas.hpp>
 #include <mbgl/text/glyph_atlas.hpp>
 #include <mbgl/text/shaping.hpp>
 #include <mbgl/programs/programs.hpp>
@@ -124,14 +125,14 @@ void drawIcon(const DrawFn& draw,
     const bool iconScaled = layout.get<IconSize>().constantOr(1.0) != 1.0 || bucket.iconsNeedLinear;
     const bool iconTransformed = values.rotationAlignment == AlignmentType::Map || parameters.state.getPitch() != 0;
 
-    const gfx::TextureBinding textureBinding{ tile.getIconAtlasTexture().getResource(),
+    const gfx::TextureBinding textureBinding{ parameters.imageAtlas.getTexture().getResource(),
                                             sdfIcons ||
                                                     parameters.state.isChanging() ||
                                                     iconScaled || iconTransformed
                                                 ? gfx::TextureFilterType::Linear
                                                 : gfx::TextureFilterType::Nearest };
 
-    const Size& iconSize = tile.getIconAtlasTexture().size;
+    const Size& iconSize = parameters.imageAtlas.getTexture().size;
     const bool variablePlacedIcon = bucket.hasVariablePlacement && layout.get<IconTextFit>() != IconTextFitType::None;
 
     if (sdfIcons) {
@@ -194,8 +195,9 @@ void drawText(const DrawFn& draw,
     const bool alongLine = layout.get<SymbolPlacement>() != SymbolPlacementType::Point &&
         layout.get<TextRotationAlignment>() == AlignmentType::Map;
 
-    const Size& glyphTexSize = tile.getGlyphAtlasTexture().size;
-    const gfx::TextureBinding glyphTextureBinding{tile.getGlyphAtlasTexture().getResource(),
+    const gfx::Texture& glyphTexture = parameters.glyphAtlas.getTexture();
+    const Size& glyphTexSize = glyphTexture.size;
+    const gfx::TextureBinding glyphTextureBinding{glyphTexture.getResource(),
                                                   gfx::TextureFilterType::Linear};
 
     const auto drawGlyphs = [&](auto& program, const auto& uniforms, const auto& textures, SymbolSDFPart part) {
@@ -214,9 +216,9 @@ void drawText(const DrawFn& draw,
         const ZoomEvaluatedSize partiallyEvaluatedTextSize =
             bucket.textSizeBinder->evaluateForZoom(parameters.state.getZoom());
         const bool transformed = values.rotationAlignment == AlignmentType::Map || parameters.state.getPitch() != 0;
-        const Size& iconTexSize = tile.getIconAtlasTexture().size;
+        const Size& iconTexSize = parameters.imageAtlas.getTexture().size;
         const gfx::TextureBinding iconTextureBinding{
-            tile.getIconAtlasTexture().getResource(),
+            parameters.imageAtlas.getTexture().getResource(),
             parameters.state.isChanging() || transformed || !partiallyEvaluatedTextSize.isZoomConstant
                 ? gfx::TextureFilterType::Linear
                 : gfx::TextureFilterType::Nearest};
@@ -3,10 +3,20 @@
 #include <mbgl/renderer/render_static_data.hpp>
 #include <mbgl/renderer/render_source.hpp>
 #include <mbgl/renderer/render_tile.hpp>
+#include <mbgl/renderer/tile_mask.hpp>
+#include <mbgl/algorithm/update_tile_masks.hpp>
 #include <mbgl/gfx/command_encoder.hpp>
+#include <mbgl/gfx/context.hpp>
 #include <mbgl/gfx/render_pass.hpp>
+#include <mbgl/gfx/renderable.hpp>
+#include <mbgl/gfx/renderer_backend.hpp>
 #include <mbgl/gfx/cull_face_mode.hpp>
 #include <mbgl/map/transform_state.hpp>
+#include <mbgl/math/clamp.hpp>
+#include <mbgl/util/constants.hpp>
+
+#include <algorithm>
+#include <cmath>
 
 namespace mbgl {
 
@@ -36,7 +46,9 @@ PaintParameters::PaintParameters(gfx::Context& context_,
                     const TransformParameters& transformParams_,
                     RenderStaticData& staticData_,
                     LineAtlas& lineAtlas_,
-                    PatternAtlas& patternAtlas_)
+                    PatternAtlas& patternAtlas_,
+                    GlyphAtlas& glyphAtlas_,
+                    ImageAtlas& imageAtlas_)
     : context(context_),
     backend(backend_),
     encoder(context.createCommandEncoder()),
@@ -46,6 +58,8 @@ PaintParameters::PaintParameters(gfx::Context& context_,
     staticData(staticData_),
     lineAtlas(lineAtlas_),
     patternAtlas(patternAtlas_),
+    glyphAtlas(glyphAtlas_),
+    imageAtlas(imageAtlas_),
     mapMode(mode_),
     debugOptions(debugOptions_),
     timePoint(timePoint_),
@@ -106,26 +120,125 @@ bool tileIDsIdentical(const RenderTiles& renderTiles,
                       [](const RenderTile& a, const auto& b) { return a.id == b.first; });
 }
 
+// Adapts render tiles to algorithm::updateTileMasks().
+class ClippingTile {
+public:
+    void setMask(TileMask&& mask_) {
+        mask = std::move(mask_);
+    }
+
+    bool usedByRenderedLayers = true;
+    TileMask mask;
+};
+
+// Marks the tiles that neither cover nor are covered by another tile. Their draw calls only need to
+// be clipped to the tile boundaries.
+std::vector<bool> findIsolatedTiles(const RenderTiles& renderTiles) {
+    std::vector<std::pair<UnwrappedTileID, ClippingTile>> tiles;
+    tiles.reserve(renderTiles->size());
+    for (const RenderTile& renderTile : *renderTiles) {
+        tiles.emplace_back(renderTile.id, ClippingTile());
+    }
+    algorithm::updateTileMasks(tiles);
+
+    // Tiles that are partially covered by other tiles don't have a full mask, and neither they
+    // nor the tiles covering them are isolated.
+    const TileMask fullMask = { { 0, 0, 0 } };
+    std::vector<UnwrappedTileID> coveredTiles;
+    for (const auto& tile : tiles) {
+        if (tile.second.mask != fullMask) {
+            coveredTiles.push_back(tile.first);
+        }
+    }
+
+    std::vector<bool> isolated;
+    isolated.reserve(tiles.size());
+    for (const auto& tile : tiles) {
+        isolated.push_back(tile.second.mask == fullMask &&
+                           std::none_of(coveredTiles.begin(), coveredTiles.end(), [&](const UnwrappedTileID& id) {
+                               return tile.first.isChildOf(id);
+                           }));
+    }
+    return isolated;
+}
+
 } // namespace
 
+bool PaintParameters::canClipWithScissor() const {
+#ifndef NDEBUG
+    if (debugOptions & MapDebugOptions::StencilClip) {
+        return false;
+    }
+#endif
+    // Tiles are only axis-aligned rectangles on the screen when the map isn't rotated or tilted.
+    return state.getPitch() == 0 && state.getBearing() == 0;
+}
+
+gfx::ScissorRect PaintParameters::scissorRectForTile(const UnwrappedTileID& tileID) const {
+    const mat4 matrix = matrixForTile(tileID);
+    const Size size = backend.getDefaultRenderable().getSize();
+
+    const auto project = [&](double x, double y) {
+        vec4 position;
+        matrix::transformMat4(position, {{ x, y, 0, 1 }}, matrix);
+        return std::array<double, 2>{{ (position[0] / position[3] + 1) / 2 * size.width,
+                                       (position[1] / position[3] + 1) / 2 * size.height }};
+    };
+    // The rectangle covers the pixels whose centers are inside the tile, which is what a stencil
+    // mask would cover too, so that neighboring tiles neither overlap nor leave a gap.
+    const auto edge = [](double pixel, uint32_t max) {
+        return util::clamp(std::ceil(pixel - 0.5), 0.0, double(max));
+    };
+
+    const auto topLeft = project(0, 0);
+    const auto bottomRight = project(util::EXTENT, util::EXTENT);
+    const double left = edge(std::min(topLeft[0], bottomRight[0]), size.width);
+    const double right = edge(std::max(topLeft[0], bottomRight[0]), size.width);
+    const double bottom = edge(std::min(topLeft[1], bottomRight[1]), size.height);
+    const double top = edge(std::max(topLeft[1], bottomRight[1]), size.height);
+    return { static_cast<int32_t>(left),
+             static_cast<int32_t>(bottom),
+             { static_cast<uint32_t>(right - left), static_cast<uint32_t>(top - bottom) } };
+}
+
 void PaintParameters::renderTileClippingMasks(const RenderTiles& renderTiles) {
     if (!renderTiles || renderTiles->empty() || tileIDsIdentical(renderTiles, tileClippingMaskIDs)) {
         // The current stencil mask is for this source already; no need to draw another one.
         return;
     }
 
-    if (nextStencilID + renderTiles->size() > 256) {
+    tileClippingMaskIDs.clear();
+    tileScissorRects.clear();
+
+    // Tiles that don't overlap any other tile can't draw into another tile's area once they're
+    // clipped to their own rectangle, so they don't need a stencil mask.
+    const std::vector<bool> isolated = canClipWithScissor() ? findIsolatedTiles(renderTiles)
+                                                            : std::vector<bool>(renderTiles->size(), false);
+    std::vector<std::reference_wrapper<const RenderTile>> maskedTiles;
+    for (std::size_t i = 0; i < renderTiles->size(); ++i) {
+        const RenderTile& renderTile = (*renderTiles)[i];
+        if (isolated[i]) {
+            tileClippingMaskIDs.emplace(renderTile.id, 0);
+            tileScissorRects.emplace(renderTile.id, scissorRectForTile(renderTile.id));
+        } else {
+            maskedTiles.emplace_back(renderTile);
+        }
+    }
+
+    if (maskedTiles.empty()) {
+        return;
+    }
+
+    if (nextStencilID + maskedTiles.size() > 256) {
         // we'll run out of fresh IDs so we need to clear and start from scratch
         clearStencil();
     }
 
-    tileClippingMaskIDs.clear();
-
     auto& program = staticData.programs.clippingMask;
     const style::Properties<>::PossiblyEvaluated properties {};
     const ClippingMaskProgram::Binders paintAttributeData(properties, 0);
 
-    for (const RenderTile& renderTile : *renderTiles) {
+    for (const RenderTile& renderTile : maskedTiles) {
         const int32_t stencilID = nextStencilID++;
         tileClippingMaskIDs.emplace(renderTile.id, stencilID);
 
@@ -165,7 +278,14 @@ void PaintParameters::renderTileClippingMasks(const RenderTiles& renderTiles) {
     }
 }
 
-gfx::StencilMode PaintParameters::stencilModeForClipping(const UnwrappedTileID& tileID) const {
+gfx::StencilMode PaintParameters::stencilModeForClipping(const UnwrappedTileID& tileID) {
+    auto rect = tileScissorRects.find(tileID);
+    if (rect != tileScissorRects.end()) {
+        context.setScissorRect(rect->second);
+        return gfx::StencilMode::disabled();
+    }
+    context.setScissorRect(nullopt);
+
     auto it = tileClippingMaskIDs.find(tileID);
     assert(it != tileClippingMaskIDs.end());
     const int32_t id = it != tileClippingMaskIDs.end() ? it->second : 0b00000000;
@@ -177,6 +297,10 @@ gfx::StencilMode PaintParameters::stencilModeForClipping(const UnwrappedTileID&
                              gfx::StencilOpType::Replace };
 }
 
+void PaintParameters::endTileClipping() {
+    context.setScissorRect(nullopt);
+}
+
 gfx::StencilMode PaintParameters::stencilModeFor3D() {
     if (nextStencilID + 1 > 256) {
         clearStencil();
@@ -185,6 +309,7 @@ gfx::StencilMode PaintParameters::stencilModeFor3D() {
     // We're potentially destroying the stencil clipping mask in this pass. That means we'll have
     // to recreate it for the next source if any.
     tileClippingMaskIDs.clear();
+    tileScissorRects.clear();
 
     const int32_t id = nextStencilID++;
     return gfx::StencilMode{ gfx::StencilMode::NotEqual{ 0b11111111 },
@@ -8,6 +8,7 @@
 #include <mbgl/gfx/depth_mode.hpp>
 #include <mbgl/gfx/stencil_mode.hpp>
 #include <mbgl/gfx/color_mode.hpp>
+#include <mbgl/gfx/scissor_rect.hpp>
 #include <mbgl/util/mat4.hpp>
 
 #include <array>
@@ -23,6 +24,8 @@ class TransformState;
 class ImageManager;
 class LineAtlas;
 class PatternAtlas;
+class GlyphAtlas;
+class ImageAtlas;
 class UnwrappedTileID;
 
 namespace gfx {
@@ -54,7 +57,9 @@ public:
                     const TransformParameters&,
                     RenderStaticData&,
                     LineAtlas&,
-                    PatternAtlas&);
+                    PatternAtlas&,
+                    GlyphAtlas&,
+                    ImageAtlas&);
     ~PaintParameters();
 
     gfx::Context& context;
@@ -69,6 +74,8 @@ public:
     RenderStaticData& staticData;
     LineAtlas& lineAtlas;
     PatternAtlas& patternAtlas;
+    GlyphAtlas& glyphAtlas;
+    ImageAtlas& imageAtlas;
 
     RenderPass pass = RenderPass::Opaque;
     MapMode mapMode;
@@ -89,14 +96,22 @@ public:
     // Stencil handling
 public:
     void renderTileClippingMasks(const RenderTiles&);
-    gfx::StencilMode stencilModeForClipping(const UnwrappedTileID&) const;
+    // Tiles that don't overlap any other tile are clipped with a scissor rectangle instead of a
+    // stencil mask, which this sets up for the tile's draw calls. Call endTileClipping() once the
+    // layer is done, so that the scissor rectangle doesn't apply to other layers.
+    gfx::StencilMode stencilModeForClipping(const UnwrappedTileID&);
+    void endTileClipping();
     gfx::StencilMode stencilModeFor3D();
 
 private:
     void clearStencil();
+    bool canClipWithScissor() const;
+    gfx::ScissorRect scissorRectForTile(const UnwrappedTileID&) const;
 
     // This needs to be an ordered map so that we have the same order as the renderTiles.
+    // Tiles that are clipped with a scissor rectangle have the ID 0, which is never used for masks.
     std::map<UnwrappedTileID, int32_t> tileClippingMaskIDs;
+    std::map<UnwrappedTileID, gfx::ScissorRect> tileScissorRects;
     int32_t nextStencilID = 1;
 
 public:
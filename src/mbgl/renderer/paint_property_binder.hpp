@@ -10,11 +10,13 @@
 #include <mbgl/renderer/possibly_evaluated_property_value.hpp>
 #include <mbgl/renderer/paint_property_statistics.hpp>
 #include <mbgl/renderer/cross_faded_property_evaluator.hpp>
+#include <mbgl/renderer/bucket_serialization.hpp>
 #include <mbgl/util/variant.hpp>
 #include <mbgl/renderer/image_atlas.hpp>
 #include <mbgl/util/indexed_tuple.hpp>
 #include <mbgl/layout/pattern_layout.hpp>
 
+#include <algorithm>
 #include <bitset>
 
 namespace mbgl {
@@ -28,6 +30,45 @@ struct FeatureVertexRange {
 
 using FeatureVertexRangeMap = std::map<std::string, std::vector<FeatureVertexRange>>;
 
+inline void writeBucketData(util::BinaryWriter& writer, const FeatureVertexRangeMap& featureMap) {
+    writer.write<uint64_t>(featureMap.size());
+    for (const auto& pair : featureMap) {
+        writer.write(pair.first);
+        writer.write(pair.second);
+    }
+}
+
+inline bool readBucketData(util::BinaryReader& reader, FeatureVertexRangeMap& featureMap) {
+    uint64_t count;
+    if (!reader.read(count)) {
+        return false;
+    }
+    featureMap.clear();
+    for (uint64_t i = 0; i < count; ++i) {
+        std::string id;
+        std::vector<FeatureVertexRange> ranges;
+        if (!reader.read(id) || !reader.read(ranges)) {
+            return false;
+        }
+        featureMap.emplace(std::move(id), std::move(ranges));
+    }
+    return true;
+}
+
+// Tells which kind of binder wrote the data in the bucket cache.
+enum class PaintPropertyBinderKind : uint8_t {
+    Constant,
+    ConstantCrossFaded,
+    SourceFunction,
+    CompositeFunction,
+    CompositeCrossFaded
+};
+
+inline bool readBucketData(util::BinaryReader& reader, PaintPropertyBinderKind expected) {
+    PaintPropertyBinderKind kind;
+    return reader.read(kind) && kind == expected;
+}
+
 /*
    ZoomInterpolatedAttribute<Attr> is a 'compound' attribute, representing two values of the
    the base attribute Attr.  These two values are provided to the shader to allow interpolation
@@ -75,6 +116,42 @@ std::array<float, N*2> zoomInterpolatedAttributeValue(const std::array<float, N>
     return result;
 }
 
+// Values of a data-driven property that were evaluated for all features of a bucket before
+// the features are added to it. The features are expected to be looked up in the order in
+// which they were evaluated.
+template <class T>
+class EvaluatedFeatureValues {
+public:
+    void assign(std::vector<std::size_t> indices_, std::vector<T> values_) {
+        assert(indices_.size() == values_.size());
+        indices = std::move(indices_);
+        values = std::move(values_);
+        next = 0;
+    }
+
+    // Returns the value evaluated for the feature with the given index, if any.
+    optional<T> take(std::size_t index) {
+        const auto it = std::find(indices.begin() + next, indices.end(), index);
+        if (it == indices.end()) {
+            return nullopt;
+        }
+        next = it - indices.begin();
+        optional<T> value = std::move(values[next++]);
+        if (next == indices.size()) {
+            // All of the values are used up.
+            indices = {};
+            values = {};
+            next = 0;
+        }
+        return value;
+    }
+
+private:
+    std::vector<std::size_t> indices;
+    std::vector<T> values;
+    std::size_t next = 0;
+};
+
 /*
    PaintPropertyBinder is an abstract class serving as the interface definition for
    the strategy used for constructing, uploading, and binding paint property data as
@@ -109,11 +186,23 @@ public:
                                       const ImagePositions&, const optional<PatternDependency>&,
                                       const style::expression::Value&) = 0;
 
+    // Evaluates the property for all of the features that are going to be passed to
+    // `populateVertexVector()`, in the same order and along with their indices.
+    virtual void evaluateFeatures(const std::vector<const GeometryTileFeature*>&, const std::vector<std::size_t>&) {}
+
     virtual void updateVertexVectors(const FeatureStates&, const GeometryTileLayer&, const ImagePositions&) {}
 
     virtual void updateVertexVector(std::size_t, std::size_t, const GeometryTileFeature&, const FeatureState&) = 0;
 
     virtual void upload(gfx::UploadPass&) = 0;
+    virtual std::size_t getMemoryUsage() const { return 0; }
+
+    // Writes the attribute data populated so far to the bucket cache, and restores it into a
+    // binder that was created for the same property value. `deserialize()` returns false if
+    // the data was written by another kind of binder or is malformed.
+    virtual void serialize(util::BinaryWriter&) const = 0;
+    virtual bool deserialize(util::BinaryReader&) = 0;
+
     virtual void setPatternParameters(const optional<ImagePosition>&, const optional<ImagePosition>&, const CrossfadeParameters&) = 0;
     virtual std::tuple<ExpandToType<As, optional<gfx::AttributeBinding>>...> attributeBinding(const PossiblyEvaluatedType& currentValue) const = 0;
     virtual std::tuple<ExpandToType<As, float>...> interpolationFactor(float currentZoom) const = 0;
@@ -122,6 +211,30 @@ public:
     static std::unique_ptr<PaintPropertyBinder> create(const PossiblyEvaluatedType& value, float zoom, T defaultValue);
 
     PaintPropertyStatistics<T> statistics;
+
+protected:
+    void writeStatistics(util::BinaryWriter& writer) const {
+        const optional<T> max = statistics.max();
+        writer.write(bool(max));
+        if (max) {
+            writer.write(*max);
+        }
+    }
+
+    bool readStatistics(util::BinaryReader& reader) {
+        bool hasMax;
+        if (!reader.read(hasMax)) {
+            return false;
+        }
+        if (hasMax) {
+            T max;
+            if (!reader.read(max)) {
+                return false;
+            }
+            statistics.add(max);
+        }
+        return true;
+    }
 };
 
 template <class T, class A>
@@ -135,6 +248,10 @@ public:
                               const optional<PatternDependency>&, const style::expression::Value&) override {}
     void updateVertexVector(std::size_t, std::size_t, const GeometryTileFeature&, const FeatureState&) override {}
     void upload(gfx::UploadPass&) override {}
+    void serialize(util::BinaryWriter& writer) const override { writer.write(PaintPropertyBinderKind::Constant); }
+    bool deserialize(util::BinaryReader& reader) override {
+        return readBucketData(reader, PaintPropertyBinderKind::Constant);
+    }
     void setPatternParameters(const optional<ImagePosition>&, const optional<ImagePosition>&, const CrossfadeParameters&) override {};
 
     std::tuple<optional<gfx::AttributeBinding>> attributeBinding(const PossiblyEvaluatedPropertyValue<T>&) const override {
@@ -164,6 +281,12 @@ public:
                               const optional<PatternDependency>&, const style::expression::Value&) override {}
     void updateVertexVector(std::size_t, std::size_t, const GeometryTileFeature&, const FeatureState&) override {}
     void upload(gfx::UploadPass&) override {}
+    void serialize(util::BinaryWriter& writer) const override {
+        writer.write(PaintPropertyBinderKind::ConstantCrossFaded);
+    }
+    bool deserialize(util::BinaryReader& reader) override {
+        return readBucketData(reader, PaintPropertyBinderKind::ConstantCrossFaded);
+    }
 
     void setPatternParameters(const optional<ImagePosition>& posA, const optional<ImagePosition>& posB, const CrossfadeParameters&) override {
         if (!posA || !posB) {
@@ -204,13 +327,22 @@ public:
           defaultValue(std::move(defaultValue_)) {
     }
     void setPatternParameters(const optional<ImagePosition>&, const optional<ImagePosition>&, const CrossfadeParameters&) override {};
+    void evaluateFeatures(const std::vector<const GeometryTileFeature*>& features,
+                          const std::vector<std::size_t>& indices) override {
+        using style::expression::EvaluationContext;
+        evaluatedValues.assign(indices, expression.evaluate(EvaluationContext(), features, defaultValue));
+    }
+
     void populateVertexVector(const GeometryTileFeature& feature, std::size_t length, std::size_t index,
                               const ImagePositions&, const optional<PatternDependency>&,
                               const style::expression::Value& formattedSection) override {
         using style::expression::EvaluationContext;
-        auto evaluated = expression.evaluate(EvaluationContext(&feature).withFormattedSection(&formattedSection), defaultValue);
-        this->statistics.add(evaluated);
-        auto value = attributeValue(evaluated);
+        optional<T> evaluated = evaluatedValues.take(index);
+        if (!evaluated) {
+            evaluated = expression.evaluate(EvaluationContext(&feature).withFormattedSection(&formattedSection), defaultValue);
+        }
+        this->statistics.add(*evaluated);
+        auto value = attributeValue(*evaluated);
         auto elements = vertexVector.elements();
         for (std::size_t i = elements; i < length; ++i) {
             vertexVector.emplace_back(BaseVertex { value });
@@ -254,6 +386,20 @@ public:
         vertexBuffer = uploadPass.createVertexBuffer(std::move(vertexVector));
     }
 
+    std::size_t getMemoryUsage() const override { return vertexVector.bytes(); }
+
+    void serialize(util::BinaryWriter& writer) const override {
+        writer.write(PaintPropertyBinderKind::SourceFunction);
+        writeBucketData(writer, vertexVector);
+        writeBucketData(writer, featureMap);
+        this->writeStatistics(writer);
+    }
+
+    bool deserialize(util::BinaryReader& reader) override {
+        return readBucketData(reader, PaintPropertyBinderKind::SourceFunction) && readBucketData(reader, vertexVector) &&
+               readBucketData(reader, featureMap) && this->readStatistics(reader);
+    }
+
     std::tuple<optional<gfx::AttributeBinding>> attributeBinding(const PossiblyEvaluatedPropertyValue<T>& currentValue) const override {
         if (currentValue.isConstant()) {
             return {};
@@ -283,6 +429,7 @@ private:
     gfx::VertexVector<BaseVertex> vertexVector;
     optional<gfx::VertexBuffer<BaseVertex>> vertexBuffer;
     FeatureVertexRangeMap featureMap;
+    EvaluatedFeatureValues<T> evaluatedValues;
 };
 
 template <class T, class A>
@@ -299,14 +446,31 @@ public:
           zoomRange({zoom, zoom + 1}) {
     }
     void setPatternParameters(const optional<ImagePosition>&, const optional<ImagePosition>&, const CrossfadeParameters&) override {};
+    void evaluateFeatures(const std::vector<const GeometryTileFeature*>& features,
+                          const std::vector<std::size_t>& indices) override {
+        using style::expression::EvaluationContext;
+        const std::vector<T> min = expression.evaluate(EvaluationContext(zoomRange.min), features, defaultValue);
+        const std::vector<T> max = expression.evaluate(EvaluationContext(zoomRange.max), features, defaultValue);
+        std::vector<Range<T>> ranges;
+        ranges.reserve(features.size());
+        for (std::size_t i = 0; i < features.size(); ++i) {
+            ranges.emplace_back(min[i], max[i]);
+        }
+        evaluatedRanges.assign(indices, std::move(ranges));
+    }
+
     void populateVertexVector(const GeometryTileFeature& feature, std::size_t length, std::size_t index,
                               const ImagePositions&, const optional<PatternDependency>&,
                               const style::expression::Value& formattedSection) override {
         using style::expression::EvaluationContext;
-        Range<T> range = {
+        optional<Range<T>> evaluated = evaluatedRanges.take(index);
+        if (!evaluated) {
+            evaluated = Range<T>{
                 expression.evaluate(EvaluationContext(zoomRange.min, &feature).withFormattedSection(&formattedSection), defaultValue),
                 expression.evaluate(EvaluationContext(zoomRange.max, &feature).withFormattedSection(&formattedSection), defaultValue),
-        };
+            };
+        }
+        const Range<T>& range = *evaluated;
         this->statistics.add(range.min);
         this->statistics.add(range.max);
         AttributeValue value = zoomInterpolatedAttributeValue(
@@ -359,6 +523,20 @@ public:
         vertexBuffer = uploadPass.createVertexBuffer(std::move(vertexVector));
     }
 
+    std::size_t getMemoryUsage() const override { return vertexVector.bytes(); }
+
+    void serialize(util::BinaryWriter& writer) const override {
+        writer.write(PaintPropertyBinderKind::CompositeFunction);
+        writeBucketData(writer, vertexVector);
+        writeBucketData(writer, featureMap);
+        this->writeStatistics(writer);
+    }
+
+    bool deserialize(util::BinaryReader& reader) override {
+        return readBucketData(reader, PaintPropertyBinderKind::CompositeFunction) && readBucketData(reader, vertexVector) &&
+               readBucketData(reader, featureMap) && this->readStatistics(reader);
+    }
+
     std::tuple<optional<gfx::AttributeBinding>> attributeBinding(const PossiblyEvaluatedPropertyValue<T>& currentValue) const override {
         if (currentValue.isConstant()) {
             return {};
@@ -392,6 +570,7 @@ private:
     gfx::VertexVector<Vertex> vertexVector;
     optional<gfx::VertexBuffer<Vertex>> vertexBuffer;
     FeatureVertexRangeMap featureMap;
+    EvaluatedFeatureValues<Range<T>> evaluatedRanges;
 };
 
 template <class T, class A1, class A2>
@@ -461,6 +640,23 @@ public:
         }
     }
 
+    std::size_t getMemoryUsage() const override {
+        return patternToVertexVector.bytes() + zoomInVertexVector.bytes() + zoomOutVertexVector.bytes();
+    }
+
+    void serialize(util::BinaryWriter& writer) const override {
+        writer.write(PaintPropertyBinderKind::CompositeCrossFaded);
+        writeBucketData(writer, patternToVertexVector);
+        writeBucketData(writer, zoomInVertexVector);
+        writeBucketData(writer, zoomOutVertexVector);
+    }
+
+    bool deserialize(util::BinaryReader& reader) override {
+        return readBucketData(reader, PaintPropertyBinderKind::CompositeCrossFaded) &&
+               readBucketData(reader, patternToVertexVector) && readBucketData(reader, zoomInVertexVector) &&
+               readBucketData(reader, zoomOutVertexVector);
+    }
+
     std::tuple<optional<gfx::AttributeBinding>, optional<gfx::AttributeBinding>> attributeBinding(const PossiblyEvaluatedPropertyValue<Faded<T>>& currentValue) const override {
         if (currentValue.isConstant()) {
             return {};
@@ -598,6 +794,11 @@ public:
                        0)...});
     }
 
+    void evaluateFeatures(const std::vector<const GeometryTileFeature*>& features,
+                          const std::vector<std::size_t>& indices) {
+        util::ignore({(binders.template get<Ps>()->evaluateFeatures(features, indices), 0)...});
+    }
+
     void updateVertexVectors(const FeatureStates& states, const GeometryTileLayer& layer,
                              const ImagePositions& imagePositions) {
         util::ignore({(binders.template get<Ps>()->updateVertexVectors(states, layer, imagePositions), 0)...});
@@ -615,6 +816,24 @@ public:
         });
     }
 
+    std::size_t getMemoryUsage() const {
+        std::size_t bytes = 0;
+        util::ignore({
+            (bytes += binders.template get<Ps>()->getMemoryUsage(), 0)...
+        });
+        return bytes;
+    }
+
+    void serialize(util::BinaryWriter& writer) const {
+        util::ignore({(binders.template get<Ps>()->serialize(writer), 0)...});
+    }
+
+    bool deserialize(util::BinaryReader& reader) {
+        bool result = true;
+        util::ignore({(result = result && binders.template get<Ps>()->deserialize(reader), 0)...});
+        return result;
+    }
+
     template <class P>
     using ZoomInterpolatedAttributeList = typename Property<P>::ZoomInterpolatedAttributeList;
     template <class P>
@@ -17,10 +17,12 @@
 #include <mbgl/renderer/render_tile.hpp>
 #include <mbgl/renderer/style_diff.hpp>
 #include <mbgl/renderer/query.hpp>
+#include <mbgl/renderer/image_atlas.hpp>
 #include <mbgl/renderer/image_manager.hpp>
 #include <mbgl/geometry/line_atlas.hpp>
 #include <mbgl/style/source_impl.hpp>
 #include <mbgl/style/transition_options.hpp>
+#include <mbgl/text/glyph_atlas.hpp>
 #include <mbgl/text/glyph_manager.hpp>
 #include <mbgl/tile/tile.hpp>
 #include <mbgl/util/math.hpp>
@@ -62,6 +64,8 @@ public:
                    std::vector<std::unique_ptr<RenderItem>> sourceRenderItems_,
                    LineAtlas& lineAtlas_,
                    PatternAtlas& patternAtlas_,
+                   GlyphAtlas& glyphAtlas_,
+                   ImageAtlas& imageAtlas_,
                    std::vector<std::reference_wrapper<RenderLayer>> layersNeedPlacement_,
                    Immutable<Placement> placement_,
                    bool updateSymbolOpacities_)
@@ -70,6 +74,8 @@ public:
           sourceRenderItems(std::move(sourceRenderItems_)),
           lineAtlas(lineAtlas_),
           patternAtlas(patternAtlas_),
+          glyphAtlas(glyphAtlas_),
+          imageAtlas(imageAtlas_),
           layersNeedPlacement(std::move(layersNeedPlacement_)),
           placement(std::move(placement_)),
           updateSymbolOpacities(updateSymbolOpacities_) {}
@@ -91,11 +97,15 @@ public:
     }
     LineAtlas& getLineAtlas() const override { return lineAtlas; }
     PatternAtlas& getPatternAtlas() const override { return patternAtlas; }
+    GlyphAtlas& getGlyphAtlas() const override { return glyphAtlas; }
+    ImageAtlas& getImageAtlas() const override { return imageAtlas; }
 
     std::set<LayerRenderItem> layerRenderItems;
     std::vector<std::unique_ptr<RenderItem>> sourceRenderItems;
     std::reference_wrapper<LineAtlas> lineAtlas;
     std::reference_wrapper<PatternAtlas> patternAtlas;
+    std::reference_wrapper<GlyphAtlas> glyphAtlas;
+    std::reference_wrapper<ImageAtlas> imageAtlas;
     std::vector<std::reference_wrapper<RenderLayer>> layersNeedPlacement;
     Immutable<Placement> placement;
     bool updateSymbolOpacities;
@@ -170,7 +180,10 @@ std::unique_ptr<RenderTree> RenderOrchestrator::createRenderTree(const UpdatePar
         updateParameters.annotationManager,
         *imageManager,
         *glyphManager,
-        updateParameters.prefetchZoomDelta
+        updateParameters.prefetchZoomDelta,
+        updateParameters.parallelTileLayout,
+        updateParameters.bucketCachePath,
+        updateParameters.tileCacheSize
     };
 
     glyphManager->setURL(updateParameters.glyphURL);
@@ -402,11 +415,14 @@ std::unique_ptr<RenderTree> RenderOrchestrator::createRenderTree(const UpdatePar
                                                                   updateParameters.crossSourceCollisions,
                                                                   placementController.getPlacement());
 
+            std::vector<std::reference_wrapper<const RenderLayer>> layers;
+            layers.reserve(layersNeedPlacement.size());
             for (auto it = layersNeedPlacement.crbegin(); it != layersNeedPlacement.crend(); ++it) {
                 const RenderLayer& layer = *it;
                 usedSymbolLayers.insert(layer.getID());
-                placement->placeLayer(layer, renderTreeParameters->transformParams.projMatrix, updateParameters.debugOptions & MapDebugOptions::Collision);
+                layers.emplace_back(layer);
             }
+            placement->placeLayers(layers, renderTreeParameters->transformParams.projMatrix, updateParameters.debugOptions & MapDebugOptions::Collision);
 
             placement->commit(updateParameters.timePoint, updateParameters.transformState.getZoom());
             crossTileSymbolIndex.pruneUnusedLayers(usedSymbolLayers);
@@ -428,13 +444,16 @@ std::unique_ptr<RenderTree> RenderOrchestrator::createRenderTree(const UpdatePar
                                                                   updateParameters.mode,
                                                                   updateParameters.transitionOptions,
                                                                   updateParameters.crossSourceCollisions);
+            std::vector<std::reference_wrapper<const RenderLayer>> layers;
+            layers.reserve(layersNeedPlacement.size());
             for (auto it = layersNeedPlacement.crbegin(); it != layersNeedPlacement.crend(); ++it) {
                 const RenderLayer& layer = *it;
                 crossTileSymbolIndex.addLayer(layer, updateParameters.transformState.getLatLng().longitude());
-                placement->placeLayer(layer,
-                                      renderTreeParameters->transformParams.projMatrix,
-                                      updateParameters.debugOptions & MapDebugOptions::Collision);
+                layers.emplace_back(layer);
             }
+            placement->placeLayers(layers,
+                                   renderTreeParameters->transformParams.projMatrix,
+                                   updateParameters.debugOptions & MapDebugOptions::Collision);
             placement->commit(updateParameters.timePoint, updateParameters.transformState.getZoom());
             placementController.setPlacement(std::move(placement));
         }
@@ -460,6 +479,8 @@ std::unique_ptr<RenderTree> RenderOrchestrator::createRenderTree(const UpdatePar
                                             std::move(sourceRenderItems),
                                             *lineAtlas,
                                             *patternAtlas,
+                                            *glyphManager->getAtlas(),
+                                            *imageManager->getAtlas(),
                                             std::move(layersNeedPlacement),
                                             placementController.getPlacement(),
                                             symbolBucketsChanged);
@@ -79,16 +79,6 @@ optional<ImagePosition> RenderTile::getPattern(const std::string& pattern) const
     return renderData->getPattern(pattern);
 }
 
-const gfx::Texture& RenderTile::getGlyphAtlasTexture() const {
-    assert(renderData);
-    return renderData->getGlyphAtlasTexture();
-}
-
-const gfx::Texture& RenderTile::getIconAtlasTexture() const {
-    assert(renderData);
-    return renderData->getIconAtlasTexture();
-}
-
 void RenderTile::upload(gfx::UploadPass& uploadPass) const {
     assert(renderData);
     renderData->upload(uploadPass);
@@ -9,6 +9,8 @@
 
 namespace mbgl {
 
+class GlyphAtlas;
+class ImageAtlas;
 class PaintParameters;
 class PatternAtlas;
 
@@ -65,6 +67,8 @@ public:
     // Resources
     virtual LineAtlas& getLineAtlas() const = 0;
     virtual PatternAtlas& getPatternAtlas() const = 0;
+    virtual GlyphAtlas& getGlyphAtlas() const = 0;
+    virtual ImageAtlas& getImageAtlas() const = 0;
     // Parameters
     const RenderTreeParameters& getParameters() const {
         return *parameters;
@@ -8,8 +8,11 @@
 
 namespace mbgl {
 
-Renderer::Renderer(gfx::RendererBackend& backend, float pixelRatio_, const optional<std::string> localFontFamily_)
-    : impl(std::make_unique<Impl>(backend, pixelRatio_, localFontFamily_)) {}
+Renderer::Renderer(gfx::RendererBackend& backend,
+                   float pixelRatio_,
+                   const optional<std::string> localFontFamily_,
+                   const optional<std::string> programCacheDir_)
+    : impl(std::make_unique<Impl>(backend, pixelRatio_, localFontFamily_, programCacheDir_)) {}
 
 Renderer::~Renderer() {
     gfx::BackendScope guard { impl->backend };
@@ -32,6 +35,11 @@ void Renderer::render(const UpdateParameters& updateParameters) {
     }
 }
 
+void Renderer::warmUpPrograms() {
+    gfx::BackendScope guard { impl->backend };
+    impl->warmUpPrograms();
+}
+
 std::vector<Feature> Renderer::queryRenderedFeatures(const ScreenLineString& geometry, const RenderedQueryOptions& options) const {
     return impl->orchestrator.queryRenderedFeatures(geometry, options);
 }
@@ -8,10 +8,12 @@
 #include <mbgl/gfx/cull_face_mode.hpp>
 #include <mbgl/gfx/context.hpp>
 #include <mbgl/gfx/renderable.hpp>
+#include <mbgl/renderer/image_atlas.hpp>
 #include <mbgl/renderer/pattern_atlas.hpp>
 #include <mbgl/renderer/renderer_observer.hpp>
 #include <mbgl/renderer/render_static_data.hpp>
 #include <mbgl/renderer/render_tree.hpp>
+#include <mbgl/text/glyph_atlas.hpp>
 #include <mbgl/util/string.hpp>
 #include <mbgl/util/logging.hpp>
 
@@ -26,11 +28,13 @@ static RendererObserver& nullObserver() {
 
 Renderer::Impl::Impl(gfx::RendererBackend& backend_,
                      float pixelRatio_,
-                     optional<std::string> localFontFamily_)
+                     optional<std::string> localFontFamily_,
+                     optional<std::string> programCacheDir_)
     : orchestrator(!backend_.contextIsShared(), std::move(localFontFamily_))
     , backend(backend_)
     , observer(&nullObserver())
-    , pixelRatio(pixelRatio_) {
+    , pixelRatio(pixelRatio_)
+    , programCacheDir(std::move(programCacheDir_)) {
 
 }
 
@@ -42,6 +46,13 @@ void Renderer::Impl::setObserver(RendererObserver* observer_) {
     observer = observer_ ? observer_ : &nullObserver();
 }
 
+void Renderer::Impl::warmUpPrograms() {
+    if (!staticData) {
+        staticData = std::make_unique<RenderStaticData>(backend.getContext(), pixelRatio, programCacheDir);
+    }
+    staticData->programs.warmUp();
+}
+
 void Renderer::Impl::render(const RenderTree& renderTree) {
     if (renderState == RenderState::Never) {
         observer->onWillStartRenderingMap();
@@ -51,7 +62,7 @@ void Renderer::Impl::render(const RenderTree& renderTree) {
     const auto& renderTreeParameters = renderTree.getParameters();
 
     if (!staticData) {
-        staticData = std::make_unique<RenderStaticData>(backend.getContext(), pixelRatio);
+        staticData = std::make_unique<RenderStaticData>(backend.getContext(), pixelRatio, programCacheDir);
     }
     staticData->has3D = renderTreeParameters.has3D;
 
@@ -71,7 +82,9 @@ void Renderer::Impl::render(const RenderTree& renderTree) {
         renderTreeParameters.transformParams,
         *staticData,
         renderTree.getLineAtlas(),
-        renderTree.getPatternAtlas()
+        renderTree.getPatternAtlas(),
+        renderTree.getGlyphAtlas(),
+        renderTree.getImageAtlas()
     };
 
     parameters.symbolFadeChange = renderTreeParameters.symbolFadeChange;
@@ -94,6 +107,8 @@ void Renderer::Impl::render(const RenderTree& renderTree) {
         staticData->upload(*uploadPass);
         renderTree.getLineAtlas().upload(*uploadPass);
         renderTree.getPatternAtlas().upload(*uploadPass);
+        renderTree.getGlyphAtlas().upload(*uploadPass);
+        renderTree.getImageAtlas().upload(*uploadPass);
     }
 
     // - 3D PASS -------------------------------------------------------------------------------------
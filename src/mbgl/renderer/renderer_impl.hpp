@@ -19,7 +19,8 @@ class Renderer::Impl {
 public:
     Impl(gfx::RendererBackend&,
          float pixelRatio_,
-         optional<std::string> localFontFamily_);
+         optional<std::string> localFontFamily_,
+         optional<std::string> programCacheDir_);
     ~Impl();
 
 private:
@@ -29,6 +30,8 @@ private:
 
     void render(const RenderTree&);
 
+    void warmUpPrograms();
+
     void reduceMemoryUse();
 
     // TODO: Move orchestrator to Map::Impl.
@@ -39,6 +42,7 @@ private:
     RendererObserver* observer;
 
     const float pixelRatio;
+    const optional<std::string> programCacheDir;
     std::unique_ptr<RenderStaticData> staticData;
 
     enum class RenderState {
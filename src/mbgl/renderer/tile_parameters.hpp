@@ -2,7 +2,9 @@
 
 #include <mbgl/map/mode.hpp>
 
+#include <cstddef>
 #include <memory>
+#include <string>
 
 namespace mbgl {
 
@@ -23,6 +25,9 @@ public:
     ImageManager& imageManager;
     GlyphManager& glyphManager;
     const uint8_t prefetchZoomDelta;
+    const bool parallelTileLayout;
+    const std::string bucketCachePath;
+    const std::size_t tileCacheSize;
 };
 
 } // namespace mbgl
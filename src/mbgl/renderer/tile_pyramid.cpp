@@ -198,6 +198,7 @@ void TilePyramid::update(const std::vector<Immutable<style::LayerProperties>>& l
             (parameters.transformState.getMaxZoom() - parameters.transformState.getMinZoom() + 1) *
             0.5;
         cache.setSize(conservativeCacheSize);
+        cache.setMaxBytes(parameters.tileCacheSize);
     }
 
     // Remove stale tiles. This goes through the (sorted!) tiles map and retain set in lockstep
@@ -350,10 +351,6 @@ std::vector<Feature> TilePyramid::querySourceFeatures(const SourceQueryOptions&
     return result;
 }
 
-void TilePyramid::setCacheSize(size_t size) {
-    cache.setSize(size);
-}
-
 void TilePyramid::reduceMemoryUse() {
     cache.clear();
 }
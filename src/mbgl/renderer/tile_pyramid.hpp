@@ -56,7 +56,7 @@ public:
 
     std::vector<Feature> querySourceFeatures(const SourceQueryOptions&) const;
 
-    void setCacheSize(size_t);
+    // Releases all cached tiles.
     void reduceMemoryUse();
 
     void setObserver(TileObserver*);
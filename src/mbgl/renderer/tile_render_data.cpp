@@ -4,24 +4,8 @@ namespace mbgl {
 
 TileRenderData::TileRenderData() = default;
 
-TileRenderData::TileRenderData(std::shared_ptr<TileAtlasTextures> atlasTextures_)
-    : atlasTextures(std::move(atlasTextures_)) {
-}
-
 TileRenderData::~TileRenderData() = default;
 
-const gfx::Texture& TileRenderData::getGlyphAtlasTexture() const {
-    assert(atlasTextures);
-    assert(atlasTextures->glyph);
-    return *atlasTextures->glyph;
-}
-
-const gfx::Texture& TileRenderData::getIconAtlasTexture() const {
-    assert(atlasTextures);
-    assert(atlasTextures->icon);
-    return *atlasTextures->icon;
-}
-
 optional<ImagePosition> TileRenderData::getPattern(const std::string&) const {
     assert(false);
     return nullopt;
@@ -16,17 +16,9 @@ class Bucket;
 class LayerRenderData;
 class SourcePrepareParameters;
 
-class TileAtlasTextures {
-public:    
-    optional<gfx::Texture> glyph;
-    optional<gfx::Texture> icon;
-};
-
 class TileRenderData {
 public:
     virtual ~TileRenderData();
-    const gfx::Texture& getGlyphAtlasTexture() const;
-    const gfx::Texture& getIconAtlasTexture() const;
     // To be implemented for concrete tile types.
     virtual optional<ImagePosition> getPattern(const std::string&) const;
     virtual const LayerRenderData* getLayerRenderData(const style::Layer::Impl&) const;
@@ -36,8 +28,6 @@ public:
 
 protected:
     TileRenderData();
-    TileRenderData(std::shared_ptr<TileAtlasTextures>);
-    std::shared_ptr<TileAtlasTextures> atlasTextures;
 };
 
 template <typename BucketType>
@@ -42,6 +42,15 @@ public:
     const bool stillImageRequest;
     
     const bool crossSourceCollisions;
+
+    // Lay out the independent layer groups of each tile in parallel.
+    const bool parallelTileLayout;
+
+    // Directory of the bucket cache, or empty if it is disabled.
+    const std::string bucketCachePath;
+
+    // Memory budget of each source's tile cache, in bytes.
+    const std::size_t tileCacheSize;
 };
 
 } // namespace mbgl
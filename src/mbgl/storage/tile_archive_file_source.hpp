@@ -0,0 +1,34 @@
+#pragma once
+
+#include <mbgl/storage/file_source.hpp>
+
+#include <atomic>
+#include <vector>
+
+namespace mbgl {
+
+namespace util {
+template <typename T> class Thread;
+} // namespace util
+
+// Serves tiles from local MBTiles and PMTiles archives, addressed as `mbtiles:///path/to/file.mbtiles`
+// and `pmtiles:///path/to/file.pmtiles`. Requesting the URL of an archive returns TileJSON built
+// from its metadata, which points at the tiles of the archive, so archives can be used as the
+// `url` of vector and raster sources.
+class TileArchiveFileSource : public FileSource {
+public:
+    TileArchiveFileSource();
+    ~TileArchiveFileSource() override;
+
+    std::unique_ptr<AsyncRequest> request(const Resource&, Callback) override;
+
+    static bool acceptsURL(const std::string& url);
+
+    class Impl;
+
+private:
+    std::vector<std::unique_ptr<util::Thread<Impl>>> impls;
+    std::atomic<std::size_t> nextImpl{0};
+};
+
+} // namespace mbgl
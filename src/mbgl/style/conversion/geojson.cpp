@@ -1,6 +1,21 @@
 #include <mbgl/style/conversion/geojson.hpp>
-#include <mbgl/style/conversion/json.hpp>
 #include <mbgl/style/conversion_impl.hpp>
+#include <mbgl/util/geometry.hpp>
+#include <mbgl/util/mapped_file.hpp>
+#include <mbgl/util/rapidjson.hpp>
+#include <mbgl/util/string.hpp>
+
+#include <rapidjson/memorystream.h>
+#include <rapidjson/reader.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <exception>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace mbgl {
 namespace style {
@@ -10,8 +25,633 @@ optional<GeoJSON> Converter<GeoJSON>::operator()(const Convertible& value, Error
     return toGeoJSON(value, error);
 }
 
+namespace {
+
+// Collects the nested coordinate arrays of a geometry. The members of a GeoJSON object may come in
+// any order, so the depth they must have is only known once the type of the geometry is read.
+class CoordinateArrays {
+public:
+    bool empty() const {
+        return counts.empty();
+    }
+
+    void startArray() {
+        if (depth > 0) {
+            ++counts[depth - 1].back();
+        }
+        if (counts.size() <= depth) {
+            counts.resize(depth + 1);
+        }
+        counts[depth].push_back(0);
+        maximumDepth = std::max(maximumDepth, ++depth);
+    }
+
+    void endArray() {
+        --depth;
+    }
+
+    void addNumber(double number) {
+        // Only the longitude and latitude of a position are kept.
+        if (counts[depth - 1].back()++ < 2) {
+            numbers.push_back(number);
+        }
+        minimumNumberDepth = std::min(minimumNumberDepth, depth);
+        maximumNumberDepth = std::max(maximumNumberDepth, depth);
+    }
+
+    // Builds the geometry of the given type. Points are one array deep, multi points and line
+    // strings two, polygons and multi line strings three and multi polygons four.
+    template <class T>
+    optional<T> build(std::size_t expectedDepth, Error& error) const {
+        const bool positionsAtDepth = minimumNumberDepth > maximumNumberDepth ||
+                                      (minimumNumberDepth == expectedDepth && maximumNumberDepth == expectedDepth);
+        if (maximumDepth > expectedDepth || !positionsAtDepth) {
+            error = { "coordinates must be nested " + util::toString(expectedDepth) + " arrays deep" };
+            return nullopt;
+        }
+        const auto& positions = level(expectedDepth - 1);
+        if (std::any_of(positions.begin(), positions.end(), [](uint32_t count) { return count < 2; })) {
+            error = { "coordinates array must have at least 2 numbers" };
+            return nullopt;
+        }
+
+        Cursor cursor;
+        return buildElement(cursor, 0, Tag<T>());
+    }
+
+private:
+    // The position of the next array of every depth while building.
+    struct Cursor {
+        std::size_t arrays[4] = {};
+        std::size_t number = 0;
+    };
+
+    template <class T>
+    struct Tag {};
+
+    const std::vector<uint32_t>& level(std::size_t index) const {
+        static const std::vector<uint32_t> none;
+        return index < counts.size() ? counts[index] : none;
+    }
+
+    Point<double> buildElement(Cursor& cursor, std::size_t, Tag<Point<double>>) const {
+        const double x = numbers[cursor.number++];
+        const double y = numbers[cursor.number++];
+        return { x, y };
+    }
+
+    template <class T>
+    T buildElement(Cursor& cursor, std::size_t index, Tag<T>) const {
+        T result;
+        const uint32_t size = level(index)[cursor.arrays[index]++];
+        result.reserve(size);
+        for (uint32_t i = 0; i < size; ++i) {
+            result.push_back(buildElement(cursor, index + 1, Tag<typename T::value_type>()));
+        }
+        return result;
+    }
+
+    // For every depth, the number of children of each array at that depth, in order.
+    std::vector<std::vector<uint32_t>> counts;
+    std::vector<double> numbers;
+    std::size_t depth = 0;
+    std::size_t maximumDepth = 0;
+    std::size_t minimumNumberDepth = std::numeric_limits<std::size_t>::max();
+    std::size_t maximumNumberDepth = 0;
+};
+
+// The members of GeoJSON objects that are read. Any other members are skipped.
+enum class Member : uint8_t {
+    Other = 0,
+    Type = 1 << 0,
+    Coordinates = 1 << 1,
+    Geometry = 1 << 2,
+    Geometries = 1 << 3,
+    Features = 1 << 4,
+    Properties = 1 << 5,
+    Id = 1 << 6,
+};
+
+Member memberForKey(const char* key, std::size_t length) {
+    static const std::pair<const char*, Member> members[] = {
+        { "type", Member::Type },
+        { "coordinates", Member::Coordinates },
+        { "geometry", Member::Geometry },
+        { "geometries", Member::Geometries },
+        { "features", Member::Features },
+        { "properties", Member::Properties },
+        { "id", Member::Id },
+    };
+    for (const auto& member : members) {
+        if (std::strlen(member.first) == length && std::memcmp(member.first, key, length) == 0) {
+            return member.second;
+        }
+    }
+    return Member::Other;
+}
+
+// A GeoJSON object whose members are being read. Its type is only known after its "type" member,
+// so the members of all types are collected and the object is built once it ends.
+struct GeoJSONObject {
+    Member member = Member::Other; // The member whose value is being read.
+    uint8_t seenMembers = 0;       // Like rapidjson's FindMember, the first of duplicate members is used.
+
+    optional<std::string> type;
+    CoordinateArrays coordinates;
+    optional<mapbox::geometry::geometry_collection<double>> geometries;
+    optional<Geometry<double>> geometry;
+    optional<FeatureCollection> features;
+    optional<PropertyMap> properties;
+    optional<FeatureIdentifier> id;
+
+    // The first error of every invalid member. It is an error of the object only if its type uses
+    // that member.
+    std::vector<std::pair<Member, std::string>> memberErrors;
+
+    void invalidate(Member invalid, std::string message) {
+        if (invalid != Member::Other && check(invalid)) {
+            memberErrors.emplace_back(invalid, std::move(message));
+        }
+    }
+
+    bool check(Member used) const {
+        return std::none_of(memberErrors.begin(), memberErrors.end(), [&](const auto& entry) { return entry.first == used; });
+    }
+
+    bool check(Member used, Error& error) const {
+        for (const auto& entry : memberErrors) {
+            if (entry.first == used) {
+                error = { entry.second };
+                return false;
+            }
+        }
+        return true;
+    }
+
+    optional<Geometry<double>> toGeometry(Error& error) {
+        if (!type) {
+            error = { "Geometry must have a type property" };
+            return nullopt;
+        }
+
+        if (*type == "GeometryCollection") {
+            if (!check(Member::Geometries, error)) return nullopt;
+            if (!geometries) {
+                error = { "GeometryCollection must have a geometries property" };
+                return nullopt;
+            }
+            return { std::move(*geometries) };
+        }
+
+        if (!check(Member::Coordinates, error)) return nullopt;
+        if (coordinates.empty()) {
+            error = { *type + " geometry must have a coordinates property" };
+            return nullopt;
+        }
+
+        const auto wrap = [](auto built) -> optional<Geometry<double>> {
+            if (!built) return nullopt;
+            return { std::move(*built) };
+        };
+        if (*type == "Point") return wrap(coordinates.build<Point<double>>(1, error));
+        if (*type == "MultiPoint") return wrap(coordinates.build<MultiPoint<double>>(2, error));
+        if (*type == "LineString") return wrap(coordinates.build<LineString<double>>(2, error));
+        if (*type == "MultiLineString") return wrap(coordinates.build<MultiLineString<double>>(3, error));
+        if (*type == "Polygon") return wrap(coordinates.build<Polygon<double>>(3, error));
+        if (*type == "MultiPolygon") return wrap(coordinates.build<MultiPolygon<double>>(4, error));
+
+        error = { *type + " is not a valid geometry type" };
+        return nullopt;
+    }
+
+    optional<GeoJSONFeature> toFeature(Error& error) {
+        if (!type) {
+            error = { "Feature must have a type property" };
+            return nullopt;
+        }
+        if (*type != "Feature") {
+            error = { "Feature type must be Feature" };
+            return nullopt;
+        }
+        if (!check(Member::Geometry, error) || !check(Member::Properties, error) || !check(Member::Id, error)) {
+            return nullopt;
+        }
+        if (!geometry) {
+            error = { "Feature must have a geometry property" };
+            return nullopt;
+        }
+
+        GeoJSONFeature feature{ std::move(*geometry) };
+        if (properties) feature.properties = std::move(*properties);
+        if (id) feature.id = std::move(*id);
+        return { std::move(feature) };
+    }
+
+    optional<GeoJSON> toGeoJSON(Error& error) {
+        if (!type) {
+            error = { "GeoJSON must have a type property" };
+            return nullopt;
+        }
+
+        if (*type == "FeatureCollection") {
+            if (!check(Member::Features, error)) return nullopt;
+            if (!features) {
+                error = { "FeatureCollection must have features property" };
+                return nullopt;
+            }
+            return { std::move(*features) };
+        }
+
+        if (*type == "Feature") {
+            if (auto feature = toFeature(error)) return { std::move(*feature) };
+            return nullopt;
+        }
+
+        if (auto result = toGeometry(error)) return { std::move(*result) };
+        return nullopt;
+    }
+};
+
+// Builds GeoJSON from the events of a rapidjson SAX reader, so that the features are built directly
+// from the text instead of from a JSON document holding a copy of all of it.
+class GeoJSONHandler {
+public:
+    optional<GeoJSON> result;
+    Error error;
+
+    bool Null() {
+        switch (container()) {
+        case Container::Object: {
+            GeoJSONObject& object = objects.back();
+            if (object.member == Member::Geometry) {
+                object.geometry = Geometry<double>{};
+                return true;
+            }
+            if (object.member == Member::Properties || object.member == Member::Id) {
+                return true;
+            }
+            return scalar("null");
+        }
+        case Container::Objects:
+            if (objects.back().member == Member::Geometries) {
+                objects.back().geometries->emplace_back();
+                return true;
+            }
+            objects.back().invalidate(Member::Features, "Feature must be an object");
+            return true;
+        case Container::Value:
+            addValue(NullValue());
+            return true;
+        default:
+            return scalar("null");
+        }
+    }
+
+    bool Bool(bool boolean) {
+        if (container() == Container::Value) {
+            addValue(boolean);
+            return true;
+        }
+        return scalar("a boolean");
+    }
+
+    bool Int(int number) { return Int64(number); }
+    bool Uint(unsigned number) { return Uint64(number); }
+
+    bool Int64(int64_t number) { return onNumber(number); }
+    bool Uint64(uint64_t number) { return onNumber(number); }
+    bool Double(double number) { return onNumber(number); }
+
+    bool RawNumber(const char*, rapidjson::SizeType, bool) {
+        return false;
+    }
+
+    bool String(const char* string, rapidjson::SizeType length, bool) {
+        if (container() == Container::Value) {
+            addValue(std::string(string, length));
+            return true;
+        }
+        if (container() == Container::Object) {
+            GeoJSONObject& object = objects.back();
+            if (object.member == Member::Type) {
+                object.type = std::string(string, length);
+                return true;
+            }
+            if (object.member == Member::Id) {
+                object.id = FeatureIdentifier(std::string(string, length));
+                return true;
+            }
+        }
+        return scalar("a string");
+    }
+
+    bool StartObject() {
+        switch (container()) {
+        case Container::None:
+            return startGeoJSONObject();
+        case Container::Object:
+            switch (objects.back().member) {
+            case Member::Geometry:
+                return startGeoJSONObject();
+            case Member::Properties:
+                values.emplace_back(true);
+                containers.push_back(Container::Value);
+                return true;
+            default:
+                break;
+            }
+            break;
+        case Container::Objects:
+            return startGeoJSONObject();
+        case Container::Value:
+            values.emplace_back(true);
+            containers.push_back(Container::Value);
+            return true;
+        default:
+            break;
+        }
+        return skip("an object");
+    }
+
+    bool Key(const char* key, rapidjson::SizeType length, bool) {
+        switch (container()) {
+        case Container::Object: {
+            GeoJSONObject& object = objects.back();
+            object.member = memberForKey(key, length);
+            const auto bit = static_cast<uint8_t>(object.member);
+            if (object.seenMembers & bit) {
+                object.member = Member::Other;
+            }
+            object.seenMembers |= bit;
+            return true;
+        }
+        case Container::Value:
+            values.back().key.assign(key, length);
+            return true;
+        default:
+            return true;
+        }
+    }
+
+    bool EndObject(rapidjson::SizeType) {
+        const Container ended = container();
+        containers.pop_back();
+        if (ended == Container::Value) {
+            endValue();
+            return true;
+        }
+        if (ended != Container::Object) {
+            return true;
+        }
+
+        GeoJSONObject object = std::move(objects.back());
+        objects.pop_back();
+        if (objects.empty()) {
+            result = object.toGeoJSON(error);
+            return bool(result);
+        }
+
+        GeoJSONObject& parent = objects.back();
+        Error objectError;
+        if (parent.member == Member::Features) {
+            if (auto feature = object.toFeature(objectError)) {
+                parent.features->push_back(std::move(*feature));
+            } else {
+                parent.invalidate(Member::Features, std::move(objectError.message));
+            }
+        } else if (parent.member == Member::Geometries) {
+            if (auto geometry = object.toGeometry(objectError)) {
+                parent.geometries->push_back(std::move(*geometry));
+            } else {
+                parent.invalidate(Member::Geometries, std::move(objectError.message));
+            }
+        } else {
+            assert(parent.member == Member::Geometry);
+            parent.geometry = object.toGeometry(objectError);
+            if (!parent.geometry) {
+                parent.invalidate(Member::Geometry, std::move(objectError.message));
+            }
+        }
+        return true;
+    }
+
+    bool StartArray() {
+        switch (container()) {
+        case Container::Object: {
+            GeoJSONObject& object = objects.back();
+            switch (object.member) {
+            case Member::Coordinates:
+                object.coordinates.startArray();
+                containers.push_back(Container::Coordinates);
+                return true;
+            case Member::Features:
+                object.features.emplace();
+                containers.push_back(Container::Objects);
+                return true;
+            case Member::Geometries:
+                object.geometries.emplace();
+                containers.push_back(Container::Objects);
+                return true;
+            default:
+                break;
+            }
+            break;
+        }
+        case Container::Coordinates:
+            objects.back().coordinates.startArray();
+            containers.push_back(Container::Coordinates);
+            return true;
+        case Container::Value:
+            values.emplace_back(false);
+            containers.push_back(Container::Value);
+            return true;
+        default:
+            break;
+        }
+        return skip("an array");
+    }
+
+    bool EndArray(rapidjson::SizeType) {
+        const Container ended = container();
+        containers.pop_back();
+        if (ended == Container::Coordinates) {
+            objects.back().coordinates.endArray();
+        } else if (ended == Container::Value) {
+            endValue();
+        }
+        return true;
+    }
+
+private:
+    enum class Container : uint8_t {
+        None,        // The root, outside of any container.
+        Object,      // A GeoJSON object.
+        Objects,     // The "features" or "geometries" of a GeoJSON object.
+        Coordinates, // An array of the "coordinates" of a geometry.
+        Value,       // An object or array of the "properties" of a feature.
+        Skipped,     // An object or array that is not read.
+    };
+
+    // A properties object or array that is being read.
+    struct ValueContainer {
+        explicit ValueContainer(bool isObject_) : isObject(isObject_) {}
+        bool isObject;
+        PropertyMap object;
+        mapbox::base::ValueArray array;
+        std::string key;
+    };
+
+    Container container() const {
+        return containers.empty() ? Container::None : containers.back();
+    }
+
+    bool startGeoJSONObject() {
+        objects.emplace_back();
+        containers.push_back(Container::Object);
+        return true;
+    }
+
+    template <class T>
+    bool onNumber(T number) {
+        switch (container()) {
+        case Container::Coordinates:
+            objects.back().coordinates.addNumber(static_cast<double>(number));
+            return true;
+        case Container::Value:
+            addValue(number);
+            return true;
+        case Container::Object:
+            if (objects.back().member == Member::Id) {
+                objects.back().id = FeatureIdentifier(number);
+                return true;
+            }
+            break;
+        default:
+            break;
+        }
+        return scalar("a number");
+    }
+
+    // Handles a value of the given kind that does not belong where it is.
+    bool scalar(const char* kind) {
+        switch (container()) {
+        case Container::None:
+            error = { "GeoJSON must be an object" };
+            return false;
+        case Container::Object:
+            return invalidMember(kind);
+        case Container::Objects:
+            objects.back().invalidate(objects.back().member, std::string("GeoJSON object must not be ") + kind);
+            return true;
+        case Container::Coordinates:
+            objects.back().invalidate(Member::Coordinates, std::string("coordinates must not contain ") + kind);
+            return true;
+        default:
+            return true;
+        }
+    }
+
+    bool invalidMember(const char* kind) {
+        GeoJSONObject& object = objects.back();
+        switch (object.member) {
+        case Member::Type:
+            object.invalidate(Member::Type, std::string("type must not be ") + kind);
+            return true;
+        case Member::Coordinates:
+            object.invalidate(Member::Coordinates, "coordinates must be an array");
+            return true;
+        case Member::Geometry:
+            object.invalidate(Member::Geometry, "geometry must be an object or null");
+            return true;
+        case Member::Geometries:
+            object.invalidate(Member::Geometries, "geometries must be an array");
+            return true;
+        case Member::Features:
+            object.invalidate(Member::Features, "features must be an array");
+            return true;
+        case Member::Properties:
+            object.invalidate(Member::Properties, "properties must be an object");
+            return true;
+        case Member::Id:
+            object.invalidate(Member::Id, "Feature id must be a string or number");
+            return true;
+        case Member::Other:
+            return true;
+        }
+        return true;
+    }
+
+    // Skips an object or array that does not belong where it is, along with everything in it.
+    bool skip(const char* kind) {
+        if (container() != Container::Skipped && !scalar(kind)) {
+            return false;
+        }
+        containers.push_back(Container::Skipped);
+        return true;
+    }
+
+    template <class T>
+    void addValue(T&& value) {
+        ValueContainer& parent = values.back();
+        if (parent.isObject) {
+            parent.object.emplace(std::move(parent.key), Value(std::forward<T>(value)));
+        } else {
+            parent.array.emplace_back(std::forward<T>(value));
+        }
+    }
+
+    void endValue() {
+        ValueContainer ended = std::move(values.back());
+        values.pop_back();
+        if (!values.empty()) {
+            if (ended.isObject) {
+                addValue(std::move(ended.object));
+            } else {
+                addValue(std::move(ended.array));
+            }
+        } else if (ended.isObject) {
+            objects.back().properties = std::move(ended.object);
+        } else {
+            objects.back().invalidate(Member::Properties, "properties must be an object");
+        }
+    }
+
+    std::vector<Container> containers;
+    std::vector<GeoJSONObject> objects;
+    std::vector<ValueContainer> values;
+};
+
+} // namespace
+
+optional<GeoJSON> parseGeoJSON(const char* data, std::size_t size, Error& error) {
+    GeoJSONHandler handler;
+    rapidjson::MemoryStream stream(data, size);
+    rapidjson::Reader reader;
+    const rapidjson::ParseResult parsed = reader.Parse<rapidjson::kParseDefaultFlags>(stream, handler);
+
+    if (handler.error.message.size()) {
+        error = std::move(handler.error);
+        return nullopt;
+    }
+    if (parsed.IsError()) {
+        error = { formatJSONParseError(parsed) };
+        return nullopt;
+    }
+    return std::move(handler.result);
+}
+
 optional<GeoJSON> parseGeoJSON(const std::string& value, Error& error) {
-    return convertJSON<GeoJSON>(value, error);
+    return parseGeoJSON(value.data(), value.size(), error);
+}
+
+optional<GeoJSON> parseGeoJSONFile(const std::string& path, Error& error) {
+    try {
+        const util::MappedFile file(path);
+        return parseGeoJSON(file.data(), file.size(), error);
+    } catch (const std::exception& ex) {
+        error = { ex.what() };
+        return nullopt;
+    }
 }
 
 } // namespace conversion
@@ -0,0 +1,1323 @@
+#include <mbgl/style/expression/compiled_expression.hpp>
+
+#include <mbgl/style/expression/assertion.hpp>
+#include <mbgl/style/expression/boolean_operator.hpp>
+#include <mbgl/style/expression/case.hpp>
+#include <mbgl/style/expression/coalesce.hpp>
+#include <mbgl/style/expression/compound_expression.hpp>
+#include <mbgl/style/expression/interpolate.hpp>
+#include <mbgl/style/expression/is_constant.hpp>
+#include <mbgl/style/expression/literal.hpp>
+#include <mbgl/style/expression/match.hpp>
+#include <mbgl/style/expression/step.hpp>
+#include <mbgl/style/expression/util.hpp>
+#include <mbgl/tile/geometry_tile_data.hpp>
+#include <mbgl/util/interpolate.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <functional>
+#include <unordered_map>
+
+namespace mbgl {
+namespace style {
+namespace expression {
+
+using Features = std::vector<const GeometryTileFeature*>;
+
+// The root of a compiled expression, which boxes the result of the typed nodes below it.
+class CompiledExpression::Node {
+public:
+    virtual ~Node() = default;
+    virtual bool evaluate(const EvaluationContext&, Value& result) const = 0;
+
+    // Column evaluation is available for number and color expressions only.
+    virtual bool evaluateColumn(EvaluationContext&, const Features&, std::vector<double>&, std::vector<bool>&) const {
+        return false;
+    }
+    virtual bool evaluateColumn(EvaluationContext&, const Features&, std::vector<Color>&, std::vector<bool>&) const {
+        return false;
+    }
+};
+
+namespace {
+
+// The result of an expression of type `string`. Strings of literals and feature properties
+// are borrowed rather than copied.
+class StringResult {
+public:
+    void borrow(const std::string& string) { borrowed = &string; }
+    void assign(std::string string) {
+        owned = std::move(string);
+        borrowed = nullptr;
+    }
+    const std::string& get() const { return borrowed ? *borrowed : owned; }
+
+private:
+    const std::string* borrowed = nullptr;
+    std::string owned;
+};
+
+// The result of an expression of type `value`. Feature properties are borrowed and only
+// converted to an expression value if the value is needed as a whole.
+class AnyResult {
+public:
+    void borrow(const mbgl::Value* property_) {
+        property = property_;
+        isProperty = true;
+    }
+
+    void assign(Value value_) {
+        value = std::move(value_);
+        isProperty = false;
+    }
+
+    bool isNull() const {
+        return isProperty ? (!property || property->is<NullValue>()) : value.is<NullValue>();
+    }
+
+    bool getNumber(double& result) const {
+        if (!isProperty) {
+            if (!value.is<double>()) return false;
+            result = value.get<double>();
+            return true;
+        }
+        if (!property) return false;
+        if (property->is<double>()) {
+            result = property->get<double>();
+        } else if (property->is<int64_t>()) {
+            result = static_cast<double>(property->get<int64_t>());
+        } else if (property->is<uint64_t>()) {
+            result = static_cast<double>(property->get<uint64_t>());
+        } else {
+            return false;
+        }
+        return true;
+    }
+
+    bool getBoolean(bool& result) const {
+        if (isProperty ? !(property && property->is<bool>()) : !value.is<bool>()) return false;
+        result = isProperty ? property->get<bool>() : value.get<bool>();
+        return true;
+    }
+
+    // The returned string lives as long as this result.
+    const std::string* getString() const {
+        if (isProperty) {
+            return property && property->is<std::string>() ? &property->get<std::string>() : nullptr;
+        }
+        return value.is<std::string>() ? &value.get<std::string>() : nullptr;
+    }
+
+    bool getString(StringResult& result) const {
+        const std::string* string = getString();
+        if (!string) return false;
+        if (isProperty) {
+            result.borrow(*string);
+        } else {
+            result.assign(*string);
+        }
+        return true;
+    }
+
+    Value toValue() const {
+        if (!isProperty) return value;
+        return property ? toExpressionValue(*property) : Null;
+    }
+
+private:
+    const mbgl::Value* property = nullptr;
+    Value value;
+    bool isProperty = false;
+};
+
+bool fromValue(const Value& value, double& result) {
+    if (!value.is<double>()) return false;
+    result = value.get<double>();
+    return true;
+}
+
+bool fromValue(const Value& value, bool& result) {
+    if (!value.is<bool>()) return false;
+    result = value.get<bool>();
+    return true;
+}
+
+bool fromValue(const Value& value, Color& result) {
+    if (!value.is<Color>()) return false;
+    result = value.get<Color>();
+    return true;
+}
+
+bool fromValue(const Value& value, StringResult& result) {
+    if (!value.is<std::string>()) return false;
+    result.assign(value.get<std::string>());
+    return true;
+}
+
+bool fromValue(const Value& value, AnyResult& result) {
+    result.assign(value);
+    return true;
+}
+
+Value toValue(double value) { return value; }
+Value toValue(bool value) { return value; }
+Value toValue(const Color& value) { return value; }
+Value toValue(const StringResult& value) { return value.get(); }
+Value toValue(const AnyResult& value) { return value.toValue(); }
+
+const std::string& unwrap(const StringResult& value) { return value.get(); }
+double unwrap(double value) { return value; }
+bool unwrap(bool value) { return value; }
+
+// Typed nodes return false if the evaluation fails, in which case the whole expression
+// is evaluated again by the tree in order to report the error.
+template <class T>
+class TypedNode {
+public:
+    virtual ~TypedNode() = default;
+    virtual bool evaluate(const EvaluationContext&, T& result) const = 0;
+
+    // Evaluates the node for each of the features and sets `valid[i]` to whether the
+    // evaluation for the i-th feature succeeded. `params` holds everything but the feature.
+    // Nodes that can process a whole column at once override this.
+    virtual void evaluateColumn(EvaluationContext& params,
+                                const Features& features,
+                                std::vector<T>& results,
+                                std::vector<bool>& valid) const {
+        for (std::size_t i = 0; i < features.size(); ++i) {
+            params.feature = features[i];
+            T value{};
+            valid[i] = evaluate(params, value);
+            results[i] = std::move(value);
+        }
+    }
+
+    // Returns the value of the node if it doesn't depend on the evaluation context.
+    virtual const T* getConstant() const { return nullptr; }
+};
+
+template <class T>
+using NodePtr = std::unique_ptr<const TypedNode<T>>;
+
+template <class T>
+bool evaluateColumn(const TypedNode<T>& node,
+                    EvaluationContext& params,
+                    const Features& features,
+                    std::vector<T>& results,
+                    std::vector<bool>& valid) {
+    node.evaluateColumn(params, features, results, valid);
+    return true;
+}
+
+template <class T, class Result>
+bool evaluateColumn(const TypedNode<T>&, EvaluationContext&, const Features&, std::vector<Result>&, std::vector<bool>&) {
+    return false;
+}
+
+// Returns the values of the nodes if they are all constant, or an empty vector otherwise.
+template <class T>
+std::vector<T> getConstants(const std::vector<NodePtr<T>>& nodes) {
+    std::vector<T> constants;
+    for (const auto& node : nodes) {
+        const T* constant = node->getConstant();
+        if (!constant) return {};
+        constants.push_back(*constant);
+    }
+    return constants;
+}
+
+template <class T>
+class Root final : public CompiledExpression::Node {
+public:
+    explicit Root(NodePtr<T> node_) : node(std::move(node_)) {}
+
+    bool evaluate(const EvaluationContext& params, Value& result) const override {
+        T value;
+        if (!node->evaluate(params, value)) return false;
+        result = toValue(value);
+        return true;
+    }
+
+    bool evaluateColumn(EvaluationContext& params,
+                        const Features& features,
+                        std::vector<double>& results,
+                        std::vector<bool>& valid) const override {
+        return expression::evaluateColumn(*node, params, features, results, valid);
+    }
+
+    bool evaluateColumn(EvaluationContext& params,
+                        const Features& features,
+                        std::vector<Color>& results,
+                        std::vector<bool>& valid) const override {
+        return expression::evaluateColumn(*node, params, features, results, valid);
+    }
+
+private:
+    const NodePtr<T> node;
+};
+
+// Evaluates a subtree that has no compiled equivalent.
+template <class T>
+class Fallback final : public TypedNode<T> {
+public:
+    explicit Fallback(const Expression& expression_) : expression(expression_) {}
+
+    bool evaluate(const EvaluationContext& params, T& result) const override {
+        const EvaluationResult value = expression.evaluate(params);
+        return value && fromValue(*value, result);
+    }
+
+private:
+    const Expression& expression;
+};
+
+template <class T>
+class Constant final : public TypedNode<T> {
+public:
+    explicit Constant(T value_) : value(std::move(value_)) {}
+
+    bool evaluate(const EvaluationContext&, T& result) const override {
+        result = value;
+        return true;
+    }
+
+    void evaluateColumn(EvaluationContext&,
+                        const Features&,
+                        std::vector<T>& results,
+                        std::vector<bool>& valid) const override {
+        std::fill(results.begin(), results.end(), value);
+        std::fill(valid.begin(), valid.end(), true);
+    }
+
+    const T* getConstant() const override { return &value; }
+
+private:
+    const T value;
+};
+
+template <>
+class Constant<StringResult> final : public TypedNode<StringResult> {
+public:
+    explicit Constant(std::string value_) : value(std::move(value_)) {}
+
+    bool evaluate(const EvaluationContext&, StringResult& result) const override {
+        result.borrow(value);
+        return true;
+    }
+
+private:
+    const std::string value;
+};
+
+template <class T>
+NodePtr<T> makeConstant(const Value& value) {
+    T result;
+    if (!fromValue(value, result)) return {};
+    return std::make_unique<Constant<T>>(std::move(result));
+}
+
+template <>
+NodePtr<StringResult> makeConstant<StringResult>(const Value& value) {
+    if (!value.is<std::string>()) return {};
+    return std::make_unique<Constant<StringResult>>(value.get<std::string>());
+}
+
+// Wraps a typed node for use where an expression of type `value` is expected.
+template <class T>
+class Boxed final : public TypedNode<AnyResult> {
+public:
+    explicit Boxed(NodePtr<T> node_) : node(std::move(node_)) {}
+
+    bool evaluate(const EvaluationContext& params, AnyResult& result) const override {
+        T value;
+        if (!node->evaluate(params, value)) return false;
+        result.assign(toValue(value));
+        return true;
+    }
+
+private:
+    const NodePtr<T> node;
+};
+
+class Zoom final : public TypedNode<double> {
+public:
+    bool evaluate(const EvaluationContext& params, double& result) const override {
+        if (!params.zoom) return false;
+        result = *params.zoom;
+        return true;
+    }
+};
+
+// ["heatmap-density"] and ["line-progress"]
+class ColorRampParameter final : public TypedNode<double> {
+public:
+    bool evaluate(const EvaluationContext& params, double& result) const override {
+        if (!params.colorRampParameter) return false;
+        result = *params.colorRampParameter;
+        return true;
+    }
+};
+
+class Get final : public TypedNode<AnyResult> {
+public:
+    explicit Get(std::string key_) : key(std::move(key_)) {}
+
+    bool evaluate(const EvaluationContext& params, AnyResult& result) const override {
+        if (!params.feature) return false;
+        result.borrow(params.feature->findValue(key));
+        return true;
+    }
+
+    void evaluateColumn(EvaluationContext&,
+                        const Features& features,
+                        std::vector<AnyResult>& results,
+                        std::vector<bool>& valid) const override {
+        for (std::size_t i = 0; i < features.size(); ++i) {
+            valid[i] = features[i] != nullptr;
+            if (valid[i]) results[i].borrow(features[i]->findValue(key));
+        }
+    }
+
+private:
+    const std::string key;
+};
+
+class Has final : public TypedNode<bool> {
+public:
+    explicit Has(std::string key_) : key(std::move(key_)) {}
+
+    bool evaluate(const EvaluationContext& params, bool& result) const override {
+        if (!params.feature) return false;
+        result = params.feature->findValue(key) != nullptr;
+        return true;
+    }
+
+private:
+    const std::string key;
+};
+
+bool extract(const AnyResult& value, double& result) { return value.getNumber(result); }
+bool extract(const AnyResult& value, bool& result) { return value.getBoolean(result); }
+bool extract(const AnyResult& value, StringResult& result) { return value.getString(result); }
+
+// ["number", ...], ["string", ...] and ["boolean", ...]
+template <class T>
+class Assert final : public TypedNode<T> {
+public:
+    explicit Assert(std::vector<NodePtr<AnyResult>> inputs_) : inputs(std::move(inputs_)) {}
+
+    bool evaluate(const EvaluationContext& params, T& result) const override {
+        AnyResult value;
+        for (const auto& input : inputs) {
+            if (!input->evaluate(params, value)) return false;
+            if (extract(value, result)) return true;
+        }
+        return false;
+    }
+
+    void evaluateColumn(EvaluationContext& params,
+                        const Features& features,
+                        std::vector<T>& results,
+                        std::vector<bool>& valid) const override {
+        if (inputs.size() != 1) {
+            TypedNode<T>::evaluateColumn(params, features, results, valid);
+            return;
+        }
+        std::vector<AnyResult> values(features.size());
+        inputs.front()->evaluateColumn(params, features, values, valid);
+        for (std::size_t i = 0; i < features.size(); ++i) {
+            T value{};
+            valid[i] = valid[i] && extract(values[i], value);
+            results[i] = std::move(value);
+        }
+    }
+
+private:
+    const std::vector<NodePtr<AnyResult>> inputs;
+};
+
+template <class T>
+class CaseNode final : public TypedNode<T> {
+public:
+    using Branch = std::pair<NodePtr<bool>, NodePtr<T>>;
+
+    CaseNode(std::vector<Branch> branches_, NodePtr<T> otherwise_)
+        : branches(std::move(branches_)), otherwise(std::move(otherwise_)) {}
+
+    bool evaluate(const EvaluationContext& params, T& result) const override {
+        for (const auto& branch : branches) {
+            bool test;
+            if (!branch.first->evaluate(params, test)) return false;
+            if (test) return branch.second->evaluate(params, result);
+        }
+        return otherwise->evaluate(params, result);
+    }
+
+private:
+    const std::vector<Branch> branches;
+    const NodePtr<T> otherwise;
+};
+
+template <class Key>
+using MatchBranches = std::unordered_map<Key, std::size_t>;
+
+const std::size_t* findBranch(const MatchBranches<std::string>& branches, const std::string* input) {
+    if (!input) return nullptr;
+    const auto it = branches.find(*input);
+    return it != branches.end() ? &it->second : nullptr;
+}
+
+const std::size_t* findBranch(const MatchBranches<std::string>& branches, const StringResult& input) {
+    return findBranch(branches, &input.get());
+}
+
+const std::size_t* findBranch(const MatchBranches<std::string>& branches, const AnyResult& input) {
+    return findBranch(branches, input.getString());
+}
+
+const std::size_t* findBranch(const MatchBranches<int64_t>& branches, double numeric) {
+    const int64_t rounded = std::floor(numeric);
+    if (numeric != rounded) return nullptr;
+    const auto it = branches.find(rounded);
+    return it != branches.end() ? &it->second : nullptr;
+}
+
+const std::size_t* findBranch(const MatchBranches<int64_t>& branches, const AnyResult& input) {
+    double numeric;
+    return input.getNumber(numeric) ? findBranch(branches, numeric) : nullptr;
+}
+
+// Branches that share an output expression share an output node.
+template <class Key, class Input, class T>
+class MatchNode final : public TypedNode<T> {
+public:
+    MatchNode(NodePtr<Input> input_,
+              MatchBranches<Key> branches_,
+              std::vector<NodePtr<T>> outputs_,
+              NodePtr<T> otherwise_)
+        : input(std::move(input_)),
+          branches(std::move(branches_)),
+          outputs(std::move(outputs_)),
+          otherwise(std::move(otherwise_)) {}
+
+    bool evaluate(const EvaluationContext& params, T& result) const override {
+        Input value;
+        if (!input->evaluate(params, value)) return false;
+        const std::size_t* branch = findBranch(branches, value);
+        return (branch ? outputs[*branch] : otherwise)->evaluate(params, result);
+    }
+
+    void evaluateColumn(EvaluationContext& params,
+                        const Features& features,
+                        std::vector<T>& results,
+                        std::vector<bool>& valid) const override {
+        std::vector<Input> values(features.size());
+        input->evaluateColumn(params, features, values, valid);
+        for (std::size_t i = 0; i < features.size(); ++i) {
+            if (!valid[i]) continue;
+            const std::size_t* branch = findBranch(branches, values[i]);
+            const TypedNode<T>& output = branch ? *outputs[*branch] : *otherwise;
+            if (const T* constant = output.getConstant()) {
+                results[i] = *constant;
+            } else {
+                params.feature = features[i];
+                T value{};
+                valid[i] = output.evaluate(params, value);
+                results[i] = std::move(value);
+            }
+        }
+    }
+
+private:
+    const NodePtr<Input> input;
+    const MatchBranches<Key> branches;
+    const std::vector<NodePtr<T>> outputs;
+    const NodePtr<T> otherwise;
+};
+
+// Converts the input like Step and Interpolate do and returns the index of the first stop
+// that is greater than the input, if any.
+bool findStop(const std::vector<double>& stops, double value, float& x, std::size_t& index) {
+    x = value;
+    if (std::isnan(x) || stops.empty()) return false;
+    index = std::upper_bound(stops.begin(), stops.end(), x) - stops.begin();
+    return true;
+}
+
+// Base of the nodes that evaluate their input first and pick outputs depending on it. In
+// column evaluation the input is evaluated for all features before any output is, and the
+// outputs are read from a table if they are all constant.
+template <class T>
+class StopsNode : public TypedNode<T> {
+public:
+    StopsNode(NodePtr<double> input_, std::vector<double> stops_, std::vector<NodePtr<T>> outputs_)
+        : input(std::move(input_)),
+          stops(std::move(stops_)),
+          outputs(std::move(outputs_)),
+          constants(getConstants(outputs)) {}
+
+    bool evaluate(const EvaluationContext& params, T& result) const final {
+        double value;
+        return input->evaluate(params, value) && evaluateStops(params, value, result);
+    }
+
+    void evaluateColumn(EvaluationContext& params,
+                        const Features& features,
+                        std::vector<T>& results,
+                        std::vector<bool>& valid) const final {
+        std::vector<double> values(features.size());
+        input->evaluateColumn(params, features, values, valid);
+        for (std::size_t i = 0; i < features.size(); ++i) {
+            if (!valid[i]) continue;
+            params.feature = features[i];
+            T value{};
+            valid[i] = evaluateStops(params, values[i], value);
+            results[i] = std::move(value);
+        }
+    }
+
+protected:
+    virtual bool evaluateStops(const EvaluationContext&, double input, T& result) const = 0;
+
+    bool evaluateOutput(const EvaluationContext& params, std::size_t index, T& result) const {
+        if (!constants.empty()) {
+            result = constants[index];
+            return true;
+        }
+        return outputs[index]->evaluate(params, result);
+    }
+
+    const NodePtr<double> input;
+    const std::vector<double> stops;
+    const std::vector<NodePtr<T>> outputs;
+    const std::vector<T> constants;
+};
+
+template <class T>
+class StepNode final : public StopsNode<T> {
+public:
+    using StopsNode<T>::StopsNode;
+
+private:
+    bool evaluateStops(const EvaluationContext& params, double value, T& result) const override {
+        float x;
+        std::size_t index;
+        if (!findStop(this->stops, value, x, index)) return false;
+        return this->evaluateOutput(params, index == 0 ? 0 : index - 1, result);
+    }
+};
+
+template <class T>
+class InterpolateNode final : public StopsNode<T> {
+public:
+    InterpolateNode(const Interpolate& expression_,
+                    NodePtr<double> input_,
+                    std::vector<double> stops_,
+                    std::vector<NodePtr<T>> outputs_)
+        : StopsNode<T>(std::move(input_), std::move(stops_), std::move(outputs_)), expression(expression_) {}
+
+private:
+    bool evaluateStops(const EvaluationContext& params, double value, T& result) const override {
+        const std::vector<double>& stopInputs = this->stops;
+        float x;
+        std::size_t index;
+        if (!findStop(stopInputs, value, x, index)) return false;
+        if (index == stopInputs.size()) return this->evaluateOutput(params, stopInputs.size() - 1, result);
+        if (index == 0) return this->evaluateOutput(params, 0, result);
+
+        const float t = expression.interpolationFactor({stopInputs[index - 1], stopInputs[index]}, x);
+        if (t == 0.0f) return this->evaluateOutput(params, index - 1, result);
+        if (t == 1.0f) return this->evaluateOutput(params, index, result);
+
+        T lower;
+        T upper;
+        if (!this->evaluateOutput(params, index - 1, lower) || !this->evaluateOutput(params, index, upper)) {
+            return false;
+        }
+        result = util::interpolate(lower, upper, t);
+        return true;
+    }
+
+    const Interpolate& expression;
+};
+
+class CoalesceNode final : public TypedNode<AnyResult> {
+public:
+    explicit CoalesceNode(std::vector<NodePtr<AnyResult>> args_) : args(std::move(args_)) {}
+
+    bool evaluate(const EvaluationContext& params, AnyResult& result) const override {
+        result.assign(Null);
+        for (const auto& arg : args) {
+            if (!arg->evaluate(params, result)) return false;
+            if (!result.isNull()) break;
+        }
+        return true;
+    }
+
+private:
+    const std::vector<NodePtr<AnyResult>> args;
+};
+
+// ["any", ...] and ["all", ...]
+template <bool any>
+class BooleanOperator final : public TypedNode<bool> {
+public:
+    explicit BooleanOperator(std::vector<NodePtr<bool>> inputs_) : inputs(std::move(inputs_)) {}
+
+    bool evaluate(const EvaluationContext& params, bool& result) const override {
+        for (const auto& input : inputs) {
+            if (!input->evaluate(params, result)) return false;
+            if (result == any) return true;
+        }
+        result = !any;
+        return true;
+    }
+
+private:
+    const std::vector<NodePtr<bool>> inputs;
+};
+
+class Not final : public TypedNode<bool> {
+public:
+    explicit Not(NodePtr<bool> input_) : input(std::move(input_)) {}
+
+    bool evaluate(const EvaluationContext& params, bool& result) const override {
+        if (!input->evaluate(params, result)) return false;
+        result = !result;
+        return true;
+    }
+
+private:
+    const NodePtr<bool> input;
+};
+
+// ["+", ...] and ["*", ...]
+template <class Op>
+class Reduction final : public TypedNode<double> {
+public:
+    Reduction(double initial_, std::vector<NodePtr<double>> args_) : initial(initial_), args(std::move(args_)) {}
+
+    bool evaluate(const EvaluationContext& params, double& result) const override {
+        result = initial;
+        for (const auto& arg : args) {
+            double value;
+            if (!arg->evaluate(params, value)) return false;
+            result = Op()(result, value);
+        }
+        return true;
+    }
+
+private:
+    const double initial;
+    const std::vector<NodePtr<double>> args;
+};
+
+// ["-", a, b] and ["/", a, b]
+template <class Op>
+class Binary final : public TypedNode<double> {
+public:
+    Binary(NodePtr<double> lhs_, NodePtr<double> rhs_) : lhs(std::move(lhs_)), rhs(std::move(rhs_)) {}
+
+    bool evaluate(const EvaluationContext& params, double& result) const override {
+        double a;
+        double b;
+        if (!lhs->evaluate(params, a) || !rhs->evaluate(params, b)) return false;
+        result = Op()(a, b);
+        return true;
+    }
+
+private:
+    const NodePtr<double> lhs;
+    const NodePtr<double> rhs;
+};
+
+class Negate final : public TypedNode<double> {
+public:
+    explicit Negate(NodePtr<double> input_) : input(std::move(input_)) {}
+
+    bool evaluate(const EvaluationContext& params, double& result) const override {
+        if (!input->evaluate(params, result)) return false;
+        result = -result;
+        return true;
+    }
+
+private:
+    const NodePtr<double> input;
+};
+
+// A comparison of two operands that have the same static type.
+template <class T, class Op>
+class Comparison final : public TypedNode<bool> {
+public:
+    Comparison(NodePtr<T> lhs_, NodePtr<T> rhs_) : lhs(std::move(lhs_)), rhs(std::move(rhs_)) {}
+
+    bool evaluate(const EvaluationContext& params, bool& result) const override {
+        T a;
+        T b;
+        if (!lhs->evaluate(params, a) || !rhs->evaluate(params, b)) return false;
+        result = Op()(unwrap(a), unwrap(b));
+        return true;
+    }
+
+private:
+    const NodePtr<T> lhs;
+    const NodePtr<T> rhs;
+};
+
+// ["==", value, literal] and ["!=", value, literal], which compare a feature property
+// without converting it.
+class EqualsConstant final : public TypedNode<bool> {
+public:
+    EqualsConstant(NodePtr<AnyResult> input_, Value constant_, bool negate_)
+        : input(std::move(input_)), constant(std::move(constant_)), negate(negate_) {}
+
+    bool evaluate(const EvaluationContext& params, bool& result) const override {
+        AnyResult value;
+        if (!input->evaluate(params, value)) return false;
+        result = constant.match(
+            [&](const std::string& string) {
+                const std::string* other = value.getString();
+                return other && *other == string;
+            },
+            [&](double number) {
+                double other;
+                return value.getNumber(other) && other == number;
+            },
+            [&](bool boolean) {
+                bool other;
+                return value.getBoolean(other) && other == boolean;
+            },
+            [&](const NullValue&) { return value.isNull(); },
+            [&](const auto&) { return value.toValue() == constant; });
+        if (negate) result = !result;
+        return true;
+    }
+
+private:
+    const NodePtr<AnyResult> input;
+    const Value constant;
+    const bool negate;
+};
+
+// ["==", a, b] and ["!=", a, b] with an operand of type `value`.
+class ValueEquality final : public TypedNode<bool> {
+public:
+    ValueEquality(NodePtr<AnyResult> lhs_, NodePtr<AnyResult> rhs_, bool negate_)
+        : lhs(std::move(lhs_)), rhs(std::move(rhs_)), negate(negate_) {}
+
+    bool evaluate(const EvaluationContext& params, bool& result) const override {
+        AnyResult a;
+        AnyResult b;
+        if (!lhs->evaluate(params, a) || !rhs->evaluate(params, b)) return false;
+        result = (a.toValue() == b.toValue()) != negate;
+        return true;
+    }
+
+private:
+    const NodePtr<AnyResult> lhs;
+    const NodePtr<AnyResult> rhs;
+    const bool negate;
+};
+
+// Ordering comparisons with an operand of type `value`, which require two strings or
+// two numbers at runtime.
+template <class Op>
+class ValueOrdering final : public TypedNode<bool> {
+public:
+    ValueOrdering(NodePtr<AnyResult> lhs_, NodePtr<AnyResult> rhs_) : lhs(std::move(lhs_)), rhs(std::move(rhs_)) {}
+
+    bool evaluate(const EvaluationContext& params, bool& result) const override {
+        AnyResult a;
+        AnyResult b;
+        if (!lhs->evaluate(params, a) || !rhs->evaluate(params, b)) return false;
+
+        double x;
+        double y;
+        if (a.getNumber(x) && b.getNumber(y)) {
+            result = Op()(x, y);
+            return true;
+        }
+        const std::string* s = a.getString();
+        const std::string* t = b.getString();
+        if (s && t) {
+            result = Op()(*s, *t);
+            return true;
+        }
+        return false;
+    }
+
+private:
+    const NodePtr<AnyResult> lhs;
+    const NodePtr<AnyResult> rhs;
+};
+
+std::vector<const Expression*> children(const Expression& expression) {
+    std::vector<const Expression*> result;
+    expression.eachChild([&](const Expression& child) { result.push_back(&child); });
+    return result;
+}
+
+// Variables are not visited by `eachChild()`, so treat them as never constant.
+bool hasVariables(const Expression& expression) {
+    if (expression.getKind() == Kind::Var) return true;
+    bool result = false;
+    expression.eachChild([&](const Expression& child) { result = result || hasVariables(child); });
+    return result;
+}
+
+bool isFoldable(const Expression& expression) {
+    return isFeatureConstant(expression) && isRuntimeConstant(expression) && !hasVariables(expression) &&
+           isGlobalPropertyConstant(expression,
+                                    std::array<std::string, 4>{{"zoom", "heatmap-density", "line-progress", "accumulated"}});
+}
+
+optional<std::string> getLiteralString(const Expression& expression) {
+    if (expression.getKind() != Kind::Literal) return nullopt;
+    const Value value = static_cast<const Literal&>(expression).getValue();
+    if (!value.is<std::string>()) return nullopt;
+    return value.get<std::string>();
+}
+
+class Compiler {
+public:
+    // Returns whether anything but fallbacks and constants was compiled.
+    bool hasCompiledNodes() const { return compiledNodes > 0; }
+
+    NodePtr<double> compileNumber(const Expression&);
+    NodePtr<bool> compileBoolean(const Expression&);
+    NodePtr<StringResult> compileString(const Expression&);
+    NodePtr<Color> compileColor(const Expression&);
+    NodePtr<AnyResult> compileAny(const Expression&);
+
+    template <class T>
+    NodePtr<T> compile(const Expression&);
+
+private:
+    template <class NodeType, class... Args>
+    std::unique_ptr<NodeType> make(Args&&... args) {
+        ++compiledNodes;
+        return std::make_unique<NodeType>(std::forward<Args>(args)...);
+    }
+
+    template <class T>
+    NodePtr<T> compileCommon(const Expression&);
+    template <class T>
+    NodePtr<T> compileMatch(const Expression&);
+    template <class Key, class Input, class T>
+    NodePtr<T> compileMatch(const Match<Key>&, NodePtr<Input>);
+    template <class T>
+    NodePtr<T> compileStep(const Step&);
+    template <class T>
+    NodePtr<T> compileInterpolate(const Interpolate&);
+    template <class T>
+    NodePtr<T> compileAssertion(const Expression&);
+    NodePtr<bool> compileComparison(const Expression&);
+
+    std::size_t compiledNodes = 0;
+};
+
+template <>
+NodePtr<double> Compiler::compile<double>(const Expression& expression) {
+    return compileNumber(expression);
+}
+
+template <>
+NodePtr<bool> Compiler::compile<bool>(const Expression& expression) {
+    return compileBoolean(expression);
+}
+
+template <>
+NodePtr<StringResult> Compiler::compile<StringResult>(const Expression& expression) {
+    return compileString(expression);
+}
+
+template <>
+NodePtr<Color> Compiler::compile<Color>(const Expression& expression) {
+    return compileColor(expression);
+}
+
+template <>
+NodePtr<AnyResult> Compiler::compile<AnyResult>(const Expression& expression) {
+    return compileAny(expression);
+}
+
+// Handles literals, constant subtrees and the operators that work with any output type.
+template <class T>
+NodePtr<T> Compiler::compileCommon(const Expression& expression) {
+    if (expression.getKind() == Kind::Literal) {
+        return makeConstant<T>(static_cast<const Literal&>(expression).getValue());
+    }
+
+    if (isFoldable(expression)) {
+        const EvaluationResult value = expression.evaluate(EvaluationContext());
+        if (value) {
+            if (auto constant = makeConstant<T>(*value)) {
+                return constant;
+            }
+        }
+    }
+
+    switch (expression.getKind()) {
+        case Kind::Case: {
+            const auto args = children(expression);
+            std::vector<typename CaseNode<T>::Branch> branches;
+            for (std::size_t i = 0; i + 1 < args.size(); i += 2) {
+                branches.emplace_back(compileBoolean(*args[i]), compile<T>(*args[i + 1]));
+            }
+            return make<CaseNode<T>>(std::move(branches), compile<T>(*args.back()));
+        }
+        case Kind::Match:
+            return compileMatch<T>(expression);
+        case Kind::Step:
+            return compileStep<T>(static_cast<const Step&>(expression));
+        default:
+            return {};
+    }
+}
+
+template <class T>
+NodePtr<T> Compiler::compileMatch(const Expression& expression) {
+    if (getMatchLabelType(expression) == type::String) {
+        const auto& match = static_cast<const Match<std::string>&>(expression);
+        const Expression& input = *match.getInput();
+        if (input.getType() == type::String) {
+            return compileMatch<std::string, StringResult, T>(match, compileString(input));
+        }
+        return compileMatch<std::string, AnyResult, T>(match, compileAny(input));
+    }
+
+    const auto& match = static_cast<const Match<int64_t>&>(expression);
+    const Expression& input = *match.getInput();
+    if (input.getType() == type::Number) {
+        return compileMatch<int64_t, double, T>(match, compileNumber(input));
+    }
+    return compileMatch<int64_t, AnyResult, T>(match, compileAny(input));
+}
+
+template <class Key, class Input, class T>
+NodePtr<T> Compiler::compileMatch(const Match<Key>& match, NodePtr<Input> input) {
+    MatchBranches<Key> branches;
+    std::vector<NodePtr<T>> outputs;
+    std::unordered_map<const Expression*, std::size_t> outputIndices;
+    for (const auto& branch : match.getBranches()) {
+        const auto inserted = outputIndices.emplace(branch.second.get(), outputs.size());
+        if (inserted.second) {
+            outputs.push_back(compile<T>(*branch.second));
+        }
+        branches.emplace(branch.first, inserted.first->second);
+    }
+    return make<MatchNode<Key, Input, T>>(
+        std::move(input), std::move(branches), std::move(outputs), compile<T>(*match.getOtherwise()));
+}
+
+template <class T>
+NodePtr<T> Compiler::compileStep(const Step& step) {
+    std::vector<double> stops;
+    std::vector<NodePtr<T>> outputs;
+    step.eachStop([&](double stop, const Expression& output) {
+        stops.push_back(stop);
+        outputs.push_back(compile<T>(output));
+    });
+    return make<StepNode<T>>(compileNumber(*step.getInput()), std::move(stops), std::move(outputs));
+}
+
+template <class T>
+NodePtr<T> Compiler::compileInterpolate(const Interpolate& interpolate) {
+    std::vector<double> stops;
+    std::vector<NodePtr<T>> outputs;
+    interpolate.eachStop([&](double stop, const Expression& output) {
+        stops.push_back(stop);
+        outputs.push_back(compile<T>(output));
+    });
+    return make<InterpolateNode<T>>(
+        interpolate, compileNumber(*interpolate.getInput()), std::move(stops), std::move(outputs));
+}
+
+template <class T>
+NodePtr<T> Compiler::compileAssertion(const Expression& expression) {
+    std::vector<NodePtr<AnyResult>> inputs;
+    expression.eachChild([&](const Expression& input) { inputs.push_back(compileAny(input)); });
+    return make<Assert<T>>(std::move(inputs));
+}
+
+template <template <class> class Op>
+NodePtr<bool> makeComparison(Compiler& compiler, const Expression& lhs, const Expression& rhs) {
+    const type::Type type = lhs.getType();
+    if (type == type::Number) {
+        return std::make_unique<Comparison<double, Op<double>>>(compiler.compileNumber(lhs), compiler.compileNumber(rhs));
+    } else if (type == type::String) {
+        return std::make_unique<Comparison<StringResult, Op<std::string>>>(compiler.compileString(lhs),
+                                                                          compiler.compileString(rhs));
+    } else {
+        return std::make_unique<Comparison<bool, Op<bool>>>(compiler.compileBoolean(lhs), compiler.compileBoolean(rhs));
+    }
+}
+
+NodePtr<bool> Compiler::compileComparison(const Expression& expression) {
+    const auto args = children(expression);
+    if (args.size() != 2) {
+        // Comparisons with a collator.
+        return {};
+    }
+
+    const Expression& lhs = *args[0];
+    const Expression& rhs = *args[1];
+    const std::string op = expression.getOperator();
+    const bool equality = op == "==" || op == "!=";
+
+    const type::Type type = lhs.getType();
+    if (type == rhs.getType() && (type == type::Number || type == type::String || type == type::Boolean)) {
+        ++compiledNodes;
+        if (op == "==") return makeComparison<std::equal_to>(*this, lhs, rhs);
+        if (op == "!=") return makeComparison<std::not_equal_to>(*this, lhs, rhs);
+        if (op == "<") return makeComparison<std::less>(*this, lhs, rhs);
+        if (op == ">") return makeComparison<std::greater>(*this, lhs, rhs);
+        if (op == "<=") return makeComparison<std::less_equal>(*this, lhs, rhs);
+        if (op == ">=") return makeComparison<std::greater_equal>(*this, lhs, rhs);
+        return {};
+    }
+
+    if (equality) {
+        if (rhs.getKind() == Kind::Literal) {
+            return make<EqualsConstant>(compileAny(lhs), static_cast<const Literal&>(rhs).getValue(), op == "!=");
+        }
+        if (lhs.getKind() == Kind::Literal) {
+            return make<EqualsConstant>(compileAny(rhs), static_cast<const Literal&>(lhs).getValue(), op == "!=");
+        }
+        return make<ValueEquality>(compileAny(lhs), compileAny(rhs), op == "!=");
+    }
+    if (op == "<") return make<ValueOrdering<std::less<>>>(compileAny(lhs), compileAny(rhs));
+    if (op == ">") return make<ValueOrdering<std::greater<>>>(compileAny(lhs), compileAny(rhs));
+    if (op == "<=") return make<ValueOrdering<std::less_equal<>>>(compileAny(lhs), compileAny(rhs));
+    if (op == ">=") return make<ValueOrdering<std::greater_equal<>>>(compileAny(lhs), compileAny(rhs));
+    return {};
+}
+
+NodePtr<double> Compiler::compileNumber(const Expression& expression) {
+    if (auto node = compileCommon<double>(expression)) {
+        return node;
+    }
+
+    switch (expression.getKind()) {
+        case Kind::Interpolate:
+            return compileInterpolate<double>(static_cast<const Interpolate&>(expression));
+        case Kind::Assertion:
+            return compileAssertion<double>(expression);
+        case Kind::CompoundExpression: {
+            const std::string op = expression.getOperator();
+            const auto args = children(expression);
+            if (op == "zoom") {
+                return make<Zoom>();
+            } else if (op == "heatmap-density" || op == "line-progress") {
+                return make<ColorRampParameter>();
+            } else if (op == "+" || op == "*") {
+                std::vector<NodePtr<double>> operands;
+                for (const Expression* arg : args) {
+                    operands.push_back(compileNumber(*arg));
+                }
+                if (op == "+") {
+                    return make<Reduction<std::plus<double>>>(0.0, std::move(operands));
+                }
+                return make<Reduction<std::multiplies<double>>>(1.0, std::move(operands));
+            } else if (op == "-" && args.size() == 1) {
+                return make<Negate>(compileNumber(*args[0]));
+            } else if (op == "-" && args.size() == 2) {
+                return make<Binary<std::minus<double>>>(compileNumber(*args[0]), compileNumber(*args[1]));
+            } else if (op == "/" && args.size() == 2) {
+                return make<Binary<std::divides<double>>>(compileNumber(*args[0]), compileNumber(*args[1]));
+            }
+            break;
+        }
+        default:
+            break;
+    }
+
+    return std::make_unique<Fallback<double>>(expression);
+}
+
+NodePtr<bool> Compiler::compileBoolean(const Expression& expression) {
+    if (auto node = compileCommon<bool>(expression)) {
+        return node;
+    }
+
+    switch (expression.getKind()) {
+        case Kind::Assertion:
+            return compileAssertion<bool>(expression);
+        case Kind::Comparison:
+            if (auto node = compileComparison(expression)) {
+                return node;
+            }
+            break;
+        case Kind::Any:
+        case Kind::All: {
+            std::vector<NodePtr<bool>> inputs;
+            expression.eachChild([&](const Expression& input) { inputs.push_back(compileBoolean(input)); });
+            if (expression.getKind() == Kind::Any) {
+                return make<BooleanOperator<true>>(std::move(inputs));
+            }
+            return make<BooleanOperator<false>>(std::move(inputs));
+        }
+        case Kind::CompoundExpression: {
+            const std::string op = expression.getOperator();
+            const auto args = children(expression);
+            if (op == "!") {
+                return make<Not>(compileBoolean(*args[0]));
+            } else if (op == "has" && args.size() == 1) {
+                if (auto key = getLiteralString(*args[0])) {
+                    return make<Has>(std::move(*key));
+                }
+            }
+            break;
+        }
+        default:
+            break;
+    }
+
+    return std::make_unique<Fallback<bool>>(expression);
+}
+
+NodePtr<StringResult> Compiler::compileString(const Expression& expression) {
+    if (auto node = compileCommon<StringResult>(expression)) {
+        return node;
+    }
+
+    if (expression.getKind() == Kind::Assertion) {
+        return compileAssertion<StringResult>(expression);
+    }
+
+    return std::make_unique<Fallback<StringResult>>(expression);
+}
+
+NodePtr<Color> Compiler::compileColor(const Expression& expression) {
+    if (auto node = compileCommon<Color>(expression)) {
+        return node;
+    }
+
+    if (expression.getKind() == Kind::Interpolate) {
+        return compileInterpolate<Color>(static_cast<const Interpolate&>(expression));
+    }
+
+    return std::make_unique<Fallback<Color>>(expression);
+}
+
+NodePtr<AnyResult> Compiler::compileAny(const Expression& expression) {
+    const type::Type type = expression.getType();
+    if (type == type::Number) {
+        return std::make_unique<Boxed<double>>(compileNumber(expression));
+    } else if (type == type::Boolean) {
+        return std::make_unique<Boxed<bool>>(compileBoolean(expression));
+    } else if (type == type::String) {
+        return std::make_unique<Boxed<StringResult>>(compileString(expression));
+    } else if (type == type::Color) {
+        return std::make_unique<Boxed<Color>>(compileColor(expression));
+    } else if (type != type::Value) {
+        return std::make_unique<Fallback<AnyResult>>(expression);
+    }
+
+    if (auto node = compileCommon<AnyResult>(expression)) {
+        return node;
+    }
+
+    if (expression.getKind() == Kind::Coalesce) {
+        std::vector<NodePtr<AnyResult>> args;
+        expression.eachChild([&](const Expression& arg) { args.push_back(compileAny(arg)); });
+        return make<CoalesceNode>(std::move(args));
+    }
+
+    if (expression.getKind() == Kind::CompoundExpression && expression.getOperator() == "get") {
+        const auto args = children(expression);
+        if (args.size() == 1) {
+            if (auto key = getLiteralString(*args[0])) {
+                return make<Get>(std::move(*key));
+            }
+        }
+    }
+
+    return std::make_unique<Fallback<AnyResult>>(expression);
+}
+
+template <class T>
+std::unique_ptr<const CompiledExpression::Node> makeRoot(NodePtr<T> node) {
+    return std::make_unique<Root<T>>(std::move(node));
+}
+
+} // namespace
+
+CompiledExpression::CompiledExpression(std::shared_ptr<const Expression> expression_,
+                                       std::unique_ptr<const Node> root_)
+    : expression(std::move(expression_)), root(std::move(root_)) {}
+
+CompiledExpression::~CompiledExpression() = default;
+
+std::unique_ptr<const CompiledExpression> CompiledExpression::compile(std::shared_ptr<const Expression> expression) {
+    assert(expression);
+    Compiler compiler;
+    std::unique_ptr<const Node> root;
+
+    const type::Type type = expression->getType();
+    if (type == type::Number) {
+        root = makeRoot(compiler.compileNumber(*expression));
+    } else if (type == type::Boolean) {
+        root = makeRoot(compiler.compileBoolean(*expression));
+    } else if (type == type::String) {
+        root = makeRoot(compiler.compileString(*expression));
+    } else if (type == type::Color) {
+        root = makeRoot(compiler.compileColor(*expression));
+    } else {
+        root = makeRoot(compiler.compileAny(*expression));
+    }
+
+    if (!compiler.hasCompiledNodes()) {
+        return {};
+    }
+    return std::unique_ptr<const CompiledExpression>(new CompiledExpression(std::move(expression), std::move(root)));
+}
+
+EvaluationResult CompiledExpression::evaluate(const EvaluationContext& params) const {
+    Value result;
+    if (root->evaluate(params, result)) {
+        return result;
+    }
+    return expression->evaluate(params);
+}
+
+EvaluationResult CompiledExpression::evaluate(optional<float> zoom,
+                                              const Feature& feature,
+                                              optional<double> colorRampParameter,
+                                              const std::set<std::string>& availableImages) const {
+    GeoJSONFeature f(feature);
+    return this->evaluate(EvaluationContext(zoom, &f, colorRampParameter).withAvailableImages(&availableImages));
+}
+
+template <class T>
+static bool evaluateRootColumn(const CompiledExpression::Node& root,
+                               const EvaluationContext& params,
+                               const Features& features,
+                               std::vector<T>& results,
+                               std::vector<bool>& valid) {
+    EvaluationContext featureParams = params;
+    results.assign(features.size(), T());
+    valid.assign(features.size(), false);
+    return root.evaluateColumn(featureParams, features, results, valid);
+}
+
+bool CompiledExpression::evaluate(const EvaluationContext& params,
+                                  const Features& features,
+                                  std::vector<double>& results,
+                                  std::vector<bool>& valid) const {
+    return evaluateRootColumn(*root, params, features, results, valid);
+}
+
+bool CompiledExpression::evaluate(const EvaluationContext& params,
+                                  const Features& features,
+                                  std::vector<Color>& results,
+                                  std::vector<bool>& valid) const {
+    return evaluateRootColumn(*root, params, features, results, valid);
+}
+
+} // namespace expression
+} // namespace style
+} // namespace mbgl
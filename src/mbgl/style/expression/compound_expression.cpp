@@ -223,7 +223,7 @@ static std::unique_ptr<detail::SignatureBase> makeSignature(std::string name, Fn
 
 } // namespace detail
 
-Value featureIdAsExpressionValue(EvaluationContext params) {
+Value featureIdAsExpressionValue(const EvaluationContext& params) {
     assert(params.feature);
     auto id = params.feature->getID();
     if (id.is<NullValue>()) return Null;
@@ -232,10 +232,31 @@ Value featureIdAsExpressionValue(EvaluationContext params) {
     });
 };
 
-optional<Value> featurePropertyAsExpressionValue(EvaluationContext params, const std::string& key) {
+// Compares a feature property with an expression value without converting the property, which
+// would copy strings.
+bool featurePropertyEquals(const EvaluationContext& params, const std::string& key, const Value& value) {
     assert(params.feature);
-    auto property = params.feature->getValue(key);
-    return property ? toExpressionValue(*property) : optional<Value>();
+    const mbgl::Value* property = params.feature->findValue(key);
+    if (!property) return false;
+    return value.match(
+        [&](const std::string& stringValue) {
+            return property->is<std::string>() && property->get<std::string>() == stringValue;
+        },
+        [&](double number) {
+            return property->match(
+                [&](double propertyNumber) { return propertyNumber == number; },
+                [&](uint64_t propertyNumber) { return static_cast<double>(propertyNumber) == number; },
+                [&](int64_t propertyNumber) { return static_cast<double>(propertyNumber) == number; },
+                [](const auto&) { return false; }
+            );
+        },
+        [&](bool boolean) {
+            return property->is<bool>() && property->get<bool>() == boolean;
+        },
+        [&](const auto&) {
+            return value == toExpressionValue(*property);
+        }
+    );
 };
 
 optional<std::string> featureTypeAsString(FeatureType type) {
@@ -253,29 +274,25 @@ optional<std::string> featureTypeAsString(FeatureType type) {
     }
 };
 
-optional<double> featurePropertyAsDouble(EvaluationContext params, const std::string& key) {
+optional<double> featurePropertyAsDouble(const EvaluationContext& params, const std::string& key) {
     assert(params.feature);
-    auto property = params.feature->getValue(key);
+    const mbgl::Value* property = params.feature->findValue(key);
     if (!property) return {};
     return property->match(
-        [](double value) { return value; },
+        [](double value) { return optional<double>(value); },
         [](uint64_t value) { return optional<double>(static_cast<double>(value)); },
         [](int64_t value) { return optional<double>(static_cast<double>(value)); },
-        [](auto) { return optional<double>(); }
+        [](const auto&) { return optional<double>(); }
     );
 };
 
-optional<std::string> featurePropertyAsString(EvaluationContext params, const std::string& key) {
+const std::string* featurePropertyAsString(const EvaluationContext& params, const std::string& key) {
     assert(params.feature);
-    auto property = params.feature->getValue(key);
-    if (!property) return {};
-    return property->match(
-        [](std::string value) { return value; },
-        [](auto) { return optional<std::string>(); }
-    );
+    const mbgl::Value* property = params.feature->findValue(key);
+    return property && property->is<std::string>() ? &property->get<std::string>() : nullptr;
 };
 
-optional<double> featureIdAsDouble(EvaluationContext params) {
+optional<double> featureIdAsDouble(const EvaluationContext& params) {
     assert(params.feature);
     auto id = params.feature->getID();
     return id.match(
@@ -286,7 +303,7 @@ optional<double> featureIdAsDouble(EvaluationContext params) {
     );
 };
 
-optional<std::string> featureIdAsString(EvaluationContext params) {
+optional<std::string> featureIdAsString(const EvaluationContext& params) {
     assert(params.feature);
     auto id = params.feature->getID();
     return id.match(
@@ -388,7 +405,7 @@ const auto& hasContextCompoundExpression() {
             };
         }
 
-        return params.feature->getValue(key) ? true : false;
+        return params.feature->findValue(key) != nullptr;
     });
     return signature;
 }
@@ -408,7 +425,7 @@ const auto& getContextCompoundExpression() {
             };
         }
 
-        auto propertyValue = params.feature->getValue(key);
+        const mbgl::Value* propertyValue = params.feature->findValue(key);
         if (!propertyValue) {
             return Null;
         }
@@ -693,8 +710,7 @@ const auto& featureStateCompoundExpression() {
 // Legacy Filters
 const auto& filterEqualsCompoundExpression() {
     static auto signature = detail::makeSignature("filter-==", [](const EvaluationContext& params, const std::string& key, const Value &lhs) -> Result<bool> {
-        const auto rhs = featurePropertyAsExpressionValue(params, key);
-        return rhs ? lhs == *rhs : false;
+        return featurePropertyEquals(params, key, lhs);
     });
     return signature;
 }
@@ -725,7 +741,7 @@ const auto& filterLessThanNumberCompoundExpression() {
 const auto& filterLessThanStringCompoundExpression() {
     static auto signature = detail::makeSignature("filter-<", [](const EvaluationContext& params, const std::string& key, std::string lhs) -> Result<bool> {
         auto rhs = featurePropertyAsString(params, key);
-        return rhs ? rhs < lhs : false;
+        return rhs ? *rhs < lhs : false;
     });
     return signature;
 }
@@ -757,7 +773,7 @@ const auto& filterMoreThanNumberCompoundExpression() {
 const auto& filterMoreThanStringCompoundExpression() {
     static auto signature = detail::makeSignature("filter->", [](const EvaluationContext& params, const std::string& key, std::string lhs) -> Result<bool> {
         auto rhs = featurePropertyAsString(params, key);
-        return rhs ? rhs > lhs : false;
+        return rhs ? *rhs > lhs : false;
     });
     return signature;
 }
@@ -789,7 +805,7 @@ const auto& filterLessOrEqualThanNumberCompoundExpression() {
 const auto& filterLessOrEqualThanStringCompoundExpression() {
     static auto signature = detail::makeSignature("filter-<=", [](const EvaluationContext& params, const std::string& key, std::string lhs) -> Result<bool> {
         auto rhs = featurePropertyAsString(params, key);
-        return rhs ? rhs <= lhs : false;
+        return rhs ? *rhs <= lhs : false;
     });
     return signature;
 }
@@ -821,7 +837,7 @@ const auto& filterGreaterOrEqualThanNumberCompoundExpression() {
 const auto& filterGreaterOrEqualThanStringCompoundExpression() {
     static auto signature = detail::makeSignature("filter->=", [](const EvaluationContext& params, const std::string& key, std::string lhs) -> Result<bool> {
         auto rhs = featurePropertyAsString(params, key);
-        return rhs ? rhs >= lhs : false;
+        return rhs ? *rhs >= lhs : false;
     });
     return signature;
 }
@@ -845,7 +861,7 @@ const auto& filterIdGreaterOrEqualThanStringCompoundExpression() {
 const auto& filterHasCompoundExpression() {
     static auto signature = detail::makeSignature("filter-has", [](const EvaluationContext& params, const std::string& key) -> Result<bool> {
         assert(params.feature);
-        return bool(params.feature->getValue(key));
+        return params.feature->findValue(key) != nullptr;
     });
     return signature;
 }
@@ -880,8 +896,10 @@ const auto& filterInCompoundExpression() {
     static auto signature = detail::makeSignature("filter-in", [](const EvaluationContext& params, const Varargs<Value>& varargs) -> Result<bool> {
         if (varargs.size() < 2) return false;
         assert(varargs[0].is<std::string>());
-        auto value = featurePropertyAsExpressionValue(params, varargs[0].get<std::string>());
-        return value ? std::find(varargs.begin() + 1, varargs.end(), *value) != varargs.end() : false;
+        const auto& key = varargs[0].get<std::string>();
+        return std::any_of(varargs.begin() + 1, varargs.end(), [&](const Value& value) {
+            return featurePropertyEquals(params, key, value);
+        });
     });
     return signature;
 }
@@ -223,6 +223,21 @@ static ParseResult create(type::Type outputType,
     ));
 }
 
+type::Type getMatchLabelType(const Expression& expression) {
+    assert(expression.getKind() == Kind::Match);
+    // Both instantiations share the same kind, so tell them apart by the first label of the
+    // serialized form, which is a literal label or an array of literal labels.
+    const mbgl::Value serialized = expression.serialize();
+    const mbgl::Value* label = &serialized.get<std::vector<mbgl::Value>>().at(2);
+    if (label->is<std::vector<mbgl::Value>>()) {
+        label = &label->get<std::vector<mbgl::Value>>().front();
+    }
+    if (label->is<std::string>()) {
+        return type::String;
+    }
+    return type::Number;
+}
+
 ParseResult parseMatch(const Convertible& value, ParsingContext& ctx) {
     assert(isArray(value));
     auto length = arrayLength(value);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <mbgl/style/expression/expression.hpp>
+#include <mbgl/tile/geometry_tile_data.hpp>
 #include <mbgl/util/color.hpp>
 
 namespace mbgl {
@@ -9,6 +10,27 @@ namespace expression {
 
 Result<Color> rgba(double r, double g, double b, double a);
 
+// Presents a GeoJSON feature to the expression evaluation.
+class GeoJSONFeature : public GeometryTileFeature {
+public:
+    const Feature& feature;
+
+    GeoJSONFeature(const Feature& feature_) : feature(feature_) {}
+
+    FeatureType getType() const override  {
+        return apply_visitor(ToFeatureType(), feature.geometry);
+    }
+    const PropertyMap& getProperties() const override { return feature.properties; }
+    FeatureIdentifier getID() const override { return feature.id; }
+    optional<mbgl::Value> getValue(const std::string& key) const override {
+        auto it = feature.properties.find(key);
+        if (it != feature.properties.end()) {
+            return optional<mbgl::Value>(it->second);
+        }
+        return optional<mbgl::Value>();
+    }
+};
+
 } // namespace expression
 } // namespace style
 } // namespace mbgl
@@ -8,7 +8,8 @@ bool Filter::operator()(const expression::EvaluationContext &context) const {
     
     if (!this->expression) return true;
     
-    const expression::EvaluationResult result = (*this->expression)->evaluate(context);
+    const expression::EvaluationResult result =
+        compiled ? compiled->evaluate(context) : (*this->expression)->evaluate(context);
     if (result) {
         const optional<bool> typed = expression::fromExpressionValue<bool>(*result);
         return typed ? *typed : false;
@@ -39,6 +39,10 @@ public:
     // Utility function for automatic layer grouping.
     virtual void stringifyLayout(rapidjson::Writer<rapidjson::StringBuffer>&) const = 0;
 
+    // Writes the data-driven paint properties, which are baked into buckets along with the
+    // layout properties. Used to key the bucket cache.
+    virtual void stringifyDataDrivenPaint(rapidjson::Writer<rapidjson::StringBuffer>&) const {}
+
     // Returns pointer to the statically allocated layer type info structure.
     virtual const LayerTypeInfo* getTypeInfo() const noexcept = 0;
 
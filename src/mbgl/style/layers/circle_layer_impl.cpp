@@ -11,5 +11,9 @@ bool CircleLayer::Impl::hasLayoutDifference(const Layer::Impl& other) const {
            paint.hasDataDrivenPropertyDifference(impl.paint);
 }
 
+void CircleLayer::Impl::stringifyDataDrivenPaint(rapidjson::Writer<rapidjson::StringBuffer>& writer) const {
+    paint.stringifyDataDriven(writer);
+}
+
 } // namespace style
 } // namespace mbgl
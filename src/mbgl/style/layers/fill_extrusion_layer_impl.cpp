@@ -11,5 +11,9 @@ bool FillExtrusionLayer::Impl::hasLayoutDifference(const Layer::Impl& other) con
            paint.hasDataDrivenPropertyDifference(impl.paint);
 }
 
+void FillExtrusionLayer::Impl::stringifyDataDrivenPaint(rapidjson::Writer<rapidjson::StringBuffer>& writer) const {
+    paint.stringifyDataDriven(writer);
+}
+
 } // namespace style
 } // namespace mbgl
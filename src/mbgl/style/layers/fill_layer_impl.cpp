@@ -11,5 +11,9 @@ bool FillLayer::Impl::hasLayoutDifference(const Layer::Impl& other) const {
            paint.hasDataDrivenPropertyDifference(impl.paint);
 }
 
+void FillLayer::Impl::stringifyDataDrivenPaint(rapidjson::Writer<rapidjson::StringBuffer>& writer) const {
+    paint.stringifyDataDriven(writer);
+}
+
 } // namespace style
 } // namespace mbgl
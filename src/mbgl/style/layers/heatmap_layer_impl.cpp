@@ -11,5 +11,9 @@ bool HeatmapLayer::Impl::hasLayoutDifference(const Layer::Impl& other) const {
            paint.hasDataDrivenPropertyDifference(impl.paint);
 }
 
+void HeatmapLayer::Impl::stringifyDataDrivenPaint(rapidjson::Writer<rapidjson::StringBuffer>& writer) const {
+    paint.stringifyDataDriven(writer);
+}
+
 } // namespace style
 } // namespace mbgl
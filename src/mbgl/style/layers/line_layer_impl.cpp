@@ -12,5 +12,9 @@ bool LineLayer::Impl::hasLayoutDifference(const Layer::Impl& other) const {
            paint.hasDataDrivenPropertyDifference(impl.paint);
 }
 
+void LineLayer::Impl::stringifyDataDrivenPaint(rapidjson::Writer<rapidjson::StringBuffer>& writer) const {
+    paint.stringifyDataDriven(writer);
+}
+
 } // namespace style
 } // namespace mbgl
@@ -285,6 +285,30 @@ public:
             util::ignore({ (result |= this->template get<Ps>().value.hasDataDrivenPropertyDifference(other.template get<Ps>().value))... });
             return result;
         }
+
+        template <class Writer>
+        void stringifyDataDriven(Writer& writer) const {
+            // Paint properties have no names, so they are written in order, with null for the
+            // ones that aren't data-driven.
+            writer.StartArray();
+            util::ignore({ (stringifyIfDataDriven(writer, this->template get<Ps>().value), 0)... });
+            writer.EndArray();
+        }
+
+    private:
+        template <class Writer, class T>
+        static void stringifyIfDataDriven(Writer& writer, const PropertyValue<T>& value) {
+            if (value.isDataDriven()) {
+                conversion::stringify(writer, value);
+            } else {
+                writer.Null();
+            }
+        }
+
+        template <class Writer, class Value>
+        static void stringifyIfDataDriven(Writer& writer, const Value&) {
+            writer.Null();
+        }
     };
 };
 
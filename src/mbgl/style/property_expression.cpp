@@ -9,6 +9,9 @@ PropertyExpressionBase::PropertyExpressionBase(std::unique_ptr<expression::Expre
     isZoomConstant_ = expression::isZoomConstant(*expression);
     isFeatureConstant_ = expression::isFeatureConstant(*expression);
     isRuntimeConstant_ = expression::isRuntimeConstant(*expression);
+    if (!isFeatureConstant_) {
+        compiled = expression::CompiledExpression::compile(expression);
+    }
 }
 
 bool PropertyExpressionBase::isZoomConstant() const noexcept {
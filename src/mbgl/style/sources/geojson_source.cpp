@@ -1,6 +1,5 @@
 #include <mbgl/storage/file_source.hpp>
 #include <mbgl/style/conversion/geojson.hpp>
-#include <mbgl/style/conversion/json.hpp>
 #include <mbgl/style/layer.hpp>
 #include <mbgl/style/source_observer.hpp>
 #include <mbgl/style/sources/geojson_source.hpp>
@@ -48,6 +47,19 @@ void GeoJSONSource::setGeoJSONData(std::shared_ptr<GeoJSONData> geoJSONData) {
     observer->onSourceChanged(*this);
 }
 
+void GeoJSONSource::updateGeoJSON(const GeoJSONFeatureChanges& changes) {
+    std::shared_ptr<GeoJSONData> current = impl().getData().lock();
+    if (!current) {
+        current = GeoJSONData::create(FeatureCollection{}, impl().getOptions());
+    }
+
+    if (std::shared_ptr<GeoJSONData> updated = current->update(changes)) {
+        setGeoJSONData(std::move(updated));
+    } else {
+        Log::Error(Event::General, "GeoJSON source '%s' does not support incremental updates", getID().c_str());
+    }
+}
+
 optional<std::string> GeoJSONSource::getURL() const {
     return url;
 }
@@ -81,7 +93,7 @@ void GeoJSONSource::loadDescription(FileSource& fileSource) {
                 auto& current = static_cast<const Impl&>(*currentImpl);
                 conversion::Error error;
                 std::shared_ptr<GeoJSONData> geoJSONData;
-                if (optional<GeoJSON> geoJSON = conversion::convertJSON<GeoJSON>(*data, error)) {
+                if (optional<GeoJSON> geoJSON = conversion::parseGeoJSON(*data, error)) {
                     geoJSONData = GeoJSONData::create(*geoJSON, current.getOptions());
                 } else {
                     // Create an empty GeoJSON VT object to make sure we're not infinitely waiting for tiles to load.
@@ -2,17 +2,38 @@
 #include <mbgl/tile/tile_id.hpp>
 #include <mbgl/util/constants.hpp>
 #include <mbgl/util/feature.hpp>
+#include <mbgl/util/parallel_for.hpp>
 #include <mbgl/util/string.hpp>
 #include <mbgl/util/thread_pool.hpp>
 
+#include <mbgl/math/clamp.hpp>
+#include <mbgl/util/geometry.hpp>
+
 #include <mapbox/geojsonvt.hpp>
 #include <supercluster.hpp>
 
+#include <algorithm>
+#include <array>
 #include <cmath>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <unordered_map>
 
 namespace mbgl {
 namespace style {
 
+// Splits the features into contiguous chunks with an index each, so that the indexes are built
+// concurrently on the worker pool. The tiles of all chunks are concatenated in chunk order, which
+// keeps the features in the same order as a single index of all features would, with one
+// exception: geojson-vt adds the copies of features wrapped across the antimeridian to a tile as
+// all left copies, then all unwrapped features, then all right copies. A single index does so over
+// all features, while here it is done per chunk, so wrapped copies are interleaved with the
+// features of later chunks.
+//
+// Each chunk is built from a copy of its features. To bound the memory held by these copies, no
+// more than `maximumCopiedFeatures` features are copied at once, and larger collections build
+// their chunks in several rounds.
 class GeoJSONVTData : public GeoJSONData, public std::enable_shared_from_this<GeoJSONVTData> {
 public:
     void getTile(const CanonicalTileID& id, const std::function<void(TileFeatures)>& fn) final {
@@ -21,7 +42,7 @@ public:
         scheduler->scheduleAndReplyValue(
             [id, weak, this]() -> TileFeatures {
                 if (auto self = weak.lock()) {
-                    return impl.getTile(id.z, id.x, id.y).features;
+                    return getTileFeatures(id);
                 }
                 return {};
             },
@@ -38,9 +59,69 @@ public:
 
 private:
     friend GeoJSONData;
-    GeoJSONVTData(const GeoJSON& geoJSON, const mapbox::geojsonvt::Options& options)
-        : impl(geoJSON, options), scheduler(Scheduler::GetSequenced()) {}
-    mapbox::geojsonvt::GeoJSONVT impl;
+    GeoJSONVTData(const GeoJSON& geoJSON, mapbox::geojsonvt::Options options)
+        : scheduler(Scheduler::GetSequenced()) {
+        // Only the root tile is split up front. Deeper tiles are split when they are first
+        // requested, so visible tiles don't wait for levels that may never be shown. The tiles
+        // are the same either way.
+        options.indexMaxZoom = 0;
+
+        const std::size_t count = geoJSON.is<Features>()
+                                      ? std::min(ThreadPool::getDefaultThreadCount(),
+                                                 geoJSON.get<Features>().size() / minimumChunkSize)
+                                      : 0;
+        if (count <= 1) {
+            chunks.push_back(std::make_unique<mapbox::geojsonvt::GeoJSONVT>(geoJSON, options));
+            return;
+        }
+
+        const Features& features = geoJSON.get<Features>();
+        const std::size_t concurrency =
+            util::clamp<std::size_t>(maximumCopiedFeatures / (features.size() / count), 1, count);
+        chunks.resize(count);
+        for (std::size_t first = 0; first < count; first += concurrency) {
+            util::parallelFor(*Scheduler::GetBackground(), std::min(concurrency, count - first), [&](std::size_t j) {
+                const std::size_t i = first + j;
+                Features chunk;
+                chunk.insert(chunk.end(),
+                             features.begin() + features.size() * i / count,
+                             features.begin() + features.size() * (i + 1) / count);
+                chunks[i] = std::make_unique<mapbox::geojsonvt::GeoJSONVT>(GeoJSON{std::move(chunk)}, options);
+            });
+        }
+    }
+
+    TileFeatures getTileFeatures(const CanonicalTileID& id) {
+        if (chunks.size() == 1) {
+            return chunks.front()->getTile(id.z, id.x, id.y).features;
+        }
+
+        // Tiles are requested one at a time on the sequenced scheduler, so each chunk is only
+        // accessed by one thread.
+        std::vector<const TileFeatures*> tiles(chunks.size());
+        util::parallelFor(*Scheduler::GetBackground(), chunks.size(), [&](std::size_t i) {
+            tiles[i] = &chunks[i]->getTile(id.z, id.x, id.y).features;
+        });
+
+        TileFeatures result;
+        std::size_t size = 0;
+        for (const auto* tile : tiles) {
+            size += tile->size();
+        }
+        result.reserve(size);
+        for (const auto* tile : tiles) {
+            result.insert(result.end(), tile->begin(), tile->end());
+        }
+        return result;
+    }
+
+    // Collections smaller than this are indexed as a whole, as splitting them would make every
+    // tile request slower without speeding up the index noticeably.
+    static constexpr std::size_t minimumChunkSize = 10000;
+    // The number of features that are copied into chunks at once while building the indexes.
+    static constexpr std::size_t maximumCopiedFeatures = 500000;
+
+    std::vector<std::unique_ptr<mapbox::geojsonvt::GeoJSONVT>> chunks;
     std::shared_ptr<Scheduler> scheduler;
 };
 
@@ -82,44 +163,478 @@ T evaluateFeature(const mapbox::feature::feature<double>& f,
     return T();
 }
 
-// static
-std::shared_ptr<GeoJSONData> GeoJSONData::create(const GeoJSON& geoJSON, Immutable<GeoJSONOptions> options) {
-    constexpr double scale = util::EXTENT / util::tileSize;
-    if (options->cluster && geoJSON.is<Features>() && !geoJSON.get<Features>().empty()) {
-        mapbox::supercluster::Options clusterOptions;
-        clusterOptions.maxZoom = options->clusterMaxZoom;
-        clusterOptions.extent = util::EXTENT;
-        clusterOptions.radius = ::round(scale * options->clusterRadius);
-        auto feature = std::make_shared<Feature>();
-        clusterOptions.map = [feature, options](const PropertyMap& properties) -> PropertyMap {
-            PropertyMap ret{};
-            if (properties.empty()) return ret;
-            for (const auto& p : options->clusterProperties) {
-                feature->properties = properties;
-                ret[p.first] = evaluateFeature<Value>(*feature, p.second.first);
+namespace {
+
+constexpr double scale = util::EXTENT / util::tileSize;
+
+mapbox::geojsonvt::Options geoJSONVTOptions(const GeoJSONOptions& options) {
+    mapbox::geojsonvt::Options vtOptions;
+    vtOptions.maxZoom = options.maxzoom;
+    vtOptions.extent = util::EXTENT;
+    vtOptions.buffer = ::round(scale * options.buffer);
+    vtOptions.tolerance = scale * options.tolerance;
+    vtOptions.lineMetrics = options.lineMetrics;
+    return vtOptions;
+}
+
+mapbox::supercluster::Options superclusterOptions(const Immutable<GeoJSONOptions>& options) {
+    mapbox::supercluster::Options clusterOptions;
+    clusterOptions.maxZoom = options->clusterMaxZoom;
+    clusterOptions.extent = util::EXTENT;
+    clusterOptions.radius = ::round(scale * options->clusterRadius);
+    auto feature = std::make_shared<Feature>();
+    clusterOptions.map = [feature, options](const PropertyMap& properties) -> PropertyMap {
+        PropertyMap ret{};
+        if (properties.empty()) return ret;
+        for (const auto& p : options->clusterProperties) {
+            feature->properties = properties;
+            ret[p.first] = evaluateFeature<Value>(*feature, p.second.first);
+        }
+        return ret;
+    };
+    clusterOptions.reduce = [feature, options](PropertyMap& toReturn, const PropertyMap& toFill) {
+        for (const auto& p : options->clusterProperties) {
+            if (toFill.count(p.first) == 0) {
+                continue;
             }
-            return ret;
-        };
-        clusterOptions.reduce = [feature, options](PropertyMap& toReturn, const PropertyMap& toFill) {
-            for (const auto& p : options->clusterProperties) {
-                if (toFill.count(p.first) == 0) {
+            feature->properties = toFill;
+            optional<Value> accumulated(toReturn[p.first]);
+            toReturn[p.first] = evaluateFeature<Value>(*feature, p.second.second, accumulated);
+        }
+    };
+    return clusterOptions;
+}
+
+// An axis-aligned box in projected coordinates, where the world spans [0, 1] on both axes.
+struct Box {
+    double minX;
+    double minY;
+    double maxX;
+    double maxY;
+};
+
+bool intersects(const Box& a, const Box& b) {
+    return a.minX <= b.maxX && b.minX <= a.maxX && a.minY <= b.maxY && b.minY <= a.maxY;
+}
+
+// Whether the bounds intersect the tile bounds, or their copies in the worlds to the left and right.
+bool intersectsWrapped(const Box& bounds, const Box& tile) {
+    for (double shift : {0.0, -1.0, 1.0}) {
+        if (intersects(bounds, {tile.minX + shift, tile.minY, tile.maxX + shift, tile.maxY})) {
+            return true;
+        }
+    }
+    return false;
+}
+
+Box unite(const Box& a, const Box& b) {
+    return {std::min(a.minX, b.minX), std::min(a.minY, b.minY), std::max(a.maxX, b.maxX), std::max(a.maxY, b.maxY)};
+}
+
+constexpr Box emptyBox{1, 1, 0, 0};
+
+// Projects the coordinates in the same way as geojson-vt does.
+Point<double> project(const Point<double>& point) {
+    const double sine = std::sin(point.y * M_PI / 180);
+    const double y = 0.5 - 0.25 * std::log((1 + sine) / (1 - sine)) / M_PI;
+    return {point.x / 360 + 0.5, util::clamp(y, 0.0, 1.0)};
+}
+
+// A feature of an incrementally updatable source, with its projected bounds.
+class IndexedFeature {
+public:
+    explicit IndexedFeature(GeoJSONFeature feature_) : feature(std::move(feature_)), bounds(emptyBox) {
+        forEachPoint(feature.geometry, [&](const Point<double>& point) {
+            const Point<double> projected = project(point);
+            bounds = unite(bounds, {projected.x, projected.y, projected.x, projected.y});
+        });
+        if (bounds.minX > bounds.maxX) {
+            bounds = {0.5, 0.5, 0.5, 0.5};
+        }
+    }
+
+    // The point that decides the partition of the feature.
+    Point<double> anchor() const {
+        return {util::clamp((bounds.minX + bounds.maxX) / 2, 0.0, 1.0), (bounds.minY + bounds.maxY) / 2};
+    }
+
+    const GeoJSONFeature feature;
+    Box bounds;
+};
+
+using IndexedFeatures = std::vector<std::shared_ptr<const IndexedFeature>>;
+
+// A node of a quadtree partitioning the features of an incrementally updatable source by the
+// anchors of their bounds. Every leaf lazily builds a geojson-vt index of its own features, so
+// that changing a feature only discards the index of the leaf containing it. Nodes are never
+// modified once built, which lets updated data share the nodes the changes don't affect.
+class FeaturePartition {
+public:
+    static constexpr std::size_t maxFeatures = 1024;
+    static constexpr uint8_t maxDepth = 20;
+
+    FeaturePartition(uint8_t depth_, Point<double> origin_, IndexedFeatures features_)
+        : depth(depth_), origin(origin_), bounds(emptyBox) {
+        if (features_.size() > maxFeatures && depth < maxDepth) {
+            std::array<IndexedFeatures, 4> quadrants;
+            for (auto& feature : features_) {
+                quadrants[quadrant(feature->anchor())].push_back(std::move(feature));
+            }
+            for (std::size_t i = 0; i < 4; ++i) {
+                children[i] = std::make_shared<const FeaturePartition>(uint8_t(depth + 1), childOrigin(i), std::move(quadrants[i]));
+                bounds = unite(bounds, children[i]->bounds);
+            }
+        } else {
+            features = std::move(features_);
+            for (const auto& feature : features) {
+                bounds = unite(bounds, feature->bounds);
+            }
+        }
+    }
+
+    FeaturePartition(uint8_t depth_, Point<double> origin_, std::array<std::shared_ptr<const FeaturePartition>, 4> children_)
+        : depth(depth_), origin(origin_), bounds(emptyBox), children(std::move(children_)) {
+        for (const auto& child : children) {
+            bounds = unite(bounds, child->bounds);
+        }
+    }
+
+    bool isLeaf() const { return !children[0]; }
+
+    // Returns a partition with the given features removed and added, or nullptr if there are no changes.
+    // `replaced` maps removed features to the features replacing them, which keep the position of the
+    // removed feature if they stay in the same leaf.
+    std::shared_ptr<const FeaturePartition> update(
+        const std::unordered_map<const IndexedFeature*, std::shared_ptr<const IndexedFeature>>& replaced,
+        std::vector<const IndexedFeature*> removed,
+        IndexedFeatures added) const {
+        if (removed.empty() && added.empty()) {
+            return nullptr;
+        }
+
+        if (isLeaf()) {
+            IndexedFeatures updated;
+            updated.reserve(features.size() + added.size());
+            for (const auto& feature : features) {
+                if (std::find(removed.begin(), removed.end(), feature.get()) == removed.end()) {
+                    updated.push_back(feature);
                     continue;
                 }
-                feature->properties = toFill;
-                optional<Value> accumulated(toReturn[p.first]);
-                toReturn[p.first] = evaluateFeature<Value>(*feature, p.second.second, accumulated);
+                auto replacement = replaced.find(feature.get());
+                if (replacement != replaced.end() && replacement->second) {
+                    auto it = std::find(added.begin(), added.end(), replacement->second);
+                    if (it != added.end()) {
+                        updated.push_back(std::move(*it));
+                        added.erase(it);
+                    }
+                }
+            }
+            std::move(added.begin(), added.end(), std::back_inserter(updated));
+            return std::make_shared<const FeaturePartition>(depth, origin, std::move(updated));
+        }
+
+        std::array<std::vector<const IndexedFeature*>, 4> removedByQuadrant;
+        std::array<IndexedFeatures, 4> addedByQuadrant;
+        for (const IndexedFeature* feature : removed) {
+            removedByQuadrant[quadrant(feature->anchor())].push_back(feature);
+        }
+        for (auto& feature : added) {
+            addedByQuadrant[quadrant(feature->anchor())].push_back(std::move(feature));
+        }
+
+        std::array<std::shared_ptr<const FeaturePartition>, 4> updatedChildren;
+        for (std::size_t i = 0; i < 4; ++i) {
+            updatedChildren[i] =
+                children[i]->update(replaced, std::move(removedByQuadrant[i]), std::move(addedByQuadrant[i]));
+            if (!updatedChildren[i]) {
+                updatedChildren[i] = children[i];
+            }
+        }
+        return std::make_shared<const FeaturePartition>(depth, origin, std::move(updatedChildren));
+    }
+
+    // Calls `fn` for every feature, in partition order.
+    template <typename Fn>
+    void forEachFeature(Fn&& fn) const {
+        if (isLeaf()) {
+            for (const auto& feature : features) {
+                fn(feature);
+            }
+        } else {
+            for (const auto& child : children) {
+                child->forEachFeature(fn);
+            }
+        }
+    }
+
+    void getTile(const CanonicalTileID& id,
+                 const Box& tileBounds,
+                 const mapbox::geojsonvt::Options& options,
+                 GeoJSONData::TileFeatures& result) const {
+        if (!intersectsWrapped(bounds, tileBounds)) {
+            return;
+        }
+
+        if (!isLeaf()) {
+            for (const auto& child : children) {
+                child->getTile(id, tileBounds, options, result);
+            }
+            return;
+        }
+
+        // Partitions are shared between versions of the data, which may load tiles concurrently.
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!index) {
+            Features collection;
+            collection.reserve(features.size());
+            for (const auto& feature : features) {
+                collection.push_back(feature->feature);
             }
+            index = std::make_unique<mapbox::geojsonvt::GeoJSONVT>(GeoJSON{std::move(collection)}, options);
+        }
+        const auto& tileFeatures = index->getTile(id.z, id.x, id.y).features;
+        result.insert(result.end(), tileFeatures.begin(), tileFeatures.end());
+    }
+
+private:
+    double size() const { return std::ldexp(1.0, -depth); }
+
+    std::size_t quadrant(const Point<double>& anchor) const {
+        const double half = size() / 2;
+        return (anchor.x >= origin.x + half ? 1 : 0) + (anchor.y >= origin.y + half ? 2 : 0);
+    }
+
+    Point<double> childOrigin(std::size_t i) const {
+        const double half = size() / 2;
+        return {origin.x + ((i & 1) ? half : 0), origin.y + ((i & 2) ? half : 0)};
+    }
+
+    const uint8_t depth;
+    const Point<double> origin;
+    Box bounds;
+    std::array<std::shared_ptr<const FeaturePartition>, 4> children;
+    IndexedFeatures features;
+
+    mutable std::mutex mutex;
+    mutable std::unique_ptr<mapbox::geojsonvt::GeoJSONVT> index;
+};
+
+} // namespace
+
+// Data of a source with GeoJSONOptions::incrementalUpdates. Features are partitioned into a
+// quadtree with a small geojson-vt index per leaf, so that an update only rebuilds the indexes of
+// the leaves containing changed features, and only the tiles overlapping them are reloaded.
+// Clustered sources build a new supercluster index of all features instead, as changing a single
+// point may change clusters anywhere.
+class IncrementalGeoJSONData : public GeoJSONData, public std::enable_shared_from_this<IncrementalGeoJSONData> {
+public:
+    void getTile(const CanonicalTileID& id, const std::function<void(TileFeatures)>& fn) final {
+        assert(fn);
+        if (options->cluster) {
+            if (clusters) {
+                clusters->getTile(id, fn);
+            } else {
+                fn({});
+            }
+            return;
+        }
+
+        std::weak_ptr<IncrementalGeoJSONData> weak = shared_from_this();
+        scheduler->scheduleAndReplyValue(
+            [id, weak, this]() -> TileFeatures {
+                TileFeatures result;
+                if (auto self = weak.lock()) {
+                    root->getTile(id, getTileBounds(id), vtOptions, result);
+                }
+                return result;
+            },
+            fn);
+    }
+
+    Features getChildren(const std::uint32_t clusterID) final {
+        return clusters ? clusters->getChildren(clusterID) : Features{};
+    }
+
+    Features getLeaves(const std::uint32_t clusterID, const std::uint32_t limit, const std::uint32_t offset) final {
+        return clusters ? clusters->getLeaves(clusterID, limit, offset) : Features{};
+    }
+
+    std::uint8_t getClusterExpansionZoom(std::uint32_t clusterID) final {
+        return clusters ? clusters->getClusterExpansionZoom(clusterID) : 0;
+    }
+
+    std::shared_ptr<GeoJSONData> update(const GeoJSONFeatureChanges& changes) final {
+        // Updates move the identifier map on to the new data. Rebuild it if this data is updated again.
+        if (!identifiers) {
+            identifiers = std::make_unique<Identifiers>();
+            root->forEachFeature([&](const std::shared_ptr<const IndexedFeature>& feature) {
+                (*identifiers)[feature->feature.id] = feature;
+            });
+        }
+
+        std::unordered_map<const IndexedFeature*, std::shared_ptr<const IndexedFeature>> replaced;
+        std::vector<const IndexedFeature*> removed;
+        IndexedFeatures added;
+        std::vector<Box> changed;
+
+        // Returns the feature in the partitions that a feature with the given identifier replaces, if any.
+        const auto removeFeature = [&](const FeatureIdentifier& id) -> const IndexedFeature* {
+            if (id.is<NullValue>()) return nullptr;
+            auto it = identifiers->find(id);
+            if (it == identifiers->end()) return nullptr;
+            std::shared_ptr<const IndexedFeature> feature = std::move(it->second);
+            identifiers->erase(it);
+
+            // The feature was added by these changes.
+            auto pending = std::find(added.begin(), added.end(), feature);
+            if (pending != added.end()) {
+                added.erase(pending);
+                for (auto& entry : replaced) {
+                    if (entry.second == feature) {
+                        entry.second = nullptr;
+                        return entry.first;
+                    }
+                }
+                return nullptr;
+            }
+
+            // The partitions still hold on to the feature until they are updated.
+            replaced.emplace(feature.get(), nullptr);
+            removed.push_back(feature.get());
+            changed.push_back(feature->bounds);
+            return feature.get();
         };
-        return std::shared_ptr<GeoJSONData>(new SuperclusterData(geoJSON.get<Features>(), clusterOptions));
+
+        const auto addFeature = [&](const GeoJSONFeature& feature, const IndexedFeature* replacing) {
+            auto indexed = std::make_shared<const IndexedFeature>(feature);
+            changed.push_back(indexed->bounds);
+            if (replacing) {
+                replaced[replacing] = indexed;
+            }
+            if (!feature.id.is<NullValue>()) {
+                (*identifiers)[feature.id] = indexed;
+            }
+            added.push_back(std::move(indexed));
+        };
+
+        for (const auto& id : changes.removed) {
+            removeFeature(id);
+        }
+        for (const auto& feature : changes.changed) {
+            addFeature(feature, removeFeature(feature.id));
+        }
+        for (const auto& feature : changes.added) {
+            addFeature(feature, removeFeature(feature.id));
+        }
+
+        auto updatedRoot = root->update(replaced, std::move(removed), std::move(added));
+        if (!updatedRoot) {
+            updatedRoot = root;
+        }
+
+        std::shared_ptr<IncrementalGeoJSONData> updated(
+            new IncrementalGeoJSONData(options, std::move(updatedRoot), std::move(identifiers)));
+        if (!options->cluster) {
+            updated->base = shared_from_this();
+            updated->changedBounds = std::move(changed);
+        }
+        return updated;
     }
 
-    mapbox::geojsonvt::Options vtOptions;
-    vtOptions.maxZoom = options->maxzoom;
-    vtOptions.extent = util::EXTENT;
-    vtOptions.buffer = ::round(scale * options->buffer);
-    vtOptions.tolerance = scale * options->tolerance;
-    vtOptions.lineMetrics = options->lineMetrics;
-    return std::shared_ptr<GeoJSONData>(new GeoJSONVTData(geoJSON, vtOptions));
+    bool tileChanged(const GeoJSONData& previous, const CanonicalTileID& id) const final {
+        auto baseData = base.lock();
+        if (baseData.get() != &previous) {
+            return true;
+        }
+
+        const Box tileBounds = getTileBounds(id);
+        return std::any_of(changedBounds.begin(), changedBounds.end(), [&](const Box& bounds) {
+            return intersectsWrapped(bounds, tileBounds);
+        });
+    }
+
+private:
+    friend GeoJSONData;
+    using Identifiers = std::map<FeatureIdentifier, std::shared_ptr<const IndexedFeature>>;
+
+    IncrementalGeoJSONData(const Features& features, Immutable<GeoJSONOptions> options_)
+        : IncrementalGeoJSONData(options_, nullptr, std::make_unique<Identifiers>()) {
+        IndexedFeatures indexed;
+        indexed.reserve(features.size());
+        for (const auto& feature : features) {
+            indexed.push_back(std::make_shared<const IndexedFeature>(feature));
+            if (!feature.id.is<NullValue>()) {
+                (*identifiers)[feature.id] = indexed.back();
+            }
+        }
+        root = std::make_shared<const FeaturePartition>(0, Point<double>{0, 0}, std::move(indexed));
+        buildClusters();
+    }
+
+    IncrementalGeoJSONData(Immutable<GeoJSONOptions> options_,
+                           std::shared_ptr<const FeaturePartition> root_,
+                           std::unique_ptr<Identifiers> identifiers_)
+        : options(std::move(options_)),
+          vtOptions(geoJSONVTOptions(*options)),
+          root(std::move(root_)),
+          identifiers(std::move(identifiers_)),
+          scheduler(Scheduler::GetSequenced()) {
+        if (root) {
+            buildClusters();
+        }
+    }
+
+    void buildClusters() {
+        if (!options->cluster) return;
+        Features features;
+        root->forEachFeature([&](const std::shared_ptr<const IndexedFeature>& feature) {
+            features.push_back(feature->feature);
+        });
+        if (!features.empty()) {
+            clusters = GeoJSONData::create(features, options);
+        }
+    }
+
+    // The bounds of the tile including its buffer.
+    Box getTileBounds(const CanonicalTileID& id) const {
+        const double size = std::ldexp(1.0, -id.z);
+        const double buffer = size * vtOptions.buffer / vtOptions.extent;
+        return {id.x * size - buffer, id.y * size - buffer, (id.x + 1) * size + buffer, (id.y + 1) * size + buffer};
+    }
+
+    const Immutable<GeoJSONOptions> options;
+    const mapbox::geojsonvt::Options vtOptions;
+    std::shared_ptr<const FeaturePartition> root;
+    std::unique_ptr<Identifiers> identifiers;
+    std::shared_ptr<GeoJSONData> clusters;
+    std::shared_ptr<Scheduler> scheduler;
+
+    // The data this data was updated from, and the bounds of the features that changed.
+    std::weak_ptr<const GeoJSONData> base;
+    std::vector<Box> changedBounds;
+};
+
+// static
+std::shared_ptr<GeoJSONData> GeoJSONData::create(const GeoJSON& geoJSON, Immutable<GeoJSONOptions> options) {
+    if (options->incrementalUpdates) {
+        Features features;
+        if (geoJSON.is<Features>()) {
+            features = geoJSON.get<Features>();
+        } else if (geoJSON.is<GeoJSONFeature>()) {
+            features.push_back(geoJSON.get<GeoJSONFeature>());
+        } else {
+            features.push_back(GeoJSONFeature{geoJSON.get<mapbox::geojson::geometry>()});
+        }
+        auto incrementalOptions = makeMutable<GeoJSONOptions>(*options);
+        incrementalOptions->incrementalUpdates = false;
+        return std::shared_ptr<GeoJSONData>(new IncrementalGeoJSONData(features, std::move(incrementalOptions)));
+    }
+
+    if (options->cluster && geoJSON.is<Features>() && !geoJSON.get<Features>().empty()) {
+        return std::shared_ptr<GeoJSONData>(new SuperclusterData(geoJSON.get<Features>(), superclusterOptions(options)));
+    }
+
+    return std::shared_ptr<GeoJSONData>(new GeoJSONVTData(geoJSON, geoJSONVTOptions(*options)));
 }
 
 GeoJSONSource::Impl::Impl(std::string id_, Immutable<GeoJSONOptions> options_)
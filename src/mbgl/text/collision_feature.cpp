@@ -15,8 +15,10 @@ CollisionFeature::CollisionFeature(const GeometryCoordinates& line,
                                    const style::SymbolPlacementType placement,
                                    IndexedSubfeature indexedFeature_,
                                    const float overscaling,
-                                   const float rotate)
-        : indexedFeature(std::move(indexedFeature_))
+                                   const float rotate,
+                                   util::MonotonicBuffer* buffer)
+        : boxes(util::MonotonicAllocator<CollisionBox>(buffer))
+        , indexedFeature(std::move(indexedFeature_))
         , alongLine(placement != style::SymbolPlacementType::Point) {
     if (top == 0 && bottom == 0 && left == 0 && right == 0) return;
 
@@ -113,6 +115,7 @@ void CollisionFeature::bboxifyLabel(const GeometryCoordinates& line,
 
     auto segmentLength = util::dist<float>(line[index], line[index + 1]);
 
+    boxes.reserve(nBoxes + 2 * nPitchPaddingBoxes);
     for (int i = -nPitchPaddingBoxes; i < nBoxes + nPitchPaddingBoxes; i++) {
         // the distance the box will be from the anchor
         const float boxOffset = i * step;
@@ -4,6 +4,7 @@
 #include <mbgl/text/shaping.hpp>
 #include <mbgl/tile/geometry_tile_data.hpp>
 #include <mbgl/geometry/feature_index.hpp>
+#include <mbgl/util/monotonic_buffer.hpp>
 
 #include <vector>
 
@@ -78,8 +79,9 @@ public:
                      const style::SymbolPlacementType placement,
                      const IndexedSubfeature& indexedFeature_,
                      const float overscaling,
-                     const float rotate)
-        : CollisionFeature(line, anchor, shapedText.top, shapedText.bottom, shapedText.left, shapedText.right, boxScale, padding, placement, indexedFeature_, overscaling, rotate) {}
+                     const float rotate,
+                     util::MonotonicBuffer* buffer = nullptr)
+        : CollisionFeature(line, anchor, shapedText.top, shapedText.bottom, shapedText.left, shapedText.right, boxScale, padding, placement, indexedFeature_, overscaling, rotate, buffer) {}
 
     // for icons
     // Icons collision features are always SymbolPlacementType::Point, which means the collision feature
@@ -93,7 +95,8 @@ public:
                      const float boxScale,
                      const float padding,
                      const IndexedSubfeature& indexedFeature_,
-                     const float rotate)
+                     const float rotate,
+                     util::MonotonicBuffer* buffer = nullptr)
         : CollisionFeature(line, anchor,
                            (shapedIcon ? shapedIcon->top() : 0),
                            (shapedIcon ? shapedIcon->bottom() : 0),
@@ -102,7 +105,7 @@ public:
                            boxScale,
                            padding,
                            style::SymbolPlacementType::Point,
-                           indexedFeature_, 1, rotate) {}
+                           indexedFeature_, 1, rotate, buffer) {}
 
     CollisionFeature(const GeometryCoordinates& line,
                      const Anchor&,
@@ -115,9 +118,10 @@ public:
                      const style::SymbolPlacementType,
                      IndexedSubfeature,
                      const float overscaling,
-                     const float rotate);
+                     const float rotate,
+                     util::MonotonicBuffer* buffer = nullptr);
 
-    std::vector<CollisionBox> boxes;
+    util::MonotonicVector<CollisionBox> boxes;
     IndexedSubfeature indexedFeature;
     bool alongLine;
 
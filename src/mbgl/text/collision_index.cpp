@@ -101,7 +101,7 @@ std::pair<bool,bool> CollisionIndex::placeFeature(const CollisionFeature& featur
                                       const bool pitchWithMap,
                                       const bool collisionDebug,
                                       const optional<CollisionTileBoundaries>& avoidEdges,
-                                      const optional<std::function<bool(const IndexedSubfeature&)>> collisionGroupPredicate,
+                                      const optional<CollisionGroupPredicate>& collisionGroupPredicate,
                                       std::vector<ProjectedCollisionBox>& projectedBoxes) {
     assert(projectedBoxes.empty());
     if (!feature.alongLine) {
@@ -116,7 +116,7 @@ std::pair<bool,bool> CollisionIndex::placeFeature(const CollisionFeature& featur
 
         if ((avoidEdges && !isInsideTile(px1, py1, px2, py2, *avoidEdges)) ||
             !isInsideGrid(px1, py1, px2, py2) ||
-            (!allowOverlap && collisionGrid.hitTest(projectedBoxes.back().box(), collisionGroupPredicate))) {
+            (!allowOverlap && hitTest(projectedBoxes.back().box(), collisionGroupPredicate))) {
             return { false, false };
         }
 
@@ -137,7 +137,7 @@ std::pair<bool,bool> CollisionIndex::placeLineFeature(const CollisionFeature& fe
                                       const bool pitchWithMap,
                                       const bool collisionDebug,
                                       const optional<CollisionTileBoundaries>& avoidEdges,
-                                      const optional<std::function<bool(const IndexedSubfeature&)>> collisionGroupPredicate,
+                                      const optional<CollisionGroupPredicate>& collisionGroupPredicate,
                                       std::vector<ProjectedCollisionBox>& projectedBoxes) {
     assert(feature.alongLine);
     assert(projectedBoxes.empty());
@@ -238,7 +238,7 @@ std::pair<bool,bool> CollisionIndex::placeLineFeature(const CollisionFeature& fe
         inGrid |= isInsideGrid(px1, py1, px2, py2);
 
         if ((avoidEdges && !isInsideTile(px1, py1, px2, py2, *avoidEdges)) ||
-            (!allowOverlap && collisionGrid.hitTest(projectedBoxes[i].circle(), collisionGroupPredicate))) {
+            (!allowOverlap && hitTest(projectedBoxes[i].circle(), collisionGroupPredicate))) {
             if (!collisionDebug) {
                 return {false, false};
             } else {
@@ -16,6 +16,16 @@ struct TileDistance;
     
 using CollisionTileBoundaries = std::array<float,4>;
 
+// Restricts collision detection to the features of one collision group.
+class CollisionGroupPredicate {
+public:
+    bool operator()(const IndexedSubfeature& feature) const {
+        return feature.collisionGroupId == collisionGroupId;
+    }
+
+    uint16_t collisionGroupId;
+};
+
 class CollisionIndex {
 public:
     using CollisionGrid = GridIndex<IndexedSubfeature>;
@@ -34,7 +44,7 @@ public:
                                       const bool pitchWithMap,
                                       const bool collisionDebug,
                                       const optional<CollisionTileBoundaries>& avoidEdges,
-                                      const optional<std::function<bool(const IndexedSubfeature&)>> collisionGroupPredicate,
+                                      const optional<CollisionGroupPredicate>& collisionGroupPredicate,
                                       std::vector<ProjectedCollisionBox>& /*out*/);
 
     void insertFeature(const CollisionFeature& feature, const std::vector<ProjectedCollisionBox>&, bool ignorePlacement, uint32_t bucketInstanceId, uint16_t collisionGroupId);
@@ -46,6 +56,11 @@ public:
     const TransformState& getTransformState() const { return transformState; }
 
 private:
+    template <typename Geometry>
+    bool hitTest(const Geometry& geometry, const optional<CollisionGroupPredicate>& collisionGroupPredicate) const {
+        return collisionGroupPredicate ? collisionGrid.hitTest(geometry, *collisionGroupPredicate)
+                                       : collisionGrid.hitTest(geometry);
+    }
     bool isOffscreen(float x1, float y1, float x2, float y2) const;
     bool isInsideGrid(float x1, float y1, float x2, float y2) const;
     bool isInsideTile(float x1, float y1, float x2, float y2, const CollisionTileBoundaries& tileBoundaries) const;
@@ -61,7 +76,7 @@ private:
                                   const bool pitchWithMap,
                                   const bool collisionDebug,
                                   const optional<CollisionTileBoundaries>& avoidEdges,
-                                  const optional<std::function<bool(const IndexedSubfeature&)>> collisionGroupPredicate,
+                                  const optional<CollisionGroupPredicate>& collisionGroupPredicate,
                                   std::vector<ProjectedCollisionBox>& /*out*/);
     
     float approximateTileDistance(const TileDistance& tileDistance, const float lastSegmentAngle, const float pixelsToTileUnits, const float cameraToAnchorDistance, const bool pitchWithMap);
@@ -4,6 +4,7 @@
 #include <mbgl/util/bitmask_operations.hpp>
 #include <mbgl/util/geometry.hpp>
 #include <mbgl/util/constants.hpp>
+#include <mbgl/util/monotonic_buffer.hpp>
 #include <mbgl/util/optional.hpp>
 
 #include <map>
@@ -38,7 +39,8 @@ public:
     
     OverscaledTileID coord;
     uint32_t bucketInstanceId;
-    std::map<std::u16string,std::vector<IndexedSymbolInstance>> indexedSymbolInstances;
+    // Copies of the keys of the symbol instances are allocated on the heap, so they outlive the bucket.
+    std::map<util::MonotonicU16String, std::vector<IndexedSymbolInstance>> indexedSymbolInstances;
 };
 
 class CrossTileSymbolLayerIndex {
@@ -1,65 +1,180 @@
 #include <mbgl/text/glyph_atlas.hpp>
+#include <mbgl/gfx/upload_pass.hpp>
 
-#include <mapbox/shelf-pack.hpp>
+#include <algorithm>
+#include <limits>
 
 namespace mbgl {
 
 static constexpr uint32_t padding = 1;
+static constexpr int32_t initialSize = 128;
 
-GlyphAtlas makeGlyphAtlas(const GlyphMap& glyphs) {
-    GlyphAtlas result;
-
-    mapbox::ShelfPack::ShelfPackOptions options;
-    options.autoResize = true;
-    mapbox::ShelfPack pack(0, 0, options);
-
-    for (const auto& glyphMapEntry : glyphs) {
-        FontStackHash fontStack = glyphMapEntry.first;
-        GlyphPositionMap& positions = result.positions[fontStack];
-
-        for (const auto& entry : glyphMapEntry.second) {
-            if (entry.second && (*entry.second)->bitmap.valid()) {
-                const Glyph& glyph = **entry.second;
-
-                const mapbox::Bin& bin = *pack.packOne(-1,
-                    glyph.bitmap.size.width + 2 * padding,
-                    glyph.bitmap.size.height + 2 * padding);
-
-                result.image.resize({
-                    static_cast<uint32_t>(pack.width()),
-                    static_cast<uint32_t>(pack.height())
-                });
-
-                AlphaImage::copy(glyph.bitmap,
-                                 result.image,
-                                 { 0, 0 },
-                                 {
-                                    bin.x + padding,
-                                    bin.y + padding
-                                 },
-                                 glyph.bitmap.size);
-
-                positions.emplace(glyph.id,
-                                  GlyphPosition {
-                                     Rect<uint16_t> {
-                                         static_cast<uint16_t>(bin.x),
-                                         static_cast<uint16_t>(bin.y),
-                                         static_cast<uint16_t>(bin.w),
-                                         static_cast<uint16_t>(bin.h)
-                                     },
-                                     glyph.metrics
-                                  });
+GlyphAtlasReference::GlyphAtlasReference(std::shared_ptr<GlyphAtlas> atlas_, GlyphPositions positions_)
+    : positions(std::move(positions_)), atlas(std::move(atlas_)) {
+}
+
+GlyphAtlasReference::~GlyphAtlasReference() {
+    atlas->release(positions);
+}
+
+GlyphAtlas::GlyphAtlas(uint16_t maximumSize_)
+    : maximumSize(maximumSize_),
+      dirtyTop(std::numeric_limits<uint32_t>::max()) {
+}
+
+GlyphAtlas::~GlyphAtlas() = default;
+
+std::unique_ptr<GlyphAtlasReference> GlyphAtlas::addGlyphs(const GlyphMap& glyphs) {
+    GlyphPositions result;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        for (const auto& glyphMapEntry : glyphs) {
+            FontStackHash fontStack = glyphMapEntry.first;
+            GlyphPositionMap& positions = result[fontStack];
+
+            for (const auto& glyphEntry : glyphMapEntry.second) {
+                if (!glyphEntry.second || !(*glyphEntry.second)->bitmap.valid()) {
+                    continue;
+                }
+
+                const Glyph& glyph = **glyphEntry.second;
+                const GlyphKey key{ fontStack, glyph.id };
+
+                auto it = entries.find(key);
+                if (it == entries.end()) {
+                    mapbox::Bin* bin = allocate(glyph.bitmap.size.width + 2 * padding,
+                                                glyph.bitmap.size.height + 2 * padding);
+                    if (!bin) {
+                        continue;
+                    }
+
+                    // The bin may have held a larger glyph before, which mustn't bleed into the
+                    // padding of this one.
+                    const Point<uint32_t> origin{ static_cast<uint32_t>(bin->x), static_cast<uint32_t>(bin->y) };
+                    const Size binSize{ static_cast<uint32_t>(bin->maxw), static_cast<uint32_t>(bin->maxh) };
+                    AlphaImage::clear(image, origin, binSize);
+                    AlphaImage::copy(glyph.bitmap,
+                                     image,
+                                     { 0, 0 },
+                                     { origin.x + padding, origin.y + padding },
+                                     glyph.bitmap.size);
+                    dirtyTop = std::min(dirtyTop, origin.y);
+                    dirtyBottom = std::max(dirtyBottom, origin.y + binSize.height);
+
+                    const GlyphPosition position {
+                        Rect<uint16_t> {
+                            static_cast<uint16_t>(bin->x),
+                            static_cast<uint16_t>(bin->y),
+                            static_cast<uint16_t>(bin->w),
+                            static_cast<uint16_t>(bin->h)
+                        },
+                        glyph.metrics
+                    };
+                    it = entries.emplace(key, Entry{ bin, position, 0, unused.end() }).first;
+                } else if (it->second.references == 0) {
+                    unused.erase(it->second.unused);
+                }
+
+                ++it->second.references;
+                positions.emplace(glyph.id, it->second.position);
             }
         }
     }
 
-    pack.shrink();
-    result.image.resize({
-        static_cast<uint32_t>(pack.width()),
-        static_cast<uint32_t>(pack.height())
-    });
+    return std::make_unique<GlyphAtlasReference>(shared_from_this(), std::move(result));
+}
+
+void GlyphAtlas::release(const GlyphPositions& positions) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    for (const auto& fontStackEntry : positions) {
+        for (const auto& positionEntry : fontStackEntry.second) {
+            auto it = entries.find({ fontStackEntry.first, positionEntry.first });
+            assert(it != entries.end());
+            assert(it->second.references > 0);
+            if (--it->second.references == 0) {
+                it->second.unused = unused.insert(unused.end(), it->first);
+            }
+        }
+    }
+}
+
+mapbox::Bin* GlyphAtlas::allocate(int32_t width, int32_t height) {
+    if (mapbox::Bin* bin = pack.packOne(-1, width, height)) {
+        return bin;
+    }
+
+    // Make room by evicting unused glyphs before growing the atlas.
+    while (!unused.empty()) {
+        auto it = entries.find(unused.front());
+        assert(it != entries.end());
+        unused.pop_front();
+        pack.unref(*it->second.bin);
+        entries.erase(it);
+
+        if (mapbox::Bin* bin = pack.packOne(-1, width, height)) {
+            return bin;
+        }
+    }
+
+    while (grow()) {
+        if (mapbox::Bin* bin = pack.packOne(-1, width, height)) {
+            return bin;
+        }
+    }
+
+    return nullptr;
+}
+
+bool GlyphAtlas::grow() {
+    int32_t width = pack.width();
+    int32_t height = pack.height();
+    if (width == 0 || height == 0) {
+        width = height = std::min<int32_t>(initialSize, maximumSize);
+    } else if (width <= height && width < maximumSize) {
+        width = std::min<int32_t>(width * 2, maximumSize);
+    } else if (height < maximumSize) {
+        height = std::min<int32_t>(height * 2, maximumSize);
+    } else if (width < maximumSize) {
+        width = std::min<int32_t>(width * 2, maximumSize);
+    } else {
+        return false;
+    }
+
+    pack.resize(width, height);
+    image.resize({ static_cast<uint32_t>(width), static_cast<uint32_t>(height) });
+    return true;
+}
+
+Size GlyphAtlas::getSize() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return image.size;
+}
+
+void GlyphAtlas::upload(gfx::UploadPass& uploadPass) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (!image.valid()) {
+        return;
+    }
+
+    if (!texture || texture->size != image.size) {
+        texture = uploadPass.createTexture(image);
+    } else if (dirtyTop < dirtyBottom) {
+        AlphaImage rows({ image.size.width, dirtyBottom - dirtyTop });
+        AlphaImage::copy(image, rows, { 0, dirtyTop }, { 0, 0 }, rows.size);
+        uploadPass.updateTextureSub(*texture, rows, 0, static_cast<uint16_t>(dirtyTop));
+    }
+
+    dirtyTop = std::numeric_limits<uint32_t>::max();
+    dirtyBottom = 0;
+}
 
-    return result;
+const gfx::Texture& GlyphAtlas::getTexture() const {
+    assert(texture);
+    return *texture;
 }
 
 } // namespace mbgl
@@ -1,11 +1,23 @@
 #pragma once
 
+#include <mbgl/gfx/texture.hpp>
 #include <mbgl/text/glyph.hpp>
+#include <mbgl/util/noncopyable.hpp>
+#include <mbgl/util/optional.hpp>
 
 #include <mapbox/shelf-pack.hpp>
 
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+
 namespace mbgl {
 
+namespace gfx {
+class UploadPass;
+} // namespace gfx
+
 struct GlyphPosition {
     Rect<uint16_t> rect;
     GlyphMetrics metrics;
@@ -14,12 +26,77 @@ struct GlyphPosition {
 using GlyphPositionMap = std::map<GlyphID, GlyphPosition>;
 using GlyphPositions = std::map<FontStackHash, GlyphPositionMap>;
 
-class GlyphAtlas {
+class GlyphAtlas;
+
+// Positions of a set of glyphs in a GlyphAtlas. The glyphs keep their positions for as long as
+// the reference is alive.
+class GlyphAtlasReference : private util::noncopyable {
 public:
-    AlphaImage image;
-    GlyphPositions positions;
+    GlyphAtlasReference(std::shared_ptr<GlyphAtlas>, GlyphPositions);
+    ~GlyphAtlasReference();
+
+    const GlyphPositions positions;
+
+private:
+    std::shared_ptr<GlyphAtlas> atlas;
 };
 
-GlyphAtlas makeGlyphAtlas(const GlyphMap&);
+// A glyph atlas shared by all tiles of a renderer, so that glyphs used by many tiles are packed
+// and uploaded only once. The atlas grows as glyphs are added, and never shrinks. Glyphs that
+// are no longer referenced are kept until the atlas runs out of space; then they are evicted,
+// least recently used first, before the atlas grows any further.
+//
+// Glyphs are added on the worker threads, while the texture is uploaded and bound on the render
+// thread.
+class GlyphAtlas : public std::enable_shared_from_this<GlyphAtlas> {
+public:
+    explicit GlyphAtlas(uint16_t maximumSize = 4096);
+    ~GlyphAtlas();
+
+    // Adds the glyphs that aren't in the atlas yet, and returns a reference to the positions of
+    // all of them. Glyphs that don't fit into an atlas of the maximum size are left out.
+    std::unique_ptr<GlyphAtlasReference> addGlyphs(const GlyphMap&);
+
+    Size getSize() const;
+
+    // Uploads the rows of the atlas that changed since the last upload, or all of it if the
+    // atlas grew.
+    void upload(gfx::UploadPass&);
+
+    // The texture of the atlas, as of the last upload.
+    const gfx::Texture& getTexture() const;
+
+private:
+    friend class GlyphAtlasReference;
+    void release(const GlyphPositions&);
+
+    mapbox::Bin* allocate(int32_t width, int32_t height);
+    bool grow();
+
+    using GlyphKey = std::pair<FontStackHash, GlyphID>;
+
+    struct Entry {
+        mapbox::Bin* bin;
+        GlyphPosition position;
+        uint32_t references;
+        // Position in the list of unused glyphs, if there are no references.
+        std::list<GlyphKey>::iterator unused;
+    };
+
+    const uint16_t maximumSize;
+
+    mutable std::mutex mutex;
+    mapbox::ShelfPack pack;
+    AlphaImage image;
+    std::map<GlyphKey, Entry> entries;
+    // Glyphs without references, least recently used first.
+    std::list<GlyphKey> unused;
+
+    // Rows of the image that changed since the last upload.
+    uint32_t dirtyTop;
+    uint32_t dirtyBottom = 0;
+
+    optional<gfx::Texture> texture;
+};
 
 } // namespace mbgl
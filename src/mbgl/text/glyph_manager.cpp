@@ -1,6 +1,9 @@
 #include <mbgl/text/glyph_manager.hpp>
+#include <mbgl/text/glyph_atlas.hpp>
 #include <mbgl/text/glyph_manager_observer.hpp>
 #include <mbgl/text/glyph_pbf.hpp>
+#include <mbgl/text/shaping_cache.hpp>
+#include <mbgl/actor/scheduler.hpp>
 #include <mbgl/storage/file_source.hpp>
 #include <mbgl/storage/resource.hpp>
 #include <mbgl/storage/response.hpp>
@@ -11,13 +14,36 @@ namespace mbgl {
 
 static GlyphManagerObserver nullObserver;
 
+namespace {
+
+Glyph generateLocalSDF(LocalGlyphRasterizer& localGlyphRasterizer, const FontStack& fontStack, GlyphID glyphID) {
+    Glyph local = localGlyphRasterizer.rasterizeGlyph(fontStack, glyphID);
+    local.bitmap = util::transformRasterToSDF(local.bitmap, 8, .25);
+    return local;
+}
+
+} // namespace
+
 GlyphManager::GlyphManager(std::unique_ptr<LocalGlyphRasterizer> localGlyphRasterizer_)
     : observer(&nullObserver),
-      localGlyphRasterizer(std::move(localGlyphRasterizer_)) {
+      localGlyphRasterizer(std::move(localGlyphRasterizer_)),
+      threadPool(Scheduler::GetBackground()),
+      // Platform rasterizers aren't thread-safe, so glyphs are rasterized one at a time.
+      rasterizerScheduler(Scheduler::GetSequenced()),
+      atlas(std::make_shared<GlyphAtlas>()),
+      shapingCache(std::make_shared<ShapingCache>()) {
 }
 
 GlyphManager::~GlyphManager() = default;
 
+void GlyphManager::setURL(const std::string& url) {
+    if (url != glyphURL) {
+        // Shapings depend on the glyph metrics of the fonts.
+        shapingCache->clear();
+    }
+    glyphURL = url;
+}
+
 void GlyphManager::getGlyphs(GlyphRequestor& requestor, GlyphDependencies glyphDependencies, FileSource& fileSource) {
     auto dependencies = std::make_shared<GlyphDependencies>(std::move(glyphDependencies));
 
@@ -31,16 +57,26 @@ void GlyphManager::getGlyphs(GlyphRequestor& requestor, GlyphDependencies glyphD
 
         const GlyphIDs& glyphIDs = dependency.second;
         std::unordered_set<GlyphRange> ranges;
+        std::vector<GlyphID> rasterize;
         for (const auto& glyphID : glyphIDs) {
             if (localGlyphRasterizer->canRasterizeGlyph(fontStack, glyphID)) {
                 if (entry.glyphs.find(glyphID) == entry.glyphs.end()) {
-                    entry.glyphs.emplace(glyphID, makeMutable<Glyph>(generateLocalSDF(fontStack, glyphID)));
+                    auto it = entry.rasterizing.find(glyphID);
+                    if (it == entry.rasterizing.end()) {
+                        it = entry.rasterizing.emplace(glyphID, Requestors()).first;
+                        rasterize.push_back(glyphID);
+                    }
+                    it->second[&requestor] = dependencies;
                 }
             } else {
                 ranges.insert(getGlyphRange(glyphID));
             }
         }
 
+        if (!rasterize.empty()) {
+            rasterizeGlyphs(fontStack, std::move(rasterize));
+        }
+
         for (const auto& range : ranges) {
             auto it = entry.ranges.find(range);
             if (it == entry.ranges.end() || !it->second.parsed) {
@@ -58,10 +94,38 @@ void GlyphManager::getGlyphs(GlyphRequestor& requestor, GlyphDependencies glyphD
     }
 }
 
-Glyph GlyphManager::generateLocalSDF(const FontStack& fontStack, GlyphID glyphID) {
-    Glyph local = localGlyphRasterizer->rasterizeGlyph(fontStack, glyphID);
-    local.bitmap = util::transformRasterToSDF(local.bitmap, 8, .25);
-    return local;
+void GlyphManager::rasterizeGlyphs(const FontStack& fontStack, std::vector<GlyphID> glyphIDs) {
+    auto rasterize = [rasterizer = localGlyphRasterizer, fontStack, glyphIDs = std::move(glyphIDs)] {
+        auto glyphs = std::make_shared<std::vector<Immutable<Glyph>>>();
+        glyphs->reserve(glyphIDs.size());
+        for (GlyphID glyphID : glyphIDs) {
+            glyphs->push_back(makeMutable<Glyph>(generateLocalSDF(*rasterizer, fontStack, glyphID)));
+        }
+        return std::shared_ptr<const std::vector<Immutable<Glyph>>>(std::move(glyphs));
+    };
+
+    auto onRasterized = [this, self = weakFactory.makeWeakPtr(), fontStack](
+                            std::shared_ptr<const std::vector<Immutable<Glyph>>> glyphs) {
+        if (!self) return; // This glyph manager has been deleted.
+
+        auto it = entries.find(fontStack);
+        if (it == entries.end()) return; // The font stack has been evicted.
+        Entry& entry = it->second;
+
+        for (const auto& glyph : *glyphs) {
+            entry.glyphs.erase(glyph->id);
+            entry.glyphs.emplace(glyph->id, glyph);
+
+            auto rasterizing = entry.rasterizing.find(glyph->id);
+            if (rasterizing != entry.rasterizing.end()) {
+                Requestors requestors = std::move(rasterizing->second);
+                entry.rasterizing.erase(rasterizing);
+                notifyCompleted(requestors);
+            }
+        }
+    };
+
+    rasterizerScheduler->scheduleAndReplyValue(rasterize, onRasterized);
 }
 
 void GlyphManager::requestRange(GlyphRequest& request, const FontStack& fontStack, const GlyphRange& range, FileSource& fileSource) {
@@ -84,39 +148,72 @@ void GlyphManager::processResponse(const Response& res, const FontStack& fontSta
         return;
     }
 
-    Entry& entry = entries[fontStack];
-    GlyphRequest& request = entry.ranges[range];
+    GlyphRequest& request = entries[fontStack].ranges[range];
+    const uint64_t responseID = ++request.responseID;
 
-    if (!res.noContent) {
-        std::vector<Glyph> glyphs;
+    if (res.noContent) {
+        processGlyphs(nullptr, nullptr, fontStack, range, responseID);
+        return;
+    }
 
+    // Ranges of non-Latin scripts contain hundreds of glyphs, so they are parsed in the background.
+    using Result = std::pair<std::shared_ptr<const std::vector<Immutable<Glyph>>>, std::exception_ptr>;
+    auto parse = [range, data = res.data]() -> Result {
         try {
-            glyphs = parseGlyphPBF(range, *res.data);
+            auto glyphs = std::make_shared<std::vector<Immutable<Glyph>>>();
+            for (auto& glyph : parseGlyphPBF(range, *data)) {
+                glyphs->push_back(makeMutable<Glyph>(std::move(glyph)));
+            }
+            return { std::move(glyphs), nullptr };
         } catch (...) {
-            observer->onGlyphsError(fontStack, range, std::current_exception());
-            return;
+            return { nullptr, std::current_exception() };
         }
+    };
+
+    auto onParsed = [this, self = weakFactory.makeWeakPtr(), fontStack, range, responseID](Result result) {
+        if (!self) return; // This glyph manager has been deleted.
+        processGlyphs(std::move(result.first), std::move(result.second), fontStack, range, responseID);
+    };
 
-        for (auto& glyph : glyphs) {
-            auto id = glyph.id;
+    threadPool->scheduleAndReplyValue(parse, onParsed);
+}
+
+void GlyphManager::processGlyphs(std::shared_ptr<const std::vector<Immutable<Glyph>>> glyphs,
+                                 std::exception_ptr error,
+                                 const FontStack& fontStack,
+                                 const GlyphRange& range,
+                                 uint64_t responseID) {
+    auto entryIt = entries.find(fontStack);
+    if (entryIt == entries.end()) return; // The font stack has been evicted.
+    Entry& entry = entryIt->second;
+
+    auto requestIt = entry.ranges.find(range);
+    if (requestIt == entry.ranges.end() || requestIt->second.responseID != responseID) {
+        // A newer response is being processed.
+        return;
+    }
+    GlyphRequest& request = requestIt->second;
+
+    if (error) {
+        observer->onGlyphsError(fontStack, range, error);
+        return;
+    }
+
+    if (glyphs) {
+        for (const auto& glyph : *glyphs) {
+            auto id = glyph->id;
             if (!localGlyphRasterizer->canRasterizeGlyph(fontStack, id)) {
                 entry.glyphs.erase(id);
-                entry.glyphs.emplace(id, makeMutable<Glyph>(std::move(glyph)));
+                entry.glyphs.emplace(id, glyph);
             }
         }
     }
 
     request.parsed = true;
 
-    for (auto& pair : request.requestors) {
-        GlyphRequestor& requestor = *pair.first;
-        const std::shared_ptr<GlyphDependencies>& dependencies = pair.second;
-        if (dependencies.unique()) {
-            notify(requestor, *dependencies);
-        }
-    }
-
+    Requestors requestors = std::move(request.requestors);
     request.requestors.clear();
+    notifyCompleted(requestors);
 
     observer->onGlyphsLoaded(fontStack, range);
 }
@@ -148,11 +245,24 @@ void GlyphManager::notify(GlyphRequestor& requestor, const GlyphDependencies& gl
     requestor.onGlyphsAvailable(response);
 }
 
+void GlyphManager::notifyCompleted(const Requestors& requestors) {
+    for (auto& pair : requestors) {
+        GlyphRequestor& requestor = *pair.first;
+        const std::shared_ptr<GlyphDependencies>& dependencies = pair.second;
+        if (dependencies.unique()) {
+            notify(requestor, *dependencies);
+        }
+    }
+}
+
 void GlyphManager::removeRequestor(GlyphRequestor& requestor) {
     for (auto& entry : entries) {
         for (auto& range : entry.second.ranges) {
             range.second.requestors.erase(&requestor);
         }
+        for (auto& glyph : entry.second.rasterizing) {
+            glyph.second.erase(&requestor);
+        }
     }
 }
 
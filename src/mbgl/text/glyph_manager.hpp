@@ -7,14 +7,20 @@
 #include <mbgl/util/font_stack.hpp>
 #include <mbgl/util/immutable.hpp>
 
+#include <mapbox/weak.hpp>
+
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace mbgl {
 
 class FileSource;
 class AsyncRequest;
+class GlyphAtlas;
 class Response;
+class Scheduler;
+class ShapingCache;
 
 class GlyphRequestor {
 public:
@@ -35,43 +41,68 @@ public:
     // their `GlyphDependencies`. If all glyphs are already locally available, GlyphManager
     // will provide them to the requestor immediately. Otherwise, it makes a request on the
     // FileSource is made for each range needed, and notifies the observer when all are
-    // complete.
+    // complete. Glyph ranges are parsed, and glyphs rasterized locally, on background
+    // threads; the glyphs are only added once they are ready.
     void getGlyphs(GlyphRequestor&, GlyphDependencies, FileSource&);
     void removeRequestor(GlyphRequestor&);
 
-    void setURL(const std::string& url) {
-        glyphURL = url;
-    }
+    void setURL(const std::string&);
 
     void setObserver(GlyphManagerObserver*);
 
     // Remove glyphs for all but the supplied font stacks.
     void evict(const std::set<FontStack>&);
 
+    // The atlas that the glyphs of all tiles are packed into.
+    const std::shared_ptr<GlyphAtlas>& getAtlas() const { return atlas; }
+
+    // The shapings of label texts, shared by all tiles.
+    const std::shared_ptr<ShapingCache>& getShapingCache() const { return shapingCache; }
+
 private:
-    Glyph generateLocalSDF(const FontStack& fontStack, GlyphID glyphID);
     std::string glyphURL;
 
+    using Requestors = std::unordered_map<GlyphRequestor*, std::shared_ptr<GlyphDependencies>>;
+
     struct GlyphRequest {
         bool parsed = false;
+        // Identifies the latest response, as responses are parsed in parallel.
+        uint64_t responseID = 0;
         std::unique_ptr<AsyncRequest> req;
-        std::unordered_map<GlyphRequestor*, std::shared_ptr<GlyphDependencies>> requestors;
+        Requestors requestors;
     };
 
     struct Entry {
         std::map<GlyphRange, GlyphRequest> ranges;
         std::map<GlyphID, Immutable<Glyph>> glyphs;
+        // Glyphs being rasterized locally, and the requestors waiting for them.
+        std::map<GlyphID, Requestors> rasterizing;
     };
 
     std::unordered_map<FontStack, Entry, FontStackHasher> entries;
 
     void requestRange(GlyphRequest&, const FontStack&, const GlyphRange&, FileSource& fileSource);
     void processResponse(const Response&, const FontStack&, const GlyphRange&);
+    void processGlyphs(std::shared_ptr<const std::vector<Immutable<Glyph>>>,
+                       std::exception_ptr,
+                       const FontStack&,
+                       const GlyphRange&,
+                       uint64_t responseID);
+    void rasterizeGlyphs(const FontStack&, std::vector<GlyphID>);
     void notify(GlyphRequestor&, const GlyphDependencies&);
-    
+    void notifyCompleted(const Requestors&);
+
     GlyphManagerObserver* observer = nullptr;
-    
-    std::unique_ptr<LocalGlyphRasterizer> localGlyphRasterizer;
+
+    // Shared with the glyphs being rasterized, and only used by one thread at a time.
+    std::shared_ptr<LocalGlyphRasterizer> localGlyphRasterizer;
+    std::shared_ptr<Scheduler> threadPool;
+    std::shared_ptr<Scheduler> rasterizerScheduler;
+
+    std::shared_ptr<GlyphAtlas> atlas;
+    std::shared_ptr<ShapingCache> shapingCache;
+
+    mapbox::base::WeakPtrFactory<GlyphManager> weakFactory{this};
 };
 
 } // namespace mbgl
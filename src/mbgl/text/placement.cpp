@@ -6,7 +6,9 @@
 #include <mbgl/tile/geometry_tile.hpp>
 #include <mbgl/renderer/buckets/symbol_bucket.hpp>
 #include <mbgl/renderer/bucket.hpp>
+#include <mbgl/actor/scheduler.hpp>
 #include <mbgl/util/math.hpp>
+#include <mbgl/util/parallel_for.hpp>
 #include <utility>
 
 namespace mbgl {
@@ -46,9 +48,7 @@ const CollisionGroups::CollisionGroup& CollisionGroups::get(const std::string& s
             uint16_t nextGroupID = ++maxGroupID;
             collisionGroups.emplace(sourceID, CollisionGroup(
                 nextGroupID,
-                optional<Predicate>([nextGroupID](const IndexedSubfeature& feature) -> bool {
-                    return feature.collisionGroupId == nextGroupID;
-                })
+                optional<Predicate>(Predicate{nextGroupID})
             ));
         }
         return collisionGroups[sourceID];
@@ -90,6 +90,14 @@ bool PlacementController::hasTransitions(TimePoint now) const {
 
 // Placement implementation
 
+namespace {
+// Projected collision boxes of unchanged tiles stay the same, as long as these parameters do.
+bool isSameCamera(const TransformState& a, const TransformState& b) {
+    return a.getSize() == b.getSize() && a.getZoom() == b.getZoom() && a.getBearing() == b.getBearing() &&
+           a.getPitch() == b.getPitch() && a.getCameraToCenterDistance() == b.getCameraToCenterDistance();
+}
+} // namespace
+
 Placement::Placement(const TransformState& state_,
                      MapMode mapMode_,
                      style::TransitionOptions transitionOptions_,
@@ -104,6 +112,33 @@ Placement::Placement(const TransformState& state_,
     assert(prevPlacement || mapMode != MapMode::Continuous);
     if (prevPlacement) {
         prevPlacement->get()->prevPlacement = nullopt; // Only hold on to one placement back
+        replayingPrevPlacement = isSameCamera(state_, prevPlacement->get()->collisionIndex.getTransformState());
+        prevBucketRecords = prevPlacement->get()->bucketRecords;
+    }
+    // Only the next placement with the same camera can replay the records, and while the camera
+    // moves, it changes from one placement to the next.
+    recordingBuckets = replayingPrevPlacement;
+}
+
+Placement::Placement(const TransformState& state_,
+                     MapMode mapMode_,
+                     optional<Immutable<Placement>> prevPlacement_,
+                     CollisionGroups collisionGroups_,
+                     uint16_t collisionGroupId)
+    : collisionIndex(state_, mapMode_),
+      mapMode(mapMode_),
+      placementZoom(state_.getZoom()),
+      collisionGroups(std::move(collisionGroups_)),
+      prevPlacement(std::move(prevPlacement_)) {
+    if (prevPlacement) {
+        // The symbols of other collision groups have no effect on the placement of this group,
+        // so its records can be replayed as long as the records of this group are the same.
+        replayingPrevPlacement = isSameCamera(state_, prevPlacement->get()->collisionIndex.getTransformState());
+        for (const auto& record : prevPlacement->get()->bucketRecords) {
+            if (record->collisionGroupId == collisionGroupId) {
+                prevBucketRecords.push_back(record);
+            }
+        }
     }
 }
 
@@ -114,6 +149,7 @@ void Placement::placeLayer(const RenderLayer& layer, const mat4& projMatrix, boo
         BucketPlacementParameters params{
                 item.tile,
                 projMatrix,
+                layer.getID(),
                 layer.baseImpl->source,
                 item.featureIndex,
                 showCollisionBoxes};
@@ -121,6 +157,111 @@ void Placement::placeLayer(const RenderLayer& layer, const mat4& projMatrix, boo
     }
 }
 
+void Placement::placeLayers(const std::vector<std::reference_wrapper<const RenderLayer>>& layers,
+                            const mat4& projMatrix,
+                            bool showCollisionBoxes) {
+    // Assign the collision group IDs in the order placing the layers one by one would.
+    std::vector<uint16_t> layerGroupIDs;
+    std::vector<uint16_t> groupIDs;
+    layerGroupIDs.reserve(layers.size());
+    for (const RenderLayer& layer : layers) {
+        uint16_t groupID = 0;
+        if (!layer.getPlacementData().empty()) {
+            groupID = collisionGroups.get(layer.baseImpl->source).first;
+            if (std::find(groupIDs.begin(), groupIDs.end(), groupID) == groupIDs.end()) {
+                groupIDs.push_back(groupID);
+            }
+        }
+        layerGroupIDs.push_back(groupID);
+    }
+
+    // With cross-source collisions, all sources share a single collision group.
+    if (groupIDs.size() < 2 || !placements.empty()) {
+        for (const RenderLayer& layer : layers) {
+            placeLayer(layer, projMatrix, showCollisionBoxes);
+        }
+        return;
+    }
+
+    // Construct the group placements up front, as the constructor isn't safe to run concurrently.
+    std::vector<std::unique_ptr<Placement>> groupPlacements;
+    groupPlacements.reserve(groupIDs.size());
+    for (uint16_t groupID : groupIDs) {
+        groupPlacements.emplace_back(
+            new Placement(collisionIndex.getTransformState(), mapMode, prevPlacement, collisionGroups, groupID));
+    }
+
+    // Placing a bucket clears its `justReloaded` flag, which placing the layers one by one below has to see.
+    std::vector<bool> bucketsJustReloaded;
+    for (const RenderLayer& layer : layers) {
+        for (const auto& item : layer.getPlacementData()) {
+            bucketsJustReloaded.push_back(static_cast<const SymbolBucket&>(item.bucket.get()).justReloaded);
+        }
+    }
+
+    std::shared_ptr<Scheduler> scheduler = Scheduler::GetBackground();
+    util::parallelFor(*scheduler, groupIDs.size(), [&](std::size_t groupIndex) {
+        for (std::size_t i = 0; i < layers.size(); ++i) {
+            if (layerGroupIDs[i] == groupIDs[groupIndex] && !layers[i].get().getPlacementData().empty()) {
+                groupPlacements[groupIndex]->placeLayer(layers[i], projMatrix, showCollisionBoxes);
+            }
+        }
+    });
+
+    std::vector<std::size_t> layerGroupIndices(layers.size(), 0);
+    std::vector<std::size_t> groupBucketCounts(groupIDs.size(), 0);
+    for (std::size_t i = 0; i < layers.size(); ++i) {
+        layerGroupIndices[i] = static_cast<std::size_t>(
+            std::find(groupIDs.begin(), groupIDs.end(), layerGroupIDs[i]) - groupIDs.begin());
+        if (layerGroupIndices[i] < groupIDs.size()) {
+            groupBucketCounts[layerGroupIndices[i]] += layers[i].get().getPlacementData().size();
+        }
+    }
+
+    // Each placed bucket leaves exactly one record. Should a group placement hold any other number
+    // of records, they can't be matched to the buckets, so place the layers one by one instead.
+    for (std::size_t groupIndex = 0; groupIndex < groupIDs.size(); ++groupIndex) {
+        if (groupPlacements[groupIndex]->bucketRecords.size() != groupBucketCounts[groupIndex]) {
+            std::size_t bucketIndex = 0;
+            for (const RenderLayer& layer : layers) {
+                for (const auto& item : layer.getPlacementData()) {
+                    static_cast<const SymbolBucket&>(item.bucket.get()).justReloaded =
+                        bucketsJustReloaded[bucketIndex++];
+                }
+            }
+            for (const RenderLayer& layer : layers) {
+                placeLayer(layer, projMatrix, showCollisionBoxes);
+            }
+            return;
+        }
+    }
+
+    // Merge the group placements in layer order. Applying the records in this order fills the
+    // collision index in the same order as placing the layers one by one.
+    std::vector<std::size_t> nextRecords(groupIDs.size(), 0);
+    for (std::size_t i = 0; i < layers.size(); ++i) {
+        if (layers[i].get().getPlacementData().empty()) continue;
+        const std::size_t groupIndex = layerGroupIndices[i];
+        const Placement& groupPlacement = *groupPlacements[groupIndex];
+        std::size_t& nextRecord = nextRecords[groupIndex];
+
+        std::set<uint32_t> seenCrossTileIDs;
+        for (std::size_t j = 0; j < layers[i].get().getPlacementData().size(); ++j) {
+            const auto& record = groupPlacement.bucketRecords[nextRecord++];
+            applyBucketRecord(*record, seenCrossTileIDs);
+            if (recordingBuckets) bucketRecords.push_back(record);
+        }
+    }
+
+    for (auto& groupPlacement : groupPlacements) {
+        retainedQueryData.insert(groupPlacement->retainedQueryData.begin(), groupPlacement->retainedQueryData.end());
+        collisionCircles.insert(groupPlacement->collisionCircles.begin(), groupPlacement->collisionCircles.end());
+    }
+
+    // The records may no longer line up with the previous placement's records.
+    replayingPrevPlacement = false;
+}
+
 namespace {
 Point<float> calculateVariableLayoutOffset(style::SymbolAnchorType anchor, float width, float height, std::array<float, 2> offset, float textBoxScale) {
     AnchorAlignment alignment = AnchorAlignment::getAnchorAlignment(anchor);
@@ -161,6 +302,27 @@ void Placement::placeBucket(
             pixelsToTileUnits);
 
     const auto& collisionGroup = collisionGroups.get(params.sourceId);
+
+    if (replayingPrevPlacement) {
+        replayingPrevPlacement = replayBucket(bucket, params, posMatrix, collisionGroup.first, seenCrossTileIDs);
+        if (replayingPrevPlacement) {
+            return;
+        }
+    }
+
+    std::shared_ptr<BucketPlacementRecord> record;
+    if (recordingBuckets) {
+        record = std::make_shared<BucketPlacementRecord>(BucketPlacementRecord{params.layerId,
+                                                                               bucket.bucketInstanceId,
+                                                                               collisionGroup.first,
+                                                                               renderTile.holdForFade(),
+                                                                               bucket.justReloaded,
+                                                                               params.showCollisionBoxes,
+                                                                               posMatrix,
+                                                                               {}});
+        record->symbols.reserve(bucket.symbolInstances.size());
+    }
+
     auto partiallyEvaluatedTextSize = bucket.textSizeBinder->evaluateForZoom(state.getZoom());
     auto partiallyEvaluatedIconSize = bucket.iconSizeBinder->evaluateForZoom(state.getZoom());
 
@@ -201,10 +363,13 @@ void Placement::placeBucket(
     auto placeSymbol = [&] (const SymbolInstance& symbolInstance) {
         if (seenCrossTileIDs.count(symbolInstance.crossTileID) != 0u) return;
 
+        BucketPlacementRecord::Symbol symbolRecord{&symbolInstance, symbolInstance.crossTileID};
         if (renderTile.holdForFade()) {
             // Mark all symbols from this tile as "not placed", but don't add to seenCrossTileIDs, because we don't
             // know yet if we have a duplicate in a parent tile that _should_ be placed.
             placements.emplace(symbolInstance.crossTileID, JointPlacement(false, false, false));
+            symbolRecord.holdForFade = true;
+            if (record) record->symbols.push_back(std::move(symbolRecord));
             return;
         }
         textBoxes.clear();
@@ -365,29 +530,15 @@ void Placement::placeBucket(
 
                         if (placedFeature.first) {
                             assert(symbolInstance.crossTileID != 0u);
-                            optional<style::TextVariableAnchorType> prevAnchor;
-
-                            // If this label was placed in the previous placement, record the anchor position
-                            // to allow us to animate the transition
-                            if (getPrevPlacement()) {
-                                auto prevOffset = getPrevPlacement()->variableOffsets.find(symbolInstance.crossTileID);
-                                auto prevPlacements = getPrevPlacement()->placements.find(symbolInstance.crossTileID);
-                                if (prevOffset != getPrevPlacement()->variableOffsets.end() &&
-                                    prevPlacements != getPrevPlacement()->placements.end() &&
-                                    prevPlacements->second.text) {
-                                    // TODO: The prevAnchor seems to be unused, needs to be fixed.
-                                    prevAnchor = prevOffset->second.anchor;
-                                }
-                            }
-
-                            variableOffsets.insert(std::make_pair(symbolInstance.crossTileID, VariableOffset{
-                                symbolInstance.variableTextOffset,
-                                width,
-                                height,
-                                anchor,
-                                textBoxScale,
-                                prevAnchor
-                            }));
+                            VariableOffset variableOffset{symbolInstance.variableTextOffset,
+                                                          width,
+                                                          height,
+                                                          anchor,
+                                                          textBoxScale,
+                                                          getPrevAnchor(symbolInstance.crossTileID)};
+                            variableOffsets.insert(std::make_pair(symbolInstance.crossTileID, variableOffset));
+                            symbolRecord.variableOffsetSource = BucketPlacementRecord::Source::Placement;
+                            symbolRecord.variableOffset = variableOffset;
 
                             if (bucket.allowVerticalPlacement) {
                                 placedOrientations.emplace(symbolInstance.crossTileID, orientation);
@@ -426,6 +577,7 @@ void Placement::placeBucket(
                 // If we didn't get placed, we still need to copy our position from the last placement for
                 // fade animations
                 if (!placeText && getPrevPlacement()) {
+                    symbolRecord.variableOffsetSource = BucketPlacementRecord::Source::PrevPlacement;
                     auto prevOffset = getPrevPlacement()->variableOffsets.find(symbolInstance.crossTileID);
                     if (prevOffset != getPrevPlacement()->variableOffsets.end()) {
                         variableOffsets[symbolInstance.crossTileID] = prevOffset->second;
@@ -475,19 +627,21 @@ void Placement::placeBucket(
         }
 
         if (placeText) {
-            if (placedVerticalText.first && symbolInstance.verticalTextCollisionFeature) {
-                collisionIndex.insertFeature(*symbolInstance.verticalTextCollisionFeature, textBoxes, layout.get<style::TextIgnorePlacement>(), bucket.bucketInstanceId, collisionGroup.first);
-            } else {
-                collisionIndex.insertFeature(symbolInstance.textCollisionFeature, textBoxes, layout.get<style::TextIgnorePlacement>(), bucket.bucketInstanceId, collisionGroup.first);
-            }
+            const CollisionFeature& textFeature = placedVerticalText.first && symbolInstance.verticalTextCollisionFeature
+                                                      ? *symbolInstance.verticalTextCollisionFeature
+                                                      : symbolInstance.textCollisionFeature;
+            const bool ignorePlacement = layout.get<style::TextIgnorePlacement>();
+            collisionIndex.insertFeature(textFeature, textBoxes, ignorePlacement, bucket.bucketInstanceId, collisionGroup.first);
+            if (record) symbolRecord.insertedText = BucketPlacementRecord::InsertedFeature{&textFeature, textBoxes, ignorePlacement};
         }
 
         if (placeIcon) {
-            if (placedVerticalIcon.first && symbolInstance.verticalIconCollisionFeature) {
-                collisionIndex.insertFeature(*symbolInstance.verticalIconCollisionFeature, iconBoxes, layout.get<style::IconIgnorePlacement>(), bucket.bucketInstanceId, collisionGroup.first);
-            } else {
-                collisionIndex.insertFeature(symbolInstance.iconCollisionFeature, iconBoxes, layout.get<style::IconIgnorePlacement>(), bucket.bucketInstanceId, collisionGroup.first);
-            }
+            const CollisionFeature& iconFeature = placedVerticalIcon.first && symbolInstance.verticalIconCollisionFeature
+                                                      ? *symbolInstance.verticalIconCollisionFeature
+                                                      : symbolInstance.iconCollisionFeature;
+            const bool ignorePlacement = layout.get<style::IconIgnorePlacement>();
+            collisionIndex.insertFeature(iconFeature, iconBoxes, ignorePlacement, bucket.bucketInstanceId, collisionGroup.first);
+            if (record) symbolRecord.insertedIcon = BucketPlacementRecord::InsertedFeature{&iconFeature, iconBoxes, ignorePlacement};
         }
 
         const bool hasIconCollisionCircleData = bucket.hasIconCollisionCircleData();
@@ -510,6 +664,15 @@ void Placement::placeBucket(
         
         placements.emplace(symbolInstance.crossTileID, JointPlacement(placeText || alwaysShowText, placeIcon || alwaysShowIcon, offscreen || bucket.justReloaded));
         seenCrossTileIDs.insert(symbolInstance.crossTileID);
+
+        symbolRecord.text = placeText || alwaysShowText;
+        symbolRecord.icon = placeIcon || alwaysShowIcon;
+        symbolRecord.offscreen = offscreen;
+        auto placedOrientation = placedOrientations.find(symbolInstance.crossTileID);
+        if (placedOrientation != placedOrientations.end()) {
+            symbolRecord.orientation = placedOrientation->second;
+        }
+        if (record) record->symbols.push_back(std::move(symbolRecord));
     };
 
     if (zOrderByViewportY) {
@@ -531,6 +694,101 @@ void Placement::placeBucket(
     retainedQueryData.emplace(std::piecewise_construct,
                                 std::forward_as_tuple(bucket.bucketInstanceId),
                                 std::forward_as_tuple(bucket.bucketInstanceId, params.featureIndex, overscaledID));
+
+    if (record) bucketRecords.push_back(std::move(record));
+}
+
+bool Placement::replayBucket(const SymbolBucket& bucket,
+                             const BucketPlacementParameters& params,
+                             const mat4& posMatrix,
+                             uint16_t collisionGroupId,
+                             std::set<uint32_t>& seenCrossTileIDs) {
+    // The collision index state depends on all symbols placed before, so a record can only be
+    // replayed if all previously placed buckets have been replayed as well.
+    if (bucketRecords.size() >= prevBucketRecords.size()) {
+        return false;
+    }
+
+    const auto& record = prevBucketRecords[bucketRecords.size()];
+    if (record->bucketInstanceId != bucket.bucketInstanceId || record->layerId != params.layerId ||
+        record->collisionGroupId != collisionGroupId || record->holdForFade != params.tile.holdForFade() ||
+        record->justReloaded || record->showCollisionBoxes || params.showCollisionBoxes || record->posMatrix != posMatrix ||
+        bucket.justReloaded || bucket.hasIconCollisionCircleData() || bucket.hasTextCollisionCircleData()) {
+        return false;
+    }
+
+    // Cross-tile IDs are reassigned if the bucket was indexed again.
+    for (const auto& symbol : record->symbols) {
+        if (symbol.instance->crossTileID != symbol.crossTileID) {
+            return false;
+        }
+    }
+
+    applyBucketRecord(*record, seenCrossTileIDs);
+
+    retainedQueryData.emplace(std::piecewise_construct,
+                              std::forward_as_tuple(bucket.bucketInstanceId),
+                              std::forward_as_tuple(bucket.bucketInstanceId, params.featureIndex, params.tile.getOverscaledTileID()));
+
+    bucketRecords.push_back(record);
+    return true;
+}
+
+void Placement::applyBucketRecord(const BucketPlacementRecord& record, std::set<uint32_t>& seenCrossTileIDs) {
+    for (const auto& symbol : record.symbols) {
+        const uint32_t crossTileID = symbol.crossTileID;
+        if (symbol.holdForFade) {
+            placements.emplace(crossTileID, JointPlacement(false, false, false));
+            continue;
+        }
+
+        if (symbol.orientation) {
+            placedOrientations[crossTileID] = *symbol.orientation;
+        }
+
+        if (symbol.variableOffsetSource == BucketPlacementRecord::Source::Placement) {
+            assert(symbol.variableOffset);
+            VariableOffset variableOffset = *symbol.variableOffset;
+            variableOffset.prevAnchor = getPrevAnchor(crossTileID);
+            variableOffsets.insert(std::make_pair(crossTileID, variableOffset));
+        } else if (symbol.variableOffsetSource == BucketPlacementRecord::Source::PrevPlacement) {
+            if (const Placement* prev = getPrevPlacement()) {
+                auto prevOffset = prev->variableOffsets.find(crossTileID);
+                if (prevOffset != prev->variableOffsets.end()) {
+                    variableOffsets[crossTileID] = prevOffset->second;
+                }
+            }
+        }
+
+        for (const auto* inserted : {&symbol.insertedText, &symbol.insertedIcon}) {
+            if (*inserted) {
+                collisionIndex.insertFeature(*(*inserted)->feature,
+                                             (*inserted)->boxes,
+                                             (*inserted)->ignorePlacement,
+                                             record.bucketInstanceId,
+                                             record.collisionGroupId);
+            }
+        }
+
+        placements.erase(crossTileID);
+        placements.emplace(crossTileID, JointPlacement(symbol.text, symbol.icon, symbol.offscreen || record.justReloaded));
+        seenCrossTileIDs.insert(crossTileID);
+    }
+}
+
+optional<style::TextVariableAnchorType> Placement::getPrevAnchor(uint32_t crossTileID) const {
+    // If this label was placed in the previous placement, record the anchor position
+    // to allow us to animate the transition
+    // TODO: The prevAnchor seems to be unused, needs to be fixed.
+    if (const Placement* prev = getPrevPlacement()) {
+        auto prevOffset = prev->variableOffsets.find(crossTileID);
+        auto prevPlacements = prev->placements.find(crossTileID);
+        if (prevOffset != prev->variableOffsets.end() && prevPlacements != prev->placements.end() &&
+            prevPlacements->second.text) {
+            return prevOffset->second.anchor;
+        }
+    }
+    return nullopt;
 }
 
 void Placement::commit(TimePoint now, const double zoom) {
@@ -6,6 +6,7 @@
 #include <mbgl/text/collision_index.hpp>
 #include <mbgl/layout/symbol_projection.hpp>
 #include <mbgl/style/transition_options.hpp>
+#include <functional>
 #include <unordered_set>
 
 namespace mbgl {
@@ -69,7 +70,7 @@ struct RetainedQueryData {
     
 class CollisionGroups {
 public:
-    using Predicate = std::function<bool(const IndexedSubfeature&)>;
+    using Predicate = CollisionGroupPredicate;
     using CollisionGroup = std::pair<uint16_t, optional<Predicate>>;
     
     CollisionGroups(const bool crossSourceCollisions_)
@@ -89,11 +90,51 @@ class BucketPlacementParameters {
 public:
     const RenderTile& tile;
     const mat4& projMatrix;
+    std::string layerId;
     std::string sourceId;
     std::shared_ptr<FeatureIndex> featureIndex;
     bool showCollisionBoxes;
 };
 
+// The outcome of placing the symbols of a bucket. A placement made with the same camera as the
+// previous one replays the records of the previous placement instead of placing the symbols again,
+// for as long as the placed buckets match. Placements only keep records while the camera rests.
+class BucketPlacementRecord {
+public:
+    enum class Source : uint8_t { None, Placement, PrevPlacement };
+
+    class InsertedFeature {
+    public:
+        const CollisionFeature* feature;
+        std::vector<ProjectedCollisionBox> boxes;
+        bool ignorePlacement;
+    };
+
+    class Symbol {
+    public:
+        const SymbolInstance* instance;
+        uint32_t crossTileID;
+        bool holdForFade = false;
+        bool text = false;
+        bool icon = false;
+        bool offscreen = false;
+        optional<style::TextWritingModeType> orientation;
+        Source variableOffsetSource = Source::None;
+        optional<VariableOffset> variableOffset;
+        optional<InsertedFeature> insertedText;
+        optional<InsertedFeature> insertedIcon;
+    };
+
+    std::string layerId;
+    uint32_t bucketInstanceId;
+    uint16_t collisionGroupId;
+    bool holdForFade;
+    bool justReloaded;
+    bool showCollisionBoxes;
+    mat4 posMatrix;
+    std::vector<Symbol> symbols;
+};
+
 class Placement;
 
 class PlacementController {
@@ -118,6 +159,13 @@ public:
               const bool crossSourceCollisions,
               optional<Immutable<Placement>> prevPlacement = nullopt);
     void placeLayer(const RenderLayer&, const mat4&, bool showCollisionBoxes);
+    // Places the layers in the given order. Without cross-source collisions, the symbols of
+    // different sources can't collide, so each collision group is placed in parallel into a
+    // placement of its own. These are merged in layer order, which gives the same outcome as
+    // placing the layers one after the other.
+    void placeLayers(const std::vector<std::reference_wrapper<const RenderLayer>>&,
+                     const mat4&,
+                     bool showCollisionBoxes);
     void commit(TimePoint, const double zoom);
     void updateLayerBuckets(const RenderLayer&, const TransformState&, bool updateOpacities) const;
     float symbolFadeChange(TimePoint now) const;
@@ -125,6 +173,11 @@ public:
     bool transitionsEnabled() const;
 
     const CollisionIndex& getCollisionIndex() const;
+    const std::unordered_map<uint32_t, JointPlacement>& getPlacements() const { return placements; }
+    const std::unordered_map<uint32_t, VariableOffset>& getVariableOffsets() const { return variableOffsets; }
+    const std::unordered_map<uint32_t, style::TextWritingModeType>& getPlacedOrientations() const {
+        return placedOrientations;
+    }
     TimePoint getCommitTime() const { return commitTime; }
     Duration getUpdatePeriod(const float zoom) const;
 
@@ -133,7 +186,23 @@ public:
     const RetainedQueryData& getQueryData(uint32_t bucketInstanceId) const;
 private:
     friend SymbolBucket;
+    // Placement of the layers of a single collision group, see `placeLayers()`.
+    Placement(const TransformState&,
+              MapMode,
+              optional<Immutable<Placement>> prevPlacement,
+              CollisionGroups,
+              uint16_t collisionGroupId);
+
     void placeBucket(const SymbolBucket&, const BucketPlacementParameters&, std::set<uint32_t>& seenCrossTileIDs);
+    // Returns `true` if the previous placement's record of the bucket was replayed; returns `false` otherwise.
+    bool replayBucket(const SymbolBucket&,
+                      const BucketPlacementParameters&,
+                      const mat4& posMatrix,
+                      uint16_t collisionGroupId,
+                      std::set<uint32_t>& seenCrossTileIDs);
+    // Applies the outcome of placing the symbols of a bucket, as recorded by `placeBucket()`.
+    void applyBucketRecord(const BucketPlacementRecord&, std::set<uint32_t>& seenCrossTileIDs);
+    optional<style::TextVariableAnchorType> getPrevAnchor(uint32_t crossTileID) const;
     // Returns `true` if bucket vertices were updated; returns `false` otherwise.
     bool updateBucketDynamicVertices(SymbolBucket&, const TransformState&, const RenderTile& tile) const;
     void updateBucketOpacities(SymbolBucket&, const TransformState&, std::set<uint32_t>&) const;
@@ -163,6 +232,15 @@ private:
     CollisionGroups collisionGroups;
     mutable optional<Immutable<Placement>> prevPlacement;
 
+    // Records of the placed buckets, in placement order.
+    std::vector<std::shared_ptr<const BucketPlacementRecord>> bucketRecords;
+    // Records of the previous placement that may be replayed, in placement order.
+    std::vector<std::shared_ptr<const BucketPlacementRecord>> prevBucketRecords;
+    // Set while the camera and all buckets placed so far are the same as in the previous placement.
+    bool replayingPrevPlacement = false;
+    // Set if the placed buckets are recorded, which group placements always are.
+    bool recordingBuckets = true;
+
     // Used for debug purposes.
     std::unordered_map<const CollisionFeature*, std::vector<ProjectedCollisionBox>> collisionCircles;
 };
@@ -0,0 +1,148 @@
+#include <mbgl/text/shaping_cache.hpp>
+#include <mbgl/text/shaping.hpp>
+#include <mbgl/util/hash.hpp>
+
+namespace mbgl {
+
+namespace {
+
+bool isCacheable(const TaggedString& text, const GlyphMap& glyphMap) {
+    for (const auto& section : text.getSections()) {
+        if (section.imageID) {
+            return false;
+        }
+    }
+    for (std::size_t i = 0; i < text.length(); i++) {
+        const SectionOptions& section = text.getSection(i);
+        auto glyphs = glyphMap.find(section.fontStackHash);
+        if (glyphs == glyphMap.end()) {
+            return false;
+        }
+        auto glyph = glyphs->second.find(text.getCharCodeAt(i));
+        if (glyph == glyphs->second.end() || !glyph->second) {
+            return false;
+        }
+    }
+    return true;
+}
+
+Shaping withGlyphPositions(const Shaping& cached, const GlyphPositions& glyphPositions) {
+    Shaping shaping = cached;
+    for (auto& line : shaping.positionedLines) {
+        for (auto& glyph : line.positionedGlyphs) {
+            glyph.rect = {};
+            auto glyphPositionMap = glyphPositions.find(glyph.font);
+            if (glyphPositionMap != glyphPositions.end()) {
+                auto glyphPosition = glyphPositionMap->second.find(glyph.glyph);
+                if (glyphPosition != glyphPositionMap->second.end()) {
+                    glyph.rect = glyphPosition->second.rect;
+                }
+            }
+        }
+    }
+    return shaping;
+}
+
+} // namespace
+
+bool ShapingCache::Key::operator==(const Key& other) const {
+    return text == other.text && sectionIndices == other.sectionIndices && sections == other.sections &&
+           maxWidth == other.maxWidth && lineHeight == other.lineHeight && textAnchor == other.textAnchor &&
+           textJustify == other.textJustify && spacing == other.spacing && translate == other.translate &&
+           writingMode == other.writingMode && allowVerticalPlacement == other.allowVerticalPlacement;
+}
+
+std::size_t ShapingCache::KeyHasher::operator()(const Key& key) const {
+    std::size_t seed = util::hash(key.text,
+                                  key.maxWidth,
+                                  key.lineHeight,
+                                  static_cast<uint8_t>(key.textAnchor),
+                                  static_cast<uint8_t>(key.textJustify),
+                                  key.spacing,
+                                  key.translate[0],
+                                  key.translate[1],
+                                  static_cast<uint8_t>(key.writingMode),
+                                  key.allowVerticalPlacement);
+    for (const auto& section : key.sections) {
+        util::hash_combine(seed, section.first);
+        util::hash_combine(seed, section.second);
+    }
+    return seed;
+}
+
+ShapingCache::ShapingCache(std::size_t maxEntries_) : maxEntries(maxEntries_) {
+}
+
+Shaping ShapingCache::getShaping(const TaggedString& text,
+                                 const float maxWidth,
+                                 const float lineHeight,
+                                 const style::SymbolAnchorType textAnchor,
+                                 const style::TextJustifyType textJustify,
+                                 const float spacing,
+                                 const std::array<float, 2>& translate,
+                                 const WritingModeType writingMode,
+                                 BiDi& bidi,
+                                 const GlyphMap& glyphMap,
+                                 const GlyphPositions& glyphPositions,
+                                 const ImagePositions& imagePositions,
+                                 const float layoutTextSize,
+                                 const float layoutTextSizeAtBucketZoomLevel,
+                                 const bool allowVerticalPlacement) {
+    auto shape = [&] {
+        return mbgl::getShaping(text, maxWidth, lineHeight, textAnchor, textJustify, spacing, translate, writingMode,
+                                bidi, glyphMap, glyphPositions, imagePositions, layoutTextSize,
+                                layoutTextSizeAtBucketZoomLevel, allowVerticalPlacement);
+    };
+
+    if (maxEntries == 0 || !isCacheable(text, glyphMap)) {
+        return shape();
+    }
+
+    // The text size only affects the size of images, so texts without images share their
+    // shaping across zoom levels.
+    Key key{ text.rawText(), text.getStyledText().second, {}, maxWidth, lineHeight, textAnchor,
+             textJustify, spacing, translate, writingMode, allowVerticalPlacement };
+    key.sections.reserve(text.sectionCount());
+    for (const auto& section : text.getSections()) {
+        key.sections.emplace_back(section.fontStackHash, section.scale);
+    }
+
+    std::shared_ptr<const Shaping> cached;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = entries.find(key);
+        if (it != entries.end()) {
+            orderedKeys.splice(orderedKeys.end(), orderedKeys, it->second.position);
+            cached = it->second.shaping;
+        }
+    }
+    if (cached) {
+        return withGlyphPositions(*cached, glyphPositions);
+    }
+
+    Shaping shaping = shape();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto result = entries.emplace(std::move(key), Entry{ std::make_shared<const Shaping>(shaping), {} });
+    if (result.second) {
+        result.first->second.position = orderedKeys.insert(orderedKeys.end(), &result.first->first);
+        while (entries.size() > maxEntries) {
+            entries.erase(entries.find(*orderedKeys.front()));
+            orderedKeys.pop_front();
+        }
+    }
+    return shaping;
+}
+
+void ShapingCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.clear();
+    orderedKeys.clear();
+}
+
+std::size_t ShapingCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+}
+
+} // namespace mbgl
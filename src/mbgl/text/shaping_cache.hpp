@@ -0,0 +1,90 @@
+#pragma once
+
+#include <mbgl/renderer/image_atlas.hpp>
+#include <mbgl/style/types.hpp>
+#include <mbgl/text/glyph.hpp>
+#include <mbgl/text/glyph_atlas.hpp>
+#include <mbgl/text/tagged_string.hpp>
+#include <mbgl/util/noncopyable.hpp>
+
+#include <array>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace mbgl {
+
+class BiDi;
+
+// Least recently used cache of the shapings of label texts, shared by the workers of all tiles
+// of a renderer. The same street names recur in neighbouring tiles and across zoom levels, and
+// shaping them once saves the BiDi, line breaking and glyph positioning for all other instances.
+//
+// Only texts without images, whose glyphs are all available, are cached: their shaping depends
+// on the glyph metrics alone, which don't change for as long as the glyph URL stays the same.
+// The positions of the glyphs in the shared glyph atlas may change though, so those are looked
+// up again for every tile.
+class ShapingCache : private util::noncopyable {
+public:
+    explicit ShapingCache(std::size_t maxEntries = 8192);
+
+    // Same as `getShaping()`, but returns the cached shaping if there is one.
+    Shaping getShaping(const TaggedString&,
+                       float maxWidth,
+                       float lineHeight,
+                       style::SymbolAnchorType textAnchor,
+                       style::TextJustifyType textJustify,
+                       float spacing,
+                       const std::array<float, 2>& translate,
+                       WritingModeType,
+                       BiDi&,
+                       const GlyphMap&,
+                       const GlyphPositions&,
+                       const ImagePositions&,
+                       float layoutTextSize,
+                       float layoutTextSizeAtBucketZoomLevel,
+                       bool allowVerticalPlacement);
+
+    // Drops all shapings, e.g. because the glyphs they were made of changed.
+    void clear();
+
+    std::size_t size() const;
+
+private:
+    struct Key {
+        std::u16string text;
+        std::vector<uint8_t> sectionIndices;
+        std::vector<std::pair<FontStackHash, double>> sections;
+        float maxWidth;
+        float lineHeight;
+        style::SymbolAnchorType textAnchor;
+        style::TextJustifyType textJustify;
+        float spacing;
+        std::array<float, 2> translate;
+        WritingModeType writingMode;
+        bool allowVerticalPlacement;
+
+        bool operator==(const Key&) const;
+    };
+
+    struct KeyHasher {
+        std::size_t operator()(const Key&) const;
+    };
+
+    struct Entry {
+        std::shared_ptr<const Shaping> shaping;
+        // Position in the list of keys.
+        std::list<const Key*>::iterator position;
+    };
+
+    const std::size_t maxEntries;
+
+    mutable std::mutex mutex;
+    std::unordered_map<Key, Entry, KeyHasher> entries;
+    // Keys ordered from the least to the most recently used.
+    std::list<const Key*> orderedKeys;
+};
+
+} // namespace mbgl
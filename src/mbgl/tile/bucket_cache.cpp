@@ -0,0 +1,230 @@
+#include <mbgl/tile/bucket_cache.hpp>
+#include <mbgl/geometry/feature_index.hpp>
+#include <mbgl/layermanager/layer_manager.hpp>
+#include <mbgl/renderer/bucket.hpp>
+#include <mbgl/renderer/bucket_parameters.hpp>
+#include <mbgl/renderer/render_layer.hpp>
+#include <mbgl/style/conversion/stringify.hpp>
+#include <mbgl/style/layer_impl.hpp>
+#include <mbgl/util/binary_stream.hpp>
+#include <mbgl/util/io.hpp>
+#include <mbgl/util/logging.hpp>
+#include <mbgl/util/string.hpp>
+
+#include <rapidjson/writer.h>
+#include <rapidjson/stringbuffer.h>
+
+#include <atomic>
+#include <cstdio>
+#include <random>
+
+namespace mbgl {
+
+namespace {
+
+// Identifies the file format. Bump the version whenever the serialized form of any bucket changes.
+constexpr uint64_t kMagic = 0x4d42474c424b5431; // "MBGLBKT1"
+constexpr uint32_t kVersion = 2;
+
+// Bounds the size of the cache directory to kFileCount * kMaxFileSize bytes.
+constexpr uint64_t kFileCount = 1024;
+constexpr std::size_t kMaxFileSize = 1024 * 1024;
+
+// FNV-1a, which unlike `std::hash` gives the same 64 bit result in every process and build.
+uint64_t stableHash(const char* data, std::size_t size) {
+    uint64_t hash = 14695981039346656037u;
+    for (std::size_t i = 0; i < size; ++i) {
+        hash = (hash ^ static_cast<unsigned char>(data[i])) * 1099511628211u;
+    }
+    return hash;
+}
+
+uint64_t stableHash(const std::string& string) {
+    return stableHash(string.data(), string.size());
+}
+
+uint64_t makeTileKey(const OverscaledTileID& id, const std::string& sourceID, MapMode mode, float pixelRatio) {
+    util::BinaryWriter writer;
+    writer.write(sourceID);
+    writer.write(static_cast<uint32_t>(mode));
+    writer.write(pixelRatio);
+    writer.write(id.overscaledZ);
+    writer.write(id.canonical.z);
+    writer.write(id.canonical.x);
+    writer.write(id.canonical.y);
+    return stableHash(writer.getData());
+}
+
+std::string makeFilename(const std::string& path, uint64_t tileKey) {
+    return path + "/" + util::toString(tileKey % kFileCount) + ".bucket";
+}
+
+} // namespace
+
+BucketCache::BucketCache(const std::string& path,
+                         const OverscaledTileID& id,
+                         const std::string& sourceID,
+                         MapMode mode,
+                         float pixelRatio,
+                         const std::string& encodedData)
+    : tileKey(makeTileKey(id, sourceID, mode, pixelRatio)),
+      filename(makeFilename(path, tileKey)),
+      dataHash(stableHash(encodedData)) {
+    optional<std::string> file = util::readFile(filename);
+    if (!file) {
+        return;
+    }
+    data = std::move(*file);
+
+    util::BinaryReader reader(data);
+    uint64_t magic, tile, hash, count;
+    uint32_t version;
+    if (!reader.read(magic) || magic != kMagic || !reader.read(version) || version != kVersion ||
+        !reader.read(tile) || tile != tileKey || !reader.read(hash) || hash != dataHash || !reader.read(count)) {
+        // The file holds another tile, the tile changed since it was stored, or it was stored by
+        // another version.
+        data.clear();
+        return;
+    }
+
+    for (uint64_t i = 0; i < count; ++i) {
+        uint64_t key, size;
+        if (!reader.read(key) || !reader.read(size)) {
+            break;
+        }
+        const char* entry = reader.skip(size);
+        if (!entry) {
+            break;
+        }
+        entries[key] = {static_cast<std::size_t>(entry - data.data()), static_cast<std::size_t>(size)};
+    }
+}
+
+uint64_t BucketCache::groupKey(const std::vector<Immutable<style::LayerProperties>>& group) {
+    using namespace style::conversion;
+
+    rapidjson::StringBuffer s;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(s);
+
+    // Like `layoutKey()`, but stable across processes, and including the data-driven paint
+    // properties of all of the layers, which are baked into the paint property binders.
+    const style::Layer::Impl& leader = *group.front()->baseImpl;
+    writer.StartArray();
+    writer.String(leader.getTypeInfo()->type);
+    writer.String(leader.sourceLayer);
+    writer.Double(leader.minZoom);
+    writer.Double(leader.maxZoom);
+    writer.Uint(static_cast<uint32_t>(leader.visibility));
+    stringify(writer, leader.filter);
+    leader.stringifyLayout(writer);
+    for (const auto& layer : group) {
+        writer.String(layer->baseImpl->id);
+        layer->baseImpl->stringifyDataDrivenPaint(writer);
+    }
+    writer.EndArray();
+
+    return stableHash(s.GetString(), s.GetSize());
+}
+
+bool BucketCache::restore(uint64_t key,
+                          const std::vector<Immutable<style::LayerProperties>>& group,
+                          const BucketParameters& parameters,
+                          FeatureIndex& featureIndex,
+                          std::unordered_map<std::string, LayerRenderData>& renderData) {
+    const auto it = entries.find(key);
+    if (it == entries.end()) {
+        return false;
+    }
+
+    util::BinaryReader reader(data.data() + it->second.offset, it->second.size);
+    bool hasData;
+    if (!reader.read(hasData)) {
+        return false;
+    }
+
+    std::shared_ptr<Bucket> bucket;
+    if (hasData) {
+        bucket = LayerManager::get()->createBucket(parameters, group);
+        if (!bucket || !bucket->deserialize(reader)) {
+            return false;
+        }
+    }
+
+    // Read the features into an index of their own, so that malformed data leaves no trace.
+    const style::Layer::Impl& leader = *group.front()->baseImpl;
+    FeatureIndex bucketFeatureIndex(nullptr);
+    if (!bucketFeatureIndex.deserialize(reader, leader.sourceLayer, leader.id) || reader.remaining() != 0) {
+        return false;
+    }
+    featureIndex.append(bucketFeatureIndex);
+
+    if (bucket) {
+        for (const auto& layer : group) {
+            renderData.emplace(layer->baseImpl->id, LayerRenderData{bucket, layer});
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    restored.insert(key);
+    return true;
+}
+
+void BucketCache::store(uint64_t key,
+                        const Bucket* bucket,
+                        const std::string& bucketLeaderID,
+                        const FeatureIndex& featureIndex) {
+    util::BinaryWriter writer;
+    writer.write(bucket != nullptr);
+    if (bucket && !bucket->serialize(writer)) {
+        return;
+    }
+    featureIndex.serialize(writer, bucketLeaderID);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    stored.emplace_back(key, writer.takeData());
+}
+
+void BucketCache::save() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (stored.empty()) {
+        return;
+    }
+
+    util::BinaryWriter writer;
+    writer.write(kMagic);
+    writer.write(kVersion);
+    writer.write(tileKey);
+    writer.write(dataHash);
+    writer.write<uint64_t>(restored.size() + stored.size());
+    for (uint64_t key : restored) {
+        const Entry& entry = entries.at(key);
+        writer.write(key);
+        writer.write(data.substr(entry.offset, entry.size));
+    }
+    for (const auto& entry : stored) {
+        writer.write(entry.first);
+        writer.write(entry.second);
+    }
+    stored.clear();
+
+    if (writer.getData().size() > kMaxFileSize) {
+        return;
+    }
+
+    // Write to a file of our own first, so that readers never see a partially written file. The
+    // name is unique within the process, and random across the processes sharing the directory.
+    static const uint32_t processID = std::random_device()();
+    static std::atomic<uint64_t> nextTemporaryFile{0};
+    const std::string temporaryFilename =
+        filename + "." + util::toString(processID) + "-" + util::toString(uint64_t(nextTemporaryFile++)) + ".tmp";
+    try {
+        util::write_file(temporaryFilename, writer.getData());
+        if (std::rename(temporaryFilename.c_str(), filename.c_str()) != 0) {
+            util::deleteFile(temporaryFilename);
+        }
+    } catch (const std::exception& e) {
+        Log::Warning(Event::General, "Failed to write bucket cache file %s: %s", filename.c_str(), e.what());
+    }
+}
+
+} // namespace mbgl
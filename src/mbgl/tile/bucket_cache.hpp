@@ -0,0 +1,83 @@
+#pragma once
+
+#include <mbgl/map/mode.hpp>
+#include <mbgl/tile/tile_id.hpp>
+#include <mbgl/util/immutable.hpp>
+#include <mbgl/style/layer_properties.hpp>
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace mbgl {
+
+class Bucket;
+class BucketParameters;
+class FeatureIndex;
+class LayerRenderData;
+
+// Stores the buckets of the layer groups of a tile on disk once they are laid out, so that the
+// tile can be restored without decoding and tessellating its features again, e.g. after the
+// application restarts. A tile is restored only if it has the same encoded data, and a group
+// only if its layers have the same properties affecting its bucket.
+//
+// Tiles are stored in a fixed number of files in the cache directory, picked by a hash of the
+// tile, and files larger than a fixed size aren't written. This bounds the size of the directory
+// to 1 GiB. A tile whose file holds another tile replaces it. Files are replaced atomically, so
+// that several map instances may share the directory.
+class BucketCache {
+public:
+    // Loads the cached groups of the tile, if any.
+    BucketCache(const std::string& path,
+                const OverscaledTileID&,
+                const std::string& sourceID,
+                MapMode,
+                float pixelRatio,
+                const std::string& encodedData);
+
+    // Returns the key of the bucket of the given group of layers. Keys are stable across processes.
+    static uint64_t groupKey(const std::vector<Immutable<style::LayerProperties>>&);
+
+    // Restores the bucket of the group with the given key, if it is cached. The features of the
+    // bucket are added to `featureIndex`, and the bucket to `renderData` if it has data.
+    bool restore(uint64_t key,
+                 const std::vector<Immutable<style::LayerProperties>>&,
+                 const BucketParameters&,
+                 FeatureIndex& featureIndex,
+                 std::unordered_map<std::string, LayerRenderData>& renderData);
+
+    // Adds the bucket of the group with the given key once it is laid out, along with the features
+    // inserted into `featureIndex` for it. `bucket` is null if the group has no data in the tile.
+    // Buckets that cannot be serialized are ignored.
+    void store(uint64_t key,
+               const Bucket* bucket,
+               const std::string& bucketLeaderID,
+               const FeatureIndex& featureIndex);
+
+    // Writes the file of the tile if any group was stored since it was loaded. Groups that were
+    // neither restored nor stored are dropped, as they are no longer part of the style.
+    void save();
+
+private:
+    struct Entry {
+        std::size_t offset;
+        std::size_t size;
+    };
+
+    const uint64_t tileKey;
+    const std::string filename;
+    const uint64_t dataHash;
+
+    // The contents of the loaded file, and the groups it contains.
+    std::string data;
+    std::unordered_map<uint64_t, Entry> entries;
+
+    std::mutex mutex;
+    std::unordered_set<uint64_t> restored;
+    std::vector<std::pair<uint64_t, std::string>> stored;
+};
+
+} // namespace mbgl
@@ -15,13 +15,21 @@ GeoJSONTile::GeoJSONTile(const OverscaledTileID& overscaledTileID,
 
 void GeoJSONTile::updateData(std::shared_ptr<style::GeoJSONData> data_, bool needsRelayout) {
     assert(data_);
+    if (data && !pendingData && !needsRelayout && !data_->tileChanged(*data, id.canonical)) {
+        // The features of this tile are the same in the new data.
+        data = std::move(data_);
+        return;
+    }
+
     data = std::move(data_);
+    pendingData = data.get();
     if (needsRelayout) reset();
     data->getTile(
         id.canonical,
         [this, self = weakFactory.makeWeakPtr(), capturedData = data.get()](style::GeoJSONData::TileFeatures features) {
             if (!self) return;
-            if (data.get() != capturedData) return;
+            if (pendingData != capturedData) return;
+            pendingData = nullptr;
             auto tileData = std::make_unique<GeoJSONTileData>(std::move(features));
             setData(std::move(tileData));
         });
@@ -25,6 +25,8 @@ public:
 
 private:
     std::shared_ptr<style::GeoJSONData> data;
+    // The data whose features the tile is waiting for, if any.
+    const style::GeoJSONData* pendingData = nullptr;
     mapbox::base::WeakPtrFactory<GeoJSONTile> weakFactory{this};
 };
 
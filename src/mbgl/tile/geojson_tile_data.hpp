@@ -46,6 +46,11 @@ public:
         return optional<Value>();
     }
 
+    const Value* findValue(const std::string& key) const override {
+        auto it = feature.properties.find(key);
+        return it != feature.properties.end() ? &it->second : nullptr;
+    }
+
     mutable optional<GeometryCollection> geometry;
 };
 
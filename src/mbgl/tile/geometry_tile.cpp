@@ -23,6 +23,8 @@
 
 #include <mbgl/gfx/upload_pass.hpp>
 
+#include <unordered_set>
+
 namespace mbgl {
 
 LayerRenderData* GeometryTile::LayoutResult::getLayerRenderData(const style::Layer::Impl& layerImpl) {
@@ -40,11 +42,8 @@ LayerRenderData* GeometryTile::LayoutResult::getLayerRenderData(const style::Lay
 
 class GeometryTileRenderData final : public TileRenderData {
 public:
-    GeometryTileRenderData(
-        std::shared_ptr<GeometryTile::LayoutResult> layoutResult_,
-        std::shared_ptr<TileAtlasTextures> atlasTextures_)
-        : TileRenderData(std::move(atlasTextures_))
-        , layoutResult(std::move(layoutResult_)) {
+    GeometryTileRenderData(std::shared_ptr<GeometryTile::LayoutResult> layoutResult_)
+        : layoutResult(std::move(layoutResult_)) {
     }
 
 private:
@@ -53,19 +52,17 @@ private:
     const LayerRenderData* getLayerRenderData(const style::Layer::Impl&) const override;
     Bucket* getBucket(const style::Layer::Impl&) const override;
     void upload(gfx::UploadPass&) override;
-    void prepare(const SourcePrepareParameters&) override;
 
     std::shared_ptr<GeometryTile::LayoutResult> layoutResult;
-    std::vector<ImagePatch> imagePatches;
 };
 
 using namespace style;
 
 optional<ImagePosition> GeometryTileRenderData::getPattern(const std::string& pattern) const {
-    if (layoutResult) {
-        const auto& iconAtlas = layoutResult->iconAtlas;
-        auto it = iconAtlas.patternPositions.find(pattern);
-        if (it != iconAtlas.patternPositions.end()) {
+    if (layoutResult && layoutResult->imageAtlasReference) {
+        const auto& patternPositions = layoutResult->imageAtlasReference->patternPositions;
+        auto it = patternPositions.find(pattern);
+        if (it != patternPositions.end()) {
             return it->second;
         }
     }
@@ -84,30 +81,6 @@ void GeometryTileRenderData::upload(gfx::UploadPass& uploadPass) {
     for (auto& entry : layoutResult->layerRenderData) {
         uploadFn(*entry.second.bucket);
     }
-
-    assert(atlasTextures);
-
-    if (layoutResult->glyphAtlasImage) {
-        atlasTextures->glyph = uploadPass.createTexture(*layoutResult->glyphAtlasImage);
-        layoutResult->glyphAtlasImage = {};
-    }
-
-    if (layoutResult->iconAtlas.image.valid()) {
-        atlasTextures->icon = uploadPass.createTexture(layoutResult->iconAtlas.image);
-        layoutResult->iconAtlas.image = {};
-    }
-
-    if (atlasTextures->icon && !imagePatches.empty()) {
-        for (const auto& imagePatch : imagePatches) { // patch updated images.
-            uploadPass.updateTextureSub(*atlasTextures->icon, imagePatch.image->image, imagePatch.textureRect.x, imagePatch.textureRect.y);
-        }
-        imagePatches.clear();
-    }
-}
-
-void GeometryTileRenderData::prepare(const SourcePrepareParameters& parameters) {
-    if (!layoutResult) return;
-    imagePatches = layoutResult->iconAtlas.getImagePatchesAndUpdateVersions(parameters.imageManager);
 }
 
 Bucket* GeometryTileRenderData::getBucket(const Layer::Impl& layer) const {
@@ -150,7 +123,12 @@ GeometryTile::GeometryTile(const OverscaledTileID& id_,
              obsolete,
              parameters.mode,
              parameters.pixelRatio,
-             parameters.debugOptions & MapDebugOptions::Collision),
+             parameters.debugOptions & MapDebugOptions::Collision,
+             parameters.parallelTileLayout,
+             parameters.bucketCachePath,
+             parameters.glyphManager.getAtlas(),
+             parameters.imageManager.getAtlas(),
+             parameters.glyphManager.getShapingCache()),
       fileSource(parameters.fileSource),
       glyphManager(parameters.glyphManager),
       imageManager(parameters.imageManager),
@@ -195,8 +173,12 @@ void GeometryTile::reset() {
     worker.self().invoke(&GeometryTileWorker::reset, correlationID);
 }
 
+void GeometryTile::setNecessity(TileNecessity necessity) {
+    worker.setPriority(necessity == TileNecessity::Required ? TaskPriority::High : TaskPriority::Low);
+}
+
 std::unique_ptr<TileRenderData> GeometryTile::createRenderData() {
-    return std::make_unique<GeometryTileRenderData>(layoutResult, atlasTextures);
+    return std::make_unique<GeometryTileRenderData>(layoutResult);
 }
 
 void GeometryTile::setLayers(const std::vector<Immutable<LayerProperties>>& layers) {
@@ -242,10 +224,6 @@ void GeometryTile::onLayout(std::shared_ptr<LayoutResult> result, const uint64_t
     }
 
     layoutResult = std::move(result);
-    if (!atlasTextures) {
-    	atlasTextures = std::make_shared<TileAtlasTextures>();
-    }
-    
     observer->onTileChanged(*this);
 }
 
@@ -265,8 +243,8 @@ void GeometryTile::getGlyphs(GlyphDependencies glyphDependencies) {
     glyphManager.getGlyphs(*this, std::move(glyphDependencies), *fileSource);
 }
 
-void GeometryTile::onImagesAvailable(ImageMap images, ImageMap patterns, ImageVersionMap versionMap, uint64_t imageCorrelationID) {
-    worker.self().invoke(&GeometryTileWorker::onImagesAvailable, std::move(images), std::move(patterns), std::move(versionMap), imageCorrelationID);
+void GeometryTile::onImagesAvailable(ImageMap images, ImageMap patterns, uint64_t imageCorrelationID) {
+    worker.self().invoke(&GeometryTileWorker::onImagesAvailable, std::move(images), std::move(patterns), imageCorrelationID);
 }
 
 void GeometryTile::getImages(ImageRequestPair pair) {
@@ -277,6 +255,25 @@ const std::shared_ptr<FeatureIndex> GeometryTile::getFeatureIndex() const {
     return layoutResult ? layoutResult->featureIndex : nullptr;
 }
 
+std::size_t GeometryTile::getMemoryUsage() const {
+    std::size_t bytes = 0;
+    if (layoutResult) {
+        // Buckets are shared by all layers of a layout group.
+        std::unordered_set<const Bucket*> buckets;
+        for (const auto& pair : layoutResult->layerRenderData) {
+            const Bucket* bucket = pair.second.bucket.get();
+            if (bucket && buckets.insert(bucket).second) {
+                bytes += bucket->getMemoryUsage();
+            }
+        }
+        if (layoutResult->featureIndex) {
+            bytes += layoutResult->featureIndex->getMemoryUsage();
+        }
+    }
+    // Glyphs, icons and patterns are in the atlases shared by all tiles.
+    return bytes;
+}
+
 bool GeometryTile::layerPropertiesUpdated(const Immutable<style::LayerProperties>& layerProperties) {
     LayerRenderData* renderData = getLayerRenderData(*layerProperties->baseImpl);
     if (!renderData) {
@@ -412,7 +409,7 @@ void GeometryTile::setFeatureState(const LayerFeatureStates& states) {
 
             auto bucket = layer.second.bucket;
             if (bucket && bucket->hasData()) {
-                bucket->update(featureStates, *sourceLayer, layerID, layoutResult->iconAtlas.patternPositions);
+                bucket->update(featureStates, *sourceLayer, layerID, layoutResult->imageAtlasReference->patternPositions);
             }
         }
     }
@@ -3,7 +3,9 @@
 #include <mbgl/actor/actor.hpp>
 #include <mbgl/geometry/feature_index.hpp>
 #include <mbgl/gfx/texture.hpp>
+#include <mbgl/renderer/image_atlas.hpp>
 #include <mbgl/renderer/image_manager.hpp>
+#include <mbgl/text/glyph_atlas.hpp>
 #include <mbgl/text/glyph_manager.hpp>
 #include <mbgl/tile/tile.hpp>
 #include <mbgl/tile/geometry_tile_worker.hpp>
@@ -21,9 +23,6 @@ class GeometryTileData;
 class RenderLayer;
 class SourceQueryOptions;
 class TileParameters;
-class GlyphAtlas;
-class ImageAtlas;
-class TileAtlasTextures;
 
 class GeometryTile : public Tile, public GlyphRequestor, public ImageRequestor {
 public:
@@ -39,12 +38,15 @@ public:
     // data and layers to come.
     void reset();
 
+    // Visible tiles are parsed ahead of tiles that are only kept or prefetched.
+    void setNecessity(TileNecessity) override;
+
     std::unique_ptr<TileRenderData> createRenderData() override;
     void setLayers(const std::vector<Immutable<style::LayerProperties>>&) override;
     void setShowCollisionBoxes(const bool showCollisionBoxes) override;
 
     void onGlyphsAvailable(GlyphMap) override;
-    void onImagesAvailable(ImageMap, ImageMap, ImageVersionMap versionMap, uint64_t imageCorrelationID) override;
+    void onImagesAvailable(ImageMap, ImageMap, uint64_t imageCorrelationID) override;
     
     void getGlyphs(GlyphDependencies);
     void getImages(ImageRequestPair);
@@ -69,19 +71,19 @@ public:
     public:
         std::unordered_map<std::string, LayerRenderData> layerRenderData;
         std::shared_ptr<FeatureIndex> featureIndex;
-        optional<AlphaImage> glyphAtlasImage;
-        ImageAtlas iconAtlas;
+        std::unique_ptr<GlyphAtlasReference> glyphAtlasReference;
+        std::unique_ptr<ImageAtlasReference> imageAtlasReference;
 
         LayerRenderData* getLayerRenderData(const style::Layer::Impl&);
 
         LayoutResult(std::unordered_map<std::string, LayerRenderData> renderData_,
                      std::unique_ptr<FeatureIndex> featureIndex_,
-                     optional<AlphaImage> glyphAtlasImage_,
-                     ImageAtlas iconAtlas_)
+                     std::unique_ptr<GlyphAtlasReference> glyphAtlasReference_,
+                     std::unique_ptr<ImageAtlasReference> imageAtlasReference_)
             : layerRenderData(std::move(renderData_)),
               featureIndex(std::move(featureIndex_)),
-              glyphAtlasImage(std::move(glyphAtlasImage_)),
-              iconAtlas(std::move(iconAtlas_)) {}
+              glyphAtlasReference(std::move(glyphAtlasReference_)),
+              imageAtlasReference(std::move(imageAtlasReference_)) {}
     };
     void onLayout(std::shared_ptr<LayoutResult>, uint64_t correlationID);
 
@@ -92,6 +94,7 @@ public:
     void markRenderedPreviously() override;
     void performedFadePlacement() override;
     const std::shared_ptr<FeatureIndex> getFeatureIndex() const;
+    std::size_t getMemoryUsage() const override;
     
     const std::string sourceID;
 
@@ -117,7 +120,6 @@ private:
     uint64_t correlationID = 0;
 
     std::shared_ptr<LayoutResult> layoutResult;
-    std::shared_ptr<TileAtlasTextures> atlasTextures;
 
     const MapMode mode;
     
@@ -185,6 +185,12 @@ const PropertyMap& GeometryTileFeature::getProperties() const {
     return dummy;
 }
 
+const Value* GeometryTileFeature::findValue(const std::string& key) const {
+    const PropertyMap& properties = getProperties();
+    auto it = properties.find(key);
+    return it != properties.end() ? &it->second : nullptr;
+}
+
 const GeometryCollection& GeometryTileFeature::getGeometries() const {
     static const GeometryCollection dummy;
     return dummy;
@@ -48,6 +48,12 @@ public:
     virtual FeatureType getType() const = 0;
     virtual optional<Value> getValue(const std::string& key) const = 0;
     virtual const PropertyMap& getProperties() const;
+
+    // Returns a pointer to the value of the given property, or nullptr if the feature doesn't have
+    // it. Unlike getValue(), the value isn't copied; the pointer stays valid as long as the feature.
+    // The default implementation looks the key up in getProperties().
+    virtual const Value* findValue(const std::string& key) const;
+
     virtual FeatureIdentifier getID() const { return NullValue {}; }
     virtual const GeometryCollection& getGeometries() const;
 };
@@ -72,6 +78,12 @@ public:
     // Returns the layer with the given name. The returned layer object *may* outlive the data
     // object.
     virtual std::unique_ptr<GeometryTileLayer> getLayer(const std::string&) const = 0;
+
+    // Approximate number of bytes held by the data, not including decoded layers and features.
+    virtual std::size_t getMemoryUsage() const { return 0; }
+
+    // Returns the encoded data the tile was decoded from, if any. Used to key the bucket cache.
+    virtual const std::string* getEncodedData() const { return nullptr; }
 };
 
 // classifies an array of rings into polygons with outer rings and holes
@@ -0,0 +1,86 @@
+#include <mbgl/tile/geometry_tile_feature_cache.hpp>
+
+#include <cassert>
+
+namespace mbgl {
+
+class GeometryTileFeatureCache::Entry {
+public:
+    explicit Entry(std::unique_ptr<GeometryTileLayer> layer_)
+        : layer(std::move(layer_)), features(layer->featureCount()) {}
+
+    std::size_t featureCount() const { return features.size(); }
+
+    const std::shared_ptr<const GeometryTileFeature>& getFeature(std::size_t i) {
+        assert(i < features.size());
+        auto& feature = features[i];
+        if (!feature) {
+            feature = layer->getFeature(i);
+        }
+        return feature;
+    }
+
+    std::string getName() const { return layer->getName(); }
+
+private:
+    const std::unique_ptr<GeometryTileLayer> layer;
+    std::vector<std::shared_ptr<const GeometryTileFeature>> features;
+};
+
+namespace {
+
+// Forwards to a feature that is shared by all layers of one cache entry. The shared
+// feature memoizes its decoded geometries and properties.
+class CachedGeometryTileFeature : public GeometryTileFeature {
+public:
+    explicit CachedGeometryTileFeature(std::shared_ptr<const GeometryTileFeature> feature_)
+        : feature(std::move(feature_)) {}
+
+    FeatureType getType() const override { return feature->getType(); }
+    optional<Value> getValue(const std::string& key) const override { return feature->getValue(key); }
+    const PropertyMap& getProperties() const override { return feature->getProperties(); }
+    const Value* findValue(const std::string& key) const override { return feature->findValue(key); }
+    FeatureIdentifier getID() const override { return feature->getID(); }
+    const GeometryCollection& getGeometries() const override { return feature->getGeometries(); }
+
+private:
+    const std::shared_ptr<const GeometryTileFeature> feature;
+};
+
+class CachedGeometryTileLayer : public GeometryTileLayer {
+public:
+    explicit CachedGeometryTileLayer(std::shared_ptr<GeometryTileFeatureCache::Entry> entry_)
+        : entry(std::move(entry_)) {}
+
+    std::size_t featureCount() const override { return entry->featureCount(); }
+
+    std::unique_ptr<GeometryTileFeature> getFeature(std::size_t i) const override {
+        return std::make_unique<CachedGeometryTileFeature>(entry->getFeature(i));
+    }
+
+    std::string getName() const override { return entry->getName(); }
+
+private:
+    const std::shared_ptr<GeometryTileFeatureCache::Entry> entry;
+};
+
+} // namespace
+
+GeometryTileFeatureCache::GeometryTileFeatureCache(const GeometryTileData& data_) : data(data_) {}
+
+GeometryTileFeatureCache::~GeometryTileFeatureCache() = default;
+
+std::unique_ptr<GeometryTileLayer> GeometryTileFeatureCache::getLayer(const std::string& sourceLayer) {
+    auto it = entries.find(sourceLayer);
+    if (it == entries.end()) {
+        auto layer = data.getLayer(sourceLayer);
+        it = entries.emplace(sourceLayer, layer ? std::make_shared<Entry>(std::move(layer)) : nullptr).first;
+    }
+
+    if (!it->second) {
+        return nullptr;
+    }
+    return std::make_unique<CachedGeometryTileLayer>(it->second);
+}
+
+} // namespace mbgl
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <mbgl/tile/geometry_tile_data.hpp>
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mbgl {
+
+/*
+    Decodes each feature of a tile at most once while the tile is parsed.
+
+    Several layout groups often read the same source layer (e.g. a "road" source
+    layer used by a dozen line layers). The layers returned by `getLayer()` share
+    their features with every other layer returned for the same source layer name, so
+    geometries and properties are decoded by the first group that touches them and
+    reused by all later ones.
+
+    Features are decoded lazily, so the cache and the layers and features it hands
+    out must not be used from several threads at once.
+*/
+class GeometryTileFeatureCache {
+public:
+    explicit GeometryTileFeatureCache(const GeometryTileData&);
+    ~GeometryTileFeatureCache();
+
+    // Returns a view of the given source layer, or nullptr if the tile has no such layer.
+    std::unique_ptr<GeometryTileLayer> getLayer(const std::string& sourceLayer);
+
+    class Entry;
+
+private:
+    const GeometryTileData& data;
+    std::unordered_map<std::string, std::shared_ptr<Entry>> entries;
+};
+
+} // namespace mbgl
@@ -1,5 +1,7 @@
 #include <mbgl/tile/geometry_tile_worker.hpp>
+#include <mbgl/tile/bucket_cache.hpp>
 #include <mbgl/tile/geometry_tile_data.hpp>
+#include <mbgl/tile/geometry_tile_feature_cache.hpp>
 #include <mbgl/tile/geometry_tile.hpp>
 #include <mbgl/layermanager/layer_manager.hpp>
 #include <mbgl/layout/layout.hpp>
@@ -7,6 +9,7 @@
 #include <mbgl/layout/pattern_layout.hpp>
 #include <mbgl/renderer/bucket_parameters.hpp>
 #include <mbgl/renderer/group_by_layout.hpp>
+#include <mbgl/renderer/image_atlas.hpp>
 #include <mbgl/style/filter.hpp>
 #include <mbgl/style/layers/symbol_layer_impl.hpp>
 #include <mbgl/renderer/layers/render_fill_layer.hpp>
@@ -14,11 +17,14 @@
 #include <mbgl/renderer/layers/render_line_layer.hpp>
 #include <mbgl/renderer/layers/render_symbol_layer.hpp>
 #include <mbgl/renderer/buckets/symbol_bucket.hpp>
+#include <mbgl/text/glyph_atlas.hpp>
 #include <mbgl/util/logging.hpp>
 #include <mbgl/util/constants.hpp>
 #include <mbgl/util/string.hpp>
 #include <mbgl/util/exception.hpp>
 #include <mbgl/util/stopwatch.hpp>
+#include <mbgl/util/parallel_for.hpp>
+#include <mbgl/actor/scheduler.hpp>
 
 #include <unordered_set>
 #include <utility>
@@ -34,7 +40,12 @@ GeometryTileWorker::GeometryTileWorker(ActorRef<GeometryTileWorker> self_,
                                        const std::atomic<bool>& obsolete_,
                                        const MapMode mode_,
                                        const float pixelRatio_,
-                                       const bool showCollisionBoxes_)
+                                       const bool showCollisionBoxes_,
+                                       const bool parallelLayout_,
+                                       std::string bucketCachePath_,
+                                       std::shared_ptr<GlyphAtlas> glyphAtlas_,
+                                       std::shared_ptr<ImageAtlas> imageAtlas_,
+                                       std::shared_ptr<ShapingCache> shapingCache_)
     : self(std::move(self_)),
       parent(std::move(parent_)),
       id(id_),
@@ -42,6 +53,11 @@ GeometryTileWorker::GeometryTileWorker(ActorRef<GeometryTileWorker> self_,
       obsolete(obsolete_),
       mode(mode_),
       pixelRatio(pixelRatio_),
+      parallelLayout(parallelLayout_),
+      bucketCachePath(std::move(bucketCachePath_)),
+      glyphAtlas(std::move(glyphAtlas_)),
+      imageAtlas(std::move(imageAtlas_)),
+      shapingCache(std::move(shapingCache_)),
       showCollisionBoxes(showCollisionBoxes_) {}
 
 GeometryTileWorker::~GeometryTileWorker() = default;
@@ -300,13 +316,12 @@ void GeometryTileWorker::onGlyphsAvailable(GlyphMap newGlyphMap) {
     symbolDependenciesChanged();
 }
 
-void GeometryTileWorker::onImagesAvailable(ImageMap newIconMap, ImageMap newPatternMap, ImageVersionMap newVersionMap, uint64_t imageCorrelationID_) {
+void GeometryTileWorker::onImagesAvailable(ImageMap newIconMap, ImageMap newPatternMap, uint64_t imageCorrelationID_) {
     if (imageCorrelationID != imageCorrelationID_) {
         return; // Ignore outdated image request replies.
     }
     imageMap = std::move(newIconMap);
     patternMap = std::move(newPatternMap);
-    versionMap = std::move(newVersionMap);
     pendingImageDependencies.clear();
     symbolDependenciesChanged();
 }
@@ -340,8 +355,6 @@ void GeometryTileWorker::parse() {
 
     MBGL_TIMING_START(watch)
 
-    std::unordered_map<std::string, std::unique_ptr<SymbolLayout>> symbolLayoutMap;
-
     renderData.clear();
     layouts.clear();
 
@@ -356,69 +369,104 @@ void GeometryTileWorker::parse() {
         groupMap[layoutKey(*layer->baseImpl)].push_back(std::move(layer));
     }
 
-    for (auto& pair : groupMap) {
-        const auto& group = pair.second;
-        if (obsolete) {
-            return;
-        }
-
-        if (!*data) {
-            continue; // Tile has no data.
+    // Groups that share a source layer share its decoded features. All source layers are
+    // obtained up front, as the tile data must not be accessed concurrently.
+    std::vector<const std::vector<Immutable<style::LayerProperties>>*> groups;
+    std::vector<std::unique_ptr<GeometryTileLayer>> geometryLayers;
+    if (*data) { // Otherwise, the tile has no data.
+        GeometryTileFeatureCache featureCache(**data);
+        for (const auto& pair : groupMap) {
+            const style::Layer::Impl& leaderImpl = *(pair.second.at(0)->baseImpl);
+            if (auto geometryLayer = featureCache.getLayer(leaderImpl.sourceLayer)) {
+                groups.push_back(&pair.second);
+                geometryLayers.push_back(std::move(geometryLayer));
+            }
         }
+    }
 
-        const style::Layer::Impl& leaderImpl = *(group.at(0)->baseImpl);
-        BucketParameters parameters { id, mode, pixelRatio, leaderImpl.getTypeInfo() };
+    // Groups that were laid out before with the same tile data and properties are restored
+    // from the bucket cache, and the others are stored in it.
+    std::unique_ptr<BucketCache> bucketCache;
+    const std::string* encodedData = *data ? (*data)->getEncodedData() : nullptr;
+    if (!bucketCachePath.empty() && encodedData && !groups.empty()) {
+        bucketCache = std::make_unique<BucketCache>(bucketCachePath, id, sourceID, mode, pixelRatio, *encodedData);
+    }
 
-        auto geometryLayer = (*data)->getLayer(leaderImpl.sourceLayer);
-        if (!geometryLayer) {
-            continue;
+    if (parallelLayout && groups.size() > 1) {
+        // Groups reading the same source layer share features, so they are laid out
+        // sequentially by the same task. Each group writes to its own results, which are
+        // merged in group order so that the outcome is identical to the sequential layout.
+        std::unordered_map<std::string, std::vector<std::size_t>> batchMap;
+        std::vector<std::vector<std::size_t>*> batches;
+        for (std::size_t i = 0; i < groups.size(); ++i) {
+            auto& batch = batchMap[geometryLayers[i]->getName()];
+            if (batch.empty()) {
+                batches.push_back(&batch);
+            }
+            batch.push_back(i);
         }
 
-        std::vector<std::string> layerIDs(group.size());
-        for (const auto& layer : group) {
-            layerIDs.push_back(layer->baseImpl->id);
-        }
+        struct GroupResult {
+            std::unique_ptr<FeatureIndex> featureIndex = std::make_unique<FeatureIndex>(nullptr);
+            std::unordered_map<std::string, LayerRenderData> renderData;
+            std::vector<std::unique_ptr<Layout>> layouts;
+            GlyphDependencies glyphDependencies;
+            ImageDependencies imageDependencies;
+        };
+        std::vector<GroupResult> results(groups.size());
+
+        std::shared_ptr<Scheduler> scheduler = Scheduler::GetBackground();
+        util::parallelFor(*scheduler, batches.size(), [&](std::size_t batchIndex) {
+            for (std::size_t i : *batches[batchIndex]) {
+                if (obsolete) {
+                    return;
+                }
+                auto& result = results[i];
+                parseGroup(*groups[i], std::move(geometryLayers[i]), result.featureIndex, result.renderData,
+                           result.layouts, result.glyphDependencies, result.imageDependencies, bucketCache.get());
+            }
+        });
 
-        featureIndex->setBucketLayerIDs(leaderImpl.id, layerIDs);
+        if (obsolete) {
+            return;
+        }
 
-        // Symbol layers and layers that support pattern properties have an extra step at layout time to figure out what images/glyphs
-        // are needed to render the layer. They use the intermediate Layout data structure to accomplish this,
-        // and either immediately create a bucket if no images/glyphs are used, or the Layout is stored until
-        // the images/glyphs are available to add the features to the buckets.
-        if (leaderImpl.getTypeInfo()->layout == LayerTypeInfo::Layout::Required) {
-            std::unique_ptr<Layout> layout = LayerManager::get()->createLayout(
-                {parameters, glyphDependencies, imageDependencies, availableImages}, std::move(geometryLayer), group);
-            if (layout->hasDependencies()) {
+        for (auto& result : results) {
+            featureIndex->append(*result.featureIndex);
+            for (auto& entry : result.renderData) {
+                renderData.emplace(entry.first, std::move(entry.second));
+            }
+            for (auto& layout : result.layouts) {
                 layouts.push_back(std::move(layout));
-            } else {
-                layout->createBucket({}, featureIndex, renderData, firstLoad, showCollisionBoxes);
             }
-        } else {
-            const Filter& filter = leaderImpl.filter;
-            const std::string& sourceLayerID = leaderImpl.sourceLayer;
-            std::shared_ptr<Bucket> bucket = LayerManager::get()->createBucket(parameters, group);
-
-            for (std::size_t i = 0; !obsolete && i < geometryLayer->featureCount(); i++) {
-                std::unique_ptr<GeometryTileFeature> feature = geometryLayer->getFeature(i);
-
-                if (!filter(expression::EvaluationContext { static_cast<float>(this->id.overscaledZ), feature.get() }))
-                    continue;
-
-                const GeometryCollection& geometries = feature->getGeometries();
-                bucket->addFeature(*feature, geometries, {}, PatternLayerMap(), i);
-                featureIndex->insert(geometries, i, sourceLayerID, leaderImpl.id);
+            for (auto& entry : result.glyphDependencies) {
+                glyphDependencies[entry.first].insert(entry.second.begin(), entry.second.end());
             }
-
-            if (!bucket->hasData()) {
-                continue;
+            imageDependencies.insert(result.imageDependencies.begin(), result.imageDependencies.end());
+        }
+    } else {
+        for (std::size_t i = 0; i < groups.size(); ++i) {
+            if (obsolete) {
+                return;
             }
-
-            for (const auto& layer : group) {
-                renderData.emplace(layer->baseImpl->id, LayerRenderData{bucket, layer});
+            if (bucketCache) {
+                // Index the features of each group on their own, so that the ones of the group
+                // are readily available to be stored along with its bucket.
+                auto groupFeatureIndex = std::make_unique<FeatureIndex>(nullptr);
+                parseGroup(*groups[i], std::move(geometryLayers[i]), groupFeatureIndex, renderData, layouts,
+                           glyphDependencies, imageDependencies, bucketCache.get());
+                featureIndex->append(*groupFeatureIndex);
+            } else {
+                parseGroup(*groups[i], std::move(geometryLayers[i]), featureIndex, renderData, layouts,
+                           glyphDependencies, imageDependencies, nullptr);
             }
         }
     }
 
+    if (bucketCache) {
+        bucketCache->save();
+    }
+
     requestNewGlyphs(glyphDependencies);
     requestNewImages(imageDependencies);
 
@@ -430,6 +478,91 @@ void GeometryTileWorker::parse() {
     finalizeLayout();
 }
 
+void GeometryTileWorker::parseGroup(const std::vector<Immutable<style::LayerProperties>>& group,
+                                    std::unique_ptr<GeometryTileLayer> geometryLayer,
+                                    std::unique_ptr<FeatureIndex>& groupFeatureIndex,
+                                    std::unordered_map<std::string, LayerRenderData>& groupRenderData,
+                                    std::vector<std::unique_ptr<Layout>>& groupLayouts,
+                                    GlyphDependencies& glyphDependencies,
+                                    ImageDependencies& imageDependencies,
+                                    BucketCache* bucketCache) {
+    const style::Layer::Impl& leaderImpl = *(group.at(0)->baseImpl);
+    BucketParameters parameters { id, mode, pixelRatio, leaderImpl.getTypeInfo() };
+
+    std::vector<std::string> layerIDs(group.size());
+    for (const auto& layer : group) {
+        layerIDs.push_back(layer->baseImpl->id);
+    }
+
+    groupFeatureIndex->setBucketLayerIDs(leaderImpl.id, layerIDs);
+
+    const uint64_t cacheKey = bucketCache ? BucketCache::groupKey(group) : 0;
+    if (bucketCache && bucketCache->restore(cacheKey, group, parameters, *groupFeatureIndex, groupRenderData)) {
+        return;
+    }
+
+    // Symbol layers and layers that support pattern properties have an extra step at layout time to figure out what images/glyphs
+    // are needed to render the layer. They use the intermediate Layout data structure to accomplish this,
+    // and either immediately create a bucket if no images/glyphs are used, or the Layout is stored until
+    // the images/glyphs are available to add the features to the buckets.
+    if (leaderImpl.getTypeInfo()->layout == LayerTypeInfo::Layout::Required) {
+        std::unique_ptr<Layout> layout = LayerManager::get()->createLayout(
+            {parameters, glyphDependencies, imageDependencies, availableImages, shapingCache}, std::move(geometryLayer), group);
+        if (layout->hasDependencies()) {
+            groupLayouts.push_back(std::move(layout));
+        } else {
+            layout->createBucket({}, groupFeatureIndex, groupRenderData, firstLoad, showCollisionBoxes);
+            if (bucketCache) {
+                const auto it = groupRenderData.find(leaderImpl.id);
+                const Bucket* bucket = it != groupRenderData.end() ? it->second.bucket.get() : nullptr;
+                bucketCache->store(cacheKey, bucket, leaderImpl.id, *groupFeatureIndex);
+            }
+        }
+    } else {
+        const Filter& filter = leaderImpl.filter;
+        const std::string& sourceLayerID = leaderImpl.sourceLayer;
+        std::shared_ptr<Bucket> bucket = LayerManager::get()->createBucket(parameters, group);
+
+        std::vector<std::unique_ptr<GeometryTileFeature>> features;
+        std::vector<const GeometryTileFeature*> featurePointers;
+        std::vector<std::size_t> featureIndices;
+        for (std::size_t i = 0; !obsolete && i < geometryLayer->featureCount(); i++) {
+            std::unique_ptr<GeometryTileFeature> feature = geometryLayer->getFeature(i);
+
+            if (!filter(expression::EvaluationContext { static_cast<float>(this->id.overscaledZ), feature.get() }))
+                continue;
+
+            featurePointers.push_back(feature.get());
+            featureIndices.push_back(i);
+            features.push_back(std::move(feature));
+        }
+
+        bucket->evaluateFeatures(featurePointers, featureIndices);
+
+        for (std::size_t j = 0; !obsolete && j < features.size(); j++) {
+            // Release each feature once it is added, so that only one feature holds decoded geometries.
+            const std::unique_ptr<GeometryTileFeature> feature = std::move(features[j]);
+            const std::size_t i = featureIndices[j];
+
+            const GeometryCollection& geometries = feature->getGeometries();
+            bucket->addFeature(*feature, geometries, {}, PatternLayerMap(), i);
+            groupFeatureIndex->insert(geometries, i, sourceLayerID, leaderImpl.id);
+        }
+
+        if (bucketCache && !obsolete) {
+            bucketCache->store(cacheKey, bucket->hasData() ? bucket.get() : nullptr, leaderImpl.id, *groupFeatureIndex);
+        }
+
+        if (!bucket->hasData()) {
+            return;
+        }
+
+        for (const auto& layer : group) {
+            groupRenderData.emplace(layer->baseImpl->id, LayerRenderData{bucket, layer});
+        }
+    }
+}
+
 bool GeometryTileWorker::hasPendingDependencies() const {
     for (auto& glyphDependency : pendingGlyphDependencies) {
         if (!glyphDependency.second.empty()) {
@@ -449,25 +582,24 @@ void GeometryTileWorker::finalizeLayout() {
     }
     
     MBGL_TIMING_START(watch)
-    optional<AlphaImage> glyphAtlasImage;
-    ImageAtlas iconAtlas = makeImageAtlas(imageMap, patternMap, versionMap);
+    std::unique_ptr<GlyphAtlasReference> glyphAtlasReference;
+    std::unique_ptr<ImageAtlasReference> imageAtlasReference = imageAtlas->addImages(imageMap, patternMap);
     if (!layouts.empty()) {
-        GlyphAtlas glyphAtlas = makeGlyphAtlas(glyphMap);
-        glyphAtlasImage = std::move(glyphAtlas.image);
+        glyphAtlasReference = glyphAtlas->addGlyphs(glyphMap);
 
         for (auto& layout : layouts) {
             if (obsolete) {
                 return;
             }
 
-            layout->prepareSymbols(glyphMap, glyphAtlas.positions, imageMap, iconAtlas.iconPositions);
+            layout->prepareSymbols(glyphMap, glyphAtlasReference->positions, imageMap, imageAtlasReference->iconPositions);
 
             if (!layout->hasSymbolInstances()) {
                 continue;
             }
 
             // layout adds the bucket to buckets
-            layout->createBucket(iconAtlas.patternPositions, featureIndex, renderData, firstLoad, showCollisionBoxes);
+            layout->createBucket(imageAtlasReference->patternPositions, featureIndex, renderData, firstLoad, showCollisionBoxes);
         }
     }
 
@@ -484,8 +616,8 @@ void GeometryTileWorker::finalizeLayout() {
     parent.invoke(&GeometryTile::onLayout, std::make_shared<GeometryTile::LayoutResult>(
         std::move(renderData),
         std::move(featureIndex),
-        std::move(glyphAtlasImage),
-        std::move(iconAtlas)
+        std::move(glyphAtlasReference),
+        std::move(imageAtlasReference)
     ), correlationID);
 }
 
@@ -18,8 +18,13 @@
 
 namespace mbgl {
 
+class BucketCache;
 class GeometryTile;
+class GlyphAtlas;
 class GeometryTileData;
+class GeometryTileLayer;
+class ImageAtlas;
+class ShapingCache;
 class Layout;
 
 namespace style {
@@ -35,7 +40,12 @@ public:
                        const std::atomic<bool>&,
                        const MapMode,
                        const float pixelRatio,
-                       const bool showCollisionBoxes_);
+                       const bool showCollisionBoxes_,
+                       const bool parallelLayout_,
+                       std::string bucketCachePath_,
+                       std::shared_ptr<GlyphAtlas> glyphAtlas_,
+                       std::shared_ptr<ImageAtlas> imageAtlas_,
+                       std::shared_ptr<ShapingCache> shapingCache_);
     ~GeometryTileWorker();
 
     void setLayers(std::vector<Immutable<style::LayerProperties>>,
@@ -48,11 +58,19 @@ public:
     void setShowCollisionBoxes(bool showCollisionBoxes_, uint64_t correlationID_);
     
     void onGlyphsAvailable(GlyphMap glyphs);
-    void onImagesAvailable(ImageMap icons, ImageMap patterns, ImageVersionMap versionMap, uint64_t imageCorrelationID);
+    void onImagesAvailable(ImageMap icons, ImageMap patterns, uint64_t imageCorrelationID);
 
 private:
     void coalesced();
     void parse();
+    void parseGroup(const std::vector<Immutable<style::LayerProperties>>&,
+                    std::unique_ptr<GeometryTileLayer>,
+                    std::unique_ptr<FeatureIndex>&,
+                    std::unordered_map<std::string, LayerRenderData>&,
+                    std::vector<std::unique_ptr<Layout>>&,
+                    GlyphDependencies&,
+                    ImageDependencies&,
+                    BucketCache*);
     void finalizeLayout();
     
     void coalesce();
@@ -74,6 +92,14 @@ private:
     const std::atomic<bool>& obsolete;
     const MapMode mode;
     const float pixelRatio;
+    // Lay out the groups of layers in parallel on the worker pool.
+    const bool parallelLayout;
+    // Directory of the bucket cache, or empty if it is disabled.
+    const std::string bucketCachePath;
+    // Shared by all tiles of the renderer.
+    const std::shared_ptr<GlyphAtlas> glyphAtlas;
+    const std::shared_ptr<ImageAtlas> imageAtlas;
+    const std::shared_ptr<ShapingCache> shapingCache;
     
     std::unique_ptr<FeatureIndex> featureIndex;
     std::unordered_map<std::string, LayerRenderData> renderData;
@@ -100,7 +126,6 @@ private:
     GlyphMap glyphMap;
     ImageMap imageMap;
     ImageMap patternMap;
-    ImageVersionMap versionMap;
     std::set<std::string> availableImages;
 
     bool showCollisionBoxes;
@@ -73,6 +73,10 @@ void RasterTile::setMask(TileMask&& mask) {
     }
 }
 
+std::size_t RasterTile::getMemoryUsage() const {
+    return bucket ? bucket->getMemoryUsage() : 0;
+}
+
 void RasterTile::setNecessity(TileNecessity necessity) {
     loader.setNecessity(necessity);
 }
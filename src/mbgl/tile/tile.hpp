@@ -127,6 +127,12 @@ public:
 
     virtual void setFeatureState(const LayerFeatureStates&) {}
 
+    // Approximate number of bytes held by this tile's render data, e.g. buckets, the feature
+    // index and atlas images. Used to keep the tile cache within its memory budget.
+    virtual std::size_t getMemoryUsage() const {
+        return 0;
+    }
+
     void dumpDebugLogs() const;
 
     const Kind kind;
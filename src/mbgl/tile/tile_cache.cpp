@@ -5,14 +5,23 @@ namespace mbgl {
 
 void TileCache::setSize(size_t size_) {
     size = size_;
+    evict();
+}
+
+void TileCache::setMaxBytes(size_t maxBytes_) {
+    maxBytes = maxBytes_;
+    evict();
+}
 
-    while (orderedKeys.size() > size) {
-        auto key = orderedKeys.front();
-        orderedKeys.remove(key);
-        tiles.erase(key);
+void TileCache::evict() {
+    // Always keeps the newest tile within the count limit, even if it exceeds the memory budget
+    // on its own, so that zooming back to it does not need to reload it.
+    while (orderedKeys.size() > size || (orderedKeys.size() > 1 && bytes > maxBytes)) {
+        pop(orderedKeys.front());
     }
 
     assert(orderedKeys.size() <= size);
+    assert(orderedKeys.size() == tiles.size());
 }
 
 void TileCache::add(const OverscaledTileID& key, std::unique_ptr<Tile> tile) {
@@ -20,27 +29,30 @@ void TileCache::add(const OverscaledTileID& key, std::unique_ptr<Tile> tile) {
         return;
     }
 
-    // insert new or query existing tile
-    if (!tiles.emplace(key, std::move(tile)).second) {
-        // remove existing tile key
-        orderedKeys.remove(key);
-    }
-
-    // (re-)insert tile key as newest
-    orderedKeys.push_back(key);
+    const size_t tileBytes = tile->getMemoryUsage();
 
-    // purge oldest key/tile if necessary
-    if (orderedKeys.size() > size) {
-        pop(orderedKeys.front());
+    auto it = tiles.find(key);
+    if (it != tiles.end()) {
+        // Replace the existing tile and mark the key as newest.
+        Entry& entry = it->second;
+        bytes -= entry.bytes;
+        entry.tile = std::move(tile);
+        entry.bytes = tileBytes;
+        orderedKeys.splice(orderedKeys.end(), orderedKeys, entry.position);
+    } else {
+        orderedKeys.push_back(key);
+        tiles.emplace(key, Entry{std::move(tile), std::prev(orderedKeys.end()), tileBytes});
     }
+    bytes += tileBytes;
 
-    assert(orderedKeys.size() <= size);
+    // purge oldest keys/tiles if necessary
+    evict();
 }
 
 Tile* TileCache::get(const OverscaledTileID& key) {
     auto it = tiles.find(key);
     if (it != tiles.end()) {
-        return it->second.get();
+        return it->second.tile.get();
     } else {
         return nullptr;
     }
@@ -52,9 +64,11 @@ std::unique_ptr<Tile> TileCache::pop(const OverscaledTileID& key) {
 
     auto it = tiles.find(key);
     if (it != tiles.end()) {
-        tile = std::move(it->second);
+        tile = std::move(it->second.tile);
+        assert(bytes >= it->second.bytes);
+        bytes -= it->second.bytes;
+        orderedKeys.erase(it->second.position);
         tiles.erase(it);
-        orderedKeys.remove(key);
         assert(tile->isRenderable());
     }
 
@@ -68,6 +82,7 @@ bool TileCache::has(const OverscaledTileID& key) {
 void TileCache::clear() {
     orderedKeys.clear();
     tiles.clear();
+    bytes = 0;
 }
 
 } // namespace mbgl
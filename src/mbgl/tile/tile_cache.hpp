@@ -2,20 +2,28 @@
 
 #include <mbgl/tile/tile_id.hpp>
 #include <mbgl/tile/tile.hpp>
-
+#include <mbgl/util/constants.hpp>
 
 #include <list>
 #include <memory>
-#include <map>
+#include <unordered_map>
 
 namespace mbgl {
 
+// Least recently used cache of tiles that are no longer needed for rendering. The cache
+// is bounded both by the number of tiles and by their memory usage, as reported by
+// `Tile::getMemoryUsage()` at the time a tile is added. All operations take constant time.
 class TileCache {
 public:
-    TileCache(size_t size_ = 0) : size(size_) {}
+    TileCache(size_t size_ = 0, size_t maxBytes_ = util::DEFAULT_TILE_CACHE_SIZE)
+        : size(size_), maxBytes(maxBytes_) {}
 
     void setSize(size_t);
     size_t getSize() const { return size; };
+    void setMaxBytes(size_t);
+    size_t getMaxBytes() const { return maxBytes; }
+    size_t getBytes() const { return bytes; }
+    size_t getCount() const { return tiles.size(); }
     void add(const OverscaledTileID& key, std::unique_ptr<Tile> data);
     std::unique_ptr<Tile> pop(const OverscaledTileID& key);
     Tile* get(const OverscaledTileID& key);
@@ -23,10 +31,21 @@ public:
     void clear();
 
 private:
-    std::map<OverscaledTileID, std::unique_ptr<Tile>> tiles;
+    void evict();
+
+    struct Entry {
+        std::unique_ptr<Tile> tile;
+        std::list<OverscaledTileID>::iterator position;
+        size_t bytes;
+    };
+
+    std::unordered_map<OverscaledTileID, Entry> tiles;
+    // Keys ordered from the least to the most recently added.
     std::list<OverscaledTileID> orderedKeys;
 
     size_t size;
+    size_t maxBytes;
+    size_t bytes = 0;
 };
 
 } // namespace mbgl
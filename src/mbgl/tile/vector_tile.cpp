@@ -13,6 +13,7 @@ VectorTile::VectorTile(const OverscaledTileID& id_,
 }
 
 void VectorTile::setNecessity(TileNecessity necessity) {
+    GeometryTile::setNecessity(necessity);
     loader.setNecessity(necessity);
 }
 
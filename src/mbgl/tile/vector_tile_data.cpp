@@ -1,11 +1,126 @@
 #include <mbgl/tile/vector_tile_data.hpp>
 #include <mbgl/util/constants.hpp>
 
+#include <stdexcept>
+
 namespace mbgl {
 
+namespace {
+
+// Field numbers from the vector tile specification.
+enum LayerField : protozero::pbf_tag_type { LayerKeys = 3, LayerValues = 4 };
+enum FeatureField : protozero::pbf_tag_type { FeatureTags = 2 };
+enum ValueField : protozero::pbf_tag_type {
+    ValueString = 1,
+    ValueFloat = 2,
+    ValueDouble = 3,
+    ValueInt = 4,
+    ValueUInt = 5,
+    ValueSInt = 6,
+    ValueBool = 7
+};
+
+Value parseValue(protozero::data_view view) {
+    protozero::pbf_reader reader(view);
+    Value value = NullValue();
+    while (reader.next()) {
+        switch (reader.tag()) {
+        case ValueString:
+            value = reader.get_string();
+            break;
+        case ValueFloat:
+            value = static_cast<double>(reader.get_float());
+            break;
+        case ValueDouble:
+            value = reader.get_double();
+            break;
+        case ValueInt:
+            value = reader.get_int64();
+            break;
+        case ValueUInt:
+            value = reader.get_uint64();
+            break;
+        case ValueSInt:
+            value = reader.get_sint64();
+            break;
+        case ValueBool:
+            value = reader.get_bool();
+            break;
+        default:
+            reader.skip();
+            break;
+        }
+    }
+    return value;
+}
+
+} // namespace
+
+VectorTileLayerProperties::VectorTileLayerProperties(const protozero::data_view& layer_) : layer(layer_) {
+}
+
+std::size_t VectorTileLayerProperties::DataViewHash::operator()(const protozero::data_view& view) const {
+    // FNV-1a
+    std::size_t hash = 2166136261u;
+    for (std::size_t i = 0; i < view.size(); ++i) {
+        hash = (hash ^ static_cast<unsigned char>(view.data()[i])) * 16777619u;
+    }
+    return hash;
+}
+
+void VectorTileLayerProperties::parse() const {
+    // Features of one layer may be read from several threads.
+    std::call_once(parsed, [&] {
+        protozero::pbf_reader reader(layer);
+        while (reader.next()) {
+            switch (reader.tag()) {
+            case LayerKeys: {
+                const protozero::data_view key = reader.get_view();
+                keyIndices.emplace(key, static_cast<uint32_t>(keys.size()));
+                keys.emplace_back(key.data(), key.size());
+                break;
+            }
+            case LayerValues:
+                values.push_back(parseValue(reader.get_view()));
+                break;
+            default:
+                reader.skip();
+                break;
+            }
+        }
+    });
+}
+
+optional<uint32_t> VectorTileLayerProperties::getKeyIndex(const std::string& key) const {
+    parse();
+    auto it = keyIndices.find(protozero::data_view(key.data(), key.size()));
+    return it != keyIndices.end() ? optional<uint32_t>(it->second) : nullopt;
+}
+
+const std::string& VectorTileLayerProperties::getKey(uint32_t index) const {
+    parse();
+    return keys.at(index);
+}
+
+const Value& VectorTileLayerProperties::getValue(uint32_t index) const {
+    parse();
+    return values.at(index);
+}
+
+std::size_t VectorTileLayerProperties::keyCount() const {
+    parse();
+    return keys.size();
+}
+
+std::size_t VectorTileLayerProperties::valueCount() const {
+    parse();
+    return values.size();
+}
+
 VectorTileFeature::VectorTileFeature(const mapbox::vector_tile::layer& layer,
+                                     const VectorTileLayerProperties& layerProperties_,
                                      const protozero::data_view& view)
-    : feature(view, layer) {
+    : feature(view, layer), layerProperties(layerProperties_), data(view) {
 }
 
 FeatureType VectorTileFeature::getType() const {
@@ -22,17 +137,66 @@ FeatureType VectorTileFeature::getType() const {
 }
 
 optional<Value> VectorTileFeature::getValue(const std::string& key) const {
-    const optional<Value> value(feature.getValue(key));
-    return value->is<NullValue>() ? nullopt : value;
+    const Value* value = findValue(key);
+    return value ? optional<Value>(*value) : nullopt;
 }
 
 const PropertyMap& VectorTileFeature::getProperties() const {
     if (!properties) {
-        properties = feature.getProperties();
+        properties = PropertyMap();
+        const TagsRange& range = getTags();
+        for (auto it = range.begin(); it != range.end();) {
+            const uint32_t key = *it++;
+            const uint32_t value = *it++;
+            properties->emplace(layerProperties.getKey(key), layerProperties.getValue(value));
+        }
     }
     return *properties;
 }
 
+const Value* VectorTileFeature::findValue(const std::string& key) const {
+    const optional<uint32_t> keyIndex = layerProperties.getKeyIndex(key);
+    if (!keyIndex) {
+        return nullptr;
+    }
+
+    const TagsRange& range = getTags();
+    for (auto it = range.begin(); it != range.end();) {
+        const uint32_t tagKey = *it++;
+        const uint32_t tagValue = *it++;
+        if (tagKey == *keyIndex) {
+            const Value& value = layerProperties.getValue(tagValue);
+            return value.is<NullValue>() ? nullptr : &value;
+        }
+    }
+    return nullptr;
+}
+
+const VectorTileFeature::TagsRange& VectorTileFeature::getTags() const {
+    if (!tags) {
+        TagsRange range;
+        protozero::pbf_reader reader(data);
+        while (reader.next(FeatureTags)) {
+            range = reader.get_packed_uint32();
+        }
+
+        // Validate the tags once, so that lookups don't need to.
+        std::size_t count = 0;
+        const std::size_t keyCount = layerProperties.keyCount();
+        const std::size_t valueCount = layerProperties.valueCount();
+        for (auto it = range.begin(); it != range.end(); ++it, ++count) {
+            if (count % 2 == 0 ? *it >= keyCount : *it >= valueCount) {
+                throw std::runtime_error("feature referenced out of range key or value");
+            }
+        }
+        if (count % 2 != 0) {
+            throw std::runtime_error("uneven number of feature tag ids");
+        }
+        tags = range;
+    }
+    return *tags;
+}
+
 FeatureIdentifier VectorTileFeature::getID() const {
     return feature.getID();
 }
@@ -50,7 +214,7 @@ const GeometryCollection& VectorTileFeature::getGeometries() const {
 
 VectorTileLayer::VectorTileLayer(std::shared_ptr<const std::string> data_,
                                  const protozero::data_view& view)
-    : data(std::move(data_)), layer(view) {
+    : data(std::move(data_)), layer(view), properties(view) {
 }
 
 std::size_t VectorTileLayer::featureCount() const {
@@ -58,7 +222,7 @@ std::size_t VectorTileLayer::featureCount() const {
 }
 
 std::unique_ptr<GeometryTileFeature> VectorTileLayer::getFeature(std::size_t i) const {
-    return std::make_unique<VectorTileFeature>(layer, layer.getFeature(i));
+    return std::make_unique<VectorTileFeature>(layer, properties, layer.getFeature(i));
 }
 
 std::string VectorTileLayer::getName() const {
@@ -87,6 +251,10 @@ std::unique_ptr<GeometryTileLayer> VectorTileData::getLayer(const std::string& n
     return nullptr;
 }
 
+std::size_t VectorTileData::getMemoryUsage() const {
+    return data ? data->size() : 0;
+}
+
 std::vector<std::string> VectorTileData::layerNames() const {
     return mapbox::vector_tile::buffer(*data).layerNames();
 }
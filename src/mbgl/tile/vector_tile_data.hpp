@@ -5,22 +5,57 @@
 
 #include <unordered_map>
 #include <functional>
+#include <mutex>
 #include <utility>
 
 namespace mbgl {
 
+// The property keys and values of a vector tile layer. Keys are resolved to their index in the
+// layer once, and every value is decoded once, so that features can look up their properties by
+// comparing key indices in their tag array and return values without copying them.
+class VectorTileLayerProperties {
+public:
+    explicit VectorTileLayerProperties(const protozero::data_view& layer);
+
+    optional<uint32_t> getKeyIndex(const std::string& key) const;
+    const std::string& getKey(uint32_t index) const;
+    const Value& getValue(uint32_t index) const;
+    std::size_t keyCount() const;
+    std::size_t valueCount() const;
+
+private:
+    void parse() const;
+
+    struct DataViewHash {
+        std::size_t operator()(const protozero::data_view&) const;
+    };
+
+    const protozero::data_view layer;
+    mutable std::once_flag parsed;
+    mutable std::vector<std::string> keys;
+    mutable std::unordered_map<protozero::data_view, uint32_t, DataViewHash> keyIndices;
+    mutable std::vector<Value> values;
+};
+
 class VectorTileFeature : public GeometryTileFeature {
 public:
-    VectorTileFeature(const mapbox::vector_tile::layer&, const protozero::data_view&);
+    VectorTileFeature(const mapbox::vector_tile::layer&, const VectorTileLayerProperties&, const protozero::data_view&);
 
     FeatureType getType() const override;
     optional<Value> getValue(const std::string& key) const override;
     const PropertyMap& getProperties() const override;
+    const Value* findValue(const std::string& key) const override;
     FeatureIdentifier getID() const override;
     const GeometryCollection& getGeometries() const override;
 
 private:
+    using TagsRange = protozero::iterator_range<protozero::pbf_reader::const_uint32_iterator>;
+    const TagsRange& getTags() const;
+
     mapbox::vector_tile::feature feature;
+    const VectorTileLayerProperties& layerProperties;
+    const protozero::data_view data;
+    mutable optional<TagsRange> tags;
     mutable optional<GeometryCollection> lines;
     mutable optional<PropertyMap> properties;
 };
@@ -36,6 +71,7 @@ public:
 private:
     std::shared_ptr<const std::string> data;
     mapbox::vector_tile::layer layer;
+    VectorTileLayerProperties properties;
 };
 
 class VectorTileData : public GeometryTileData {
@@ -44,6 +80,8 @@ public:
 
     std::unique_ptr<GeometryTileData> clone() const override;
     std::unique_ptr<GeometryTileLayer> getLayer(const std::string& name) const override;
+    std::size_t getMemoryUsage() const override;
+    const std::string* getEncodedData() const override { return data.get(); }
 
     std::vector<std::string> layerNames() const;
 
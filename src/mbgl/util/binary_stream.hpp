@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace mbgl {
+namespace util {
+
+// Appends values to a byte string in the native byte order and layout. The data is only meant
+// to be read back by a BinaryReader of the same build, e.g. for caches stored on disk.
+class BinaryWriter {
+public:
+    template <class T>
+    void write(const T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "value must be trivially copyable");
+        data.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template <class T>
+    void write(const std::vector<T>& values) {
+        static_assert(std::is_trivially_copyable<T>::value, "elements must be trivially copyable");
+        write<uint64_t>(values.size());
+        data.append(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+    }
+
+    void write(const std::string& value) {
+        write<uint64_t>(value.size());
+        data.append(value);
+    }
+
+    const std::string& getData() const { return data; }
+    std::string takeData() { return std::move(data); }
+
+private:
+    std::string data;
+};
+
+// Reads values written by a BinaryWriter. Reading past the end of the data fails, and leaves
+// the reader at the end of the data, so that any subsequent reads fail as well.
+class BinaryReader {
+public:
+    BinaryReader(const char* data, std::size_t size) : current(data), end(data + size) {}
+    explicit BinaryReader(const std::string& data) : BinaryReader(data.data(), data.size()) {}
+
+    template <class T>
+    bool read(T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "value must be trivially copyable");
+        if (!has(sizeof(T))) {
+            return false;
+        }
+        std::memcpy(&value, current, sizeof(T));
+        current += sizeof(T);
+        return true;
+    }
+
+    template <class T>
+    bool read(std::vector<T>& values) {
+        static_assert(std::is_trivially_copyable<T>::value, "elements must be trivially copyable");
+        uint64_t count;
+        if (!read(count) || !has(count, sizeof(T))) {
+            return false;
+        }
+        values.resize(count);
+        std::memcpy(values.data(), current, count * sizeof(T));
+        current += count * sizeof(T);
+        return true;
+    }
+
+    bool read(std::string& value) {
+        uint64_t size;
+        if (!read(size) || !has(size)) {
+            return false;
+        }
+        value.assign(current, size);
+        current += size;
+        return true;
+    }
+
+    // Skips `size` bytes, and returns a pointer to them.
+    const char* skip(std::size_t size) {
+        if (!has(size)) {
+            return nullptr;
+        }
+        const char* result = current;
+        current += size;
+        return result;
+    }
+
+    std::size_t remaining() const { return end - current; }
+
+private:
+    bool has(uint64_t count, std::size_t elementSize = 1) {
+        if (count > remaining() / elementSize) {
+            current = end;
+            return false;
+        }
+        return true;
+    }
+
+    const char* current;
+    const char* end;
+};
+
+} // namespace util
+} // namespace mbgl
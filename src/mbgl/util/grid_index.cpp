@@ -1,9 +1,7 @@
 #include <mbgl/util/grid_index.hpp>
 #include <mbgl/geometry/feature_index.hpp>
-#include <mbgl/math/minmax.hpp>
 
-#include <unordered_set>
-#include <cmath>
+#include <cassert>
 
 namespace mbgl {
 
@@ -24,9 +22,7 @@ GridIndex<T>::GridIndex(const float width_, const float height_, const uint32_t
     }
 
 template <class T>
-void GridIndex<T>::insert(T&& t, const BBox& bbox) {
-    size_t uid = boxElements.size();
-
+void GridIndex<T>::insertIntoCells(std::vector<Cell>& cells, uint32_t id, const BBox& bbox) {
     auto cx1 = convertToXCellCoord(bbox.min.x);
     auto cy1 = convertToYCellCoord(bbox.min.y);
     auto cx2 = convertToXCellCoord(bbox.max.x);
@@ -36,31 +32,52 @@ void GridIndex<T>::insert(T&& t, const BBox& bbox) {
     for (x = cx1; x <= cx2; ++x) {
         for (y = cy1; y <= cy2; ++y) {
             cellIndex = xCellCount * y + x;
-            boxCells[cellIndex].push_back(uid);
+            Cell& cell = cells[cellIndex];
+            const std::size_t lane = cell.ids.size() % 4;
+            if (lane == 0) {
+                cell.bounds.resize(cell.bounds.size() + 16);
+            }
+            float* block = cell.bounds.data() + cell.bounds.size() - 16;
+            block[lane] = bbox.min.x;
+            block[4 + lane] = bbox.min.y;
+            block[8 + lane] = bbox.max.x;
+            block[12 + lane] = bbox.max.y;
+            cell.ids.push_back(id);
         }
     }
+}
 
-    boxElements.emplace_back(t, bbox);
+template <class T>
+void GridIndex<T>::insert(T&& t, const BBox& bbox) {
+    insertIntoCells(boxCells, static_cast<uint32_t>(boxes.size()), bbox);
+    boxKeys.push_back(std::move(t));
+    boxes.push_back(bbox);
 }
 
 template <class T>
 void GridIndex<T>::insert(T&& t, const BCircle& bcircle) {
-    size_t uid = circleElements.size();
+    insertIntoCells(circleCells, static_cast<uint32_t>(circles.size()), convertToBox(bcircle));
+    circleKeys.push_back(std::move(t));
+    circles.push_back(bcircle);
+}
 
-    auto cx1 = convertToXCellCoord(bcircle.center.x - bcircle.radius);
-    auto cy1 = convertToYCellCoord(bcircle.center.y - bcircle.radius);
-    auto cx2 = convertToXCellCoord(bcircle.center.x + bcircle.radius);
-    auto cy2 = convertToYCellCoord(bcircle.center.y + bcircle.radius);
+template <class T>
+void GridIndex<T>::forEachBox(const std::function<void(const T&, const BBox&)>& fn) const {
+    for (std::size_t i = 0; i < boxes.size(); ++i) {
+        fn(boxKeys[i], boxes[i]);
+    }
+}
 
-    std::size_t x, y, cellIndex;
-    for (x = cx1; x <= cx2; ++x) {
-        for (y = cy1; y <= cy2; ++y) {
-            cellIndex = xCellCount * y + x;
-            circleCells[cellIndex].push_back(uid);
+template <class T>
+std::size_t GridIndex<T>::getMemoryUsage() const {
+    std::size_t bytes = (boxKeys.capacity() + circleKeys.capacity()) * sizeof(T) +
+                        boxes.capacity() * sizeof(BBox) + circles.capacity() * sizeof(BCircle);
+    for (const auto& cells : { &boxCells, &circleCells }) {
+        for (const auto& cell : *cells) {
+            bytes += sizeof(cell) + cell.bounds.capacity() * sizeof(float) + cell.ids.capacity() * sizeof(uint32_t);
         }
     }
-
-    circleElements.emplace_back(t, bcircle);
+    return bytes;
 }
 
 template <class T>
@@ -84,227 +101,18 @@ std::vector<std::pair<T, typename GridIndex<T>::BBox>> GridIndex<T>::queryWithBo
 }
 
 template <class T>
-bool GridIndex<T>::hitTest(const BBox& queryBBox, optional<std::function<bool(const T&)>> predicate) const {
-    bool hit = false;
-    query(queryBBox, [&](const T& t, const BBox&) -> bool {
-        if (!predicate || (*predicate)(t)) {
-            hit = true;
-            return true;
-        } else {
-            return false;
-        }
-    });
-    return hit;
-}
-
-template <class T>
-bool GridIndex<T>::hitTest(const BCircle& queryBCircle, optional<std::function<bool(const T&)>> predicate) const {
-    bool hit = false;
-    query(queryBCircle, [&](const T& t, const BBox&) -> bool {
-        if (!predicate || (*predicate)(t)) {
-            hit = true;
-            return true;
-        } else {
-            return false;
-        }
-    });
-    return hit;
-}
-
-template <class T>
-bool GridIndex<T>::noIntersection(const BBox& queryBBox) const {
-    return queryBBox.max.x < 0 || queryBBox.min.x >= width || queryBBox.max.y < 0 || queryBBox.min.y >= height;
-}
-
-template <class T>
-bool GridIndex<T>::completeIntersection(const BBox& queryBBox) const {
-    return queryBBox.min.x <= 0 && queryBBox.min.y <= 0 && width <= queryBBox.max.x && height <= queryBBox.max.y;
-}
-
-template <class T>
-typename GridIndex<T>::BBox GridIndex<T>::convertToBox(const BCircle& circle) const {
-    return BBox{{circle.center.x - circle.radius, circle.center.y - circle.radius},
-                {circle.center.x + circle.radius, circle.center.y + circle.radius}};
-}
-
-template <class T>
-void GridIndex<T>::query(const BBox& queryBBox, std::function<bool (const T&, const BBox&)> resultFn) const {
-    std::unordered_set<size_t> seenBoxes;
-    std::unordered_set<size_t> seenCircles;
-    
-    if (noIntersection(queryBBox)) {
-        return;
-    } else if (completeIntersection(queryBBox)) {
-        for (auto& element : boxElements) {
-            if (resultFn(element.first, element.second)) {
-                return;
-            }
-        }
-        for (auto& element : circleElements) {
-            if (resultFn(element.first, convertToBox(element.second))) {
-                return;
-            }
-        }
-        return;
-    }
-
-    auto cx1 = convertToXCellCoord(queryBBox.min.x);
-    auto cy1 = convertToYCellCoord(queryBBox.min.y);
-    auto cx2 = convertToXCellCoord(queryBBox.max.x);
-    auto cy2 = convertToYCellCoord(queryBBox.max.y);
-
-    std::size_t x, y, cellIndex;
-    for (x = cx1; x <= cx2; ++x) {
-        for (y = cy1; y <= cy2; ++y) {
-            cellIndex = xCellCount * y + x;
-            // Look up other boxes
-            for (auto uid : boxCells[cellIndex]) {
-                if (seenBoxes.count(uid) == 0) {
-                    seenBoxes.insert(uid);
-
-                    auto& pair = boxElements.at(uid);
-                    auto& bbox = pair.second;
-                    if (boxesCollide(queryBBox, bbox)) {
-                        if (resultFn(pair.first, bbox)) {
-                            return;
-                        }
-                    }
-                }
-            }
-            
-            // Look up circles
-            for (auto uid : circleCells[cellIndex]) {
-                if (seenCircles.count(uid) == 0) {
-                    seenCircles.insert(uid);
-
-                    auto& pair = circleElements.at(uid);
-                    auto& bcircle = pair.second;
-                    if (circleAndBoxCollide(bcircle, queryBBox)) {
-                        if (resultFn(pair.first, convertToBox(bcircle))) {
-                            return;
-                        }
-                    }
-                }
-            }
-        }
-    }
-}
-
-template <class T>
-void GridIndex<T>::query(const BCircle& queryBCircle, std::function<bool (const T&, const BBox&)> resultFn) const {
-    std::unordered_set<size_t> seenBoxes;
-    std::unordered_set<size_t> seenCircles;
-
-    BBox queryBBox = convertToBox(queryBCircle);
-    if (noIntersection(queryBBox)) {
-        return;
-    } else if (completeIntersection(queryBBox)) {
-        for (auto& element : boxElements) {
-            if (resultFn(element.first, element.second)) {
-                return;
-            }
-        }
-        for (auto& element : circleElements) {
-            if (resultFn(element.first, convertToBox(element.second))) {
-                return;
-            }
-        }
-    }
-
-    auto cx1 = convertToXCellCoord(queryBCircle.center.x - queryBCircle.radius);
-    auto cy1 = convertToYCellCoord(queryBCircle.center.y - queryBCircle.radius);
-    auto cx2 = convertToXCellCoord(queryBCircle.center.x + queryBCircle.radius);
-    auto cy2 = convertToYCellCoord(queryBCircle.center.y + queryBCircle.radius);
-
-    std::size_t x, y, cellIndex;
-    for (x = cx1; x <= cx2; ++x) {
-        for (y = cy1; y <= cy2; ++y) {
-            cellIndex = xCellCount * y + x;
-            // Look up boxes
-            for (auto uid : boxCells[cellIndex]) {
-                if (seenBoxes.count(uid) == 0) {
-                    seenBoxes.insert(uid);
-
-                    auto& pair = boxElements.at(uid);
-                    auto& bbox = pair.second;
-                    if (circleAndBoxCollide(queryBCircle, bbox)) {
-                        if (resultFn(pair.first, bbox)) {
-                            return;
-                        }
-                    }
-                }
-            }
-            
-            // Look up other circles
-            for (auto uid : circleCells[cellIndex]) {
-                if (seenCircles.count(uid) == 0) {
-                    seenCircles.insert(uid);
-
-                    auto& pair = circleElements.at(uid);
-                    auto& bcircle = pair.second;
-                    if (circlesCollide(queryBCircle, bcircle)) {
-                        if (resultFn(pair.first, convertToBox(bcircle))) {
-                            return;
-                        }
-                    }
-                }
-            }
-        }
-    }
-}
-
-template <class T>
-std::size_t GridIndex<T>::convertToXCellCoord(const float x) const {
-    return util::max(0.0, util::min(xCellCount - 1.0, std::floor(x * xScale)));
-}
-
-template <class T>
-std::size_t GridIndex<T>::convertToYCellCoord(const float y) const {
-    return util::max(0.0, util::min(yCellCount - 1.0, std::floor(y * yScale)));
-}
-
-template <class T>
-bool GridIndex<T>::boxesCollide(const BBox& first, const BBox& second) const {
-	return first.min.x <= second.max.x &&
-           first.min.y <= second.max.y &&
-           first.max.x >= second.min.x &&
-           first.max.y >= second.min.y;
+bool GridIndex<T>::hitTest(const BBox& queryBBox) const {
+    return hitTest(queryBBox, [](const T&) { return true; });
 }
 
 template <class T>
-bool GridIndex<T>::circlesCollide(const BCircle& first, const BCircle& second) const {
-    auto dx = second.center.x - first.center.x;
-    auto dy = second.center.y - first.center.y;
-    auto bothRadii = first.radius + second.radius;
-    return (bothRadii * bothRadii) > (dx * dx + dy * dy);
-}
-
-template <class T>
-bool GridIndex<T>::circleAndBoxCollide(const BCircle& circle, const BBox& box) const {
-    auto halfRectWidth = (box.max.x - box.min.x) / 2;
-    auto distX = std::abs(circle.center.x - (box.min.x + halfRectWidth));
-    if (distX > (halfRectWidth + circle.radius)) {
-        return false;
-    }
-
-    auto halfRectHeight = (box.max.y - box.min.y) / 2;
-    auto distY = std::abs(circle.center.y - (box.min.y + halfRectHeight));
-    if (distY > (halfRectHeight + circle.radius)) {
-        return false;
-    }
-
-    if (distX <= halfRectWidth || distY <= halfRectHeight) {
-        return true;
-    }
-
-    auto dx = distX - halfRectWidth;
-    auto dy = distY - halfRectHeight;
-    return (dx * dx + dy * dy) <= (circle.radius * circle.radius);
+bool GridIndex<T>::hitTest(const BCircle& queryBCircle) const {
+    return hitTest(queryBCircle, [](const T&) { return true; });
 }
 
 template <class T>
 bool GridIndex<T>::empty() const {
-    return boxElements.empty() && circleElements.empty();
+    return boxes.empty() && circles.empty();
 }
 
 
@@ -2,13 +2,23 @@
 
 #include <mapbox/geometry/point.hpp>
 #include <mapbox/geometry/box.hpp>
-#include <mbgl/util/optional.hpp>
+#include <mbgl/math/minmax.hpp>
 
+#include <algorithm>
+#include <cmath>
 #include <cstdint>
 #include <cstddef>
 #include <vector>
 #include <functional>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MBGL_GRID_INDEX_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define MBGL_GRID_INDEX_NEON
+#endif
+
 namespace mbgl {
 
 namespace geometry {
@@ -41,6 +51,38 @@ constexpr bool operator!=(circle<T> const& lhs, circle<T> const& rhs)
 } // namespace geometry
 
 
+namespace detail {
+
+// Tests four boxes, stored as [minX × 4, minY × 4, maxX × 4, maxY × 4], against the given box and
+// returns a bit mask with bit i set if box i intersects it.
+inline uint32_t intersectBoxBlock(const float* block, float minX, float minY, float maxX, float maxY) {
+#if defined(MBGL_GRID_INDEX_SSE2)
+    const __m128 x = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(block), _mm_set1_ps(maxX)),
+                                _mm_cmpge_ps(_mm_loadu_ps(block + 8), _mm_set1_ps(minX)));
+    const __m128 y = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(block + 4), _mm_set1_ps(maxY)),
+                                _mm_cmpge_ps(_mm_loadu_ps(block + 12), _mm_set1_ps(minY)));
+    return static_cast<uint32_t>(_mm_movemask_ps(_mm_and_ps(x, y)));
+#elif defined(MBGL_GRID_INDEX_NEON)
+    const uint32x4_t x = vandq_u32(vcleq_f32(vld1q_f32(block), vdupq_n_f32(maxX)),
+                                   vcgeq_f32(vld1q_f32(block + 8), vdupq_n_f32(minX)));
+    const uint32x4_t y = vandq_u32(vcleq_f32(vld1q_f32(block + 4), vdupq_n_f32(maxY)),
+                                   vcgeq_f32(vld1q_f32(block + 12), vdupq_n_f32(minY)));
+    const uint32x4_t hit = vandq_u32(x, y);
+    return (vgetq_lane_u32(hit, 0) & 1u) | (vgetq_lane_u32(hit, 1) & 2u) |
+           (vgetq_lane_u32(hit, 2) & 4u) | (vgetq_lane_u32(hit, 3) & 8u);
+#else
+    uint32_t mask = 0;
+    for (uint32_t i = 0; i < 4; ++i) {
+        if (block[i] <= maxX && block[4 + i] <= maxY && block[8 + i] >= minX && block[12 + i] >= minY) {
+            mask |= 1u << i;
+        }
+    }
+    return mask;
+#endif
+}
+
+} // namespace detail
+
 /*
  GridIndex is a data structure for testing the intersection of
  circles and rectangles in a 2d plane.
@@ -51,6 +93,11 @@ constexpr bool operator!=(circle<T> const& lhs, circle<T> const& rhs)
  at least one cell. As long as the geometries are relatively
  uniformly distributed across the plane, this greatly reduces
  the number of comparisons necessary.
+
+ The bounding boxes of the geometries are copied into every cell
+ they intersect, in blocks of four, so that a cell is scanned with
+ one SIMD comparison per block and without touching the geometries
+ that don't come close to the query.
 */
 
 template <class T>
@@ -67,26 +114,52 @@ public:
     
     std::vector<T> query(const BBox&) const;
     std::vector<std::pair<T,BBox>> queryWithBoxes(const BBox&) const;
-    
-    bool hitTest(const BBox&, optional<std::function<bool(const T&)>> predicate = nullopt) const;
-    bool hitTest(const BCircle&, optional<std::function<bool(const T&)>> predicate = nullopt) const;
+
+    // Calls `fn(const T&, const BBox&)` once for every geometry that intersects the query, until it
+    // returns `true`. Geometries that share a cell are visited in insertion order.
+    template <typename Fn>
+    void query(const BBox&, Fn&& fn) const;
+    template <typename Fn>
+    void query(const BCircle&, Fn&& fn) const;
+
+    bool hitTest(const BBox&) const;
+    bool hitTest(const BCircle&) const;
+
+    // Returns `true` if any of the geometries intersecting the query satisfies `predicate(const T&)`.
+    template <typename Predicate>
+    bool hitTest(const BBox&, Predicate&& predicate) const;
+    template <typename Predicate>
+    bool hitTest(const BCircle&, Predicate&& predicate) const;
     
     bool empty() const;
 
+    // Calls the given function for every inserted box, in insertion order.
+    void forEachBox(const std::function<void(const T&, const BBox&)>&) const;
+
+    // Approximate number of bytes held by the index.
+    std::size_t getMemoryUsage() const;
+
 private:
+    // The geometries intersecting a cell, in insertion order. `bounds` holds their bounding boxes in
+    // blocks of four as [minX × 4, minY × 4, maxX × 4, maxY × 4]; `ids` holds their indices.
+    struct Cell {
+        std::vector<float> bounds;
+        std::vector<uint32_t> ids;
+    };
+
     bool noIntersection(const BBox& queryBBox) const;
     bool completeIntersection(const BBox& queryBBox) const;
-    BBox convertToBox(const BCircle& circle) const;
+    static BBox convertToBox(const BCircle& circle);
 
-    void query(const BBox&, std::function<bool (const T&, const BBox&)>) const;
-    void query(const BCircle&, std::function<bool (const T&, const BBox&)>) const;
+    void insertIntoCells(std::vector<Cell>&, uint32_t id, const BBox&);
+    template <typename Fn>
+    static bool queryCell(const Cell&, const BBox&, Fn&&);
 
     std::size_t convertToXCellCoord(const float x) const;
     std::size_t convertToYCellCoord(const float y) const;
     
-    bool boxesCollide(const BBox&, const BBox&) const;
-    bool circlesCollide(const BCircle&, const BCircle&) const;
-    bool circleAndBoxCollide(const BCircle&, const BBox&) const;
+    static bool circlesCollide(const BCircle&, const BCircle&);
+    static bool circleAndBoxCollide(const BCircle&, const BBox&);
 
     const float width;
     const float height;
@@ -96,12 +169,225 @@ private:
     const double xScale;
     const double yScale;
 
-    std::vector<std::pair<T, BBox>> boxElements;
-    std::vector<std::pair<T, BCircle>> circleElements;
+    std::vector<T> boxKeys;
+    std::vector<BBox> boxes;
+    std::vector<T> circleKeys;
+    std::vector<BCircle> circles;
     
-    std::vector<std::vector<size_t>> boxCells;
-    std::vector<std::vector<size_t>> circleCells;
+    std::vector<Cell> boxCells;
+    std::vector<Cell> circleCells;
 
 };
 
+template <class T>
+template <typename Fn>
+bool GridIndex<T>::queryCell(const Cell& cell, const BBox& queryBBox, Fn&& fn) {
+    const std::size_t count = cell.ids.size();
+    for (std::size_t first = 0; first < count; first += 4) {
+        uint32_t mask = detail::intersectBoxBlock(cell.bounds.data() + first * 4,
+                                                  queryBBox.min.x, queryBBox.min.y,
+                                                  queryBBox.max.x, queryBBox.max.y);
+        if (count - first < 4) {
+            mask &= (1u << (count - first)) - 1;
+        }
+        for (std::size_t i = 0; mask != 0; ++i, mask >>= 1) {
+            if ((mask & 1u) && fn(cell.ids[first + i])) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+template <class T>
+template <typename Fn>
+void GridIndex<T>::query(const BBox& queryBBox, Fn&& resultFn) const {
+    if (noIntersection(queryBBox)) {
+        return;
+    } else if (completeIntersection(queryBBox)) {
+        for (std::size_t i = 0; i < boxes.size(); ++i) {
+            if (resultFn(boxKeys[i], boxes[i])) {
+                return;
+            }
+        }
+        for (std::size_t i = 0; i < circles.size(); ++i) {
+            if (resultFn(circleKeys[i], convertToBox(circles[i]))) {
+                return;
+            }
+        }
+        return;
+    }
+
+    auto cx1 = convertToXCellCoord(queryBBox.min.x);
+    auto cy1 = convertToYCellCoord(queryBBox.min.y);
+    auto cx2 = convertToXCellCoord(queryBBox.max.x);
+    auto cy2 = convertToYCellCoord(queryBBox.max.y);
+
+    std::size_t x, y, cellIndex;
+    for (x = cx1; x <= cx2; ++x) {
+        for (y = cy1; y <= cy2; ++y) {
+            cellIndex = xCellCount * y + x;
+            // A geometry that spans several cells is only reported in the first cell it shares
+            // with the query, which is also the first one visited.
+            const auto isFirstCell = [&](const BBox& bbox) {
+                return x == std::max(cx1, convertToXCellCoord(bbox.min.x)) &&
+                       y == std::max(cy1, convertToYCellCoord(bbox.min.y));
+            };
+
+            // Look up other boxes
+            if (queryCell(boxCells[cellIndex], queryBBox, [&](uint32_t uid) {
+                    const BBox& bbox = boxes[uid];
+                    return isFirstCell(bbox) && resultFn(boxKeys[uid], bbox);
+                })) {
+                return;
+            }
+
+            // Look up circles
+            if (queryCell(circleCells[cellIndex], queryBBox, [&](uint32_t uid) {
+                    const BCircle& bcircle = circles[uid];
+                    const BBox bbox = convertToBox(bcircle);
+                    return circleAndBoxCollide(bcircle, queryBBox) && isFirstCell(bbox) &&
+                           resultFn(circleKeys[uid], bbox);
+                })) {
+                return;
+            }
+        }
+    }
+}
+
+template <class T>
+template <typename Fn>
+void GridIndex<T>::query(const BCircle& queryBCircle, Fn&& resultFn) const {
+    const BBox queryBBox = convertToBox(queryBCircle);
+    if (noIntersection(queryBBox)) {
+        return;
+    } else if (completeIntersection(queryBBox)) {
+        for (std::size_t i = 0; i < boxes.size(); ++i) {
+            if (resultFn(boxKeys[i], boxes[i])) {
+                return;
+            }
+        }
+        for (std::size_t i = 0; i < circles.size(); ++i) {
+            if (resultFn(circleKeys[i], convertToBox(circles[i]))) {
+                return;
+            }
+        }
+        return;
+    }
+
+    auto cx1 = convertToXCellCoord(queryBBox.min.x);
+    auto cy1 = convertToYCellCoord(queryBBox.min.y);
+    auto cx2 = convertToXCellCoord(queryBBox.max.x);
+    auto cy2 = convertToYCellCoord(queryBBox.max.y);
+
+    std::size_t x, y, cellIndex;
+    for (x = cx1; x <= cx2; ++x) {
+        for (y = cy1; y <= cy2; ++y) {
+            cellIndex = xCellCount * y + x;
+            const auto isFirstCell = [&](const BBox& bbox) {
+                return x == std::max(cx1, convertToXCellCoord(bbox.min.x)) &&
+                       y == std::max(cy1, convertToYCellCoord(bbox.min.y));
+            };
+
+            // Look up boxes
+            if (queryCell(boxCells[cellIndex], queryBBox, [&](uint32_t uid) {
+                    const BBox& bbox = boxes[uid];
+                    return circleAndBoxCollide(queryBCircle, bbox) && isFirstCell(bbox) &&
+                           resultFn(boxKeys[uid], bbox);
+                })) {
+                return;
+            }
+
+            // Look up other circles
+            if (queryCell(circleCells[cellIndex], queryBBox, [&](uint32_t uid) {
+                    const BCircle& bcircle = circles[uid];
+                    const BBox bbox = convertToBox(bcircle);
+                    return circlesCollide(queryBCircle, bcircle) && isFirstCell(bbox) &&
+                           resultFn(circleKeys[uid], bbox);
+                })) {
+                return;
+            }
+        }
+    }
+}
+
+template <class T>
+template <typename Predicate>
+bool GridIndex<T>::hitTest(const BBox& queryBBox, Predicate&& predicate) const {
+    bool hit = false;
+    query(queryBBox, [&](const T& t, const BBox&) -> bool {
+        hit = predicate(t);
+        return hit;
+    });
+    return hit;
+}
+
+template <class T>
+template <typename Predicate>
+bool GridIndex<T>::hitTest(const BCircle& queryBCircle, Predicate&& predicate) const {
+    bool hit = false;
+    query(queryBCircle, [&](const T& t, const BBox&) -> bool {
+        hit = predicate(t);
+        return hit;
+    });
+    return hit;
+}
+
+template <class T>
+bool GridIndex<T>::noIntersection(const BBox& queryBBox) const {
+    return queryBBox.max.x < 0 || queryBBox.min.x >= width || queryBBox.max.y < 0 || queryBBox.min.y >= height;
+}
+
+template <class T>
+bool GridIndex<T>::completeIntersection(const BBox& queryBBox) const {
+    return queryBBox.min.x <= 0 && queryBBox.min.y <= 0 && width <= queryBBox.max.x && height <= queryBBox.max.y;
+}
+
+template <class T>
+typename GridIndex<T>::BBox GridIndex<T>::convertToBox(const BCircle& circle) {
+    return BBox{{circle.center.x - circle.radius, circle.center.y - circle.radius},
+                {circle.center.x + circle.radius, circle.center.y + circle.radius}};
+}
+
+template <class T>
+std::size_t GridIndex<T>::convertToXCellCoord(const float x) const {
+    return util::max(0.0, util::min(xCellCount - 1.0, std::floor(x * xScale)));
+}
+
+template <class T>
+std::size_t GridIndex<T>::convertToYCellCoord(const float y) const {
+    return util::max(0.0, util::min(yCellCount - 1.0, std::floor(y * yScale)));
+}
+
+template <class T>
+bool GridIndex<T>::circlesCollide(const BCircle& first, const BCircle& second) {
+    auto dx = second.center.x - first.center.x;
+    auto dy = second.center.y - first.center.y;
+    auto bothRadii = first.radius + second.radius;
+    return (bothRadii * bothRadii) > (dx * dx + dy * dy);
+}
+
+template <class T>
+bool GridIndex<T>::circleAndBoxCollide(const BCircle& circle, const BBox& box) {
+    auto halfRectWidth = (box.max.x - box.min.x) / 2;
+    auto distX = std::abs(circle.center.x - (box.min.x + halfRectWidth));
+    if (distX > (halfRectWidth + circle.radius)) {
+        return false;
+    }
+
+    auto halfRectHeight = (box.max.y - box.min.y) / 2;
+    auto distY = std::abs(circle.center.y - (box.min.y + halfRectHeight));
+    if (distY > (halfRectHeight + circle.radius)) {
+        return false;
+    }
+
+    if (distX <= halfRectWidth || distY <= halfRectHeight) {
+        return true;
+    }
+
+    auto dx = distX - halfRectWidth;
+    auto dy = distY - halfRectHeight;
+    return (dx * dx + dy * dy) <= (circle.radius * circle.radius);
+}
+
 } // namespace mbgl
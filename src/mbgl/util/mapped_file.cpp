@@ -0,0 +1,59 @@
+#include <mbgl/util/mapped_file.hpp>
+#include <mbgl/util/io.hpp>
+
+#include <stdexcept>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace mbgl {
+namespace util {
+
+MappedFile::MappedFile(const std::string& path) {
+#if defined(_WIN32)
+    auto contents_ = readFile(path);
+    if (!contents_ || contents_->empty()) {
+        throw std::runtime_error("Cannot read file " + path);
+    }
+    contents = std::move(*contents_);
+    address = contents.data();
+    length = contents.size();
+#else
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd == -1) {
+        throw std::runtime_error("Cannot open file " + path);
+    }
+    struct stat buf;
+    if (fstat(fd, &buf) == -1 || buf.st_size == 0) {
+        ::close(fd);
+        throw std::runtime_error("Cannot read file " + path);
+    }
+    length = static_cast<std::size_t>(buf.st_size);
+    void* mapping = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        throw std::runtime_error("Cannot map file " + path);
+    }
+    address = static_cast<const char*>(mapping);
+#endif
+}
+
+MappedFile::~MappedFile() {
+#if !defined(_WIN32)
+    munmap(const_cast<char*>(address), length);
+#endif
+}
+
+const char* MappedFile::range(uint64_t offset, uint64_t size_) const {
+    if (offset > length || size_ > length - offset) {
+        throw std::runtime_error("File is truncated");
+    }
+    return address + offset;
+}
+
+} // namespace util
+} // namespace mbgl
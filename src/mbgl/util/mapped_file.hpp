@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace mbgl {
+namespace util {
+
+// A read-only view of the contents of a file, which is memory-mapped where supported, so that
+// only the parts of the file that are actually read are loaded.
+class MappedFile {
+public:
+    // Throws if the file cannot be opened, is empty, or cannot be mapped.
+    MappedFile(const std::string& path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const { return address; }
+    std::size_t size() const { return length; }
+
+    // Returns the given range of the file, or throws if it is out of bounds.
+    const char* range(uint64_t offset, uint64_t size) const;
+
+private:
+#if defined(_WIN32)
+    std::string contents;
+#endif
+    const char* address = nullptr;
+    std::size_t length = 0;
+};
+
+} // namespace util
+} // namespace mbgl
@@ -0,0 +1,46 @@
+#include <mbgl/util/monotonic_buffer.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+
+namespace mbgl {
+namespace util {
+
+// Blocks double in size up to this limit, which keeps the number of blocks small for large
+// buckets without wasting much of the last block.
+static constexpr std::size_t maximumBlockSize = 1 << 20;
+
+MonotonicBuffer::MonotonicBuffer(std::size_t initialBlockSize)
+    : nextBlockSize(std::max<std::size_t>(initialBlockSize, alignof(std::max_align_t))) {
+}
+
+MonotonicBuffer::~MonotonicBuffer() = default;
+
+void* MonotonicBuffer::allocate(std::size_t size, std::size_t alignment) {
+    assert(alignment <= alignof(std::max_align_t));
+    if (size == 0) {
+        size = 1;
+    }
+
+    std::size_t padding = (alignment - reinterpret_cast<std::uintptr_t>(current) % alignment) % alignment;
+    if (!current || padding + size > remaining) {
+        // Blocks are aligned for any type, as they are allocated with new[].
+        const std::size_t blockSize = std::max(nextBlockSize, size);
+        blocks.emplace_back(new char[blockSize]);
+        current = blocks.back().get();
+        remaining = blockSize;
+        memoryUsage += blockSize;
+        nextBlockSize = std::min(nextBlockSize * 2, std::max(maximumBlockSize, nextBlockSize));
+        padding = 0;
+    }
+
+    ++allocationCount;
+    char* result = current + padding;
+    current = result + size;
+    remaining -= padding + size;
+    return result;
+}
+
+} // namespace util
+} // namespace mbgl
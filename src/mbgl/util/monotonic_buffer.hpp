@@ -0,0 +1,96 @@
+#pragma once
+
+#include <mbgl/util/noncopyable.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace mbgl {
+namespace util {
+
+// Hands out memory from a few large blocks, and releases all of it at once when it is destroyed.
+// Deallocating is a no-op, so this suits data that is built once and then lives as long as its
+// owner, such as the symbols of a bucket.
+//
+// Not thread-safe: all allocations must happen on one thread at a time.
+class MonotonicBuffer : private util::noncopyable {
+public:
+    explicit MonotonicBuffer(std::size_t initialBlockSize = 4096);
+    ~MonotonicBuffer();
+
+    void* allocate(std::size_t size, std::size_t alignment);
+
+    // Total size of the allocated blocks.
+    std::size_t getMemoryUsage() const { return memoryUsage; }
+    std::size_t getBlockCount() const { return blocks.size(); }
+    // Number of allocations served, each of which would otherwise be a heap allocation.
+    std::size_t getAllocationCount() const { return allocationCount; }
+
+private:
+    std::vector<std::unique_ptr<char[]>> blocks;
+    char* current = nullptr;
+    std::size_t remaining = 0;
+    std::size_t nextBlockSize;
+    std::size_t memoryUsage = 0;
+    std::size_t allocationCount = 0;
+};
+
+// Allocates from a MonotonicBuffer, or from the heap if it has none.
+//
+// Copies of a container get a heap allocator, so that they may outlive the buffer. Moves keep the
+// buffer.
+template <class T>
+class MonotonicAllocator {
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    MonotonicAllocator() noexcept = default;
+    explicit MonotonicAllocator(MonotonicBuffer* buffer_) noexcept : buffer(buffer_) {}
+    template <class U>
+    MonotonicAllocator(const MonotonicAllocator<U>& other) noexcept : buffer(other.getBuffer()) {}
+
+    T* allocate(std::size_t n) {
+        if (buffer) {
+            return static_cast<T*>(buffer->allocate(n * sizeof(T), alignof(T)));
+        }
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, std::size_t) noexcept {
+        if (!buffer) {
+            ::operator delete(p);
+        }
+    }
+
+    MonotonicAllocator select_on_container_copy_construction() const { return {}; }
+
+    MonotonicBuffer* getBuffer() const noexcept { return buffer; }
+
+private:
+    MonotonicBuffer* buffer = nullptr;
+};
+
+template <class T, class U>
+bool operator==(const MonotonicAllocator<T>& lhs, const MonotonicAllocator<U>& rhs) noexcept {
+    return lhs.getBuffer() == rhs.getBuffer();
+}
+
+template <class T, class U>
+bool operator!=(const MonotonicAllocator<T>& lhs, const MonotonicAllocator<U>& rhs) noexcept {
+    return lhs.getBuffer() != rhs.getBuffer();
+}
+
+template <class T>
+using MonotonicVector = std::vector<T, MonotonicAllocator<T>>;
+
+using MonotonicU16String = std::basic_string<char16_t, std::char_traits<char16_t>, MonotonicAllocator<char16_t>>;
+
+} // namespace util
+} // namespace mbgl
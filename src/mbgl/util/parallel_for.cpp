@@ -0,0 +1,77 @@
+#include <mbgl/util/parallel_for.hpp>
+
+#include <mbgl/actor/scheduler.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+
+namespace mbgl {
+namespace util {
+
+namespace {
+
+class ParallelForState {
+public:
+    ParallelForState(std::size_t count_, const std::function<void(std::size_t)>& fn_)
+        : count(count_), fn(fn_) {}
+
+    // Runs unclaimed indices until there are none left.
+    void run() {
+        for (std::size_t i = next++; i < count; i = next++) {
+            try {
+                fn(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!error) {
+                    error = std::current_exception();
+                }
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            if (++completed == count) {
+                cv.notify_all();
+            }
+        }
+    }
+
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [this] { return completed == count; });
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+private:
+    const std::size_t count;
+    // Only invoked for claimed indices, i.e. while the caller of parallelFor() is waiting.
+    const std::function<void(std::size_t)>& fn;
+
+    std::atomic<std::size_t> next{0};
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::size_t completed = 0;
+    std::exception_ptr error;
+};
+
+} // namespace
+
+void parallelFor(Scheduler& scheduler, std::size_t count, const std::function<void(std::size_t)>& fn) {
+    if (count == 0) {
+        return;
+    }
+
+    auto state = std::make_shared<ParallelForState>(count, fn);
+    for (std::size_t i = 1; i < count; ++i) {
+        scheduler.schedule([state] { state->run(); });
+    }
+
+    state->run();
+    state->wait();
+}
+
+} // namespace util
+} // namespace mbgl
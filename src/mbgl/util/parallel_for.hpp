@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+namespace mbgl {
+
+class Scheduler;
+
+namespace util {
+
+// Calls `fn` for every index in [0, count) and returns once all calls have completed.
+//
+// The calling thread takes part in the work, and up to `count - 1` helper tasks are
+// scheduled to the given scheduler to pick up the indices nobody has started yet. The
+// caller therefore never waits for a helper that is still queued, which makes it safe
+// to call from a task running on the same scheduler.
+//
+// If any call throws, the first exception is rethrown once all started calls have
+// finished.
+void parallelFor(Scheduler&, std::size_t count, const std::function<void(std::size_t)>& fn);
+
+} // namespace util
+} // namespace mbgl
@@ -4,8 +4,12 @@
 namespace mbgl {
 
 std::string formatJSONParseError(const JSDocument& doc) {
-    return std::string{ rapidjson::GetParseError_En(doc.GetParseError()) } + " at offset " +
-           util::toString(doc.GetErrorOffset());
+    return formatJSONParseError(rapidjson::ParseResult(doc.GetParseError(), doc.GetErrorOffset()));
+}
+
+std::string formatJSONParseError(const rapidjson::ParseResult& result) {
+    return std::string{ rapidjson::GetParseError_En(result.Code()) } + " at offset " +
+           util::toString(result.Offset());
 }
 
 } // namespace mbgl
@@ -9,5 +9,6 @@ using JSDocument = rapidjson::GenericDocument<rapidjson::UTF8<>, rapidjson::CrtA
 using JSValue = rapidjson::GenericValue<rapidjson::UTF8<>, rapidjson::CrtAllocator>;
 
 std::string formatJSONParseError(const JSDocument&);
+std::string formatJSONParseError(const rapidjson::ParseResult&);
 
 } // namespace mbgl
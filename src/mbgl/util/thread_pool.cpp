@@ -2,10 +2,38 @@
 
 #include <mbgl/util/platform.hpp>
 #include <mbgl/util/string.hpp>
+#include <mbgl/util/thread_local.hpp>
 #include <mbgl/platform/thread.hpp>
 
+#include <cassert>
+#include <cstdlib>
+
 namespace mbgl {
 
+namespace {
+
+// Identifies the scheduler thread the code is currently running on, so that
+// tasks scheduled from a worker end up in that worker's own queue.
+struct WorkerThread {
+    const ThreadedSchedulerBase* scheduler;
+    std::size_t index;
+};
+
+util::ThreadLocal<WorkerThread>& currentWorker() {
+    static util::ThreadLocal<WorkerThread> worker;
+    return worker;
+}
+
+} // namespace
+
+ThreadedSchedulerBase::ThreadedSchedulerBase(std::size_t threadCount) {
+    assert(threadCount > 0);
+    queues.reserve(threadCount);
+    for (std::size_t i = 0; i < threadCount; ++i) {
+        queues.emplace_back(std::make_unique<WorkQueue>());
+    }
+}
+
 ThreadedSchedulerBase::~ThreadedSchedulerBase() = default;
 
 void ThreadedSchedulerBase::terminate() {
@@ -17,36 +45,140 @@ void ThreadedSchedulerBase::terminate() {
 }
 
 std::thread ThreadedSchedulerBase::makeSchedulerThread(size_t index) {
+    assert(index < queues.size());
     return std::thread([this, index]() {
         platform::setCurrentThreadName(std::string{"Worker "} + util::toString(index + 1));
         platform::attachThread();
 
+        WorkerThread self{this, index};
+        currentWorker().set(&self);
+
         while (true) {
+            if (auto function = take(index)) {
+                function();
+                continue;
+            }
+
             std::unique_lock<std::mutex> lock(mutex);
 
-            cv.wait(lock, [this] { return !queue.empty() || terminated; });
+            // `sleeping` is raised before `pending` is checked, and `push()` raises `pending`
+            // before checking `sleeping`, so a task cannot slip in unnoticed.
+            ++sleeping;
+            cv.wait(lock, [this] { return pending > 0 || terminated; });
+            --sleeping;
 
             if (terminated) {
+                currentWorker().set(nullptr);
                 platform::detachThread();
                 return;
             }
-
-            auto function = std::move(queue.front());
-            queue.pop();
-            lock.unlock();
-            if (function) function();
         }
     });
 }
 
-void ThreadedSchedulerBase::schedule(std::function<void()> fn) {
+std::function<void()> ThreadedSchedulerBase::takeFrom(WorkQueue& queue, std::size_t lane, bool owner) {
+    if (queue.size == 0) {
+        return {};
+    }
+
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    auto& tasks = queue.lanes[lane];
+    if (tasks.empty()) {
+        return {};
+    }
+
+    // The owner processes its queue in FIFO order, while thieves take the most
+    // recently scheduled task so they contend as little as possible with the owner.
+    std::function<void()> function;
+    if (owner) {
+        function = std::move(tasks.front());
+        tasks.pop_front();
+    } else {
+        function = std::move(tasks.back());
+        tasks.pop_back();
+    }
+    --queue.size;
+    --pending;
+    return function;
+}
+
+std::function<void()> ThreadedSchedulerBase::take(std::size_t index) {
+    if (pending == 0) {
+        return {};
+    }
+
+    const std::size_t count = queues.size();
+    for (std::size_t lane = 0; lane < kPriorityCount; ++lane) {
+        if (auto function = takeFrom(*queues[index], lane, true)) {
+            return function;
+        }
+        for (std::size_t i = 1; i < count; ++i) {
+            if (auto function = takeFrom(*queues[(index + i) % count], lane, false)) {
+                return function;
+            }
+        }
+    }
+    return {};
+}
+
+void ThreadedSchedulerBase::push(TaskPriority priority, std::function<void()> fn) {
     assert(fn);
+
+    std::size_t index;
+    WorkerThread* worker = currentWorker().get();
+    if (worker && worker->scheduler == this) {
+        index = worker->index;
+    } else {
+        index = nextQueue++ % queues.size();
+    }
+
     {
-        std::lock_guard<std::mutex> lock(mutex);
-        queue.push(std::move(fn));
+        WorkQueue& queue = *queues[index];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.lanes[static_cast<std::size_t>(priority)].push_back(std::move(fn));
+        ++queue.size;
+        ++pending;
+    }
+
+    if (sleeping > 0) {
+        // Synchronize with a thread that is about to go to sleep.
+        { std::lock_guard<std::mutex> lock(mutex); }
+        cv.notify_one();
+    }
+}
+
+void ThreadedSchedulerBase::schedule(std::function<void()> fn) {
+    push(TaskPriority::Normal, std::move(fn));
+}
+
+ThreadPool::ThreadPool(std::size_t threadCount) : ThreadedSchedulerBase(threadCount) {
+    threads.reserve(threadCount);
+    for (std::size_t i = 0u; i < threadCount; ++i) {
+        threads.emplace_back(makeSchedulerThread(i));
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    terminate();
+    for (auto& thread : threads) {
+        thread.join();
     }
+}
+
+void ThreadPool::scheduleWithPriority(TaskPriority priority, std::function<void()> fn) {
+    push(priority, std::move(fn));
+}
 
-    cv.notify_one();
+// static
+std::size_t ThreadPool::getDefaultThreadCount() {
+    if (const char* value = std::getenv("MBGL_WORKER_THREADS")) {
+        char* end = nullptr;
+        const long count = std::strtol(value, &end, 10);
+        if (end != value && *end == '\0' && count > 0) {
+            return static_cast<std::size_t>(count);
+        }
+    }
+    return kDefaultThreadCount;
 }
 
 } // namespace mbgl
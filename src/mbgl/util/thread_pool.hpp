@@ -4,25 +4,55 @@
 #include <mbgl/actor/scheduler.hpp>
 
 #include <array>
+#include <atomic>
 #include <condition_variable>
+#include <deque>
+#include <memory>
 #include <mutex>
-#include <queue>
 #include <thread>
+#include <vector>
 
 namespace mbgl {
 
+/**
+ * @brief ThreadedSchedulerBase runs the scheduled tasks on a fixed set of threads.
+ *
+ * Every thread owns a work queue with a lane per `TaskPriority`. Tasks scheduled from
+ * one of the scheduler threads are pushed to that thread's own queue; tasks scheduled
+ * from elsewhere are distributed round-robin. A thread takes work from its own queue
+ * first and steals from the other threads' queues when it runs dry, always picking the
+ * most urgent lane available.
+ */
 class ThreadedSchedulerBase : public Scheduler {
 public:
     void schedule(std::function<void()>) override;
 
 protected:
-    ThreadedSchedulerBase() = default;
+    explicit ThreadedSchedulerBase(std::size_t threadCount);
     ~ThreadedSchedulerBase() override;
 
     void terminate();
     std::thread makeSchedulerThread(size_t index);
+    void push(TaskPriority, std::function<void()>);
+
+private:
+    static constexpr std::size_t kPriorityCount = 3;
+
+    struct WorkQueue {
+        std::mutex mutex;
+        std::array<std::deque<std::function<void()>>, kPriorityCount> lanes;
+        // Number of tasks in all lanes; lets other threads skip empty queues without locking.
+        std::atomic<std::size_t> size{0};
+    };
+
+    std::function<void()> take(std::size_t index);
+    std::function<void()> takeFrom(WorkQueue&, std::size_t lane, bool owner);
+
+    std::vector<std::unique_ptr<WorkQueue>> queues;
+    std::atomic<std::size_t> nextQueue{0};
+    std::atomic<std::size_t> pending{0};
+    std::atomic<std::size_t> sleeping{0};
 
-    std::queue<std::function<void()>> queue;
     std::mutex mutex;
     std::condition_variable cv;
     bool terminated{false};
@@ -39,7 +69,7 @@ protected:
 template <std::size_t N>
 class ThreadedScheduler : public ThreadedSchedulerBase {
 public:
-    ThreadedScheduler() {
+    ThreadedScheduler() : ThreadedSchedulerBase(N) {
         for (std::size_t i = 0u; i < N; ++i) {
             threads[i] = makeSchedulerThread(i);
         }
@@ -65,6 +95,31 @@ class SequencedScheduler : public ThreadedScheduler<1> {};
 template <std::size_t extra>
 using ParallelScheduler = ThreadedScheduler<1 + extra>;
 
-class ThreadPool : public ParallelScheduler<3> {};
+/**
+ * @brief ThreadPool is the shared, priority-aware worker pool returned by
+ * `Scheduler::GetBackground()`.
+ *
+ * Unlike the other threaded schedulers, the number of threads is chosen at runtime and
+ * tasks scheduled with `scheduleWithPriority()` are run in the order of their priority.
+ */
+class ThreadPool final : public ThreadedSchedulerBase {
+public:
+    explicit ThreadPool(std::size_t threadCount = getDefaultThreadCount());
+    ~ThreadPool() override;
+
+    void scheduleWithPriority(TaskPriority, std::function<void()>) override;
+    mapbox::base::WeakPtr<Scheduler> makeWeakPtr() override { return weakFactory.makeWeakPtr(); }
+
+    std::size_t getThreadCount() const { return threads.size(); }
+
+    // Returns the thread count requested by the `MBGL_WORKER_THREADS` environment
+    // variable, or `kDefaultThreadCount` if it is unset or invalid.
+    static std::size_t getDefaultThreadCount();
+    static constexpr std::size_t kDefaultThreadCount = 4;
+
+private:
+    std::vector<std::thread> threads;
+    mapbox::base::WeakPtrFactory<Scheduler> weakFactory{this};
+};
 
 } // namespace mbgl
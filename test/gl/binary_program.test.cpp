@@ -0,0 +1,106 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/gfx/backend.hpp>
+#include <mbgl/gfx/headless_frontend.hpp>
+#include <mbgl/gl/binary_program.hpp>
+#include <mbgl/map/map.hpp>
+#include <mbgl/map/map_options.hpp>
+#include <mbgl/renderer/renderer.hpp>
+#include <mbgl/storage/resource_options.hpp>
+#include <mbgl/style/style.hpp>
+#include <mbgl/util/io.hpp>
+#include <mbgl/util/run_loop.hpp>
+
+#include <algorithm>
+
+using namespace mbgl;
+
+TEST(BinaryProgram, File) {
+    const std::string path = "test/fixtures/program_cache/file.bin";
+    util::deleteFile(path);
+
+    gl::BinaryProgramFile file(path);
+    EXPECT_TRUE(file.keys().empty());
+    EXPECT_FALSE(file.load(1, "a"));
+
+    file.store(1, "a", { 7, "first" });
+    file.store(2, "b", { 8, std::string("sec\0ond", 7) });
+    EXPECT_EQ((std::vector<uint32_t>{ 1, 2 }), file.keys());
+
+    const gl::BinaryProgram* first = file.load(1, "a");
+    ASSERT_TRUE(first);
+    EXPECT_EQ(7u, first->format);
+    EXPECT_EQ("first", first->code);
+
+    // Stored binaries are only written by save().
+    EXPECT_TRUE(gl::BinaryProgramFile(path).keys().empty());
+    file.save();
+
+    gl::BinaryProgramFile reread(path);
+    EXPECT_EQ((std::vector<uint32_t>{ 1, 2 }), reread.keys());
+    const gl::BinaryProgram* second = reread.load(2, "b");
+    ASSERT_TRUE(second);
+    EXPECT_EQ(8u, second->format);
+    EXPECT_EQ(std::string("sec\0ond", 7), second->code);
+
+    // Binaries are only loaded for the identifier they were stored with.
+    EXPECT_FALSE(file.load(1, "b"));
+
+    // Storing a key again replaces its binary.
+    file.store(1, "c", { 9, "third" });
+    EXPECT_EQ((std::vector<uint32_t>{ 2, 1 }), file.keys());
+    EXPECT_FALSE(file.load(1, "a"));
+    ASSERT_TRUE(file.load(1, "c"));
+    EXPECT_EQ("third", file.load(1, "c")->code);
+
+    // Saving keeps the binaries that other writers saved in the meantime.
+    reread.store(3, "d", { 10, "fourth" });
+    reread.save();
+    file.save();
+    gl::BinaryProgramFile merged(path);
+    EXPECT_EQ((std::vector<uint32_t>{ 2, 1, 3 }), merged.keys());
+    ASSERT_TRUE(merged.load(1, "c"));
+    ASSERT_TRUE(merged.load(3, "d"));
+    EXPECT_EQ("fourth", merged.load(3, "d")->code);
+
+    // Files that aren't program caches are ignored.
+    util::write_file(path, "not a program cache");
+    gl::BinaryProgramFile invalid(path);
+    EXPECT_TRUE(invalid.keys().empty());
+    EXPECT_FALSE(invalid.load(2, "b"));
+
+    util::deleteFile(path);
+}
+
+TEST(BinaryProgram, WarmUp) {
+    if (gfx::Backend::GetType() != gfx::Backend::Type::OpenGL) {
+        return;
+    }
+
+    util::RunLoop loop;
+
+    const auto render = [](bool warmUp) {
+        HeadlessFrontend frontend{ 1,
+                                   gfx::HeadlessBackend::SwapBehaviour::NoFlush,
+                                   gfx::ContextMode::Unique,
+                                   {},
+                                   std::string("test/fixtures/program_cache") };
+        Map map(frontend,
+                MapObserver::nullObserver(),
+                MapOptions().withMapMode(MapMode::Static).withSize(frontend.getSize()),
+                ResourceOptions().withCachePath(":memory:").withAssetPath("test/fixtures/api/assets"));
+        map.getStyle().loadJSON(util::read_file("test/fixtures/api/water.json"));
+        map.jumpTo(CameraOptions().withCenter(LatLng { 37.8, -122.5 }).withZoom(10.0));
+        if (warmUp) {
+            frontend.getRenderer()->warmUpPrograms();
+        }
+        return frontend.render(map).image;
+    };
+
+    // The second map loads the programs that the first one cached, where the driver supports it,
+    // and must render the same image.
+    const PremultipliedImage compiled = render(false);
+    const PremultipliedImage cached = render(true);
+    ASSERT_EQ(compiled.size, cached.size);
+    EXPECT_TRUE(std::equal(compiled.data.get(), compiled.data.get() + compiled.bytes(), cached.data.get()));
+}
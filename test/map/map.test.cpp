@@ -10,6 +10,7 @@
 #include <mbgl/gl/context.hpp>
 #include <mbgl/map/map_options.hpp>
 #include <mbgl/math/log2.hpp>
+#include <mbgl/renderer/renderer.hpp>
 #include <mbgl/storage/default_file_source.hpp>
 #include <mbgl/storage/network_status.hpp>
 #include <mbgl/storage/online_file_source.hpp>
@@ -26,6 +27,10 @@
 #include <mbgl/util/image.hpp>
 #include <mbgl/util/io.hpp>
 #include <mbgl/util/run_loop.hpp>
+#include <mbgl/util/string.hpp>
+#include <mbgl/util/constants.hpp>
+
+#include <array>
 
 using namespace mbgl;
 using namespace mbgl::style;
@@ -361,6 +366,9 @@ TEST(Map, DefaultMapOptions) {
     EXPECT_EQ(options.constrainMode(), ConstrainMode::HeightOnly);
     EXPECT_EQ(options.northOrientation(), NorthOrientation::Upwards);
     EXPECT_TRUE(options.crossSourceCollisions());
+    EXPECT_FALSE(options.parallelTileLayout());
+    EXPECT_EQ(options.bucketCachePath(), "");
+    EXPECT_EQ(options.tileCacheSize(), util::DEFAULT_TILE_CACHE_SIZE);
     EXPECT_EQ(options.size().width, 256);
     EXPECT_EQ(options.size().height, 256);
     EXPECT_EQ(options.pixelRatio(), 1);
@@ -1068,3 +1076,172 @@ TEST(Map, NoHangOnMissingImage) {
     // The test passes if the following call does not hang.
     test.frontend.render(test.map);
 }
+
+TEST(Map, ParallelTileLayout) {
+    const std::string style{R"STYLE({
+      "version": 8,
+      "center": [-122.5195, 37.8575],
+      "zoom": 10,
+      "sources": {
+        "mapbox": {
+          "type": "vector",
+          "tiles": ["asset://streets/{z}-{x}-{y}.vector.pbf"]
+        }
+      },
+      "layers": [
+        { "id": "background", "type": "background", "paint": { "background-color": "white" } },
+        { "id": "landcover", "type": "fill", "source": "mapbox", "source-layer": "landcover", "paint": { "fill-color": "green" } },
+        { "id": "landuse", "type": "fill", "source": "mapbox", "source-layer": "landuse", "paint": { "fill-color": "yellow", "fill-opacity": 0.5 } },
+        { "id": "water", "type": "fill", "source": "mapbox", "source-layer": "water", "paint": { "fill-color": "blue" } },
+        { "id": "water-outline", "type": "line", "source": "mapbox", "source-layer": "water", "paint": { "line-color": "navy", "line-width": 2 } },
+        { "id": "waterway", "type": "line", "source": "mapbox", "source-layer": "waterway", "paint": { "line-color": "cyan" } },
+        { "id": "road", "type": "line", "source": "mapbox", "source-layer": "road", "paint": { "line-color": "black" } },
+        { "id": "admin", "type": "line", "source": "mapbox", "source-layer": "admin", "paint": { "line-color": "red", "line-dasharray": [2, 2] } }
+      ]
+    })STYLE"};
+
+    auto render = [&](bool parallel, std::vector<Feature>& features) {
+        util::RunLoop runLoop;
+        StubMapObserver observer;
+        HeadlessFrontend frontend{1};
+        MapAdapter map(frontend,
+                       observer,
+                       std::make_shared<DefaultFileSource>(":memory:", "test/fixtures/api/assets"),
+                       MapOptions()
+                           .withMapMode(MapMode::Static)
+                           .withSize(frontend.getSize())
+                           .withParallelTileLayout(parallel));
+        map.getStyle().loadJSON(style);
+        map.jumpTo(map.getStyle().getDefaultCamera());
+        auto image = frontend.render(map).image;
+        features = frontend.getRenderer()->queryRenderedFeatures(ScreenBox{{0, 0}, {256, 256}});
+        return image;
+    };
+
+    std::vector<Feature> sequentialFeatures;
+    std::vector<Feature> parallelFeatures;
+    const auto sequential = render(false, sequentialFeatures);
+    const auto parallel = render(true, parallelFeatures);
+
+    // Laying out the layer groups in parallel must not change the result.
+    ASSERT_EQ(sequential.bytes(), parallel.bytes());
+    EXPECT_TRUE(std::equal(sequential.data.get(), sequential.data.get() + sequential.bytes(), parallel.data.get()));
+    ASSERT_FALSE(sequentialFeatures.empty());
+    ASSERT_EQ(sequentialFeatures.size(), parallelFeatures.size());
+    for (std::size_t i = 0; i < sequentialFeatures.size(); ++i) {
+        EXPECT_EQ(sequentialFeatures[i].sourceLayer, parallelFeatures[i].sourceLayer);
+        EXPECT_EQ(sequentialFeatures[i].properties, parallelFeatures[i].properties);
+    }
+}
+
+TEST(Map, TileClippingDrawCalls) {
+    // At zoom 1, the four tiles of source "a" are visible. Source "b" only has tiles up to zoom 0,
+    // so its single tile is overscaled. Its layers alternate with those of "a", so that the tiles
+    // to clip change with every layer.
+    const std::string style{R"STYLE({
+      "version": 8,
+      "sources": {
+        "a": { "type": "geojson", "data": { "type": "Polygon", "coordinates": [[[-180, -80], [180, -80], [180, 80], [-180, 80], [-180, -80]]] } },
+        "b": { "type": "geojson", "maxzoom": 0, "data": { "type": "Polygon", "coordinates": [[[-180, -80], [180, -80], [180, 80], [-180, 80], [-180, -80]]] } }
+      },
+      "layers": [
+        { "id": "a1", "type": "line", "source": "a", "paint": { "line-color": "black" } },
+        { "id": "b1", "type": "line", "source": "b", "paint": { "line-color": "red" } },
+        { "id": "a2", "type": "line", "source": "a", "paint": { "line-color": "green" } },
+        { "id": "b2", "type": "line", "source": "b", "paint": { "line-color": "blue" } }
+      ]
+    })STYLE"};
+
+    auto render = [&](double bearing) {
+        MapTest<> test;
+        test.map.getStyle().loadJSON(style);
+        test.map.jumpTo(CameraOptions().withCenter(LatLng{0, 0}).withZoom(1).withBearing(bearing));
+        return test.frontend.render(test.map).stats;
+    };
+
+    // The square viewport shows the same tiles either way, but only tiles that are aligned with
+    // the screen can be clipped without drawing stencil masks. When rotated, every layer draws a
+    // mask for each of its tiles first: 4 + 1 + 4 + 1 draw calls.
+    const gfx::RenderingStats aligned = render(0);
+    const gfx::RenderingStats rotated = render(180);
+    EXPECT_EQ(aligned.numDrawCalls + 10, rotated.numDrawCalls);
+}
+
+TEST(Map, SharedGlyphAtlasTextures) {
+    // Renders labels at the given coordinates at zoom 1, where the four tiles of the world are
+    // visible, and returns the rendering stats of the frame.
+    auto render = [](const std::string& coordinates) {
+        MapTest<> test;
+        test.fileSource->glyphsResponse = [](const Resource&) {
+            Response response;
+            response.data = std::make_shared<std::string>(util::read_file("test/fixtures/resources/glyphs.pbf"));
+            return response;
+        };
+        test.map.getStyle().loadJSON(R"STYLE({
+          "version": 8,
+          "glyphs": "asset://{fontstack}/{range}.pbf",
+          "sources": {
+            "points": { "type": "geojson", "data": { "type": "MultiPoint", "coordinates": )STYLE" +
+                                     coordinates + R"STYLE( } }
+          },
+          "layers": [
+            { "id": "labels", "type": "symbol", "source": "points", "layout": { "text-field": "Label" } }
+          ]
+        })STYLE");
+        test.map.jumpTo(CameraOptions().withCenter(LatLng{0, 0}).withZoom(1));
+        return test.frontend.render(test.map).stats;
+    };
+
+    // The points are far enough from the tile edges that each tile holds only its own.
+    const gfx::RenderingStats oneTile = render("[[100, 50], [120, 50], [100, 60], [120, 60]]");
+    const gfx::RenderingStats fourTiles = render("[[-120, -50], [120, -50], [-120, 50], [120, 50]]");
+
+    // All tiles share one glyph atlas texture, so labels in more tiles don't add textures.
+    EXPECT_EQ(oneTile.numActiveTextures, fourTiles.numActiveTextures);
+    EXPECT_EQ(oneTile.memTextures, fourTiles.memTextures);
+}
+
+TEST(Map, SharedImageAtlasTextures) {
+    // Renders icons at the given coordinates, and pattern-filled squares around them, at zoom 1,
+    // where the four tiles of the world are visible, and returns the rendering stats of the frame.
+    auto render = [](const std::vector<std::array<int, 2>>& coordinates) {
+        const auto point = [](int x, int y) { return "[" + util::toString(x) + ", " + util::toString(y) + "]"; };
+        std::string points;
+        std::string squares;
+        for (const auto& c : coordinates) {
+            const std::string separator = points.empty() ? "" : ", ";
+            points += separator + point(c[0], c[1]);
+            squares += separator + "[[" + point(c[0] - 2, c[1] - 2) + ", " + point(c[0] + 2, c[1] - 2) + ", " +
+                       point(c[0] + 2, c[1] + 2) + ", " + point(c[0] - 2, c[1] + 2) + ", " +
+                       point(c[0] - 2, c[1] - 2) + "]]";
+        }
+
+        MapTest<> test;
+        test.map.getStyle().loadJSON(R"STYLE({
+          "version": 8,
+          "sources": {
+            "points": { "type": "geojson", "data": { "type": "MultiPoint", "coordinates": [)STYLE" +
+                                     points + R"STYLE(] } },
+            "squares": { "type": "geojson", "data": { "type": "MultiPolygon", "coordinates": [)STYLE" +
+                                     squares + R"STYLE(] } }
+          },
+          "layers": [
+            { "id": "squares", "type": "fill", "source": "squares", "paint": { "fill-pattern": "pattern" } },
+            { "id": "icons", "type": "symbol", "source": "points", "layout": { "icon-image": "icon" } }
+          ]
+        })STYLE");
+        test.map.getStyle().addImage(std::make_unique<style::Image>("icon", PremultipliedImage({ 16, 16 }), 1.0f));
+        test.map.getStyle().addImage(std::make_unique<style::Image>("pattern", PremultipliedImage({ 8, 8 }), 1.0f));
+        test.map.jumpTo(CameraOptions().withCenter(LatLng{0, 0}).withZoom(1));
+        return test.frontend.render(test.map).stats;
+    };
+
+    // The points are far enough from the tile edges that each tile holds only its own.
+    const gfx::RenderingStats oneTile = render({{{100, 50}}, {{120, 50}}, {{100, 60}}, {{120, 60}}});
+    const gfx::RenderingStats fourTiles = render({{{-120, -50}}, {{120, -50}}, {{-120, 50}}, {{120, 50}}});
+
+    // All tiles share one icon and pattern atlas texture, so icons and patterns in more tiles don't
+    // add textures.
+    EXPECT_EQ(oneTile.numActiveTextures, fourTiles.numActiveTextures);
+    EXPECT_EQ(oneTile.memTextures, fourTiles.memTextures);
+}
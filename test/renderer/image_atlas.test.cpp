@@ -0,0 +1,97 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/renderer/image_atlas.hpp>
+
+using namespace mbgl;
+
+namespace {
+
+Immutable<style::Image::Impl> makeImage(const std::string& id, uint32_t size, float pixelRatio = 1) {
+    return makeMutable<style::Image::Impl>(id, PremultipliedImage({ size, size }), pixelRatio);
+}
+
+} // namespace
+
+TEST(ImageAtlas, SharesImages) {
+    auto atlas = std::make_shared<ImageAtlas>();
+    auto one = makeImage("one", 16);
+    auto two = makeImage("two", 16);
+
+    auto first = atlas->addImages({{ "one", one }}, {{ "two", two }});
+    auto second = atlas->addImages({{ "one", one }, { "two", two }}, {});
+
+    EXPECT_EQ(first->iconPositions.at("one").textureRect, second->iconPositions.at("one").textureRect);
+    // Icons and patterns are padded differently, so they are packed separately.
+    EXPECT_FALSE(first->patternPositions.at("two").textureRect == second->iconPositions.at("two").textureRect);
+    EXPECT_EQ(Rect<uint16_t>(1, 1, 16, 16), first->iconPositions.at("one").textureRect);
+    EXPECT_EQ(Size(128, 128), atlas->getSize());
+}
+
+TEST(ImageAtlas, UpdatesImages) {
+    auto atlas = std::make_shared<ImageAtlas>();
+    auto one = makeImage("one", 16, 2);
+
+    auto reference = atlas->addImages({{ "one", one }}, {});
+    const ImagePosition position = reference->iconPositions.at("one");
+    EXPECT_EQ(8, position.displaySize()[0]);
+
+    // Images of the same size keep their position, even for tiles that hold the old image.
+    atlas->updateImage(makeImage("one", 16, 2));
+    EXPECT_EQ(position.textureRect, atlas->addImages({{ "one", one }}, {})->iconPositions.at("one").textureRect);
+
+    // Other images get a new position, and the old one is kept until it is released.
+    atlas->updateImage(makeImage("one", 16, 1));
+    auto updated = atlas->addImages({{ "one", one }}, {});
+    EXPECT_FALSE(position.textureRect == updated->iconPositions.at("one").textureRect);
+    EXPECT_EQ(16, updated->iconPositions.at("one").displaySize()[0]);
+
+    reference.reset();
+    auto other = atlas->addImages({{ "other", makeImage("other", 16) }}, {});
+    EXPECT_EQ(position.textureRect, other->iconPositions.at("other").textureRect);
+}
+
+TEST(ImageAtlas, RemovesImages) {
+    auto atlas = std::make_shared<ImageAtlas>();
+
+    auto reference = atlas->addImages({{ "one", makeImage("one", 16) }}, {});
+    const Rect<uint16_t> rect = reference->iconPositions.at("one").textureRect;
+    atlas->removeImage("one");
+
+    // The space of removed images is reused once no tile references them.
+    auto two = atlas->addImages({{ "two", makeImage("two", 16) }}, {});
+    EXPECT_FALSE(rect == two->iconPositions.at("two").textureRect);
+
+    reference.reset();
+    auto three = atlas->addImages({{ "three", makeImage("three", 16) }}, {});
+    EXPECT_EQ(rect, three->iconPositions.at("three").textureRect);
+}
+
+TEST(ImageAtlas, EvictsUnusedImages) {
+    // Fits four images.
+    auto atlas = std::make_shared<ImageAtlas>(36);
+    auto add = [&](const std::string& id, uint32_t size = 16) {
+        return atlas->addImages({{ id, makeImage(id, size) }}, {});
+    };
+
+    auto a = add("a");
+    auto b = add("b");
+    auto c = add("c");
+    auto d = add("d");
+    const Rect<uint16_t> rectA = a->iconPositions.at("a").textureRect;
+    const Rect<uint16_t> rectC = c->iconPositions.at("c").textureRect;
+    a.reset();
+    c.reset();
+
+    // Unused images stay in the atlas until their space is needed.
+    a = add("a");
+    EXPECT_EQ(rectA, a->iconPositions.at("a").textureRect);
+
+    // Then they are evicted least recently used first, but images that are referenced stay.
+    auto e = add("e");
+    EXPECT_EQ(rectC, e->iconPositions.at("e").textureRect);
+
+    // Images that don't fit into an atlas of the maximum size are left out.
+    auto large = add("large", 40);
+    EXPECT_TRUE(large->iconPositions.empty());
+    EXPECT_EQ(Size(36, 36), atlas->getSize());
+}
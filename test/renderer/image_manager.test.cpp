@@ -2,6 +2,7 @@
 #include <mbgl/test/fixture_log_observer.hpp>
 #include <mbgl/test/stub_style_observer.hpp>
 
+#include <mbgl/renderer/image_atlas.hpp>
 #include <mbgl/renderer/image_manager.hpp>
 #include <mbgl/renderer/image_manager_observer.hpp>
 #include <mbgl/sprite/sprite_parser.hpp>
@@ -54,12 +55,22 @@ TEST(ImageManager, Update) {
     FixtureLog log;
     ImageManager imageManager;
 
-    imageManager.addImage(makeMutable<style::Image::Impl>("one", PremultipliedImage({ 16, 16 }), 2));
-    EXPECT_EQ(0, imageManager.updatedImageVersions.size());
-    imageManager.updateImage(makeMutable<style::Image::Impl>("one", PremultipliedImage({ 16, 16 }), 2));
-    EXPECT_EQ(1, imageManager.updatedImageVersions.size());
+    Immutable<style::Image::Impl> one = makeMutable<style::Image::Impl>("one", PremultipliedImage({ 16, 16 }), 2);
+    imageManager.addImage(one);
+    auto reference = imageManager.getAtlas()->addImages({{ "one", one }}, {});
+    const Rect<uint16_t> rect = reference->iconPositions.at("one").textureRect;
+
+    // Images of the same size are redrawn in place.
+    EXPECT_FALSE(imageManager.updateImage(makeMutable<style::Image::Impl>("one", PremultipliedImage({ 16, 16 }), 2)));
+    EXPECT_EQ(rect, imageManager.getAtlas()->addImages({{ "one", one }}, {})->iconPositions.at("one").textureRect);
+
+    // Images of another size get a new position once the tiles are laid out again.
+    EXPECT_TRUE(imageManager.updateImage(makeMutable<style::Image::Impl>("one", PremultipliedImage({ 24, 24 }), 2)));
+    auto updated = imageManager.getAtlas()->addImages({{ "one", one }}, {});
+    EXPECT_EQ(24, updated->iconPositions.at("one").textureRect.w);
+    EXPECT_EQ(16, reference->iconPositions.at("one").textureRect.w);
+
     imageManager.removeImage("one");
-    EXPECT_EQ(0, imageManager.updatedImageVersions.size());
 }
 
 TEST(ImageManager, RemoveReleasesBinPackRect) {
@@ -80,11 +91,11 @@ class StubImageRequestor : public ImageRequestor {
 public:
     StubImageRequestor(ImageManager& imageManager_) : ImageRequestor(imageManager_) {}
 
-    void onImagesAvailable(ImageMap icons, ImageMap patterns, std::unordered_map<std::string, uint32_t> versionMap, uint64_t imageCorrelationID_) final {
-        if (imagesAvailable && imageCorrelationID == imageCorrelationID_) imagesAvailable(icons, patterns, versionMap);
+    void onImagesAvailable(ImageMap icons, ImageMap patterns, uint64_t imageCorrelationID_) final {
+        if (imagesAvailable && imageCorrelationID == imageCorrelationID_) imagesAvailable(icons, patterns);
     }
 
-    std::function<void (ImageMap, ImageMap, std::unordered_map<std::string, uint32_t>)> imagesAvailable;
+    std::function<void (ImageMap, ImageMap)> imagesAvailable;
     uint64_t imageCorrelationID = 0;
 };
 
@@ -97,7 +108,7 @@ TEST(ImageManager, NotifiesRequestorWhenSpriteIsLoaded) {
     ImageManagerObserver observer;
     imageManager.setObserver(&observer);
 
-    requestor.imagesAvailable = [&] (ImageMap, ImageMap, std::unordered_map<std::string, uint32_t>) {
+    requestor.imagesAvailable = [&] (ImageMap, ImageMap) {
         notified = true;
     };
 
@@ -122,7 +133,7 @@ TEST(ImageManager, NotifiesRequestorImmediatelyIfDependenciesAreSatisfied) {
     StubImageRequestor requestor(imageManager);
     bool notified = false;
 
-    requestor.imagesAvailable = [&] (ImageMap, ImageMap, std::unordered_map<std::string, uint32_t>) {
+    requestor.imagesAvailable = [&] (ImageMap, ImageMap) {
         notified = true;
     };
 
@@ -162,7 +173,7 @@ TEST(ImageManager, OnStyleImageMissingBeforeSpriteLoaded) {
 
     bool notified = false;
 
-    requestor.imagesAvailable = [&] (ImageMap, ImageMap, std::unordered_map<std::string, uint32_t>) {
+    requestor.imagesAvailable = [&] (ImageMap, ImageMap) {
         notified = true;
     };
 
@@ -217,7 +228,7 @@ TEST(ImageManager, OnStyleImageMissingAfterSpriteLoaded) {
 
     bool notified = false;
 
-    requestor.imagesAvailable = [&] (ImageMap, ImageMap, std::unordered_map<std::string, uint32_t>) {
+    requestor.imagesAvailable = [&] (ImageMap, ImageMap) {
         notified = true;
     };
 
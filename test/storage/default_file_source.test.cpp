@@ -3,7 +3,9 @@
 #include <mbgl/storage/network_status.hpp>
 #include <mbgl/storage/resource_transform.hpp>
 #include <mbgl/test/util.hpp>
+#include <mbgl/util/io.hpp>
 #include <mbgl/util/run_loop.hpp>
+#include <mbgl/util/string.hpp>
 
 using namespace mbgl;
 
@@ -308,6 +310,42 @@ TEST(DefaultFileSource, OptionalExpired) {
     loop.run();
 }
 
+TEST(DefaultFileSource, TEST_REQUIRES_WRITE(OptionalFromReadOnlyConnections)) {
+    util::RunLoop loop;
+    util::deleteFile("test/fixtures/offline_database/offline.db");
+    DefaultFileSource fs("test/fixtures/offline_database/offline.db", ".");
+
+    using namespace std::chrono_literals;
+
+    // Lookups of a database stored in a file are served by a pool of read-only connections.
+    const unsigned count = 20;
+    std::vector<Resource> resources;
+    for (unsigned i = 0; i < count; ++i) {
+        resources.push_back({ Resource::Unknown, "http://127.0.0.1:3000/test" + util::toString(i), {}, Resource::LoadingMethod::CacheOnly });
+
+        Response response;
+        response.data = std::make_shared<std::string>("Cached value " + util::toString(i));
+        response.expires = util::now() + 1h;
+        fs.put(resources.back(), response);
+    }
+
+    std::vector<std::unique_ptr<AsyncRequest>> reqs(count);
+    unsigned responses = 0;
+    for (unsigned i = 0; i < count; ++i) {
+        reqs[i] = fs.request(resources[i], [&, i](Response res) {
+            reqs[i].reset();
+            EXPECT_EQ(nullptr, res.error);
+            ASSERT_TRUE(res.data.get());
+            EXPECT_EQ("Cached value " + util::toString(i), *res.data);
+            if (++responses == count) {
+                loop.stop();
+            }
+        });
+    }
+
+    loop.run();
+}
+
 TEST(DefaultFileSource, GetBaseURLAndAccessTokenWhilePaused) {
     util::RunLoop loop;
     DefaultFileSource fs(":memory:", ".");
@@ -92,6 +92,14 @@ static std::vector<std::string> databaseTableColumns(const std::string& path, co
     return columns;
 }
 
+static int64_t databaseTileAccessed(const std::string& path) {
+    mapbox::sqlite::Database db = mapbox::sqlite::Database::open(path, mapbox::sqlite::ReadOnly);
+    mapbox::sqlite::Statement stmt{ db, "select accessed from tiles" };
+    mapbox::sqlite::Query query{ stmt };
+    query.run();
+    return query.get<int64_t>(0);
+}
+
 static int databaseAutoVacuum(const std::string& path) {
     mapbox::sqlite::Database db = mapbox::sqlite::Database::open(path, mapbox::sqlite::ReadOnly);
     mapbox::sqlite::Statement stmt{db, "pragma auto_vacuum"};
@@ -146,7 +154,6 @@ TEST(OfflineDatabase, TEST_REQUIRES_WRITE(CreateFail)) {
     // We can also still "query" the database even though it is not open, and we will always get an empty result.
     for (const auto& res : { fixture::resource, fixture::tile }) {
         EXPECT_FALSE(bool(db.get(res)));
-        EXPECT_EQ(1u, log.count(warning(ResultCode::CantOpen, "Can't update timestamp: unable to open database file")));
         EXPECT_EQ(1u, log.count(warning(ResultCode::CantOpen, "Can't read resource: unable to open database file")));
         EXPECT_EQ(0u, log.uncheckedCount());
     }
@@ -163,13 +170,12 @@ TEST(OfflineDatabase, TEST_REQUIRES_WRITE(CreateFail)) {
     }
 
     // Next, set the file system to read only mode and try to read the data again. While we can't
-    // write anymore, we should still be able to read, and the query that tries to update the last
-    // accessed timestamp may fail without crashing.
+    // write anymore, we should still be able to read. The last accessed timestamps are only
+    // written later on, so reading doesn't produce any warnings.
     fs.allowFileCreate(false);
     fs.setWriteLimit(0);
     for (const auto& res : { fixture::resource, fixture::tile }) {
         auto result = db.get(res);
-        EXPECT_EQ(1u, log.count(warning(ResultCode::CantOpen, "Can't update timestamp: unable to open database file")));
         EXPECT_EQ(0u, log.uncheckedCount());
 
         ASSERT_TRUE(result && result->data);
@@ -178,13 +184,11 @@ TEST(OfflineDatabase, TEST_REQUIRES_WRITE(CreateFail)) {
     fs.setDebug(false);
 
     // We're allowing SQLite to create a journal file, but restrict the number of bytes it
-    // can write so that it can start writing the journal file, but eventually fails during the
-    // timestamp update.
+    // can write so that it can start writing the journal file.
     fs.allowFileCreate(true);
     fs.setWriteLimit(8192);
     for (const auto& res : { fixture::resource, fixture::tile }) {
         auto result = db.get(res);
-        EXPECT_EQ(1u, log.count(warning(ResultCode::Full, "Can't update timestamp: database or disk is full")));
         EXPECT_EQ(0u, log.uncheckedCount());
         ASSERT_TRUE(result && result->data);
         EXPECT_EQ("first", *result->data);
@@ -197,7 +201,6 @@ TEST(OfflineDatabase, TEST_REQUIRES_WRITE(CreateFail)) {
     for (const auto& res : { fixture::resource, fixture::tile }) {
         // First, try reading.
         auto result = db.get(res);
-        EXPECT_EQ(1u, log.count(warning(ResultCode::Auth, "Can't update timestamp: authorization denied")));
         EXPECT_EQ(1u, log.count(warning(ResultCode::Auth, "Can't read resource: authorization denied")));
         EXPECT_EQ(0u, log.uncheckedCount());
         EXPECT_FALSE(result);
@@ -227,7 +230,7 @@ TEST(OfflineDatabase, TEST_REQUIRES_WRITE(SchemaVersion)) {
         OfflineDatabase db(filename);
     }
 
-    EXPECT_EQ(6, databaseUserVersion(filename));
+    EXPECT_EQ(7, databaseUserVersion(filename));
 
     OfflineDatabase db(filename);
     // Now try inserting and reading back to make sure we have a valid database.
@@ -1051,6 +1054,51 @@ TEST(OfflineDatabase, PutReturnsSize) {
     EXPECT_EQ(0u, log.uncheckedCount());
 }
 
+TEST(OfflineDatabase, TEST_REQUIRES_WRITE(PutCompressesTilesWithDictionary)) {
+    FixtureLog log;
+    deleteDatabaseFiles();
+
+    // The tiles share most of their content, which is random, so that they only compress well
+    // with a dictionary trained on the first of them.
+    auto tileData = [](int32_t x) {
+        std::string data = *randomString(2048);
+        std::mt19937 random(x);
+        for (size_t i = 0; i < 256; i++) {
+            data.push_back(random());
+        }
+        return data;
+    };
+    auto tile = [](int32_t x) {
+        return Resource::tile("http://example.com/{z}/{x}/{y}.pbf", 1, x, 0, 5, Tileset::Scheme::XYZ);
+    };
+
+    {
+        OfflineDatabase db(filename);
+        for (int32_t x = 0; x < 32; x++) {
+            Response response;
+            response.data = std::make_shared<std::string>(tileData(x));
+            const uint64_t size = db.put(tile(x), response).second;
+            if (x < 15) {
+                EXPECT_EQ(response.data->size(), size) << x;
+            } else {
+                EXPECT_GT(512u, size) << x;
+            }
+        }
+    }
+
+    // The dictionary is read back from the database.
+    {
+        OfflineDatabase db(filename);
+        for (int32_t x = 0; x < 32; x++) {
+            auto result = db.get(tile(x));
+            ASSERT_TRUE(result && result->data) << x;
+            EXPECT_EQ(tileData(x), *result->data) << x;
+        }
+    }
+
+    EXPECT_EQ(0u, log.uncheckedCount());
+}
+
 TEST(OfflineDatabase, PutEvictsLeastRecentlyUsedResources) {
     FixtureLog log;
     OfflineDatabase db(":memory:");
@@ -1070,6 +1118,33 @@ TEST(OfflineDatabase, PutEvictsLeastRecentlyUsedResources) {
     EXPECT_EQ(0u, log.uncheckedCount());
 }
 
+TEST(OfflineDatabase, TEST_REQUIRES_WRITE(GetDefersAccessedTimestamp)) {
+    FixtureLog log;
+    deleteDatabaseFiles();
+
+    {
+        OfflineDatabase db(filename);
+        EXPECT_EQ(std::make_pair(true, uint64_t(5)), db.put(fixture::tile, fixture::response));
+    }
+    {
+        mapbox::sqlite::Database db = mapbox::sqlite::Database::open(filename, mapbox::sqlite::ReadWriteCreate);
+        db.exec("UPDATE tiles SET accessed = 0");
+    }
+
+    {
+        OfflineDatabase db(filename);
+        EXPECT_TRUE(bool(db.get(fixture::tile)));
+
+        // Reading the tile doesn't write its accessed timestamp right away.
+        EXPECT_EQ(0, databaseTileAccessed(filename));
+    }
+
+    // The timestamp is written when the database is closed at the latest.
+    EXPECT_LT(0, databaseTileAccessed(filename));
+
+    EXPECT_EQ(0u, log.uncheckedCount());
+}
+
 TEST(OfflineDatabase, PutRegionResourceDoesNotEvict) {
     FixtureLog log;
     OfflineDatabase db(":memory:");
@@ -1351,7 +1426,7 @@ TEST(OfflineDatabase, MigrateFromV2Schema) {
         }
     }
 
-    EXPECT_EQ(6, databaseUserVersion(filename));
+    EXPECT_EQ(7, databaseUserVersion(filename));
     EXPECT_LT(databasePageCount(filename),
               databasePageCount("test/fixtures/offline_database/v2.db"));
 
@@ -1374,7 +1449,7 @@ TEST(OfflineDatabase, MigrateFromV3Schema) {
         }
     }
 
-    EXPECT_EQ(6, databaseUserVersion(filename));
+    EXPECT_EQ(7, databaseUserVersion(filename));
 
     EXPECT_EQ(0u, log.uncheckedCount());
 }
@@ -1395,7 +1470,7 @@ TEST(OfflineDatabase, MigrateFromV4Schema) {
         }
     }
 
-    EXPECT_EQ(6, databaseUserVersion(filename));
+    EXPECT_EQ(7, databaseUserVersion(filename));
 
     // Journal mode should be DELETE after migration to v5.
     EXPECT_EQ("delete", databaseJournalMode(filename));
@@ -1423,7 +1498,7 @@ TEST(OfflineDatabase, MigrateFromV5Schema) {
         }
     }
 
-    EXPECT_EQ(6, databaseUserVersion(filename));
+    EXPECT_EQ(7, databaseUserVersion(filename));
 
     EXPECT_EQ((std::vector<std::string>{"id",
                                         "url_template",
@@ -1480,7 +1555,7 @@ TEST(OfflineDatabase, DowngradeSchema) {
         db.setMaximumAmbientCacheSize(0);
     }
 
-    EXPECT_EQ(6, databaseUserVersion(filename));
+    EXPECT_EQ(7, databaseUserVersion(filename));
 
     EXPECT_EQ((std::vector<std::string>{ "id", "url_template", "pixel_ratio", "z", "x", "y",
                                          "expires", "modified", "etag", "data", "compressed",
@@ -1565,7 +1640,6 @@ TEST(OfflineDatabase, TEST_REQUIRES_WRITE(DisallowedIO)) {
     fs.allowIO(false);
 
     EXPECT_EQ(nullopt, db.get(fixture::resource));
-    EXPECT_EQ(1u, log.count(warning(ResultCode::Auth, "Can't update timestamp: authorization denied")));
     EXPECT_EQ(1u, log.count(warning(ResultCode::Auth, "Can't read resource: authorization denied")));
     EXPECT_EQ(0u, log.uncheckedCount());
 
@@ -1586,7 +1660,6 @@ TEST(OfflineDatabase, TEST_REQUIRES_WRITE(DisallowedIO)) {
     EXPECT_EQ(0u, log.uncheckedCount());
 
     EXPECT_EQ(nullopt, db.getRegionResource(fixture::resource));
-    EXPECT_EQ(1u, log.count(warning(ResultCode::Auth, "Can't update timestamp: authorization denied")));
     EXPECT_EQ(1u, log.count(warning(ResultCode::Auth, "Can't read region resource: authorization denied")));
     EXPECT_EQ(0u, log.uncheckedCount());
 
@@ -1770,6 +1843,77 @@ TEST(OfflineDatabase, MergeDatabaseWithMultipleRegionsWithOverlap) {
     }
 }
 
+TEST(OfflineDatabase, TEST_REQUIRES_WRITE(MergeDatabaseWithCollidingDictionary)) {
+    FixtureLog log;
+    deleteDatabaseFiles();
+    util::deleteFile(filename_sideload);
+
+    // Tiles that are compressed with a dictionary, as in PutCompressesTilesWithDictionary.
+    auto tileData = [](int32_t x) {
+        std::string data = *randomString(2048);
+        std::mt19937 random(x);
+        for (size_t i = 0; i < 256; i++) {
+            data.push_back(random());
+        }
+        return data;
+    };
+    auto tile = [](int32_t x) {
+        return Resource::tile("http://example.com/{z}/{x}/{y}.pbf", 1, x, 0, 5, Tileset::Scheme::XYZ);
+    };
+
+    {
+        OfflineDatabase side(filename_sideload);
+        OfflineTilePyramidRegionDefinition definition{
+            "http://example.com/style", LatLngBounds::hull({1, 2}, {3, 4}), 5, 6, 1.0, false};
+        auto region = side.createRegion(definition, {});
+        ASSERT_TRUE(region);
+        for (int32_t x = 0; x < 32; x++) {
+            Response response;
+            response.data = std::make_shared<std::string>(tileData(x));
+            side.putRegionResource(region->getID(), tile(x), response);
+        }
+    }
+
+    int64_t dictionaryID;
+    {
+        mapbox::sqlite::Database side =
+            mapbox::sqlite::Database::open(filename_sideload, mapbox::sqlite::ReadOnly);
+        mapbox::sqlite::Statement stmt{ side, "SELECT id FROM dictionaries" };
+        mapbox::sqlite::Query query{ stmt };
+        ASSERT_TRUE(query.run());
+        dictionaryID = query.get<int64_t>(0);
+    }
+
+    // Another dictionary with the same ID is in the main database already.
+    {
+        OfflineDatabase db(filename);
+    }
+    {
+        mapbox::sqlite::Database db = mapbox::sqlite::Database::open(filename, mapbox::sqlite::ReadWriteCreate);
+        mapbox::sqlite::Statement stmt{ db, "INSERT INTO dictionaries (id, url_template, data) VALUES (?1, ?2, ?3)" };
+        mapbox::sqlite::Query query{ stmt };
+        const std::string otherDictionary = "another dictionary";
+        query.bind(1, dictionaryID);
+        query.bind(2, std::string("http://example.com/other/{z}/{x}/{y}.pbf"));
+        query.bindBlob(3, otherDictionary.data(), otherDictionary.size());
+        query.run();
+    }
+
+    OfflineDatabase db(filename);
+    auto result = db.mergeDatabase(filename_sideload);
+    ASSERT_TRUE(result);
+    EXPECT_EQ(1u, result->size());
+
+    // The merged tiles don't refer to the other dictionary.
+    for (int32_t x = 0; x < 32; x++) {
+        auto merged = db.get(tile(x));
+        ASSERT_TRUE(merged && merged->data) << x;
+        EXPECT_EQ(tileData(x), *merged->data) << x;
+    }
+
+    EXPECT_EQ(0u, log.uncheckedCount());
+}
+
 TEST(OfflineDatabase, MergeDatabaseWithSingleRegionTooManyNewTiles) {
     FixtureLog log;
     util::deleteFile(filename_sideload);
@@ -0,0 +1,111 @@
+#include <mbgl/storage/tile_archive_file_source.hpp>
+#include <mbgl/storage/resource.hpp>
+#include <mbgl/style/conversion/json.hpp>
+#include <mbgl/style/conversion/tileset.hpp>
+#include <mbgl/util/run_loop.hpp>
+
+#include <gtest/gtest.h>
+
+using namespace mbgl;
+
+namespace {
+
+Response requestSync(FileSource& fs, const Resource& resource) {
+    util::RunLoop loop;
+    Response response;
+    std::unique_ptr<AsyncRequest> req = fs.request(resource, [&](Response res) {
+        req.reset();
+        response = res;
+        loop.stop();
+    });
+    loop.run();
+    return response;
+}
+
+} // namespace
+
+TEST(TileArchiveFileSource, AcceptsURL) {
+    EXPECT_TRUE(TileArchiveFileSource::acceptsURL("mbtiles:///path/to/archive.mbtiles"));
+    EXPECT_TRUE(TileArchiveFileSource::acceptsURL("pmtiles://archive.pmtiles/1/2/3"));
+    EXPECT_FALSE(TileArchiveFileSource::acceptsURL("file:///archive.mbtiles"));
+    EXPECT_FALSE(TileArchiveFileSource::acceptsURL("mbtiles:"));
+    EXPECT_FALSE(TileArchiveFileSource::acceptsURL(""));
+}
+
+TEST(TileArchiveFileSource, MBTiles) {
+    TileArchiveFileSource fs;
+    const std::string url = "mbtiles://test/fixtures/storage/archive.mbtiles";
+
+    Response source = requestSync(fs, Resource::source(url));
+    ASSERT_EQ(nullptr, source.error);
+    ASSERT_TRUE(source.data.get());
+
+    style::conversion::Error error;
+    optional<Tileset> tileset = style::conversion::convertJSON<Tileset>(*source.data, error);
+    ASSERT_TRUE(bool(tileset)) << error.message;
+    ASSERT_EQ(1u, tileset->tiles.size());
+    EXPECT_EQ(url + "/{z}/{x}/{y}", tileset->tiles[0]);
+    EXPECT_EQ(Range<uint8_t>(0, 1), tileset->zoomRange);
+    EXPECT_EQ("MBTiles attribution", tileset->attribution);
+
+    // Rows of MBTiles archives are numbered from the south.
+    Response tile = requestSync(fs, Resource::tile(tileset->tiles[0], 1, 0, 0, 1, Tileset::Scheme::XYZ));
+    ASSERT_EQ(nullptr, tile.error);
+    ASSERT_TRUE(tile.data.get());
+    EXPECT_EQ("mbtiles 1/0/0", *tile.data);
+
+    // Compressed tiles are decompressed.
+    Response gzipped = requestSync(fs, Resource::tile(tileset->tiles[0], 1, 1, 0, 1, Tileset::Scheme::XYZ));
+    ASSERT_EQ(nullptr, gzipped.error);
+    ASSERT_TRUE(gzipped.data.get());
+    EXPECT_EQ("mbtiles 1/1/0", *gzipped.data);
+
+    Response zlibbed = requestSync(fs, Resource::tile(tileset->tiles[0], 1, 0, 1, 1, Tileset::Scheme::XYZ));
+    ASSERT_EQ(nullptr, zlibbed.error);
+    ASSERT_TRUE(zlibbed.data.get());
+    EXPECT_EQ("mbtiles 1/0/1", *zlibbed.data);
+
+    Response missing = requestSync(fs, Resource::tile(tileset->tiles[0], 1, 1, 1, 1, Tileset::Scheme::XYZ));
+    EXPECT_EQ(nullptr, missing.error);
+    EXPECT_TRUE(missing.noContent);
+}
+
+TEST(TileArchiveFileSource, PMTiles) {
+    TileArchiveFileSource fs;
+    const std::string url = "pmtiles://test/fixtures/storage/archive.pmtiles";
+
+    Response source = requestSync(fs, Resource::source(url));
+    ASSERT_EQ(nullptr, source.error);
+    ASSERT_TRUE(source.data.get());
+
+    style::conversion::Error error;
+    optional<Tileset> tileset = style::conversion::convertJSON<Tileset>(*source.data, error);
+    ASSERT_TRUE(bool(tileset)) << error.message;
+    ASSERT_EQ(1u, tileset->tiles.size());
+    EXPECT_EQ(url + "/{z}/{x}/{y}", tileset->tiles[0]);
+    EXPECT_EQ(Range<uint8_t>(0, 1), tileset->zoomRange);
+    EXPECT_EQ("PMTiles attribution", tileset->attribution);
+
+    Response root = requestSync(fs, Resource::tile(tileset->tiles[0], 1, 0, 0, 0, Tileset::Scheme::XYZ));
+    ASSERT_EQ(nullptr, root.error);
+    ASSERT_TRUE(root.data.get());
+    EXPECT_EQ("pmtiles 0/0/0", *root.data);
+
+    Response tile = requestSync(fs, Resource::tile(tileset->tiles[0], 1, 0, 0, 1, Tileset::Scheme::XYZ));
+    ASSERT_EQ(nullptr, tile.error);
+    ASSERT_TRUE(tile.data.get());
+    EXPECT_EQ("pmtiles 1/0/0", *tile.data);
+
+    Response missing = requestSync(fs, Resource::tile(tileset->tiles[0], 1, 1, 0, 1, Tileset::Scheme::XYZ));
+    EXPECT_EQ(nullptr, missing.error);
+    EXPECT_TRUE(missing.noContent);
+}
+
+TEST(TileArchiveFileSource, NonExistentArchive) {
+    TileArchiveFileSource fs;
+
+    Response response = requestSync(fs, Resource::source("pmtiles://test/fixtures/storage/does_not_exist.pmtiles"));
+    ASSERT_NE(nullptr, response.error);
+    EXPECT_EQ(Response::Error::Reason::Other, response.error->reason);
+    EXPECT_FALSE(response.data.get());
+}
@@ -0,0 +1,95 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/style/conversion/geojson.hpp>
+#include <mbgl/util/io.hpp>
+
+using namespace mbgl;
+using namespace mbgl::style::conversion;
+
+namespace {
+
+// Parses the text with the streaming reader and with a JSON document, which must agree.
+void expectSameAsDocument(const std::string& json) {
+    Error error;
+    optional<GeoJSON> parsed = parseGeoJSON(json, error);
+    ASSERT_TRUE(bool(parsed)) << error.message;
+    EXPECT_EQ(mapbox::geojson::parse(json), *parsed);
+}
+
+} // namespace
+
+TEST(GeoJSONConversion, Geometries) {
+    expectSameAsDocument(R"JSON({ "type": "Point", "coordinates": [1.5, -2, 100] })JSON");
+    expectSameAsDocument(R"JSON({ "type": "MultiPoint", "coordinates": [[1, 2], [3, 4]] })JSON");
+    expectSameAsDocument(R"JSON({ "type": "LineString", "coordinates": [] })JSON");
+    expectSameAsDocument(R"JSON({ "type": "MultiLineString", "coordinates": [[[1, 2], [3, 4]], [], [[5, 6]]] })JSON");
+    expectSameAsDocument(R"JSON({ "type": "Polygon", "coordinates": [[[0, 0], [0, 1], [1, 1], [0, 0]]] })JSON");
+    expectSameAsDocument(R"JSON({ "type": "MultiPolygon", "coordinates": [[[[0, 0], [0, 1], [1, 0], [0, 0]]], [[[2, 2], [2, 3], [3, 2], [2, 2]], [[2.1, 2.1], [2.2, 2.1], [2.1, 2.2], [2.1, 2.1]]]] })JSON");
+    expectSameAsDocument(R"JSON({ "type": "GeometryCollection", "geometries": [{ "type": "Point", "coordinates": [1, 2] }, { "type": "LineString", "coordinates": [[1, 2], [3, 4]] }] })JSON");
+}
+
+TEST(GeoJSONConversion, Features) {
+    expectSameAsDocument(R"JSON({
+        "type": "FeatureCollection",
+        "features": [{
+            "type": "Feature",
+            "id": 7,
+            "geometry": { "type": "Point", "coordinates": [1, 2] },
+            "properties": { "name": "a", "rank": -3, "area": 1.25, "open": true, "tags": [1, "b", null, { "c": [] }] }
+        }, {
+            "type": "Feature",
+            "id": "second",
+            "geometry": null,
+            "properties": null
+        }, {
+            "type": "Feature",
+            "id": 18446744073709551615,
+            "geometry": { "type": "LineString", "coordinates": [[1, 2], [3, 4]] }
+        }]
+    })JSON");
+}
+
+TEST(GeoJSONConversion, MembersInAnyOrder) {
+    expectSameAsDocument(R"JSON({
+        "features": [{
+            "properties": { "a": 1 },
+            "geometry": { "coordinates": [[1, 2], [3, 4]], "bbox": [1, 2, 3, 4], "type": "LineString" },
+            "crs": { "type": "name", "properties": { "name": "EPSG:4326" } },
+            "type": "Feature"
+        }],
+        "type": "FeatureCollection"
+    })JSON");
+}
+
+TEST(GeoJSONConversion, Errors) {
+    const auto fails = [](const std::string& json) {
+        Error error;
+        return !parseGeoJSON(json, error) && !error.message.empty();
+    };
+
+    EXPECT_TRUE(fails(R"JSON([1, 2])JSON"));
+    EXPECT_TRUE(fails(R"JSON({ "type": "FeatureCollection" )JSON"));
+    EXPECT_TRUE(fails(R"JSON({ "type": "Circle", "coordinates": [1, 2] })JSON"));
+    EXPECT_TRUE(fails(R"JSON({ "type": "Point", "coordinates": [1] })JSON"));
+    EXPECT_TRUE(fails(R"JSON({ "type": "Point", "coordinates": [[1, 2]] })JSON"));
+    EXPECT_TRUE(fails(R"JSON({ "type": "LineString", "coordinates": [[1, 2], ["3", 4]] })JSON"));
+    EXPECT_TRUE(fails(R"JSON({ "type": "Polygon" })JSON"));
+    EXPECT_TRUE(fails(R"JSON({ "type": "Feature", "properties": {} })JSON"));
+    EXPECT_TRUE(fails(R"JSON({ "type": "Feature", "geometry": null, "properties": [] })JSON"));
+    EXPECT_TRUE(fails(R"JSON({ "type": "Feature", "geometry": null, "id": true })JSON"));
+    EXPECT_TRUE(fails(R"JSON({ "type": "FeatureCollection", "features": [{ "type": "Point", "coordinates": [1, 2] }] })JSON"));
+
+    // Invalid members that the type of the object does not use are ignored.
+    Error error;
+    EXPECT_TRUE(bool(parseGeoJSON(R"JSON({ "type": "Point", "coordinates": [1, 2], "features": 3, "id": {} })JSON", error)));
+}
+
+TEST(GeoJSONConversion, File) {
+    Error error;
+    optional<GeoJSON> parsed = parseGeoJSONFile("test/fixtures/supercluster/places.json", error);
+    ASSERT_TRUE(bool(parsed)) << error.message;
+    EXPECT_EQ(mapbox::geojson::parse(util::read_file("test/fixtures/supercluster/places.json")), *parsed);
+
+    EXPECT_FALSE(parseGeoJSONFile("test/fixtures/supercluster/does_not_exist.json", error));
+    EXPECT_FALSE(error.message.empty());
+}
@@ -1,9 +1,11 @@
 #include <mbgl/test/util.hpp>
+#include <mbgl/test/stub_geometry_tile_feature.hpp>
 #include <mbgl/util/io.hpp>
 #include <mbgl/style/conversion_impl.hpp>
 #include <mbgl/util/rapidjson.hpp>
 #include <mbgl/style/rapidjson_conversion.hpp>
 #include <mbgl/style/expression/is_expression.hpp>
+#include <mbgl/style/expression/compiled_expression.hpp>
 
 #include <rapidjson/document.h>
 
@@ -99,3 +101,52 @@ INSTANTIATE_TEST_CASE_P(Expression, ExpressionEqualityTest, ::testing::ValuesIn(
     EXPECT_GT(names.size(), 0u);
     return names;
 }()));
+
+TEST(Expression, CompiledExpression) {
+    const std::vector<std::string> expressions = {
+        R"(["match", ["get", "class"], ["park", "cemetery"], 1, "water", 2, 0])",
+        R"(["match", ["get", "rank"], [1, 2], "low", 3, "mid", "high"])",
+        R"(["step", ["number", ["get", "rank"], 0], "a", 5, "b", 10, "c"])",
+        R"(["interpolate", ["linear"], ["zoom"], 10, ["*", ["number", ["get", "rank"]], 2], 15, 100])",
+        R"(["interpolate", ["exponential", 2], ["get", "rank"], 0, ["to-color", "red"], 10, ["to-color", "blue"]])",
+        R"(["all", ["==", ["get", "class"], "park"], [">=", ["get", "rank"], 3]])",
+        R"(["any", ["!", ["has", "name"]], ["!=", ["get", "rank"], ["+", 1, 2]]])",
+        R"(["case", ["has", "name"], ["coalesce", ["get", "name_en"], ["get", "name"]], "none"])",
+        R"(["<", ["get", "name"], ["get", "class"]])",
+        R"(["string", ["get", "rank"]])",
+    };
+
+    const std::vector<PropertyMap> features = {
+        {{"class", std::string("park")}, {"rank", 5.0}, {"name", std::string("Park")}, {"name_en", std::string("Park EN")}},
+        {{"class", std::string("water")}, {"rank", int64_t(3)}, {"name", std::string("Lake")}},
+        {{"class", std::string("cemetery")}, {"rank", uint64_t(12)}, {"name_en", NullValue()}},
+        {{"class", true}, {"rank", 2.5}, {"name", int64_t(1)}},
+        {},
+    };
+
+    for (const auto& json : expressions) {
+        JSDocument document;
+        document.Parse<0>(json.c_str());
+        expression::ParsingContext ctx;
+        expression::ParseResult parsed = ctx.parseExpression(conversion::Convertible(&document));
+        ASSERT_TRUE(parsed) << json;
+
+        const std::shared_ptr<const expression::Expression> tree = std::move(*parsed);
+        const auto compiled = expression::CompiledExpression::compile(tree);
+        ASSERT_TRUE(compiled) << json;
+
+        for (const auto& properties : features) {
+            StubGeometryTileFeature feature(properties);
+            const expression::EvaluationContext context(12.5f, &feature);
+            const expression::EvaluationResult expected = tree->evaluate(context);
+            const expression::EvaluationResult actual = compiled->evaluate(context);
+            ASSERT_EQ(bool(expected), bool(actual)) << json;
+            if (expected) {
+                EXPECT_EQ(*expected, *actual) << json;
+            } else {
+                // Errors are reported by the expression tree, so the messages are identical.
+                EXPECT_EQ(expected.error().message, actual.error().message) << json;
+            }
+        }
+    }
+}
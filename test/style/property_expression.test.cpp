@@ -68,6 +68,41 @@ TEST(PropertyExpression, Defaults) {
         .evaluate(oneString, 2.0f));
 }
 
+TEST(PropertyExpression, EvaluateFeatures) {
+    const std::vector<const GeometryTileFeature*> features = {
+        &oneInteger, &oneDouble, &oneString, &emptyTileFeature, nullptr};
+
+    const PropertyExpression<float> numberExpression(
+        interpolate(linear(), number(get("property")), 0.0, literal(0.0), 2.0, literal(10.0)), 3.0f);
+    const PropertyExpression<float> zoomExpression(
+        interpolate(linear(), zoom(),
+            10.0, interpolate(linear(), number(get("property")), 0.0, literal(0.0), 2.0, literal(10.0)),
+            20.0, literal(20.0)));
+    const PropertyExpression<Color> colorExpression(
+        interpolate(linear(), number(get("property")), 0.0, literal(Color::red()), 2.0, literal(Color::blue())));
+    const PropertyExpression<std::string> stringExpression(string(get("property")));
+
+    // Evaluating the features at once gives the same results as evaluating them one by one,
+    // including the defaults of the features that fail to evaluate.
+    auto expectEqualResults = [&](const auto& expression, const EvaluationContext& context, auto finalDefaultValue) {
+        const auto results = expression.evaluate(context, features, finalDefaultValue);
+        ASSERT_EQ(features.size(), results.size());
+        for (std::size_t i = 0; i < features.size(); ++i) {
+            EvaluationContext featureContext = context;
+            featureContext.feature = features[i];
+            EXPECT_EQ(expression.evaluate(featureContext, finalDefaultValue), results[i]) << i;
+        }
+    };
+
+    expectEqualResults(numberExpression, EvaluationContext(), -1.0f);
+    expectEqualResults(zoomExpression, EvaluationContext(15.0f), -1.0f);
+    expectEqualResults(colorExpression, EvaluationContext(), Color::black());
+    expectEqualResults(stringExpression, EvaluationContext(), "default"s);
+
+    EXPECT_EQ(std::vector<float>({5.0f, 5.0f, 3.0f, 3.0f, 3.0f}),
+              numberExpression.evaluate(EvaluationContext(), features, -1.0f));
+}
+
 TEST(PropertyExpression, ZoomInterpolation) {
     EXPECT_EQ(40.0f, PropertyExpression<float>(
         interpolate(linear(), zoom(),
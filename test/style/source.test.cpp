@@ -14,6 +14,7 @@
 #include <mbgl/style/source_impl.hpp>
 #include <mbgl/style/sources/custom_geometry_source.hpp>
 #include <mbgl/style/sources/geojson_source.hpp>
+#include <mbgl/style/sources/geojson_source_impl.hpp>
 #include <mbgl/style/sources/image_source.hpp>
 #include <mbgl/style/sources/raster_dem_source.hpp>
 #include <mbgl/style/sources/raster_source.hpp>
@@ -43,6 +44,7 @@
 #include <mbgl/renderer/image_manager.hpp>
 #include <mbgl/renderer/tile_render_data.hpp>
 #include <mbgl/text/glyph_manager.hpp>
+#include <mbgl/util/constants.hpp>
 
 #include <cstdint>
 #include <gmock/gmock.h>
@@ -72,7 +74,10 @@ public:
                 annotationManager,
                 imageManager,
                 glyphManager,
-                0};
+                0,
+                false,
+                "",
+                util::DEFAULT_TILE_CACHE_SIZE};
     };
 
     SourceTest() {
@@ -878,3 +883,83 @@ TEST(Source, GeoJSONSourceTilesAfterDataReset) {
         .update(source.baseImpl, layers, true, true, test.tileParameters(MapMode::Static));
     EXPECT_TRUE(renderSource.isLoaded()); // Tiles are reset in static mode.
 }
+
+namespace {
+
+GeoJSONFeature makePoint(uint64_t id, double lng, double lat) {
+    GeoJSONFeature feature{mapbox::geometry::point<double>{lng, lat}};
+    feature.id = id;
+    return feature;
+}
+
+} // namespace
+
+TEST(Source, GeoJSONSourceIncrementalUpdates) {
+    SourceTest test;
+    auto options = makeMutable<GeoJSONOptions>();
+    options->incrementalUpdates = true;
+    GeoJSONSource source("source", std::move(options));
+    source.setGeoJSON(FeatureCollection{makePoint(1, -90, 45), makePoint(2, 90, 45)});
+    auto initial = source.impl().getData().lock();
+
+    GeoJSONFeatureChanges changes;
+    changes.removed.push_back(uint64_t(1));
+    changes.changed.push_back(makePoint(2, 100, 45));
+    changes.added.push_back(makePoint(3, 90, -45));
+    source.updateGeoJSON(changes);
+    auto updated = source.impl().getData().lock();
+    ASSERT_NE(initial, updated);
+
+    updated->getTile(CanonicalTileID(0, 0, 0), [&](GeoJSONData::TileFeatures features) {
+        ASSERT_EQ(2u, features.size());
+        EXPECT_EQ(FeatureIdentifier(uint64_t(2)), features[0].id);
+        EXPECT_EQ(FeatureIdentifier(uint64_t(3)), features[1].id);
+        test.end();
+    });
+    test.run();
+
+    // Only tiles overlapping the removed, changed or added features have changed.
+    EXPECT_TRUE(updated->tileChanged(*initial, CanonicalTileID(1, 0, 0)));
+    EXPECT_TRUE(updated->tileChanged(*initial, CanonicalTileID(1, 1, 0)));
+    EXPECT_TRUE(updated->tileChanged(*initial, CanonicalTileID(1, 1, 1)));
+    EXPECT_FALSE(updated->tileChanged(*initial, CanonicalTileID(1, 0, 1)));
+    EXPECT_FALSE(updated->tileChanged(*initial, CanonicalTileID(3, 0, 0)));
+
+    // Tiles of unrelated data are always reloaded.
+    auto unrelated = GeoJSONData::create(FeatureCollection{}, source.impl().getOptions());
+    EXPECT_TRUE(updated->tileChanged(*unrelated, CanonicalTileID(1, 0, 1)));
+}
+
+TEST(Source, GeoJSONSourceChunkedIndex) {
+    SourceTest test;
+
+    // Large enough to be indexed in several chunks, and far enough from the antimeridian that
+    // no feature is wrapped into the root tile twice.
+    FeatureCollection features;
+    for (uint64_t id = 0; id < 50000; ++id) {
+        features.push_back(makePoint(id, double(id * 7919 % 9000) / 100 - 45, double(id * 6271 % 8000) / 100 - 40));
+    }
+    auto data = GeoJSONData::create(features);
+
+    // Features come in the order of the collection, as from a single index.
+    data->getTile(CanonicalTileID(0, 0, 0), [&](GeoJSONData::TileFeatures tileFeatures) {
+        ASSERT_EQ(features.size(), tileFeatures.size());
+        for (uint64_t id = 0; id < tileFeatures.size(); ++id) {
+            ASSERT_EQ(FeatureIdentifier(id), tileFeatures[id].id);
+        }
+        test.end();
+    });
+    test.run();
+}
+
+TEST(Source, GeoJSONSourceIncrementalUpdatesUnsupported) {
+    SourceTest test;
+    GeoJSONSource source("source");
+    source.setGeoJSON(FeatureCollection{makePoint(1, 0, 0)});
+    auto initial = source.impl().getData().lock();
+
+    GeoJSONFeatureChanges changes;
+    changes.removed.push_back(uint64_t(1));
+    source.updateGeoJSON(changes);
+    EXPECT_EQ(initial, source.impl().getData().lock());
+}
@@ -17,7 +17,7 @@ TEST(calculateTileDistances, Line) {
     const GeometryCoordinates line = {
         Point<int16_t>{1, 1}, Point<int16_t>{1, 2}, Point<int16_t>{1, 3}, Point<int16_t>{1, 4}};
     const auto distances = SymbolLayout::calculateTileDistances(line, Anchor(1.0f, 3.0f, .0f, 2u));
-    EXPECT_EQ(distances, std::vector<float>({2.0f, 1.0f, 0.0f, 1.0f}));
+    EXPECT_EQ(distances, util::MonotonicVector<float>({2.0f, 1.0f, 0.0f, 1.0f}));
 }
 
 TEST(calculateTileDistances, EmptySegment) {
@@ -0,0 +1,82 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/text/glyph_atlas.hpp>
+
+using namespace mbgl;
+
+namespace {
+
+constexpr FontStackHash fontStack = 1;
+
+Glyphs makeGlyphs(std::initializer_list<GlyphID> ids, uint32_t size = 14) {
+    Glyphs glyphs;
+    for (GlyphID id : ids) {
+        Glyph glyph;
+        glyph.id = id;
+        glyph.bitmap = AlphaImage({ size, size });
+        glyph.metrics.width = size;
+        glyph.metrics.height = size;
+        glyph.metrics.advance = size;
+        glyphs.emplace(id, makeMutable<Glyph>(std::move(glyph)));
+    }
+    return glyphs;
+}
+
+Rect<uint16_t> rect(const GlyphAtlasReference& reference, GlyphID id) {
+    return reference.positions.at(fontStack).at(id).rect;
+}
+
+} // namespace
+
+TEST(GlyphAtlas, SharesGlyphs) {
+    auto atlas = std::make_shared<GlyphAtlas>();
+
+    auto first = atlas->addGlyphs({{ fontStack, makeGlyphs({ u'a', u'b' }) }});
+    auto second = atlas->addGlyphs({{ fontStack, makeGlyphs({ u'b', u'c' }) }});
+
+    ASSERT_EQ(2u, first->positions.at(fontStack).size());
+    ASSERT_EQ(2u, second->positions.at(fontStack).size());
+    EXPECT_EQ(rect(*first, u'b'), rect(*second, u'b'));
+    EXPECT_FALSE(rect(*first, u'a') == rect(*second, u'c'));
+    EXPECT_EQ(Size(128, 128), atlas->getSize());
+}
+
+TEST(GlyphAtlas, Grows) {
+    auto atlas = std::make_shared<GlyphAtlas>();
+
+    auto small = atlas->addGlyphs({{ fontStack, makeGlyphs({ u'a' }) }});
+    EXPECT_EQ(Size(128, 128), atlas->getSize());
+
+    // Growing keeps the glyphs where they are.
+    auto large = atlas->addGlyphs({{ fontStack, makeGlyphs({ u'b' }, 200) }});
+    EXPECT_EQ(Size(256, 256), atlas->getSize());
+    EXPECT_EQ(Rect<uint16_t>(0, 0, 16, 16), rect(*small, u'a'));
+    EXPECT_EQ(202, rect(*large, u'b').w);
+}
+
+TEST(GlyphAtlas, EvictsUnusedGlyphs) {
+    // Fits four glyphs.
+    auto atlas = std::make_shared<GlyphAtlas>(32);
+
+    auto full = atlas->addGlyphs({{ fontStack, makeGlyphs({ u'a', u'b', u'c', u'd' }) }});
+    const Rect<uint16_t> a = rect(*full, u'a');
+    const Rect<uint16_t> c = rect(*full, u'c');
+    const Rect<uint16_t> d = rect(*full, u'd');
+    full.reset();
+
+    // Unused glyphs stay in the atlas until their space is needed.
+    auto b = atlas->addGlyphs({{ fontStack, makeGlyphs({ u'b' }) }});
+
+    // The least recently used glyph goes first, but glyphs that are still referenced stay.
+    auto e = atlas->addGlyphs({{ fontStack, makeGlyphs({ u'e' }) }});
+    EXPECT_EQ(a, rect(*e, u'e'));
+    auto f = atlas->addGlyphs({{ fontStack, makeGlyphs({ u'f' }) }});
+    EXPECT_EQ(c, rect(*f, u'f'));
+    auto g = atlas->addGlyphs({{ fontStack, makeGlyphs({ u'g' }) }});
+    EXPECT_EQ(d, rect(*g, u'g'));
+
+    // Glyphs that don't fit into an atlas of the maximum size are left out.
+    auto h = atlas->addGlyphs({{ fontStack, makeGlyphs({ u'h' }) }});
+    EXPECT_TRUE(h->positions.at(fontStack).empty());
+    EXPECT_EQ(Size(32, 32), atlas->getSize());
+}
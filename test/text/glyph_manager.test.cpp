@@ -253,6 +253,34 @@ TEST(GlyphManager, LoadLocalCJKGlyph) {
         });
 }
 
+TEST(GlyphManager, LoadLocalAndRemoteGlyphs) {
+    GlyphManagerTest test;
+
+    test.fileSource.glyphsResponse = [&] (const Resource&) {
+        Response response;
+        response.data = std::make_shared<std::string>(util::read_file("test/fixtures/resources/glyphs.pbf"));
+        return response;
+    };
+
+    // The requestor is notified once, when both the rasterized and the parsed glyphs are ready.
+    test.requestor.glyphsAvailable = [&] (GlyphMap glyphs) {
+        const auto& testPositions = glyphs.at(FontStackHasher()({{"Test Stack"}}));
+
+        ASSERT_EQ(testPositions.size(), 2u);
+        ASSERT_TRUE(bool(testPositions.at(u'中')));
+        ASSERT_TRUE(bool(testPositions.at(u'a')));
+        EXPECT_EQ((*testPositions.at(u'中'))->metrics.advance, 24ul);
+
+        test.end();
+    };
+
+    test.run(
+        "test/fixtures/resources/glyphs.pbf",
+        GlyphDependencies {
+            {{{"Test Stack"}}, {u'中', u'a'}}
+        });
+}
+
 TEST(GlyphManager, LoadLocalCJKGlyphAfterLoadingRangeFromURL) {
     GlyphManagerTest test;
     int firstGlyphResponse = false;
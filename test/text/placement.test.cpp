@@ -0,0 +1,245 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/map/transform_state.hpp>
+#include <mbgl/renderer/buckets/symbol_bucket.hpp>
+#include <mbgl/renderer/render_layer.hpp>
+#include <mbgl/renderer/render_tile.hpp>
+#include <mbgl/style/image_impl.hpp>
+#include <mbgl/style/layers/symbol_layer.hpp>
+#include <mbgl/style/layers/symbol_layer_impl.hpp>
+#include <mbgl/style/layers/symbol_layer_properties.hpp>
+#include <mbgl/text/placement.hpp>
+#include <mbgl/text/shaping.hpp>
+#include <mbgl/tile/tile.hpp>
+#include <mbgl/util/constants.hpp>
+#include <mbgl/util/geo.hpp>
+
+#include <algorithm>
+#include <tuple>
+
+using namespace mbgl;
+
+namespace {
+
+class StubTile : public Tile {
+public:
+    explicit StubTile(const OverscaledTileID& tileID) : Tile(Kind::Geometry, tileID) {}
+    std::unique_ptr<TileRenderData> createRenderData() override { return nullptr; }
+    bool layerPropertiesUpdated(const Immutable<style::LayerProperties>&) override { return true; }
+};
+
+// A 16x16 px icon at the given tile coordinates.
+SymbolInstance makeIconInstance(Point<float> point, std::size_t index) {
+    Anchor anchor(point.x, point.y, 0, 0);
+    const ShapedTextOrientations shaping{};
+    const ImagePosition image{mapbox::Bin(-1, 18, 18, 0, 0, 0, 0),
+                              style::Image::Impl("icon", PremultipliedImage({16, 16}), 1.0)};
+    const auto shapedIcon = PositionedIcon::shapeIcon(image, {{0.0f, 0.0f}}, style::SymbolAnchorType::Center, 0);
+    const std::array<float, 2> offset{{0.0f, 0.0f}};
+    const float iconBoxScale = util::EXTENT / util::tileSize;
+
+    auto sharedData = std::make_shared<SymbolInstanceSharedData>(GeometryCoordinates{},
+                                                                 shaping,
+                                                                 nullopt,
+                                                                 nullopt,
+                                                                 style::SymbolLayoutProperties::Evaluated{},
+                                                                 style::SymbolPlacementType::Point,
+                                                                 offset,
+                                                                 ImageMap{},
+                                                                 SymbolContent::IconRGBA,
+                                                                 false);
+    return SymbolInstance(anchor, std::move(sharedData), shaping, shapedIcon, nullopt, 0, 0,
+                          style::SymbolPlacementType::Point, offset, iconBoxScale, 0, offset,
+                          IndexedSubfeature(index, "", "", index), index, index, u"", 1.0f, 0.0f, 0.0f, offset,
+                          false, SymbolContent::IconRGBA);
+}
+
+// A symbol layer with a single tile, holding a bucket of icons.
+class StubSymbolLayer final : public RenderLayer {
+public:
+    StubSymbolLayer(const std::string& id,
+                    const std::string& sourceID,
+                    const std::vector<Point<float>>& icons,
+                    uint32_t& maxCrossTileID)
+        : RenderLayer(makeMutable<style::SymbolLayerProperties>(
+              staticImmutableCast<style::SymbolLayer::Impl>(style::SymbolLayer(id, sourceID).baseImpl))),
+          tile(OverscaledTileID(0, 0, 0)),
+          renderTile(UnwrappedTileID(0, 0, 0), tile) {
+        std::vector<SymbolInstance> instances;
+        for (std::size_t i = 0; i < icons.size(); ++i) {
+            instances.push_back(makeIconInstance(icons[i], i));
+        }
+        bucket = std::make_unique<SymbolBucket>(makeMutable<style::SymbolLayoutProperties::PossiblyEvaluated>(),
+                                                std::map<std::string, Immutable<style::LayerProperties>>{},
+                                                16.0f,
+                                                1.0f,
+                                                0,
+                                                false,
+                                                false,
+                                                id,
+                                                std::move(instances),
+                                                1.0f,
+                                                false,
+                                                std::vector<style::TextWritingModeType>{},
+                                                false);
+        for (auto& instance : bucket->symbolInstances) {
+            instance.crossTileID = ++maxCrossTileID;
+            instance.placedIconIndex = bucket->icon.placedSymbols.size();
+            bucket->icon.placedSymbols.emplace_back(instance.anchor.point,
+                                                    0,
+                                                    1.0f,
+                                                    1.0f,
+                                                    std::array<float, 2>{{0.0f, 0.0f}},
+                                                    WritingModeType::None,
+                                                    GeometryCoordinates{},
+                                                    util::MonotonicVector<float>{});
+        }
+        placementData.push_back({*bucket, renderTile, nullptr});
+    }
+
+    void transition(const TransitionParameters&) override {}
+    void evaluate(const PropertyEvaluationParameters&) override {}
+    bool hasTransition() const override { return false; }
+    bool hasCrossfade() const override { return false; }
+    void render(PaintParameters&) override {}
+
+private:
+    StubTile tile;
+    RenderTile renderTile;
+    std::unique_ptr<SymbolBucket> bucket;
+};
+
+TransformState makeTransformState() {
+    TransformState state;
+    state.setSize({512, 512});
+    state.setLatLngZoom(LatLng{0, 0}, 0);
+    return state;
+}
+
+Immutable<Placement> makeInitialPlacement() {
+    return makeMutable<Placement>(TransformState{}, MapMode::Static, style::TransitionOptions{}, true, nullopt);
+}
+
+// The features in the collision index, as (bucket instance ID, feature index, collision group ID).
+std::vector<std::tuple<uint32_t, std::size_t, uint16_t>> getCollisionIndexContents(const Placement& placement) {
+    const ScreenLineString viewport{{-100, -100}, {612, -100}, {612, 612}, {-100, 612}, {-100, -100}};
+    std::vector<std::tuple<uint32_t, std::size_t, uint16_t>> contents;
+    for (const auto& pair : placement.getCollisionIndex().queryRenderedSymbols(viewport)) {
+        for (const auto& feature : pair.second) {
+            contents.emplace_back(pair.first, feature.index, feature.collisionGroupId);
+        }
+    }
+    std::sort(contents.begin(), contents.end());
+    return contents;
+}
+
+void expectSamePlacement(const Placement& expected, const Placement& actual) {
+    ASSERT_EQ(expected.getPlacements().size(), actual.getPlacements().size());
+    for (const auto& pair : expected.getPlacements()) {
+        auto it = actual.getPlacements().find(pair.first);
+        ASSERT_NE(actual.getPlacements().end(), it);
+        EXPECT_EQ(pair.second.text, it->second.text);
+        EXPECT_EQ(pair.second.icon, it->second.icon);
+        EXPECT_EQ(pair.second.skipFade, it->second.skipFade);
+    }
+
+    ASSERT_EQ(expected.getVariableOffsets().size(), actual.getVariableOffsets().size());
+    for (const auto& pair : expected.getVariableOffsets()) {
+        auto it = actual.getVariableOffsets().find(pair.first);
+        ASSERT_NE(actual.getVariableOffsets().end(), it);
+        EXPECT_EQ(pair.second.offset, it->second.offset);
+        EXPECT_EQ(pair.second.width, it->second.width);
+        EXPECT_EQ(pair.second.height, it->second.height);
+        EXPECT_EQ(pair.second.anchor, it->second.anchor);
+        EXPECT_EQ(pair.second.textBoxScale, it->second.textBoxScale);
+        EXPECT_EQ(pair.second.prevAnchor, it->second.prevAnchor);
+    }
+
+    EXPECT_EQ(expected.getPlacedOrientations(), actual.getPlacedOrientations());
+    EXPECT_EQ(getCollisionIndexContents(expected), getCollisionIndexContents(actual));
+}
+
+} // namespace
+
+TEST(Placement, ReplayedPlacementMatchesFullPlacement) {
+    const TransformState state = makeTransformState();
+    mat4 projMatrix;
+    state.getProjMatrix(projMatrix);
+
+    uint32_t maxCrossTileID = 0;
+    StubSymbolLayer first("first", "source", {{1000, 1000}, {1100, 1000}, {4000, 4000}}, maxCrossTileID);
+    StubSymbolLayer second("second", "source", {{1050, 1050}, {6000, 2000}}, maxCrossTileID);
+
+    const auto place = [&](Immutable<Placement> prevPlacement) -> Immutable<Placement> {
+        auto placement = makeMutable<Placement>(
+            state, MapMode::Continuous, style::TransitionOptions{}, true, std::move(prevPlacement));
+        placement->placeLayer(first, projMatrix, false);
+        placement->placeLayer(second, projMatrix, false);
+        return Immutable<Placement>(std::move(placement));
+    };
+
+    const Immutable<Placement> initial = makeInitialPlacement();
+    const Immutable<Placement> prev = place(initial);
+
+    // The overlapping icons collide with the icon placed before them.
+    EXPECT_TRUE(prev->getPlacements().at(1).icon);
+    EXPECT_FALSE(prev->getPlacements().at(2).icon);
+    EXPECT_TRUE(prev->getPlacements().at(3).icon);
+    EXPECT_FALSE(prev->getPlacements().at(4).icon);
+    EXPECT_TRUE(prev->getPlacements().at(5).icon);
+
+    // The camera differs from the initial placement, so the previous placement kept no records
+    // and all symbols are placed again. Now that the camera rests, the buckets are recorded.
+    const Immutable<Placement> recorded = place(prev);
+    // Same camera and tiles as the recorded placement, so its records are replayed.
+    const Immutable<Placement> replayed = place(recorded);
+    // The camera of the initial placement differs, so all symbols are placed again.
+    const Immutable<Placement> full = place(initial);
+
+    expectSamePlacement(*full, *recorded);
+    expectSamePlacement(*full, *replayed);
+    expectSamePlacement(*prev, *replayed);
+}
+
+TEST(Placement, PlaceLayersMatchesSerialPlacement) {
+    const TransformState state = makeTransformState();
+    mat4 projMatrix;
+    state.getProjMatrix(projMatrix);
+
+    uint32_t maxCrossTileID = 0;
+    std::vector<std::unique_ptr<StubSymbolLayer>> layers;
+    const auto addLayer = [&](const std::string& id, const std::string& sourceID, std::vector<Point<float>> icons) {
+        layers.push_back(std::make_unique<StubSymbolLayer>(id, sourceID, icons, maxCrossTileID));
+    };
+    addLayer("a1", "a", {{1000, 1000}, {4000, 4000}});
+    addLayer("b1", "b", {{1000, 1000}, {1050, 1000}});
+    addLayer("a2", "a", {{1050, 1050}, {7000, 7000}});
+    addLayer("c1", "c", {{4000, 4000}});
+    addLayer("b2", "b", {{1020, 1020}});
+
+    const Immutable<Placement> initial = makeInitialPlacement();
+
+    auto serial = makeMutable<Placement>(state, MapMode::Continuous, style::TransitionOptions{}, false, initial);
+    for (const auto& layer : layers) {
+        serial->placeLayer(*layer, projMatrix, false);
+    }
+
+    auto parallel = makeMutable<Placement>(state, MapMode::Continuous, style::TransitionOptions{}, false, initial);
+    std::vector<std::reference_wrapper<const RenderLayer>> layerRefs;
+    for (const auto& layer : layers) {
+        layerRefs.emplace_back(*layer);
+    }
+    parallel->placeLayers(layerRefs, projMatrix, false);
+
+    // Icons only collide with the icons of the same source.
+    EXPECT_TRUE(serial->getPlacements().at(1).icon);
+    EXPECT_TRUE(serial->getPlacements().at(2).icon);
+    EXPECT_TRUE(serial->getPlacements().at(3).icon);
+    EXPECT_FALSE(serial->getPlacements().at(4).icon);
+    EXPECT_FALSE(serial->getPlacements().at(5).icon);
+    EXPECT_TRUE(serial->getPlacements().at(6).icon);
+    EXPECT_TRUE(serial->getPlacements().at(7).icon);
+    EXPECT_FALSE(serial->getPlacements().at(8).icon);
+
+    expectSamePlacement(*serial, *parallel);
+}
@@ -0,0 +1,136 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/text/bidi.hpp>
+#include <mbgl/text/shaping_cache.hpp>
+#include <mbgl/util/constants.hpp>
+
+using namespace mbgl;
+using namespace util;
+
+namespace {
+
+class ShapingCacheTest {
+public:
+    ShapingCacheTest() {
+        GlyphPosition glyphPosition;
+        glyphPosition.rect = { 1, 1, 18, 18 };
+        glyphPosition.metrics.width = 18;
+        glyphPosition.metrics.height = 18;
+        glyphPosition.metrics.left = 2;
+        glyphPosition.metrics.top = -8;
+        glyphPosition.metrics.advance = 21;
+
+        for (char16_t codePoint : { u'中', u'国' }) {
+            Glyph glyph;
+            glyph.id = codePoint;
+            glyph.metrics = glyphPosition.metrics;
+            glyphs[fontStackHash].emplace(codePoint, Immutable<Glyph>(makeMutable<Glyph>(std::move(glyph))));
+            glyphPositions[fontStackHash].emplace(codePoint, glyphPosition);
+        }
+    }
+
+    void setAdvance(uint32_t advance) {
+        for (auto& glyph : glyphs[fontStackHash]) {
+            auto mutableGlyph = makeMutable<Glyph>();
+            mutableGlyph->id = (*glyph.second)->id;
+            mutableGlyph->metrics = (*glyph.second)->metrics;
+            mutableGlyph->metrics.advance = advance;
+            glyph.second = Immutable<Glyph>(std::move(mutableGlyph));
+        }
+        for (auto& glyphPosition : glyphPositions[fontStackHash]) {
+            glyphPosition.second.metrics.advance = advance;
+        }
+    }
+
+    Shaping getShaping(const std::u16string& text, float layoutTextSize = 16.0f, float maxWidth = 10 * ONE_EM) {
+        return cache.getShaping(TaggedString(text, sectionOptions),
+                                maxWidth,
+                                ONE_EM, // lineHeight
+                                style::SymbolAnchorType::Center,
+                                style::TextJustifyType::Center,
+                                0,              // spacing
+                                {{0.0f, 0.0f}}, // translate
+                                WritingModeType::Horizontal,
+                                bidi,
+                                glyphs,
+                                glyphPositions,
+                                imagePositions,
+                                layoutTextSize,
+                                layoutTextSize,
+                                /*allowVerticalPlacement*/ false);
+    }
+
+    const FontStack fontStack{{"font-stack"}};
+    const FontStackHash fontStackHash = FontStackHasher()(fontStack);
+    const SectionOptions sectionOptions{ 1.0f, fontStack };
+
+    BiDi bidi;
+    GlyphMap glyphs;
+    GlyphPositions glyphPositions;
+    ImagePositions imagePositions;
+    ShapingCache cache{ 2 };
+};
+
+} // namespace
+
+TEST(ShapingCache, CachesShaping) {
+    ShapingCacheTest test;
+
+    const Shaping shaping = test.getShaping(u"中国");
+    ASSERT_EQ(1u, test.cache.size());
+    ASSERT_EQ(1u, shaping.positionedLines.size());
+    ASSERT_EQ(2u, shaping.positionedLines[0].positionedGlyphs.size());
+
+    // Shapings are shared across text sizes, but not across other layout properties.
+    const Shaping cached = test.getShaping(u"中国", 24.0f);
+    EXPECT_EQ(1u, test.cache.size());
+    EXPECT_EQ(shaping.left, cached.left);
+    EXPECT_EQ(shaping.right, cached.right);
+    EXPECT_EQ(shaping.positionedLines[0].positionedGlyphs[1].x, cached.positionedLines[0].positionedGlyphs[1].x);
+
+    const Shaping broken = test.getShaping(u"中国", 16.0f, ONE_EM);
+    EXPECT_EQ(2u, test.cache.size());
+    EXPECT_EQ(2u, broken.positionedLines.size());
+}
+
+TEST(ShapingCache, UpdatesGlyphPositions) {
+    ShapingCacheTest test;
+    test.getShaping(u"中国");
+
+    // The positions of the glyphs in the atlas may change between tiles.
+    test.glyphPositions[test.fontStackHash].at(u'国').rect = { 20, 1, 18, 18 };
+    test.glyphPositions[test.fontStackHash].erase(u'中');
+    const Shaping shaping = test.getShaping(u"中国");
+    EXPECT_EQ(1u, test.cache.size());
+    EXPECT_EQ(Rect<uint16_t>(), shaping.positionedLines[0].positionedGlyphs[0].rect);
+    EXPECT_EQ(Rect<uint16_t>(20, 1, 18, 18), shaping.positionedLines[0].positionedGlyphs[1].rect);
+}
+
+TEST(ShapingCache, SkipsMissingGlyphs) {
+    ShapingCacheTest test;
+
+    // Shapings of texts with missing glyphs would change once the glyphs are available.
+    const Shaping shaping = test.getShaping(u"中a");
+    EXPECT_EQ(1u, shaping.positionedLines[0].positionedGlyphs.size());
+    EXPECT_EQ(0u, test.cache.size());
+}
+
+TEST(ShapingCache, EvictsLeastRecentlyUsed) {
+    ShapingCacheTest test;
+
+    const float width = test.getShaping(u"中").right;
+    test.getShaping(u"国");
+    test.getShaping(u"中");
+    test.getShaping(u"中国");
+    EXPECT_EQ(2u, test.cache.size());
+
+    // Cached shapings keep the metrics they were made with, which tells them apart from new ones.
+    test.setAdvance(42);
+    EXPECT_EQ(width, test.getShaping(u"中").right);
+    EXPECT_EQ(2 * width, test.getShaping(u"国").right);
+    EXPECT_EQ(2u, test.cache.size());
+
+    test.cache.clear();
+    EXPECT_EQ(0u, test.cache.size());
+    EXPECT_EQ(2 * width, test.getShaping(u"中").right);
+}
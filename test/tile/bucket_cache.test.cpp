@@ -0,0 +1,188 @@
+#include <mbgl/test/util.hpp>
+#include <mbgl/test/stub_geometry_tile_feature.hpp>
+
+#include <mbgl/geometry/feature_index.hpp>
+#include <mbgl/layermanager/layer_manager.hpp>
+#include <mbgl/renderer/bucket_parameters.hpp>
+#include <mbgl/renderer/bucket_serialization.hpp>
+#include <mbgl/renderer/buckets/circle_bucket.hpp>
+#include <mbgl/renderer/render_layer.hpp>
+#include <mbgl/style/layers/circle_layer.hpp>
+#include <mbgl/style/layers/circle_layer_impl.hpp>
+#include <mbgl/style/layers/circle_layer_properties.hpp>
+#include <mbgl/tile/bucket_cache.hpp>
+#include <mbgl/util/binary_stream.hpp>
+
+#include <limits>
+#include <unordered_map>
+
+using namespace mbgl;
+using namespace mbgl::style;
+
+namespace {
+
+PropertyMap properties;
+
+std::vector<Immutable<LayerProperties>> makeCircleGroup(const std::string& id) {
+    CircleLayer layer(id, "source");
+    return {makeMutable<CircleLayerProperties>(staticImmutableCast<CircleLayer::Impl>(layer.baseImpl))};
+}
+
+BucketParameters makeBucketParameters(const std::vector<Immutable<LayerProperties>>& group) {
+    return {OverscaledTileID(0, 0, 0), MapMode::Static, 1.0f, group.front()->baseImpl->getTypeInfo()};
+}
+
+std::unique_ptr<Bucket> makeCircleBucket(const std::vector<Immutable<LayerProperties>>& group) {
+    auto bucket = LayerManager::get()->createBucket(makeBucketParameters(group), group);
+    for (const auto& point : {Point<int16_t>{100, 100}, Point<int16_t>{2000, 3000}}) {
+        GeometryCollection geometry{{point}};
+        bucket->addFeature(StubGeometryTileFeature{{}, FeatureType::Point, geometry, properties},
+                           geometry,
+                           {},
+                           PatternLayerMap(),
+                           0);
+    }
+    return bucket;
+}
+
+std::string serialize(const Bucket& bucket) {
+    util::BinaryWriter writer;
+    EXPECT_TRUE(bucket.serialize(writer));
+    return writer.getData();
+}
+
+std::string serialize(const FeatureIndex& featureIndex, const std::string& bucketLeaderID) {
+    util::BinaryWriter writer;
+    featureIndex.serialize(writer, bucketLeaderID);
+    return writer.getData();
+}
+
+} // namespace
+
+TEST(BucketCache, BucketRoundTrip) {
+    const auto group = makeCircleGroup("circle");
+    const auto bucket = makeCircleBucket(group);
+    ASSERT_TRUE(bucket->hasData());
+    const std::string data = serialize(*bucket);
+
+    auto restored = LayerManager::get()->createBucket(makeBucketParameters(group), group);
+    util::BinaryReader reader(data);
+    ASSERT_TRUE(restored->deserialize(reader));
+    EXPECT_EQ(0u, reader.remaining());
+    EXPECT_TRUE(restored->hasData());
+
+    // The vertices, indices, segments and paint property binders are restored.
+    EXPECT_EQ(data, serialize(*restored));
+
+    // Truncated data is rejected.
+    for (std::size_t size : {std::size_t(0), data.size() / 2, data.size() - 1}) {
+        auto truncated = LayerManager::get()->createBucket(makeBucketParameters(group), group);
+        util::BinaryReader truncatedReader(data.data(), size);
+        EXPECT_FALSE(truncated->deserialize(truncatedReader));
+    }
+}
+
+TEST(BucketCache, MalformedSegments) {
+    gfx::VertexVector<CircleLayoutVertex> vertices;
+    for (int i = 0; i < 4; ++i) {
+        vertices.emplace_back(CircleProgram::vertex({0, 0}, 0, 0));
+    }
+    gfx::IndexVector<gfx::Triangles> triangles;
+    triangles.emplace_back(0, 1, 2);
+
+    const auto readSegment = [&](uint64_t vertexOffset,
+                                 uint64_t indexOffset,
+                                 uint64_t vertexLength,
+                                 uint64_t indexLength) {
+        util::BinaryWriter writer;
+        writer.write<uint64_t>(1);
+        writer.write(vertexOffset);
+        writer.write(indexOffset);
+        writer.write(vertexLength);
+        writer.write(indexLength);
+        writer.write(0.0f);
+        util::BinaryReader reader(writer.getData());
+        SegmentVector<CircleAttributes> segments;
+        return readBucketData(reader, segments, vertices, triangles);
+    };
+
+    EXPECT_TRUE(readSegment(0, 0, 4, 3));
+    EXPECT_TRUE(readSegment(1, 0, 3, 3));
+
+    // Segments reaching past the vertices or indices.
+    EXPECT_FALSE(readSegment(1, 0, 4, 3));
+    EXPECT_FALSE(readSegment(0, 1, 4, 3));
+    EXPECT_FALSE(readSegment(5, 0, 0, 0));
+    EXPECT_FALSE(readSegment(std::numeric_limits<uint64_t>::max(), 0, 2, 3));
+    EXPECT_FALSE(readSegment(0, 0, 4, std::numeric_limits<uint64_t>::max()));
+
+    // Indices past the vertices of the segment.
+    EXPECT_FALSE(readSegment(0, 0, 2, 3));
+}
+
+TEST(BucketCache, FeatureIndexRoundTrip) {
+    FeatureIndex featureIndex(nullptr);
+    featureIndex.insert({{{100, 100}, {200, 300}}}, 0, "layer", "circle");
+    featureIndex.insert({{{1000, 1000}}}, 1, "layer", "circle");
+    featureIndex.insert({{{500, 500}}}, 0, "layer", "other");
+    const std::string data = serialize(featureIndex, "circle");
+
+    FeatureIndex restored(nullptr);
+    util::BinaryReader reader(data);
+    ASSERT_TRUE(restored.deserialize(reader, "layer", "circle"));
+    EXPECT_EQ(0u, reader.remaining());
+
+    // Only the features of the given bucket are restored.
+    EXPECT_EQ(data, serialize(restored, "circle"));
+    EXPECT_EQ(serialize(FeatureIndex(nullptr), "other"), serialize(restored, "other"));
+}
+
+TEST(BucketCache, StoreAndRestore) {
+    const std::string path = "test/fixtures/bucket_cache";
+    const OverscaledTileID id(0, 0, 0);
+    const auto group = makeCircleGroup("circle");
+    const auto bucket = makeCircleBucket(group);
+    const BucketParameters parameters = makeBucketParameters(group);
+    FeatureIndex featureIndex(nullptr);
+    featureIndex.insert({{{100, 100}}}, 0, "", "circle");
+
+    const uint64_t key = BucketCache::groupKey(group);
+    EXPECT_EQ(key, BucketCache::groupKey(makeCircleGroup("circle")));
+    EXPECT_NE(key, BucketCache::groupKey(makeCircleGroup("other")));
+
+    {
+        // Replaces whatever a previous run left behind.
+        BucketCache cache(path, id, "source", MapMode::Static, 1.0f, "previous data");
+        cache.store(key, bucket.get(), "circle", featureIndex);
+        cache.save();
+    }
+
+    {
+        // The tile data changed, so nothing is restored.
+        BucketCache cache(path, id, "source", MapMode::Static, 1.0f, "data");
+        FeatureIndex restoredIndex(nullptr);
+        std::unordered_map<std::string, LayerRenderData> renderData;
+        EXPECT_FALSE(cache.restore(key, group, parameters, restoredIndex, renderData));
+        cache.store(key, bucket.get(), "circle", featureIndex);
+        cache.save();
+    }
+
+    {
+        BucketCache cache(path, id, "source", MapMode::Static, 1.0f, "data");
+        FeatureIndex restoredIndex(nullptr);
+        std::unordered_map<std::string, LayerRenderData> renderData;
+        EXPECT_FALSE(cache.restore(key + 1, group, parameters, restoredIndex, renderData));
+        ASSERT_TRUE(cache.restore(key, group, parameters, restoredIndex, renderData));
+        ASSERT_EQ(1u, renderData.count("circle"));
+        EXPECT_EQ(serialize(*bucket), serialize(*renderData.at("circle").bucket));
+        EXPECT_EQ(serialize(featureIndex, "circle"), serialize(restoredIndex, "circle"));
+    }
+
+    {
+        // Other tiles aren't restored from the file.
+        BucketCache cache(path, OverscaledTileID(1, 0, 0), "source", MapMode::Static, 1.0f, "data");
+        FeatureIndex restoredIndex(nullptr);
+        std::unordered_map<std::string, LayerRenderData> renderData;
+        EXPECT_FALSE(cache.restore(key, group, parameters, restoredIndex, renderData));
+    }
+}
@@ -14,6 +14,7 @@
 #include <mbgl/annotation/annotation_manager.hpp>
 #include <mbgl/renderer/image_manager.hpp>
 #include <mbgl/text/glyph_manager.hpp>
+#include <mbgl/util/constants.hpp>
 
 #include <memory>
 
@@ -39,7 +40,10 @@ public:
         annotationManager,
         imageManager,
         glyphManager,
-        0
+        0,
+        false,
+        "",
+        util::DEFAULT_TILE_CACHE_SIZE
     };
 };
 
@@ -14,6 +14,7 @@
 #include <mbgl/style/style.hpp>
 #include <mbgl/text/glyph_manager.hpp>
 #include <mbgl/util/run_loop.hpp>
+#include <mbgl/util/constants.hpp>
 
 #include <memory>
 
@@ -40,7 +41,10 @@ public:
         annotationManager,
         imageManager,
         glyphManager,
-        0
+        0,
+        false,
+        "",
+        util::DEFAULT_TILE_CACHE_SIZE
     };
 };
 
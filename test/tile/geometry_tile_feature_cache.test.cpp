@@ -0,0 +1,62 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/tile/geometry_tile_feature_cache.hpp>
+#include <mbgl/tile/vector_tile_data.hpp>
+#include <mbgl/util/io.hpp>
+
+using namespace mbgl;
+
+TEST(GeometryTileFeatureCache, MissingLayer) {
+    VectorTileData data(std::make_shared<std::string>(util::read_file("test/fixtures/api/assets/streets/10-163-395.vector.pbf")));
+    GeometryTileFeatureCache cache(data);
+
+    EXPECT_EQ(nullptr, cache.getLayer("no-such-layer"));
+    EXPECT_EQ(nullptr, cache.getLayer("no-such-layer"));
+}
+
+TEST(GeometryTileFeatureCache, SharesDecodedFeatures) {
+    VectorTileData data(std::make_shared<std::string>(util::read_file("test/fixtures/api/assets/streets/10-163-395.vector.pbf")));
+    GeometryTileFeatureCache cache(data);
+
+    auto raw = data.getLayer("road");
+    auto first = cache.getLayer("road");
+    auto second = cache.getLayer("road");
+    ASSERT_TRUE(raw);
+    ASSERT_TRUE(first);
+    ASSERT_TRUE(second);
+
+    EXPECT_EQ(raw->getName(), first->getName());
+    ASSERT_EQ(raw->featureCount(), first->featureCount());
+    ASSERT_EQ(raw->featureCount(), second->featureCount());
+    ASSERT_GT(raw->featureCount(), 0u);
+
+    for (std::size_t i = 0; i < raw->featureCount(); ++i) {
+        auto expected = raw->getFeature(i);
+        auto a = first->getFeature(i);
+        auto b = second->getFeature(i);
+
+        EXPECT_EQ(expected->getType(), a->getType());
+        EXPECT_EQ(expected->getID(), a->getID());
+        EXPECT_EQ(expected->getProperties(), a->getProperties());
+        EXPECT_EQ(expected->getValue("class"), a->getValue("class"));
+        EXPECT_EQ(expected->getGeometries(), a->getGeometries());
+
+        // Both views hand out the same decoded data.
+        EXPECT_EQ(&a->getGeometries(), &b->getGeometries());
+        EXPECT_EQ(&a->getProperties(), &b->getProperties());
+    }
+}
+
+TEST(GeometryTileFeatureCache, LayerOutlivesCache) {
+    VectorTileData data(std::make_shared<std::string>(util::read_file("test/fixtures/api/assets/streets/10-163-395.vector.pbf")));
+
+    std::unique_ptr<GeometryTileLayer> layer;
+    {
+        GeometryTileFeatureCache cache(data);
+        layer = cache.getLayer("water");
+    }
+
+    ASSERT_TRUE(layer);
+    ASSERT_GT(layer->featureCount(), 0u);
+    EXPECT_FALSE(layer->getFeature(0)->getGeometries().empty());
+}
@@ -11,6 +11,7 @@
 #include <mbgl/renderer/buckets/raster_bucket.hpp>
 #include <mbgl/renderer/image_manager.hpp>
 #include <mbgl/text/glyph_manager.hpp>
+#include <mbgl/util/constants.hpp>
 
 using namespace mbgl;
 
@@ -34,7 +35,10 @@ public:
         annotationManager,
         imageManager,
         glyphManager,
-        0
+        0,
+        false,
+        "",
+        util::DEFAULT_TILE_CACHE_SIZE
     };
 };
 
@@ -18,6 +18,7 @@
 #include <mbgl/style/style.hpp>
 #include <mbgl/text/glyph_manager.hpp>
 #include <mbgl/util/run_loop.hpp>
+#include <mbgl/util/constants.hpp>
 
 #include <memory>
 
@@ -42,7 +43,10 @@ public:
                                   annotationManager,
                                   imageManager,
                                   glyphManager,
-                                  0};
+                                  0,
+                                  false,
+                                  "",
+                                  util::DEFAULT_TILE_CACHE_SIZE};
 };
 
 class VectorTileMock : public VectorTile {
@@ -56,6 +60,20 @@ public:
     }
 };
 
+class SizedVectorTileMock : public VectorTileMock {
+public:
+    SizedVectorTileMock(const OverscaledTileID& id_,
+                        const TileParameters& parameters,
+                        const Tileset& tileset,
+                        std::size_t bytes_)
+        : VectorTileMock(id_, "source", parameters, tileset), bytes(bytes_) {}
+
+    std::size_t getMemoryUsage() const override { return bytes; }
+
+private:
+    const std::size_t bytes;
+};
+
 TEST(TileCache, Smoke) {
     VectorTileTest test;
     TileCache cache(1);
@@ -85,3 +103,73 @@ TEST(TileCache, Issue15926) {
     EXPECT_FALSE(cache.has(id0));
     EXPECT_TRUE(cache.has(id1));
 }
+
+TEST(TileCache, LeastRecentlyUsed) {
+    VectorTileTest test;
+    TileCache cache(2);
+    OverscaledTileID id0(1, 0, 0);
+    OverscaledTileID id1(1, 0, 1);
+    OverscaledTileID id2(1, 1, 0);
+
+    cache.add(id0, std::make_unique<VectorTileMock>(id0, "source", test.tileParameters, test.tileset));
+    cache.add(id1, std::make_unique<VectorTileMock>(id1, "source", test.tileParameters, test.tileset));
+    // Adding the tile again makes it the most recently used one.
+    cache.add(id0, std::make_unique<VectorTileMock>(id0, "source", test.tileParameters, test.tileset));
+    cache.add(id2, std::make_unique<VectorTileMock>(id2, "source", test.tileParameters, test.tileset));
+
+    EXPECT_EQ(2u, cache.getCount());
+    EXPECT_TRUE(cache.has(id0));
+    EXPECT_FALSE(cache.has(id1));
+    EXPECT_TRUE(cache.has(id2));
+
+    auto tile = cache.pop(id0);
+    ASSERT_TRUE(tile);
+    EXPECT_EQ(id0, tile->id);
+    EXPECT_FALSE(cache.has(id0));
+    EXPECT_EQ(nullptr, cache.get(id0));
+    EXPECT_EQ(nullptr, cache.pop(id0));
+    EXPECT_EQ(1u, cache.getCount());
+}
+
+TEST(TileCache, MemoryBudget) {
+    VectorTileTest test;
+    TileCache cache(10, 100);
+    OverscaledTileID id0(1, 0, 0);
+    OverscaledTileID id1(1, 0, 1);
+    OverscaledTileID id2(1, 1, 0);
+    OverscaledTileID id3(1, 1, 1);
+
+    cache.add(id0, std::make_unique<SizedVectorTileMock>(id0, test.tileParameters, test.tileset, 40));
+    cache.add(id1, std::make_unique<SizedVectorTileMock>(id1, test.tileParameters, test.tileset, 40));
+    EXPECT_EQ(80u, cache.getBytes());
+
+    // Evicts the oldest tile to stay within the budget.
+    cache.add(id2, std::make_unique<SizedVectorTileMock>(id2, test.tileParameters, test.tileset, 30));
+    EXPECT_FALSE(cache.has(id0));
+    EXPECT_TRUE(cache.has(id1));
+    EXPECT_TRUE(cache.has(id2));
+    EXPECT_EQ(70u, cache.getBytes());
+
+    // Replacing a tile accounts for its new size.
+    cache.add(id1, std::make_unique<SizedVectorTileMock>(id1, test.tileParameters, test.tileset, 10));
+    EXPECT_EQ(40u, cache.getBytes());
+
+    cache.pop(id2);
+    EXPECT_EQ(10u, cache.getBytes());
+
+    // A tile exceeding the budget on its own is kept as long as it is the newest one.
+    cache.add(id3, std::make_unique<SizedVectorTileMock>(id3, test.tileParameters, test.tileset, 200));
+    EXPECT_FALSE(cache.has(id1));
+    EXPECT_TRUE(cache.has(id3));
+    EXPECT_EQ(200u, cache.getBytes());
+
+    cache.setMaxBytes(50);
+    EXPECT_TRUE(cache.has(id3));
+    cache.add(id0, std::make_unique<SizedVectorTileMock>(id0, test.tileParameters, test.tileset, 20));
+    EXPECT_FALSE(cache.has(id3));
+    EXPECT_EQ(20u, cache.getBytes());
+
+    cache.clear();
+    EXPECT_EQ(0u, cache.getBytes());
+    EXPECT_EQ(0u, cache.getCount());
+}
@@ -15,6 +15,7 @@
 #include <mbgl/annotation/annotation_manager.hpp>
 #include <mbgl/renderer/image_manager.hpp>
 #include <mbgl/text/glyph_manager.hpp>
+#include <mbgl/util/constants.hpp>
 
 #include <memory>
 
@@ -40,7 +41,10 @@ public:
         annotationManager,
         imageManager,
         glyphManager,
-        0
+        0,
+        false,
+        "",
+        util::DEFAULT_TILE_CACHE_SIZE
     };
 };
 
@@ -104,3 +108,24 @@ TEST(VectorTileData, ParseResults) {
 
     ASSERT_EQ(feature->getValue("invalid"), nullopt);
 }
+
+TEST(VectorTileData, FindValue) {
+    VectorTileData data(std::make_shared<std::string>(util::read_file("test/fixtures/map/issue12432/0-0-0.mvt")));
+    std::unique_ptr<GeometryTileLayer> layer = data.getLayer("admin");
+
+    for (std::size_t i = 0; i < 100u; ++i) {
+        std::unique_ptr<GeometryTileFeature> feature = layer->getFeature(i);
+        for (const auto& property : feature->getProperties()) {
+            const Value* value = feature->findValue(property.first);
+            ASSERT_TRUE(value);
+            EXPECT_EQ(property.second, *value);
+            EXPECT_EQ(property.second, *feature->getValue(property.first));
+        }
+    }
+
+    std::unique_ptr<GeometryTileFeature> first = layer->getFeature(0u);
+    std::unique_ptr<GeometryTileFeature> second = layer->getFeature(1u);
+    // Values are shared between the features of a layer instead of being copied.
+    EXPECT_EQ(first->findValue("disputed"), second->findValue("disputed"));
+    EXPECT_EQ(nullptr, first->findValue("invalid"));
+}
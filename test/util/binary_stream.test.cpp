@@ -0,0 +1,83 @@
+#include <mbgl/util/binary_stream.hpp>
+#include <mbgl/renderer/bucket_serialization.hpp>
+#include <mbgl/programs/fill_program.hpp>
+
+#include <mbgl/test/util.hpp>
+
+#include <cstring>
+#include <limits>
+
+using namespace mbgl;
+
+TEST(BinaryStream, RoundTrip) {
+    util::BinaryWriter writer;
+    writer.write<uint32_t>(42);
+    writer.write(std::string("layer"));
+    writer.write(std::vector<float>{1.5f, 2.5f});
+    writer.write(true);
+
+    util::BinaryReader reader(writer.getData());
+    uint32_t number;
+    std::string string;
+    std::vector<float> floats;
+    bool flag;
+    ASSERT_TRUE(reader.read(number));
+    ASSERT_TRUE(reader.read(string));
+    ASSERT_TRUE(reader.read(floats));
+    ASSERT_TRUE(reader.read(flag));
+    EXPECT_EQ(42u, number);
+    EXPECT_EQ("layer", string);
+    EXPECT_EQ((std::vector<float>{1.5f, 2.5f}), floats);
+    EXPECT_TRUE(flag);
+    EXPECT_EQ(0u, reader.remaining());
+    EXPECT_FALSE(reader.read(flag));
+}
+
+TEST(BinaryStream, Truncated) {
+    util::BinaryWriter writer;
+    writer.write(std::vector<uint64_t>{1, 2, 3});
+    const std::string data = writer.getData();
+
+    // A vector whose elements were cut off fails to read, as does everything after it.
+    util::BinaryReader reader(data.data(), data.size() - 1);
+    std::vector<uint64_t> values;
+    EXPECT_FALSE(reader.read(values));
+    EXPECT_EQ(0u, reader.remaining());
+
+    // A huge element count doesn't cause a huge allocation.
+    util::BinaryWriter countWriter;
+    countWriter.write(std::numeric_limits<uint64_t>::max());
+    util::BinaryReader countReader(countWriter.getData());
+    EXPECT_FALSE(countReader.read(values));
+}
+
+TEST(BinaryStream, BucketData) {
+    gfx::VertexVector<FillLayoutVertex> vertices;
+    vertices.emplace_back(FillProgram::layoutVertex({1, 2}));
+    vertices.emplace_back(FillProgram::layoutVertex({3, 4}));
+    gfx::IndexVector<gfx::Triangles> triangles;
+    triangles.emplace_back(0, 1, 0);
+    SegmentVector<FillAttributes> segments;
+    segments.emplace_back(0, 0, 2, 3, 1.0f);
+
+    util::BinaryWriter writer;
+    writeBucketData(writer, vertices);
+    writeBucketData(writer, triangles);
+    writeBucketData(writer, segments);
+
+    gfx::VertexVector<FillLayoutVertex> readVertices;
+    gfx::IndexVector<gfx::Triangles> readTriangles;
+    SegmentVector<FillAttributes> readSegments;
+    util::BinaryReader reader(writer.getData());
+    ASSERT_TRUE(readBucketData(reader, readVertices));
+    ASSERT_TRUE(readBucketData(reader, readTriangles));
+    ASSERT_TRUE(readBucketData(reader, readSegments));
+
+    ASSERT_EQ(2u, readVertices.elements());
+    EXPECT_EQ(0, std::memcmp(vertices.data(), readVertices.data(), vertices.bytes()));
+    EXPECT_EQ(triangles.vector(), readTriangles.vector());
+    ASSERT_EQ(1u, readSegments.size());
+    EXPECT_EQ(2u, readSegments[0].vertexLength);
+    EXPECT_EQ(3u, readSegments[0].indexLength);
+    EXPECT_EQ(1.0f, readSegments[0].sortKey);
+}
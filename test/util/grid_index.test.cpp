@@ -56,3 +56,35 @@ TEST(GridIndex, IndexesFeaturesOverflow) {
     grid.insert(0, {{4500, 4500}, {4900, 4900}});
     EXPECT_EQ(grid.query({{4000, 4000}, {5000, 5000}}), (std::vector<int16_t>{0}));
 }
+
+TEST(GridIndex, HitTestPredicate) {
+    GridIndex<int16_t> grid(100, 100, 10);
+    grid.insert(1, {{10, 10}, {40, 40}});
+    grid.insert(2, {{60, 60}, 10});
+
+    const auto isEven = [](int16_t key) { return key % 2 == 0; };
+    EXPECT_TRUE(grid.hitTest({{20, 20}, {25, 25}}));
+    EXPECT_FALSE(grid.hitTest({{20, 20}, {25, 25}}, isEven));
+    EXPECT_TRUE(grid.hitTest({{55, 55}, {56, 56}}, isEven));
+    EXPECT_FALSE(grid.hitTest({{35, 35}, 2}, isEven));
+    EXPECT_TRUE(grid.hitTest({{65, 65}, 2}, isEven));
+}
+
+TEST(GridIndex, QueryVisitsEachGeometryOnce) {
+    GridIndex<int16_t> grid(100, 100, 10);
+    // Spans 36 cells, and more than four boxes share some of them.
+    for (int i = 0; i < 9; ++i) {
+        grid.insert(int16_t(i), {{5.0f + i, 5.0f + i}, {55.0f + i, 55.0f + i}});
+    }
+    grid.insert(9, {{50, 50}, 20});
+
+    EXPECT_EQ(grid.query({{0, 0}, {99, 99}}), (std::vector<int16_t>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+    EXPECT_EQ(grid.query({{58, 58}, {70, 70}}), (std::vector<int16_t>{3, 4, 5, 6, 7, 8, 9}));
+
+    std::vector<int16_t> visited;
+    grid.query(GridIndex<int16_t>::BCircle{{30, 30}, 5}, [&](int16_t key, const GridIndex<int16_t>::BBox&) {
+        visited.push_back(key);
+        return key == 4;
+    });
+    EXPECT_EQ(visited, (std::vector<int16_t>{0, 1, 2, 3, 4}));
+}
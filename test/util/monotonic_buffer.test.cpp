@@ -0,0 +1,103 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/geometry/anchor.hpp>
+#include <mbgl/layout/symbol_layout.hpp>
+#include <mbgl/text/collision_feature.hpp>
+#include <mbgl/tile/geometry_tile_data.hpp>
+#include <mbgl/util/monotonic_buffer.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace mbgl;
+using namespace mbgl::util;
+
+TEST(MonotonicBuffer, Allocate) {
+    MonotonicBuffer buffer(64);
+    EXPECT_EQ(0u, buffer.getMemoryUsage());
+
+    auto* a = static_cast<char*>(buffer.allocate(3, 1));
+    auto* b = static_cast<char*>(buffer.allocate(8, 8));
+    EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(b) % 8);
+    EXPECT_LE(a + 3, b);
+    EXPECT_EQ(1u, buffer.getBlockCount());
+    EXPECT_EQ(64u, buffer.getMemoryUsage());
+
+    // Blocks double in size.
+    buffer.allocate(60, 1);
+    EXPECT_EQ(2u, buffer.getBlockCount());
+    EXPECT_EQ(192u, buffer.getMemoryUsage());
+
+    // Larger allocations get a block of their own size.
+    buffer.allocate(1000, 1);
+    EXPECT_EQ(3u, buffer.getBlockCount());
+    EXPECT_EQ(1192u, buffer.getMemoryUsage());
+    EXPECT_EQ(4u, buffer.getAllocationCount());
+}
+
+TEST(MonotonicBuffer, Containers) {
+    MonotonicBuffer buffer;
+
+    MonotonicVector<float> vector{ MonotonicAllocator<float>(&buffer) };
+    vector.reserve(100);
+    vector.assign(100, 1.0f);
+    MonotonicU16String string(u"a string that does not fit into the string itself", MonotonicAllocator<char16_t>(&buffer));
+    EXPECT_EQ(1u, buffer.getBlockCount());
+
+    // Moves keep allocating from the buffer.
+    MonotonicVector<float> moved(std::move(vector));
+    EXPECT_EQ(&buffer, moved.get_allocator().getBuffer());
+
+    // Copies are allocated on the heap, so that they may outlive the buffer.
+    MonotonicVector<float> copy(moved);
+    EXPECT_EQ(nullptr, copy.get_allocator().getBuffer());
+    EXPECT_EQ(moved, copy);
+    MonotonicU16String stringCopy(string);
+    EXPECT_EQ(nullptr, stringCopy.get_allocator().getBuffer());
+    EXPECT_EQ(string, stringCopy);
+
+    // Containers without a buffer allocate on the heap.
+    MonotonicVector<float> heap(10, 2.0f);
+    EXPECT_EQ(nullptr, heap.get_allocator().getBuffer());
+    EXPECT_EQ(1u, buffer.getBlockCount());
+}
+
+TEST(MonotonicBuffer, SymbolLayoutAllocations) {
+    MonotonicBuffer buffer;
+
+    // A tile of 1000 line labels, each allocating what SymbolLayout allocates for it: the key,
+    // the collision boxes, and the line, tile distances and glyph offsets of the placed symbol.
+    GeometryCoordinates line;
+    for (int16_t x = 0; x <= 4096; x += 512) {
+        line.emplace_back(x, 2048);
+    }
+    const std::u16string key = u"Main Street";
+    std::vector<MonotonicU16String> keys;
+    std::vector<CollisionFeature> features;
+    std::vector<MonotonicVector<GeometryCoordinate>> lines;
+    std::vector<MonotonicVector<float>> tileDistances;
+    std::vector<MonotonicVector<float>> glyphOffsets;
+    keys.reserve(1000);
+    features.reserve(1000);
+    lines.reserve(1000);
+    tileDistances.reserve(1000);
+    glyphOffsets.reserve(1000);
+    for (std::size_t i = 0; i < 1000; ++i) {
+        const float x = 1000.0f + 2.0f * static_cast<float>(i);
+        const Anchor anchor(x, 2048.0f, 0.0f, static_cast<std::size_t>(x / 512));
+        keys.emplace_back(key.begin(), key.end(), MonotonicAllocator<char16_t>(&buffer));
+        features.emplace_back(line, anchor, -10.0f, 10.0f, -100.0f, 100.0f, 1.0f, 0.0f,
+                              style::SymbolPlacementType::Line, IndexedSubfeature(i, "", "", i), 1.0f, 0.0f,
+                              &buffer);
+        lines.emplace_back(line.begin(), line.end(), MonotonicAllocator<GeometryCoordinate>(&buffer));
+        tileDistances.push_back(
+            SymbolLayout::calculateTileDistances(line, anchor, MonotonicAllocator<float>(&buffer)));
+        glyphOffsets.emplace_back(MonotonicAllocator<float>(&buffer));
+        glyphOffsets.back().reserve(key.size());
+    }
+
+    // Without the buffer, every one of these would be a heap allocation of its own.
+    EXPECT_EQ(5000u, buffer.getAllocationCount());
+    EXPECT_EQ(9u, buffer.getBlockCount());
+}
@@ -0,0 +1,156 @@
+#include <mbgl/util/thread_pool.hpp>
+
+#include <mbgl/actor/actor.hpp>
+#include <mbgl/test/util.hpp>
+
+#include <atomic>
+#include <future>
+#include <mutex>
+#include <vector>
+
+using namespace mbgl;
+
+TEST(ThreadPool, RunsAllTasks) {
+    ThreadPool pool(8);
+    EXPECT_EQ(8u, pool.getThreadCount());
+
+    const unsigned count = 10000;
+    std::atomic<unsigned> executed{0};
+    std::promise<void> done;
+
+    for (unsigned i = 0; i < count; ++i) {
+        pool.schedule([&] {
+            if (++executed == count) done.set_value();
+        });
+    }
+
+    done.get_future().get();
+    EXPECT_EQ(count, executed);
+}
+
+TEST(ThreadPool, TasksScheduledFromWorkers) {
+    ThreadPool pool(4);
+
+    const unsigned fanOut = 100;
+    std::atomic<unsigned> executed{0};
+    std::promise<void> done;
+
+    for (unsigned i = 0; i < fanOut; ++i) {
+        pool.schedule([&] {
+            // Nested tasks land in the worker's own queue and get stolen by the others.
+            for (unsigned j = 0; j < fanOut; ++j) {
+                pool.schedule([&] {
+                    if (++executed == fanOut * fanOut) done.set_value();
+                });
+            }
+        });
+    }
+
+    done.get_future().get();
+    EXPECT_EQ(fanOut * fanOut, executed);
+}
+
+TEST(ThreadPool, Priorities) {
+    ThreadPool pool(1);
+
+    std::promise<void> blocker;
+    std::shared_future<void> blocked = blocker.get_future().share();
+    std::promise<void> started;
+    pool.schedule([&] {
+        started.set_value();
+        blocked.wait();
+    });
+    started.get_future().wait();
+
+    std::mutex mutex;
+    std::vector<TaskPriority> order;
+    std::promise<void> done;
+    auto record = [&](TaskPriority priority) {
+        return [&, priority] {
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back(priority);
+            if (order.size() == 3) done.set_value();
+        };
+    };
+
+    pool.scheduleWithPriority(TaskPriority::Low, record(TaskPriority::Low));
+    pool.scheduleWithPriority(TaskPriority::Normal, record(TaskPriority::Normal));
+    pool.scheduleWithPriority(TaskPriority::High, record(TaskPriority::High));
+    blocker.set_value();
+
+    done.get_future().get();
+    EXPECT_EQ((std::vector<TaskPriority>{ TaskPriority::High, TaskPriority::Normal, TaskPriority::Low }), order);
+}
+
+TEST(ThreadPool, SequencedSchedulerIgnoresPriorities) {
+    SequencedScheduler scheduler;
+
+    std::mutex mutex;
+    std::vector<int> order;
+    std::promise<void> done;
+
+    for (int i = 0; i < 100; ++i) {
+        const auto priority = i % 2 ? TaskPriority::High : TaskPriority::Low;
+        scheduler.scheduleWithPriority(priority, [&, i] {
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back(i);
+            if (order.size() == 100) done.set_value();
+        });
+    }
+
+    done.get_future().get();
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(i, order[i]);
+    }
+}
+
+namespace {
+
+class Counter {
+public:
+    Counter(ActorRef<Counter>) {}
+
+    void next(unsigned value, std::function<void()> cb) {
+        // Messages to a mailbox are processed in order and never concurrently.
+        EXPECT_FALSE(busy.exchange(true));
+        EXPECT_EQ(expected++, value);
+        busy = false;
+        if (cb) cb();
+    }
+
+private:
+    std::atomic<bool> busy{false};
+    unsigned expected = 0;
+};
+
+} // namespace
+
+TEST(ThreadPool, MailboxOrdering) {
+    auto pool = std::make_shared<ThreadPool>(8);
+
+    const unsigned actorCount = 16;
+    const unsigned messageCount = 1000;
+    std::atomic<unsigned> finished{0};
+    std::promise<void> done;
+
+    std::vector<std::unique_ptr<Actor<Counter>>> actors;
+    for (unsigned i = 0; i < actorCount; ++i) {
+        actors.emplace_back(std::make_unique<Actor<Counter>>(pool));
+        actors.back()->setPriority(i % 2 ? TaskPriority::High : TaskPriority::Low);
+    }
+
+    for (unsigned value = 0; value < messageCount; ++value) {
+        for (auto& actor : actors) {
+            std::function<void()> cb;
+            if (value + 1 == messageCount) {
+                cb = [&] {
+                    if (++finished == actorCount) done.set_value();
+                };
+            }
+            actor->self().invoke(&Counter::next, value, std::move(cb));
+        }
+    }
+
+    done.get_future().get();
+    actors.clear();
+}